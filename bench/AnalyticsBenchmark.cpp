@@ -0,0 +1,575 @@
+//
+//  AnalyticsBenchmark.cpp
+//  InvertedYieldCurveTrader
+//
+//  Microbenchmarks for every analytics stage, parameterized over
+//  N indicators, T observations and rolling window length
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <benchmark/benchmark.h>
+#include "SyntheticData.hpp"
+#include "../src/DataProcessors/DataAligner.hpp"
+#include "../src/DataProcessors/SurpriseTransformer.hpp"
+#include "../src/DataProcessors/EwmaCovariance.hpp"
+#include "../src/DataProcessors/PairwiseCovariance.hpp"
+#include "../src/DataProcessors/MonteCarloRisk.hpp"
+#include "../src/DataProcessors/HistoricalSimulation.hpp"
+#include "../src/DataProcessors/ScenarioLibrary.hpp"
+#include "../src/DataProcessors/RegimeEngine.hpp"
+#include "../src/DataProcessors/RegimeHmm.hpp"
+#include "../src/Utils/Logger.hpp"
+#include <limits>
+
+// ===== DataAligner =====
+
+// Arg: T daily observations
+static void BM_DownsampleToMonthly(benchmark::State& state) {
+    const int numObservations = static_cast<int>(state.range(0));
+    std::vector<double> daily = SyntheticData::levelSeries(numObservations);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(DataAligner::downsampleToMonthly(daily, numObservations / 21));
+    }
+    state.SetItemsProcessed(state.iterations() * numObservations);
+}
+BENCHMARK(BM_DownsampleToMonthly)->Arg(252)->Arg(2520)->Arg(25200);
+
+// Arg: T quarterly observations
+static void BM_InterpolateQuarterlyToMonthly(benchmark::State& state) {
+    const int numObservations = static_cast<int>(state.range(0));
+    std::vector<double> quarterly = SyntheticData::levelSeries(numObservations);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(DataAligner::interpolateQuarterlyToMonthly(quarterly, 3 * numObservations));
+    }
+    state.SetItemsProcessed(state.iterations() * numObservations);
+}
+BENCHMARK(BM_InterpolateQuarterlyToMonthly)->Arg(8)->Arg(120)->Arg(1200);
+
+// Arg: T daily observations for the daily indicators (252 = one year → 12 months)
+static void BM_AlignAllIndicators(benchmark::State& state) {
+    auto raw = SyntheticData::rawIndicatorPanel(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(DataAligner::alignAllIndicators(raw));
+    }
+}
+BENCHMARK(BM_AlignAllIndicators)->Arg(252)->Arg(2520);
+
+// ===== SurpriseTransformer =====
+
+// Args: T monthly levels, AR(1) lookback
+static void BM_ExtractSurprise(benchmark::State& state) {
+    const int numObservations = static_cast<int>(state.range(0));
+    const int lookback = static_cast<int>(state.range(1));
+    std::vector<double> levels = SyntheticData::levelSeries(numObservations);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SurpriseTransformer::extractSurprise(levels, "unemployment", lookback));
+    }
+    state.SetItemsProcessed(state.iterations() * numObservations);
+}
+BENCHMARK(BM_ExtractSurprise)->ArgsProduct({{12, 120, 360}, {6, 12, 36}});
+
+// ===== CovarianceCalculator =====
+
+// Args: N indicators, T observations
+static void BM_CalculateCovarianceMatrix(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numObservations = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, numObservations);
+    CovarianceCalculator calculator;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculator.calculateCovarianceMatrix(panel));
+    }
+    state.SetItemsProcessed(state.iterations() * numIndicators * numObservations);
+}
+BENCHMARK(BM_CalculateCovarianceMatrix)->ArgsProduct({{8, 32, 128}, {12, 120, 360}});
+
+// Args: N indicators, T observations — NaN-padded ragged starts, masked GEMM kernel
+static void BM_PairwiseCovariance(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numObservations = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, numObservations);
+
+    // Every fourth series starts a quarter of the way in
+    int column = 0;
+    for (auto& [name, series] : panel) {
+        if (column++ % 4 == 0) {
+            std::fill(series.begin(), series.begin() + numObservations / 4, std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    PairwiseCovarianceOptions options;
+    options.repairPsd = false;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PairwiseCovariance::compute(panel, options));
+    }
+    state.SetItemsProcessed(state.iterations() * numIndicators * numObservations);
+}
+BENCHMARK(BM_PairwiseCovariance)->ArgsProduct({{8, 32, 128}, {120, 360}});
+
+// Args: N indicators, number of half-lives — cost of folding in one new month
+static void BM_EwmaCovarianceUpdate(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numHorizons = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, 360);
+
+    std::vector<std::string> names;
+    for (const auto& [name, series] : panel) {
+        names.push_back(name);
+    }
+    std::vector<double> halfLives;
+    for (int h = 0; h < numHorizons; h++) {
+        halfLives.push_back(3.0 * (h + 1));
+    }
+    EwmaCovariance engine(names, halfLives, true);
+
+    Eigen::VectorXd observation(numIndicators);
+    size_t t = 0;
+    for (auto _ : state) {
+        int i = 0;
+        for (const auto& [name, series] : panel) {
+            observation(i++) = series[t];
+        }
+        engine.update(observation);
+        t = (t + 1) % 360;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EwmaCovarianceUpdate)->ArgsProduct({{8, 32, 128}, {1, 3}});
+
+// ===== MacroFactorModel =====
+
+// Args: N indicators, K factors
+static void BM_DecomposeSurpriseCovariance(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numFactors = static_cast<int>(state.range(1));
+    CovarianceMatrix covariance = SyntheticData::surpriseCovariance(numIndicators);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MacroFactorModel::decomposeSurpriseCovariance(covariance, numFactors));
+    }
+}
+BENCHMARK(BM_DecomposeSurpriseCovariance)->ArgsProduct({{8, 32, 128}, {3}})->Args({128, 8});
+
+// Args: N indicators, T observations — exact path: form Σ, dense eigensolve
+static void BM_DecomposePanelExact(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numObservations = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, numObservations);
+    CovarianceCalculator calculator;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MacroFactorModel::decomposeSurpriseCovariance(
+            calculator.calculateCovarianceMatrix(panel), 3));
+    }
+}
+BENCHMARK(BM_DecomposePanelExact)->ArgsProduct({{128, 512}, {360}})->Unit(benchmark::kMillisecond);
+
+// Args: N indicators, T observations, power iterations — randomized path, Σ never formed
+static void BM_DecomposePanelRandomized(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numObservations = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, numObservations);
+    RandomizedPCAOptions options;
+    options.powerIterations = static_cast<int>(state.range(2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MacroFactorModel::decomposeSurprisePanel(panel, 3, options));
+    }
+}
+BENCHMARK(BM_DecomposePanelRandomized)
+    ->ArgsProduct({{128, 512, 2048}, {360}, {2}})
+    ->Args({2048, 360, 0})
+    ->Unit(benchmark::kMillisecond);
+
+// Args: N indicators, K factors — archetype matrix built once, one K × A cosine product
+static void BM_LabelFactors(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numFactors = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, 120);
+    CovarianceCalculator calculator;
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+        calculator.calculateCovarianceMatrix(panel), numFactors);
+    ArchetypeMatrix archetypes = MacroFactorModel::buildArchetypeMatrix(factors.indicatorNames);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MacroFactorModel::labelFactors(factors.loadings, archetypes));
+    }
+    state.SetItemsProcessed(state.iterations() * numFactors);
+}
+BENCHMARK(BM_LabelFactors)->ArgsProduct({{8, 128}, {3}});
+
+// Args: N indicators, T observations — every date scored in one T × N × K product
+static void BM_ComputeFactorScores(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numObservations = static_cast<int>(state.range(1));
+    auto panel = SyntheticData::surprisePanel(numIndicators, numObservations);
+    CovarianceCalculator calculator;
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+        calculator.calculateCovarianceMatrix(panel), 3);
+
+    for (auto _ : state) {
+        MacroFactorModel::computeFactorScores(factors, panel, FactorScoreMethod::Bartlett);
+        benchmark::DoNotOptimize(factors.factors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numObservations);
+}
+BENCHMARK(BM_ComputeFactorScores)->ArgsProduct({{8, 128}, {360}});
+
+// Args: N indicators, T observations, window length
+static void BM_RollingDecomposition(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numObservations = static_cast<int>(state.range(1));
+    const int window = static_cast<int>(state.range(2));
+    auto panel = SyntheticData::surprisePanel(numIndicators, numObservations);
+
+    // Label-flip warnings are logged; mute them so terminal speed is not measured
+    Logger::setLevel(Logger::ERROR);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MacroFactorModel::rollingDecompositionWithDriftDetection(panel, window, 3));
+    }
+    Logger::setLevel(Logger::INFO);
+    state.SetItemsProcessed(state.iterations() * (numObservations - window + 1));  // Windows
+}
+BENCHMARK(BM_RollingDecomposition)
+    ->Args({8, 120, 12})
+    ->Args({8, 360, 12})
+    ->Args({8, 360, 36})
+    ->Args({32, 360, 36})
+    ->Unit(benchmark::kMillisecond);
+
+// ===== PortfolioRiskAnalyzer =====
+
+// Arg: N indicators (K = 3)
+static void BM_AnalyzeRisk(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+        SyntheticData::surpriseCovariance(numIndicators), 3);
+    Eigen::VectorXd beta = SyntheticData::sensitivities(numIndicators);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PortfolioRiskAnalyzer::analyzeRisk(beta, factors));
+    }
+}
+BENCHMARK(BM_AnalyzeRisk)->Arg(8)->Arg(32)->Arg(128);
+
+// Args: N indicators, P portfolios — one analyzeRisk call per book
+static void BM_AnalyzeRiskPerBook(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numBooks = static_cast<int>(state.range(1));
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+        SyntheticData::surpriseCovariance(numIndicators), 3);
+    Eigen::MatrixXd books = Eigen::MatrixXd::Random(numIndicators, numBooks);
+
+    for (auto _ : state) {
+        for (int p = 0; p < numBooks; p++) {
+            benchmark::DoNotOptimize(PortfolioRiskAnalyzer::analyzeRisk(books.col(p), factors));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numBooks);
+}
+BENCHMARK(BM_AnalyzeRiskPerBook)->ArgsProduct({{8, 128}, {1000}});
+
+// Args: N indicators, P portfolios — batch API, preallocated SoA output
+static void BM_AnalyzeRiskBatch(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    const int numBooks = static_cast<int>(state.range(1));
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+        SyntheticData::surpriseCovariance(numIndicators), 3);
+    Eigen::MatrixXd books = Eigen::MatrixXd::Random(numIndicators, numBooks);
+    BatchRiskDecomposition result;
+
+    for (auto _ : state) {
+        PortfolioRiskAnalyzer::analyzeRiskBatch(books, factors, result);
+        benchmark::DoNotOptimize(result.totalVariance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numBooks);
+}
+BENCHMARK(BM_AnalyzeRiskBatch)->ArgsProduct({{8, 128}, {1000}});
+
+// Args: T days, rolling window (K = 5) — one O(K²) update per day
+static void BM_RollingDrawdownAttribution(benchmark::State& state) {
+    const int T = static_cast<int>(state.range(0));
+    const size_t window = static_cast<size_t>(state.range(1));
+    const int K = 5;
+    Eigen::MatrixXd shocks = 0.01 * Eigen::MatrixXd::Random(T, K);
+    Eigen::VectorXd returns = shocks * Eigen::VectorXd::LinSpaced(K, 0.5, -0.5) + 0.002 * Eigen::VectorXd::Random(T);
+    std::vector<std::string> labels = {"Growth", "Inflation", "Volatility", "Liquidity", "Policy"};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PortfolioRiskAnalyzer::rollingDrawdownAttribution(returns, shocks, labels, window));
+    }
+    state.SetItemsProcessed(state.iterations() * T);
+}
+BENCHMARK(BM_RollingDrawdownAttribution)->ArgsProduct({{10000}, {63, 252}})->Unit(benchmark::kMillisecond);
+
+// Args: n assets, warm start (0/1) — a quarter of daily ERC rebalances on a slowly drifting Σ
+static void BM_RiskBudgetDailyRebalance(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const bool warm = state.range(1) != 0;
+    const int days = 63;
+    Eigen::MatrixXd loadings = Eigen::MatrixXd::Random(n, n);
+    Eigen::MatrixXd base = loadings * loadings.transpose() / n + 0.2 * Eigen::MatrixXd::Identity(n, n);
+    std::vector<Eigen::MatrixXd> covariances;
+    for (int d = 0; d < days; d++) {
+        Eigen::MatrixXd drift = Eigen::MatrixXd::Random(n, n);
+        base += 0.01 * drift * drift.transpose() / n;
+        covariances.push_back(base);
+    }
+    Eigen::VectorXd budgets = Eigen::VectorXd::Ones(n);
+    int64_t iterations = 0;
+
+    for (auto _ : state) {
+        Eigen::VectorXd previous;
+        for (const auto& covariance : covariances) {
+            RiskBudgetSolution solution = PortfolioRiskAnalyzer::solveRiskBudget(
+                covariance, budgets, warm ? previous : Eigen::VectorXd());
+            iterations += solution.iterations;
+            previous = solution.weights;
+        }
+    }
+    state.counters["newton_steps_per_day"] =
+        static_cast<double>(iterations) / (static_cast<double>(state.iterations()) * days);
+    state.SetItemsProcessed(state.iterations() * days);
+}
+BENCHMARK(BM_RiskBudgetDailyRebalance)->ArgsProduct({{10, 100}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// ===== PositionSizer =====
+
+// Arg: N indicators behind the risk decomposition (K = 3)
+static void BM_ComputePositionSize(benchmark::State& state) {
+    const int numIndicators = static_cast<int>(state.range(0));
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+        SyntheticData::surpriseCovariance(numIndicators), 3);
+    RiskDecomposition risk = PortfolioRiskAnalyzer::analyzeRisk(SyntheticData::sensitivities(numIndicators), factors);
+    MacroRegime regime = SyntheticData::stressedRegime();
+    PositionConstraint constraints{10000000.0, 2.0, {{"Growth", 5.0}}, 100000.0, 500000.0};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PositionSizer::computePositionSize(5000000.0, risk, regime, constraints));
+    }
+}
+BENCHMARK(BM_ComputePositionSize)->Arg(8)->Arg(128);
+
+// Shared setup for the book-sizing pair: M instruments on K = 5 factors
+static InstrumentBook syntheticBook(int numInstruments) {
+    InstrumentBook book;
+    for (int i = 0; i < numInstruments; i++) {
+        book.symbols.push_back("F" + std::to_string(i));
+    }
+    book.baseNotional = Eigen::VectorXd::Constant(numInstruments, 5000000.0);
+    book.maxNotional = Eigen::VectorXd::Constant(numInstruments, 10000000.0);
+    book.contractNotional = Eigen::VectorXd::LinSpaced(numInstruments, 50000.0, 400000.0);
+    book.factorSensitivities = 0.01 * Eigen::MatrixXd::Random(5, numInstruments);
+    book.residualVariance = Eigen::VectorXd::Constant(numInstruments, 1e-5);
+    return book;
+}
+
+// Arg: M instruments — one computePositionSize per instrument, eager rationale strings
+static void BM_SizeBookPerInstrument(benchmark::State& state) {
+    const int M = static_cast<int>(state.range(0));
+    InstrumentBook book = syntheticBook(M);
+    Eigen::MatrixXd factorCovariance = Eigen::VectorXd::LinSpaced(5, 1.0, 0.2).asDiagonal();
+    MacroRegime regime = SyntheticData::stressedRegime();
+    PositionConstraint constraints{10000000.0, 2.0, {{"Growth", 5.0}}, 100000.0, 500000.0};
+    std::vector<RiskDecomposition> risks(M);
+    for (int i = 0; i < M; i++) {
+        Eigen::VectorXd gamma = book.factorSensitivities.col(i);
+        risks[i].numFactors = 5;
+        risks[i].factorLabels = {"Growth", "Inflation", "Volatility", "Policy", "Credit"};
+        risks[i].factorSensitivities.assign(gamma.data(), gamma.data() + 5);
+        risks[i].totalRisk = std::sqrt(gamma.dot(factorCovariance * gamma));
+    }
+
+    for (auto _ : state) {
+        for (int i = 0; i < M; i++) {
+            benchmark::DoNotOptimize(PositionSizer::computePositionSize(book.baseNotional(i), risks[i], regime, constraints));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * M);
+}
+BENCHMARK(BM_SizeBookPerInstrument)->Arg(8)->Arg(64);
+
+// Arg: M instruments — computeBookSizing, SoA output reused, correlation included
+static void BM_SizeBookBatch(benchmark::State& state) {
+    const int M = static_cast<int>(state.range(0));
+    InstrumentBook book = syntheticBook(M);
+    Eigen::MatrixXd factorCovariance = Eigen::VectorXd::LinSpaced(5, 1.0, 0.2).asDiagonal();
+    std::vector<std::string> labels = {"Growth", "Inflation", "Volatility", "Policy", "Credit"};
+    MacroRegime regime = SyntheticData::stressedRegime();
+    PositionConstraint constraints{10000000.0, 2.0, {{"Growth", 5.0}}, 100000.0, 500000.0};
+    BookSizing sizing;
+
+    for (auto _ : state) {
+        PositionSizer::computeBookSizing(book, factorCovariance, labels, regime, constraints, sizing);
+        benchmark::DoNotOptimize(sizing.recommendedNotional.data());
+    }
+    state.SetItemsProcessed(state.iterations() * M);
+}
+BENCHMARK(BM_SizeBookBatch)->Arg(8)->Arg(64);
+
+// 30 years of daily ticks through the streaming regime engine, then one snapshot round trip
+static void BM_RegimeEngineStream(benchmark::State& state) {
+    const int days = 7560;
+    std::vector<RegimeTick> ticks(days);
+    for (int d = 0; d < days; d++) {
+        const double vix = 20.0 + 12.0 * std::sin(d / 90.0);
+        ticks[d] = {19950101 + d, vix, 80.0 + 2.0 * vix, 150.0 + 80.0 * std::cos(d / 200.0), 50.0 - vix, 0.9};
+    }
+
+    for (auto _ : state) {
+        RegimeEngine engine;
+        for (const RegimeTick& tick : ticks) {
+            engine.rebalance(5000000.0 / engine.observe(tick).volatilityMultiplier);
+        }
+        benchmark::DoNotOptimize(RegimeEngine::deserialize(engine.serialize()).currentSize());
+    }
+    state.SetItemsProcessed(state.iterations() * days);
+}
+BENCHMARK(BM_RegimeEngineStream)->Unit(benchmark::kMillisecond);
+
+// 30 years of daily ticks through the rolling percentile thresholds
+static void BM_AdaptiveThresholds(benchmark::State& state) {
+    const int days = 7560;
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<RegimeTick> ticks(days);
+    double vix = 18.0;
+    for (int d = 0; d < days; d++) {
+        vix = std::clamp(vix + noise(rng) + 0.02 * (18.0 - vix), 9.0, 80.0);
+        ticks[d] = {19950101 + d, vix, 80.0 + 2.0 * vix, 100.0 + 5.0 * vix, 50.0 - vix, 0.9};
+    }
+
+    for (auto _ : state) {
+        AdaptiveRegimeThresholds adaptive;
+        double checksum = 0.0;
+        for (const RegimeTick& tick : ticks) {
+            checksum += adaptive.observe(tick).vixRiskOff;
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * days);
+}
+BENCHMARK(BM_AdaptiveThresholds)->Unit(benchmark::kMillisecond);
+
+// Baum-Welch on 30 years of daily ticks drawn from a three-state chain
+static void BM_HmmFitThirtyYears(benchmark::State& state) {
+    const int days = 7560;
+    const double level[3][5] = {{13.0, 80.0, 100.0, 130.0, 0.80},
+                                {20.0, 100.0, 160.0, 40.0, 0.95},
+                                {35.0, 135.0, 280.0, -30.0, 1.15}};
+    std::mt19937_64 rng(13);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<RegimeTick> ticks(days);
+    int regime = 0;
+    for (int d = 0; d < days; d++) {
+        if (uniform(rng) < 0.01) {
+            regime = (regime + 1 + static_cast<int>(uniform(rng) * 2.0)) % 3;
+        }
+        const double* mu = level[regime];
+        ticks[d] = {19950101 + d, mu[0] * (1.0 + 0.1 * noise(rng)), mu[1] * (1.0 + 0.08 * noise(rng)),
+                    mu[2] * (1.0 + 0.1 * noise(rng)), mu[3] + 25.0 * noise(rng), mu[4] + 0.05 * noise(rng)};
+    }
+
+    int iterations = 0;
+    for (auto _ : state) {
+        GaussianHmm model = GaussianHmm::fit(ticks);
+        iterations = model.iterations();
+        benchmark::DoNotOptimize(model.trainingLogLikelihood());
+    }
+    state.counters["em_iterations"] = iterations;
+    state.SetItemsProcessed(state.iterations() * days);
+}
+BENCHMARK(BM_HmmFitThirtyYears)->Unit(benchmark::kMillisecond);
+
+// Online filter: one O(S²) update per day
+static void BM_HmmFilterUpdate(benchmark::State& state) {
+    Eigen::MatrixXd means(3, 5), variances(3, 5), transition(3, 3);
+    means << 13.0, 80.0, 100.0, 130.0, 0.80,
+             20.0, 100.0, 160.0, 40.0, 0.95,
+             35.0, 135.0, 280.0, -30.0, 1.15;
+    variances = (0.1 * means).cwiseAbs2().array() + 1.0;
+    transition << 0.98, 0.015, 0.005,
+                  0.01, 0.98, 0.01,
+                  0.005, 0.015, 0.98;
+    HmmRegimeFilter filter(GaussianHmm(Eigen::Vector3d::Constant(1.0 / 3.0), transition, means, variances));
+
+    int32_t date = 19950101;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(filter.update({date++, 22.0, 105.0, 170.0, 30.0, 0.97}).data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HmmFilterUpdate);
+
+// ===== MonteCarloRisk =====
+
+// Args: paths, innovations (0 = Gaussian, 1 = Student-t), threads (0 = all cores); N = 32, K = 3
+static void BM_MonteCarloVaR(benchmark::State& state) {
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(SyntheticData::surpriseCovariance(32), 3);
+    Eigen::VectorXd beta = SyntheticData::sensitivities(32);
+    MonteCarloOptions options;
+    options.numPaths = static_cast<size_t>(state.range(0));
+    options.innovations = state.range(1) == 0 ? InnovationDistribution::Gaussian : InnovationDistribution::StudentT;
+    options.numThreads = static_cast<int>(state.range(2));
+    options.confidenceLevels = {0.95, 0.99, 0.999};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MonteCarloRisk::simulate(beta, factors, 5000000.0, options));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MonteCarloVaR)
+    ->ArgsProduct({{1000000}, {0, 1}, {1, 0}})
+    ->Args({10000000, 0, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// ===== HistoricalSimulation =====
+
+// Args: T days of history (K = 5), rolling window — scenario build + rolling VaR/ES at three levels
+static void BM_HistoricalVaRRolling(benchmark::State& state) {
+    const int T = static_cast<int>(state.range(0));
+    const size_t window = static_cast<size_t>(state.range(1));
+    Eigen::MatrixXd shocks = 0.01 * Eigen::MatrixXd::Random(T, 5);
+    Eigen::VectorXd gamma = Eigen::VectorXd::LinSpaced(5, 0.8, -0.4);
+
+    for (auto _ : state) {
+        Eigen::VectorXd pnl = HistoricalSimulation::scenarioPnl(gamma, shocks, 5000000.0);
+        benchmark::DoNotOptimize(HistoricalSimulation::rollingTailRisk(pnl, window, {0.95, 0.99, 0.999}));
+    }
+    state.SetItemsProcessed(state.iterations() * T);
+}
+BENCHMARK(BM_HistoricalVaRRolling)->ArgsProduct({{7560}, {250, 1000}})->Unit(benchmark::kMillisecond);
+
+// ===== ScenarioLibrary =====
+
+// Args: portfolios — worst-10 tables over a 16⁵ ≈ 1M-row grid on K = 5 factors
+static void BM_StressGridWorstCases(benchmark::State& state) {
+    const std::vector<std::string> labels = {"Growth", "Inflation", "Volatility", "Policy", "Credit"};
+    std::vector<double> axis(16);
+    for (int i = 0; i < 16; i++) {
+        axis[i] = -4.0 + 0.5 * i;
+    }
+    ScenarioLibrary library(labels);
+    std::vector<std::pair<std::string, std::vector<double>>> axes;
+    for (const auto& label : labels) {
+        axes.emplace_back(label, axis);
+    }
+    library.addGrid("full grid", axes);
+    Eigen::MatrixXd exposures = 1e6 * Eigen::MatrixXd::Random(5, state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ScenarioEvaluator::worstCases(library, exposures, 10));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(library.size()) * state.range(0));
+}
+BENCHMARK(BM_StressGridWorstCases)->Arg(1)->Arg(16)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
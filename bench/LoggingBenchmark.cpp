@@ -0,0 +1,34 @@
+//
+//  LoggingBenchmark.cpp
+//  InvertedYieldCurveTrader
+//
+//  Cost of a log call whose level is disabled, json-context API vs LOG_* macros
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <benchmark/benchmark.h>
+#include "../src/Utils/Logger.hpp"
+
+// ===== Disabled levels =====
+
+static void BM_DisabledDebugJsonContext(benchmark::State& state) {
+    Logger::setLevel(Logger::INFO);
+    int window = 0;
+    for (auto _ : state) {
+        // Context object is built (and allocated) before the level check
+        Logger::debug("Window decomposed", {{"t", window}, {"detail", "stable"}});
+        benchmark::DoNotOptimize(++window);
+    }
+}
+BENCHMARK(BM_DisabledDebugJsonContext);
+
+static void BM_DisabledDebugMacro(benchmark::State& state) {
+    Logger::setLevel(Logger::INFO);
+    int window = 0;
+    for (auto _ : state) {
+        LOG_DEBUG("Window decomposed", "t", window, "detail", "stable");
+        benchmark::DoNotOptimize(++window);
+    }
+}
+BENCHMARK(BM_DisabledDebugMacro);
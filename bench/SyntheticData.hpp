@@ -0,0 +1,184 @@
+//
+//  SyntheticData.hpp
+//  InvertedYieldCurveTrader
+//
+//  Deterministic synthetic inputs for the benchmark suite. Everything is
+//  derived from a fixed seed through mt19937_64 (whose output sequence is
+//  fixed by the standard) and a local Box-Muller transform, so the same
+//  (N, T, window) always produces bit-identical data on every toolchain
+//  and timings stay comparable across commits.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef SYNTHETIC_DATA_HPP
+#define SYNTHETIC_DATA_HPP
+
+#include "../src/DataProcessors/PositionSizer.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * SyntheticData: Seeded generators shaped like the live pipeline inputs
+ *
+ * Surprise panels come from three latent factors (growth, inflation, policy)
+ * plus idiosyncratic noise, so covariance and PCA see realistic structure
+ * rather than white noise.
+ */
+class SyntheticData {
+public:
+    static constexpr uint64_t DEFAULT_SEED = 20261018;
+
+    /**
+     * N sorted indicator names: the live indicators first, then "extra_NNN"
+     */
+    static std::vector<std::string> indicatorNames(int numIndicators) {
+        static const std::vector<std::string> LIVE = {
+            "consumer_sentiment", "fed_funds", "gdp", "inflation",
+            "inverted_yield", "treasury_10y", "unemployment", "vix"
+        };
+
+        std::vector<std::string> names;
+        for (int i = 0; i < numIndicators; i++) {
+            if (i < static_cast<int>(LIVE.size())) {
+                names.push_back(LIVE[i]);
+            } else {
+                char name[32];
+                std::snprintf(name, sizeof(name), "extra_%03d", i);
+                names.push_back(name);
+            }
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    /**
+     * Random-walk level series of T values (most recent first, like the processors)
+     */
+    static std::vector<double> levelSeries(int numObservations, uint64_t seed = DEFAULT_SEED) {
+        Gaussian gaussian(seed);
+        std::vector<double> levels(numObservations);
+        double level = 100.0;
+        for (int t = numObservations - 1; t >= 0; t--) {
+            level += 0.5 * gaussian();
+            levels[t] = level;
+        }
+        return levels;
+    }
+
+    /**
+     * T × N surprise panel keyed by indicator name, with a 3-factor structure
+     */
+    static std::map<std::string, std::vector<double>> surprisePanel(
+        int numIndicators, int numObservations, uint64_t seed = DEFAULT_SEED)
+    {
+        const int numLatent = 3;
+        Gaussian gaussian(seed);
+
+        Eigen::MatrixXd loadings(numIndicators, numLatent);
+        for (int i = 0; i < numIndicators; i++) {
+            for (int k = 0; k < numLatent; k++) {
+                loadings(i, k) = gaussian();
+            }
+        }
+
+        std::vector<std::string> names = indicatorNames(numIndicators);
+        std::map<std::string, std::vector<double>> panel;
+        for (const auto& name : names) {
+            panel[name].resize(numObservations);
+        }
+
+        Eigen::VectorXd factors(numLatent);
+        for (int t = 0; t < numObservations; t++) {
+            for (int k = 0; k < numLatent; k++) {
+                factors(k) = gaussian();
+            }
+            Eigen::VectorXd row = loadings * factors;
+            for (int i = 0; i < numIndicators; i++) {
+                panel[names[i]][t] = row(i) + 0.3 * gaussian();
+            }
+        }
+        return panel;
+    }
+
+    /**
+     * Surprise covariance of an N × T synthetic panel
+     */
+    static CovarianceMatrix surpriseCovariance(int numIndicators, int numObservations = 120,
+                                               uint64_t seed = DEFAULT_SEED) {
+        CovarianceCalculator calculator;
+        return calculator.calculateCovarianceMatrix(surprisePanel(numIndicators, numObservations, seed));
+    }
+
+    /**
+     * ES sensitivities β ∈ ℝ^N in [-1, 1]
+     */
+    static Eigen::VectorXd sensitivities(int numIndicators, uint64_t seed = DEFAULT_SEED) {
+        std::mt19937_64 rng(seed);
+        Eigen::VectorXd beta(numIndicators);
+        for (int i = 0; i < numIndicators; i++) {
+            beta(i) = 2.0 * uniform(rng) - 1.0;
+        }
+        return beta;
+    }
+
+    /**
+     * The raw 8-indicator panel DataAligner receives from the processors
+     */
+    static std::map<std::string, std::vector<double>> rawIndicatorPanel(int dailyObservations,
+                                                                        uint64_t seed = DEFAULT_SEED) {
+        std::map<std::string, std::vector<double>> raw;
+        uint64_t stream = seed;
+        for (const std::string name : {"vix", "treasury_10y", "treasury_2y", "inverted_yield"}) {
+            raw[name] = levelSeries(dailyObservations, stream++);
+        }
+        for (const std::string name : {"inflation", "fed_funds", "unemployment", "consumer_sentiment"}) {
+            raw[name] = levelSeries(12, stream++);
+        }
+        raw["gdp"] = levelSeries(8, stream++);
+        return raw;
+    }
+
+    /**
+     * A mildly stressed market regime (VIX 24, MOVE 115)
+     */
+    static MacroRegime stressedRegime() {
+        return PositionSizer::classifyRegime(24.0, 115.0, 160.0, 20.0, 1.05);
+    }
+
+private:
+    // Top 53 bits → [0, 1); identical on every platform, unlike std::uniform_real_distribution
+    static double uniform(std::mt19937_64& rng) {
+        return (rng() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Box-Muller over mt19937_64, since std::normal_distribution is implementation-defined
+    struct Gaussian {
+        std::mt19937_64 rng;
+        double spare = 0.0;
+        bool hasSpare = false;
+
+        explicit Gaussian(uint64_t seed) : rng(seed) {}
+
+        double operator()() {
+            if (hasSpare) {
+                hasSpare = false;
+                return spare;
+            }
+            double u1 = 1.0 - uniform(rng);  // (0, 1]
+            double u2 = uniform(rng);
+            double radius = std::sqrt(-2.0 * std::log(u1));
+            spare = radius * std::sin(2.0 * M_PI * u2);
+            hasSpare = true;
+            return radius * std::cos(2.0 * M_PI * u2);
+        }
+    };
+};
+
+#endif // SYNTHETIC_DATA_HPP
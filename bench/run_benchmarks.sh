@@ -0,0 +1,44 @@
+#!/bin/bash
+# Build and run the analytics microbenchmarks (no API keys required)
+#
+# Extra arguments are passed to the benchmark binary, e.g.
+#   ./bench/run_benchmarks.sh --benchmark_filter=Rolling --benchmark_out=bench.json
+
+set -e  # Exit on error
+
+echo "========================================="
+echo "Building and Running Benchmarks"
+echo "========================================="
+echo ""
+
+INCLUDES="-I./src -I/opt/homebrew/opt/nlohmann-json/include -I/opt/homebrew/opt/eigen/include/eigen3 -I/opt/homebrew/opt/google-benchmark/include"
+BENCH_LIBS="-L/opt/homebrew/opt/google-benchmark/lib -lbenchmark -pthread"
+CXX_FLAGS="-std=c++20 -O3 -DNDEBUG"
+
+ANALYTICS_SRC="src/DataProcessors/DataAligner.cpp \
+    src/DataProcessors/SurpriseTransformer.cpp \
+    src/DataProcessors/CovarianceCalculator.cpp \
+    src/DataProcessors/EwmaCovariance.cpp \
+    src/DataProcessors/PairwiseCovariance.cpp \
+    src/DataProcessors/MacroFactorModel.cpp \
+    src/DataProcessors/RandomizedPCA.cpp \
+    src/DataProcessors/PortfolioRiskAnalyzer.cpp \
+    src/DataProcessors/PositionSizer.cpp \
+    src/DataProcessors/MonteCarloRisk.cpp \
+    src/DataProcessors/HistoricalSimulation.cpp \
+    src/DataProcessors/ScenarioLibrary.cpp \
+    src/DataProcessors/RegimeEngine.cpp \
+    src/DataProcessors/QuantileSketch.cpp \
+    src/DataProcessors/RegimeHmm.cpp \
+    src/Utils/Tracer.cpp \
+    src/Utils/Logger.cpp"
+
+echo "Compiling benchmarks..."
+g++ $CXX_FLAGS $INCLUDES \
+    $ANALYTICS_SRC \
+    bench/*Benchmark.cpp \
+    $BENCH_LIBS \
+    -o bench_analytics || { echo "❌ Failed to compile benchmarks"; exit 1; }
+
+echo ""
+./bench_analytics "$@"
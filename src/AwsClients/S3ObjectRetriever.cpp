@@ -11,6 +11,7 @@
 #include <stdio.h>
 
 #include "S3ObjectRetriever.hpp"
+#include "../Utils/Metrics.hpp"
 #include <aws/s3/S3Client.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <iostream>
@@ -26,7 +27,10 @@ bool S3ObjectRetriever::RetrieveJson(std::string& jsonData) {
     getObjectRequest.SetBucket(bucketName);
     getObjectRequest.SetKey(objectKey);
 
+    METRICS_TIMER_START(getTimer, "s3.get");
     auto getObjectOutcome = s3Client.GetObject(getObjectRequest);
+    METRICS_TIMER_STOP(getTimer);
+    METRICS_COUNT("s3.requests", 1);
 
     if (getObjectOutcome.IsSuccess()) {
         Aws::IOStream& bodyStream = getObjectOutcome.GetResult().GetBody();
@@ -39,6 +43,7 @@ bool S3ObjectRetriever::RetrieveJson(std::string& jsonData) {
 
         return true;
     } else {
+        METRICS_COUNT("s3.errors", 1);
         std::cerr << "Error retrieving JSON from S3: " << getObjectOutcome.GetError().GetMessage() << std::endl;
         return false;
     }
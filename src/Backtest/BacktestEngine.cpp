@@ -0,0 +1,317 @@
+//
+//  BacktestEngine.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the event-driven backtest engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "BacktestEngine.hpp"
+#include "../DataProcessors/SurpriseTransformer.hpp"
+#include "../DataProcessors/PortfolioRiskAnalyzer.hpp"
+#include "../DataProcessors/RegimeEngine.hpp"
+#include "../Utils/Date.hpp"
+#include "../Utils/Tracer.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <fstream>
+#include <cmath>
+
+namespace {
+
+// Neutral regime inputs, the same baseline the live workflow uses
+constexpr double DEFAULT_VIX = 18.0;
+constexpr double DEFAULT_MOVE = 100.0;
+constexpr double DEFAULT_CREDIT_SPREAD = 110.0;
+constexpr double DEFAULT_CURVE_SLOPE = 120.0;
+constexpr double DEFAULT_PUT_CALL = 0.92;
+
+constexpr double TRADING_DAYS_PER_YEAR = 252.0;
+
+}  // namespace
+
+// ===== Cursor / RollingCovariance =====
+
+double BacktestEngine::Cursor::advanceTo(int32_t date) {
+    while (next < view.size && view.dates[next] <= date) {
+        next++;
+    }
+    return next == 0 ? fallback : view.values[next - 1];
+}
+
+void BacktestEngine::RollingCovariance::reset(int windowSize, int numIndicators) {
+    window = windowSize;
+    count = 0;
+    head = 0;
+    rows = Eigen::MatrixXd::Zero(windowSize, numIndicators);
+    sum = Eigen::VectorXd::Zero(numIndicators);
+    crossProducts = Eigen::MatrixXd::Zero(numIndicators, numIndicators);
+}
+
+void BacktestEngine::RollingCovariance::push(const Eigen::VectorXd& row) {
+    if (full()) {
+        Eigen::VectorXd dropped = rows.row(head).transpose();
+        sum -= dropped;
+        crossProducts.noalias() -= dropped * dropped.transpose();
+    } else {
+        count++;
+    }
+
+    rows.row(head) = row.transpose();
+    sum += row;
+    crossProducts.noalias() += row * row.transpose();
+    head = (head + 1) % window;
+
+    // Resum once per wrap so add/subtract rounding never accumulates
+    if (head == 0 && full()) {
+        sum = rows.colwise().sum().transpose();
+        crossProducts.noalias() = rows.transpose() * rows;
+    }
+}
+
+Eigen::MatrixXd BacktestEngine::RollingCovariance::covariance() const {
+    // Unbiased estimator, same as CovarianceCalculator: (Σxxᵀ − n·x̄x̄ᵀ) / (n − 1)
+    Eigen::VectorXd mean = sum / count;
+    return (crossProducts - count * mean * mean.transpose()) / (count - 1);
+}
+
+// ===== BacktestEngine =====
+
+BacktestEngine::BacktestEngine(const HistoryStore& store, const BacktestConfig& config,
+                               const VintageStore* vintages)
+    : store_(store), config_(config), vintages_(vintages), indicators_(config.indicators)
+{
+    if (indicators_.empty()) {
+        throw std::invalid_argument("Backtest needs at least one indicator");
+    }
+    if (config_.windowMonths < 2) {
+        throw std::invalid_argument("windowMonths must be >= 2");
+    }
+    if (config_.surpriseLookback < 1) {
+        throw std::invalid_argument("surpriseLookback must be >= 1");
+    }
+    if (config_.numFactors < 1 || config_.numFactors > static_cast<int>(indicators_.size())) {
+        throw std::invalid_argument("numFactors must be between 1 and the number of indicators");
+    }
+    if (config_.initialCapital <= 0.0 || config_.baseNotional <= 0.0) {
+        throw std::invalid_argument("initialCapital and baseNotional must be positive");
+    }
+    if (!store_.hasSeries(config_.returnSeries)) {
+        throw std::invalid_argument("Return series '" + config_.returnSeries + "' not in history store");
+    }
+
+    // Factor labeling expects sorted names (CovarianceCalculator order)
+    std::sort(indicators_.begin(), indicators_.end());
+
+    betas_ = Eigen::VectorXd::Zero(indicators_.size());
+    for (size_t i = 0; i < indicators_.size(); i++) {
+        const std::string& name = indicators_[i];
+        bool inVintages = vintages_ != nullptr && vintages_->hasSeries(name);
+        if (!inVintages && !store_.hasSeries(name)) {
+            throw std::invalid_argument("Indicator '" + name + "' not in history or vintage store");
+        }
+        auto beta = config_.indicatorBetas.find(name);
+        if (beta != config_.indicatorBetas.end()) {
+            betas_(i) = beta->second;
+        }
+        auto lag = config_.publicationLagDays.find(name);
+        publicationLags_.push_back(lag != config_.publicationLagDays.end() ? lag->second
+                                                                           : config_.defaultPublicationLagDays);
+        if (publicationLags_.back() < 0) {
+            throw std::invalid_argument("Publication lag for '" + name + "' must be >= 0");
+        }
+    }
+}
+
+BacktestResult BacktestEngine::run() {
+    BacktestResult result;
+
+    const int numIndicators = static_cast<int>(indicators_.size());
+    const size_t levelWindow = static_cast<size_t>(config_.surpriseLookback) + 1;
+
+    SeriesView returns = store_.series(config_.returnSeries).slice(config_.startDate, config_.endDate);
+    result.steps.reserve(returns.size);
+
+    // Fresh cursors per run so run() can be called repeatedly
+    auto makeCursor = [&](const std::string& name, double fallback) {
+        Cursor cursor;
+        cursor.fallback = fallback;
+        if (store_.hasSeries(name)) {
+            cursor.view = store_.series(name);
+        }
+        return cursor;
+    };
+
+    Cursor vix = makeCursor(config_.vixSeries, DEFAULT_VIX);
+    Cursor move = makeCursor(config_.moveSeries, DEFAULT_MOVE);
+    Cursor spread = makeCursor(config_.spreadSeries, DEFAULT_CREDIT_SPREAD);
+    Cursor curve = makeCursor(config_.curveSeries, DEFAULT_CURVE_SLOPE);
+    Cursor putCall = makeCursor(config_.putCallSeries, DEFAULT_PUT_CALL);
+
+    std::vector<Cursor> levelCursors;
+    for (const auto& name : indicators_) {
+        levelCursors.push_back(makeCursor(name, std::nan("")));
+    }
+
+    std::vector<std::vector<double>> levelHistory(numIndicators);  // Month-end levels, chronological
+    rolling_.reset(config_.windowMonths, numIndicators);
+
+    RiskDecomposition risk;
+    bool modelReady = false;
+
+    // Month-end: sample levels, extract surprises, update Σ and refit factors
+    auto closeMonth = [&](int32_t asOfDate) {
+        Eigen::VectorXd levels(numIndicators);
+        for (int j = 0; j < numIndicators; j++) {
+            if (vintages_ != nullptr && vintages_->hasSeries(indicators_[j])) {
+                std::vector<double> known = vintages_->series(indicators_[j]).recentAsOf(asOfDate, 1);
+                levels(j) = known.empty() ? std::nan("") : known[0];
+            } else {
+                // Only what had been published by asOfDate
+                levels(j) = levelCursors[j].advanceTo(addDays(asOfDate, -publicationLags_[j]));
+            }
+            if (std::isnan(levels(j))) {
+                return;  // Not every indicator exists yet
+            }
+        }
+
+        for (int j = 0; j < numIndicators; j++) {
+            levelHistory[j].push_back(levels(j));
+            if (levelHistory[j].size() > levelWindow) {
+                levelHistory[j].erase(levelHistory[j].begin());
+            }
+        }
+        if (levelHistory[0].size() < levelWindow) {
+            return;
+        }
+
+        Eigen::VectorXd surpriseRow(numIndicators);
+        for (int j = 0; j < numIndicators; j++) {
+            surpriseRow(j) = SurpriseTransformer::extractSurprise(
+                levelHistory[j], indicators_[j], config_.surpriseLookback).surprises.back();
+        }
+        rolling_.push(surpriseRow);
+
+        if (rolling_.full()) {
+            TRACE_SCOPE_ARGS("backtest", "refit", {{"as_of", asOfDate}});
+            CovarianceMatrix surpriseCov(rolling_.covariance(), indicators_);
+            MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(
+                surpriseCov, config_.numFactors, config_.labelThreshold);
+            risk = PortfolioRiskAnalyzer::analyzeRisk(betas_, factors);
+            modelReady = true;
+            result.factorRefits++;
+        }
+    };
+
+    double equity = config_.initialCapital;
+    double peak = equity;
+    double notional = 0.0;
+    RegimeEngine regimeEngine(config_.regimeWeights);
+    AdaptiveRegimeThresholds adaptiveThresholds(config_.thresholdOptions);
+
+    int32_t currentMonth = -1;
+    int32_t previousDate = 0;
+
+    double sumReturns = 0.0;
+    double sumSquaredReturns = 0.0;
+
+    for (size_t i = 0; i < returns.size; i++) {
+        const int32_t date = returns.dates[i];
+        const double dailyReturn = returns.values[i];
+
+        if (currentMonth != -1 && date / 100 != currentMonth) {
+            closeMonth(previousDate);
+        }
+        currentMonth = date / 100;
+        previousDate = date;
+
+        // Mark yesterday's position to market before acting on today's data
+        double pnl = notional * dailyReturn;
+
+        const RegimeTick tick{date, vix.advanceTo(date), move.advanceTo(date), spread.advanceTo(date),
+                              curve.advanceTo(date), putCall.advanceTo(date)};
+        if (config_.adaptiveThresholds) {
+            regimeEngine.setThresholds(adaptiveThresholds.observe(tick));
+        }
+        const MacroRegime& regime = regimeEngine.observe(tick);
+
+        double target = 0.0;
+        if (modelReady) {
+            PositionSizing sizing = PositionSizer::computePositionSize(
+                config_.baseNotional, risk, regime, config_.constraints, config_.regimeWeights);
+            target = regimeEngine.rebalance(sizing.recommendedNotional);
+        }
+
+        double turnover = std::abs(target - notional);
+        pnl -= turnover * config_.transactionCostBps / 10000.0;
+
+        double equityBefore = equity;
+        equity += pnl;
+        peak = std::max(peak, equity);
+
+        double equityReturn = pnl / equityBefore;
+        sumReturns += equityReturn;
+        sumSquaredReturns += equityReturn * equityReturn;
+
+        BacktestStep step;
+        step.date = date;
+        step.dailyReturn = dailyReturn;
+        step.pnl = pnl;
+        step.equity = equity;
+        step.drawdown = peak - equity;
+        step.notional = target;
+        step.turnover = turnover;
+        step.volatilityMultiplier = regime.volatilityMultiplier;
+        step.riskLabel = regime.riskLabel;
+        step.daysInCurrentRegime = regimeEngine.daysInCurrentRegime();
+        step.modelReady = modelReady;
+        result.steps.push_back(std::move(step));
+
+        result.totalTurnover += turnover;
+        result.maxDrawdown = std::max(result.maxDrawdown, peak - equity);
+        result.maxDrawdownPercent = std::max(result.maxDrawdownPercent, (peak - equity) / peak);
+
+        notional = target;
+    }
+    result.regimeChanges = static_cast<int>(regimeEngine.regimeChanges());
+
+    result.totalPnL = equity - config_.initialCapital;
+    result.totalReturn = equity / config_.initialCapital - 1.0;
+
+    size_t n = result.steps.size();
+    if (n > 1) {
+        double mean = sumReturns / n;
+        double variance = (sumSquaredReturns - n * mean * mean) / (n - 1);
+        double stdDev = std::sqrt(std::max(0.0, variance));
+        result.annualizedVolatility = stdDev * std::sqrt(TRADING_DAYS_PER_YEAR);
+        if (stdDev > 0.0) {
+            result.sharpeRatio = mean / stdDev * std::sqrt(TRADING_DAYS_PER_YEAR);
+        }
+    }
+
+    return result;
+}
+
+void BacktestEngine::writeStepsCsv(const BacktestResult& result, const std::string& path) {
+    std::ofstream csv(path);
+    if (!csv.is_open()) {
+        throw std::runtime_error("Failed to open '" + path + "' for writing");
+    }
+
+    csv << "date,daily_return,pnl,equity,drawdown,notional,turnover,"
+        << "volatility_multiplier,risk_label,days_in_regime,model_ready\n";
+    for (const auto& step : result.steps) {
+        csv << intToDate(step.date) << ','
+            << step.dailyReturn << ','
+            << step.pnl << ','
+            << step.equity << ','
+            << step.drawdown << ','
+            << step.notional << ','
+            << step.turnover << ','
+            << step.volatilityMultiplier << ','
+            << step.riskLabel << ','
+            << step.daysInCurrentRegime << ','
+            << (step.modelReady ? 1 : 0) << '\n';
+    }
+}
@@ -0,0 +1,186 @@
+//
+//  BacktestEngine.hpp
+//  InvertedYieldCurveTrader
+//
+//  Event-driven replay of the macro factor pipeline through history.
+//  Steps one trading day at a time: month-end surprises feed a rolling
+//  covariance, factors are refit monthly, and regime/sizing run daily.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef BACKTEST_ENGINE_HPP
+#define BACKTEST_ENGINE_HPP
+
+#include "../DataProcessors/PositionSizer.hpp"
+#include "../DataProcessors/RegimeEngine.hpp"
+#include "../DataProcessors/MacroFactorModel.hpp"
+#include "../Storage/HistoryStore.hpp"
+#include "../Storage/VintageStore.hpp"
+#include <Eigen/Dense>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+/**
+ * BacktestConfig: What to replay and how
+ *
+ * Series names refer to HistoryStore columns. Regime inputs that are not in
+ * the store fall back to the neutral values used by the live workflow.
+ */
+struct BacktestConfig {
+    std::vector<std::string> indicators;            // Factor model inputs (sorted internally)
+    std::map<std::string, double> indicatorBetas;   // ES sensitivity β_i per indicator (0 if absent)
+
+    // Calendar days from an observation's date to its release, for indicators
+    // read from the history store. Stored observations carry their reference
+    // date (CPI for March is dated 03-01 but published mid-April), so a month
+    // end only sees observations dated at least this long before it.
+    // Indicators served from a VintageStore use their real release dates.
+    std::map<std::string, int> publicationLagDays = {
+        {"consumer_sentiment", 31}, {"fed_funds", 32}, {"unemployment", 38}, {"inflation", 45},
+        {"gdp", 120}, {"inverted_yield", 1}, {"vix", 1}
+    };
+    int defaultPublicationLagDays = 31;             // Indicators missing from publicationLagDays
+
+    std::string returnSeries = "es_returns";        // Daily ES returns (decimal); defines the calendar
+    std::string vixSeries = "vix";
+    std::string moveSeries = "move";
+    std::string spreadSeries = "credit_spread";     // BAA-AAA (bps)
+    std::string curveSeries = "curve_slope";        // 2s10s (bps)
+    std::string putCallSeries = "put_call";
+
+    int32_t startDate = 0;                          // YYYYMMDD, inclusive
+    int32_t endDate = 99991231;
+
+    int windowMonths = 12;                          // Rolling surprise covariance window
+    int surpriseLookback = 6;                       // AR(1) expectation lookback (months)
+    int numFactors = 3;
+    double labelThreshold = MacroFactorModel::DEFAULT_LABEL_THRESHOLD;
+    RegimeWeights regimeWeights = PositionSizer::defaultRegimeWeights();
+    bool adaptiveThresholds = false;                // Regime labels from rolling percentiles
+    AdaptiveThresholdOptions thresholdOptions;      // Used when adaptiveThresholds is set
+
+    double initialCapital = 10000000.0;
+    double baseNotional = 5000000.0;
+    double transactionCostBps = 0.5;                // Per unit of notional traded
+    PositionConstraint constraints{10000000.0, 2.0, {}, 100000.0, 500000.0};
+};
+
+/**
+ * BacktestStep: State after one trading day
+ */
+struct BacktestStep {
+    int32_t date;
+    double dailyReturn;             // ES return on this date
+    double pnl;                     // Yesterday's position × return, net of today's costs
+    double equity;
+    double drawdown;                // Peak equity − equity ($)
+    double notional;                // Position held into the next day
+    double turnover;                // |Δ notional| traded today
+    double volatilityMultiplier;
+    std::string riskLabel;
+    int daysInCurrentRegime;
+    bool modelReady;                // A full covariance window was available
+};
+
+/**
+ * BacktestResult: Daily path plus summary statistics
+ */
+struct BacktestResult {
+    std::vector<BacktestStep> steps;
+
+    double totalPnL = 0.0;
+    double totalReturn = 0.0;       // Final equity / initial capital − 1
+    double annualizedVolatility = 0.0;
+    double sharpeRatio = 0.0;       // Annualized, zero risk-free rate
+    double maxDrawdown = 0.0;       // $
+    double maxDrawdownPercent = 0.0;
+    double totalTurnover = 0.0;     // $ traded
+    int regimeChanges = 0;
+    int factorRefits = 0;
+};
+
+/**
+ * BacktestEngine: Day-by-day replay over a shared, read-only history store
+ *
+ * Per step the work is O(N²) at month ends (rolling covariance update plus
+ * an N×N eigensolve for the refit) and O(1) otherwise; series are read
+ * through forward-only cursors into the mapped columns, so nothing is
+ * copied or re-loaded. With a VintageStore, indicator levels are taken as
+ * they were published on each day instead of the latest revision. Without
+ * one, each indicator's latest revision is used but only once its
+ * publication lag has passed, so month ends never see unreleased data.
+ *
+ * Usage:
+ *   HistoryStore store("/data/history");
+ *   BacktestConfig config;
+ *   config.indicators = {"gdp", "inflation", "unemployment", "vix"};
+ *   BacktestResult result = BacktestEngine(store, config).run();
+ */
+class BacktestEngine {
+public:
+    /**
+     * @param store: History store holding indicators, returns and regime inputs
+     * @param config: Replay configuration
+     * @param vintages: Optional point-in-time store for indicator levels
+     * @throws std::invalid_argument if the config is inconsistent or series are missing
+     */
+    BacktestEngine(const HistoryStore& store, const BacktestConfig& config,
+                   const VintageStore* vintages = nullptr);
+
+    /**
+     * Replay every trading day in [startDate, endDate]
+     */
+    BacktestResult run();
+
+    /**
+     * Write the daily path as CSV (one row per step)
+     */
+    static void writeStepsCsv(const BacktestResult& result, const std::string& path);
+
+private:
+    /**
+     * Forward-only reader: value on or before the requested date (LOCF)
+     */
+    struct Cursor {
+        SeriesView view;
+        size_t next = 0;
+        double fallback = 0.0;
+
+        double advanceTo(int32_t date);
+    };
+
+    const HistoryStore& store_;
+    BacktestConfig config_;
+    const VintageStore* vintages_;
+
+    std::vector<std::string> indicators_;   // Sorted, matches covariance order
+    Eigen::VectorXd betas_;
+    std::vector<int> publicationLags_;      // Days, per indicator
+
+    /**
+     * Rolling covariance over the last windowMonths surprise rows
+     *
+     * Keeps Σx and Σxxᵀ so adding/dropping a row is O(N²); resummed from
+     * the ring once per wrap to stop floating-point drift accumulating.
+     */
+    struct RollingCovariance {
+        int window = 0;
+        int count = 0;
+        int head = 0;
+        Eigen::MatrixXd rows;               // window × N ring buffer
+        Eigen::VectorXd sum;
+        Eigen::MatrixXd crossProducts;
+
+        void reset(int windowSize, int numIndicators);
+        void push(const Eigen::VectorXd& row);
+        bool full() const { return count == window; }
+        Eigen::MatrixXd covariance() const;
+    };
+
+    RollingCovariance rolling_;
+};
+
+#endif // BACKTEST_ENGINE_HPP
@@ -0,0 +1,231 @@
+//
+//  ParameterSweep.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the parallel hyperparameter sweep
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "ParameterSweep.hpp"
+#include "../Utils/Tracer.hpp"
+#include <atomic>
+#include <thread>
+#include <random>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+// Accept either a scalar or an array of candidates
+template <typename T>
+std::vector<T> readValues(const json& value, const std::string& key) {
+    try {
+        if (value.is_array()) {
+            std::vector<T> values = value.get<std::vector<T>>();
+            if (values.empty()) {
+                throw std::invalid_argument("'" + key + "' must not be empty");
+            }
+            return values;
+        }
+        return {value.get<T>()};
+    } catch (const json::exception& e) {
+        throw std::invalid_argument("Invalid sweep values for '" + key + "': " + e.what());
+    }
+}
+
+template <typename T>
+void readRange(const json& spec, const std::string& key, T& min, T& max) {
+    if (!spec.contains(key)) {
+        return;
+    }
+    std::vector<T> bounds = readValues<T>(spec.at(key), key);
+    if (bounds.size() != 2 || bounds[0] > bounds[1]) {
+        throw std::invalid_argument("'" + key + "' range must be [min, max]");
+    }
+    min = bounds[0];
+    max = bounds[1];
+}
+
+}  // namespace
+
+std::vector<SweepParameters> ParameterSweep::expandGrid(const SweepGrid& grid) {
+    std::vector<SweepParameters> points;
+    points.reserve(grid.windowMonths.size() * grid.numFactors.size() * grid.labelThresholds.size() *
+                   grid.vixWeights.size() * grid.moveWeights.size());
+
+    for (int window : grid.windowMonths) {
+        for (int factors : grid.numFactors) {
+            for (double threshold : grid.labelThresholds) {
+                for (double vixWeight : grid.vixWeights) {
+                    for (double moveWeight : grid.moveWeights) {
+                        points.push_back({window, factors, threshold, vixWeight, moveWeight});
+                    }
+                }
+            }
+        }
+    }
+    return points;
+}
+
+std::vector<SweepParameters> ParameterSweep::sampleRandom(const SweepRanges& ranges, int numSamples, uint64_t seed) {
+    if (numSamples < 0) {
+        throw std::invalid_argument("numSamples must be >= 0");
+    }
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> window(ranges.minWindowMonths, ranges.maxWindowMonths);
+    std::uniform_int_distribution<int> factors(ranges.minNumFactors, ranges.maxNumFactors);
+    std::uniform_real_distribution<double> threshold(ranges.minLabelThreshold, ranges.maxLabelThreshold);
+    std::uniform_real_distribution<double> vixWeight(ranges.minVixWeight, ranges.maxVixWeight);
+    std::uniform_real_distribution<double> moveWeight(ranges.minMoveWeight, ranges.maxMoveWeight);
+
+    // Drawn serially up front so the points do not depend on thread scheduling
+    std::vector<SweepParameters> points;
+    points.reserve(numSamples);
+    for (int i = 0; i < numSamples; i++) {
+        SweepParameters point;
+        point.windowMonths = window(rng);
+        point.numFactors = factors(rng);
+        point.labelThreshold = threshold(rng);
+        point.vixWeight = vixWeight(rng);
+        point.moveWeight = moveWeight(rng);
+        points.push_back(point);
+    }
+    return points;
+}
+
+std::vector<SweepParameters> ParameterSweep::fromSpec(const json& spec) {
+    static const std::vector<std::string> KEYS = {
+        "windowMonths", "numFactors", "labelThreshold", "vixWeight", "moveWeight"
+    };
+
+    auto checkKeys = [](const json& object, bool allowSampling) {
+        for (const auto& [key, _] : object.items()) {
+            bool known = std::find(KEYS.begin(), KEYS.end(), key) != KEYS.end() ||
+                         (allowSampling && (key == "samples" || key == "seed"));
+            if (!known) {
+                throw std::invalid_argument("Unknown sweep parameter '" + key + "'");
+            }
+        }
+    };
+
+    if (!spec.is_object()) {
+        throw std::invalid_argument("Sweep spec must be a JSON object");
+    }
+
+    if (spec.contains("random")) {
+        const json& random = spec.at("random");
+        checkKeys(random, true);
+
+        SweepRanges ranges;
+        readRange(random, "windowMonths", ranges.minWindowMonths, ranges.maxWindowMonths);
+        readRange(random, "numFactors", ranges.minNumFactors, ranges.maxNumFactors);
+        readRange(random, "labelThreshold", ranges.minLabelThreshold, ranges.maxLabelThreshold);
+        readRange(random, "vixWeight", ranges.minVixWeight, ranges.maxVixWeight);
+        readRange(random, "moveWeight", ranges.minMoveWeight, ranges.maxMoveWeight);
+
+        int samples = random.value("samples", 100);
+        uint64_t seed = random.value("seed", uint64_t{42});
+        return sampleRandom(ranges, samples, seed);
+    }
+
+    checkKeys(spec, false);
+
+    SweepGrid grid;
+    if (spec.contains("windowMonths")) grid.windowMonths = readValues<int>(spec.at("windowMonths"), "windowMonths");
+    if (spec.contains("numFactors")) grid.numFactors = readValues<int>(spec.at("numFactors"), "numFactors");
+    if (spec.contains("labelThreshold")) grid.labelThresholds = readValues<double>(spec.at("labelThreshold"), "labelThreshold");
+    if (spec.contains("vixWeight")) grid.vixWeights = readValues<double>(spec.at("vixWeight"), "vixWeight");
+    if (spec.contains("moveWeight")) grid.moveWeights = readValues<double>(spec.at("moveWeight"), "moveWeight");
+    return expandGrid(grid);
+}
+
+BacktestConfig ParameterSweep::applyParameters(const BacktestConfig& baseConfig, const SweepParameters& parameters) {
+    BacktestConfig config = baseConfig;
+    config.windowMonths = parameters.windowMonths;
+    config.numFactors = parameters.numFactors;
+    config.labelThreshold = parameters.labelThreshold;
+    config.regimeWeights.vix = parameters.vixWeight;
+    config.regimeWeights.move = parameters.moveWeight;
+    return config;
+}
+
+std::vector<SweepResult> ParameterSweep::run(
+    const HistoryStore& store,
+    const BacktestConfig& baseConfig,
+    const std::vector<SweepParameters>& points,
+    int numThreads,
+    const VintageStore* vintages)
+{
+    std::vector<SweepResult> results(points.size());
+    if (points.empty()) {
+        return results;
+    }
+
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    numThreads = std::min<int>(numThreads, static_cast<int>(points.size()));
+
+    // Dynamic scheduling: each worker claims the next unclaimed point
+    std::atomic<size_t> nextPoint{0};
+
+    auto worker = [&]() {
+        for (size_t i = nextPoint.fetch_add(1); i < points.size(); i = nextPoint.fetch_add(1)) {
+            TRACE_SCOPE_ARGS("sweep", "sweep_point", {{"index", i}});
+            SweepResult& row = results[i];
+            row.parameters = points[i];
+            try {
+                BacktestEngine engine(store, applyParameters(baseConfig, points[i]), vintages);
+                BacktestResult backtest = engine.run();
+                row.totalReturn = backtest.totalReturn;
+                row.sharpeRatio = backtest.sharpeRatio;
+                row.maxDrawdownPercent = backtest.maxDrawdownPercent;
+                row.totalTurnover = backtest.totalTurnover;
+                row.regimeChanges = backtest.regimeChanges;
+                row.factorRefits = backtest.factorRefits;
+            } catch (const std::exception& e) {
+                row.error = e.what();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; t++) {
+        workers.emplace_back([&worker, t]() {
+            Tracer::setThreadName("sweep-worker-" + std::to_string(t));
+            worker();
+        });
+    }
+    worker();  // The calling thread works too
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    return results;
+}
+
+void ParameterSweep::writeResultsCsv(const std::vector<SweepResult>& results, const std::string& path) {
+    std::ofstream csv(path);
+    if (!csv.is_open()) {
+        throw std::runtime_error("Failed to open '" + path + "' for writing");
+    }
+
+    csv << "window_months,num_factors,label_threshold,vix_weight,move_weight,"
+        << "total_return,sharpe,max_drawdown_pct,turnover,regime_changes,factor_refits,error\n";
+    for (const auto& row : results) {
+        const SweepParameters& p = row.parameters;
+        csv << p.windowMonths << ',' << p.numFactors << ',' << p.labelThreshold << ','
+            << p.vixWeight << ',' << p.moveWeight << ','
+            << row.totalReturn << ',' << row.sharpeRatio << ',' << row.maxDrawdownPercent << ','
+            << row.totalTurnover << ',' << row.regimeChanges << ',' << row.factorRefits << ',';
+
+        // Quote errors so commas in messages do not break the table
+        std::string error = row.error;
+        std::replace(error.begin(), error.end(), '"', '\'');
+        csv << (error.empty() ? "" : "\"" + error + "\"") << '\n';
+    }
+}
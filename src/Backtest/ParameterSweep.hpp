@@ -0,0 +1,135 @@
+//
+//  ParameterSweep.hpp
+//  InvertedYieldCurveTrader
+//
+//  Grid / random-search sweeps of model hyperparameters, each point run as
+//  a full backtest on a worker thread against one shared history store.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef PARAMETER_SWEEP_HPP
+#define PARAMETER_SWEEP_HPP
+
+#include "BacktestEngine.hpp"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using json = nlohmann::json;
+
+/**
+ * SweepParameters: One point in hyperparameter space
+ */
+struct SweepParameters {
+    int windowMonths;           // Rolling covariance window
+    int numFactors;             // K
+    double labelThreshold;      // Archetype cosine cutoff (0.65 live)
+    double vixWeight;           // PositionSizer VIX_WEIGHT (0.4 live)
+    double moveWeight;          // PositionSizer MOVE_WEIGHT (0.25 live)
+};
+
+/**
+ * SweepGrid: Cartesian product of candidate values (defaults are the live settings)
+ */
+struct SweepGrid {
+    std::vector<int> windowMonths = {12};
+    std::vector<int> numFactors = {3};
+    std::vector<double> labelThresholds = {MacroFactorModel::DEFAULT_LABEL_THRESHOLD};
+    std::vector<double> vixWeights = {PositionSizer::defaultRegimeWeights().vix};
+    std::vector<double> moveWeights = {PositionSizer::defaultRegimeWeights().move};
+};
+
+/**
+ * SweepRanges: Inclusive [min, max] bounds for random search
+ */
+struct SweepRanges {
+    int minWindowMonths = 6, maxWindowMonths = 36;
+    int minNumFactors = 1, maxNumFactors = 4;
+    double minLabelThreshold = 0.5, maxLabelThreshold = 0.85;
+    double minVixWeight = 0.1, maxVixWeight = 0.7;
+    double minMoveWeight = 0.0, maxMoveWeight = 0.5;
+};
+
+/**
+ * SweepResult: One row of the results table
+ */
+struct SweepResult {
+    SweepParameters parameters;
+    double totalReturn = 0.0;
+    double sharpeRatio = 0.0;
+    double maxDrawdownPercent = 0.0;
+    double totalTurnover = 0.0;
+    int regimeChanges = 0;
+    int factorRefits = 0;
+    std::string error;          // Non-empty if this point's backtest threw
+};
+
+/**
+ * ParameterSweep: Parallel hyperparameter search over BacktestEngine
+ *
+ * Every worker shares the same const HistoryStore (and VintageStore), so
+ * the data is mapped once and never re-loaded; workers pull the next
+ * point from an atomic counter, which keeps all cores busy even when
+ * run times differ. Only summary statistics are kept per run.
+ *
+ * Usage:
+ *   SweepGrid grid;
+ *   grid.windowMonths = {6, 12, 24};
+ *   grid.vixWeights = {0.2, 0.4, 0.6};
+ *   auto results = ParameterSweep::run(store, baseConfig, ParameterSweep::expandGrid(grid));
+ *   ParameterSweep::writeResultsCsv(results, "sweep.csv");
+ */
+class ParameterSweep {
+public:
+    /**
+     * Every combination of the grid values
+     */
+    static std::vector<SweepParameters> expandGrid(const SweepGrid& grid);
+
+    /**
+     * numSamples points drawn uniformly from the ranges (deterministic for a seed)
+     */
+    static std::vector<SweepParameters> sampleRandom(const SweepRanges& ranges, int numSamples, uint64_t seed);
+
+    /**
+     * Build points from a JSON spec
+     *
+     * Grid:   {"windowMonths": [6, 12], "vixWeight": [0.2, 0.4], ...}
+     * Random: {"random": {"samples": 200, "seed": 7, "windowMonths": [6, 36], ...}}
+     *
+     * @throws std::invalid_argument on unknown keys or malformed values
+     */
+    static std::vector<SweepParameters> fromSpec(const json& spec);
+
+    /**
+     * Run one backtest per point in parallel
+     *
+     * @param store: Shared read-only history
+     * @param baseConfig: Everything the sweep does not vary
+     * @param points: Hyperparameter points
+     * @param numThreads: Worker count (0 = hardware concurrency)
+     * @param vintages: Optional point-in-time store
+     * @return One result per point, in input order
+     */
+    static std::vector<SweepResult> run(
+        const HistoryStore& store,
+        const BacktestConfig& baseConfig,
+        const std::vector<SweepParameters>& points,
+        int numThreads = 0,
+        const VintageStore* vintages = nullptr
+    );
+
+    /**
+     * Write the results table as CSV
+     */
+    static void writeResultsCsv(const std::vector<SweepResult>& results, const std::string& path);
+
+    /**
+     * Apply a point to a backtest config
+     */
+    static BacktestConfig applyParameters(const BacktestConfig& baseConfig, const SweepParameters& parameters);
+};
+
+#endif // PARAMETER_SWEEP_HPP
@@ -6,11 +6,19 @@
 //
 
 #include "ConsumerSentimentProcessor.hpp"
+#include "../Storage/HistoryStore.hpp"
 #include "../DataProviders/FREDDataClient.hpp"
 #include <stdexcept>
 #include <iostream>
 
 std::vector<double> ConsumerSentimentProcessor::process(const std::string& fredApiKey, int numValues) {
+    // Serve from the local history store when it is complete and current
+    // (monthly: the next release lands within ~80 days of the last observation)
+    std::vector<double> storedValues;
+    if (HistoryStore::readRecent("consumer_sentiment", numValues, 80, storedValues)) {
+        return storedValues;
+    }
+
     try {
         FREDDataClient client(fredApiKey);
         auto observations = client.fetchConsumerSentiment(numValues);
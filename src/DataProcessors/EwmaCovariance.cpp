@@ -0,0 +1,140 @@
+//
+//  EwmaCovariance.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the exponentially weighted covariance engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "EwmaCovariance.hpp"
+#include <cmath>
+#include <set>
+#include <stdexcept>
+
+double EwmaCovariance::decayFromHalfLife(double halfLife) {
+    if (!std::isfinite(halfLife) || halfLife <= 0.0) {
+        throw std::invalid_argument("Half-life must be positive and finite");
+    }
+    return std::exp2(-1.0 / halfLife);
+}
+
+EwmaCovariance::EwmaCovariance(const std::vector<std::string>& indicatorNames,
+                               const std::vector<double>& halfLives,
+                               bool demean)
+    : indicatorNames_(indicatorNames), halfLives_(halfLives), demean_(demean) {
+    if (indicatorNames.empty()) {
+        throw std::invalid_argument("EWMA covariance needs at least one indicator");
+    }
+    if (std::set<std::string>(indicatorNames.begin(), indicatorNames.end()).size() != indicatorNames.size()) {
+        throw std::invalid_argument("Indicator names must be unique");
+    }
+    if (halfLives.empty()) {
+        throw std::invalid_argument("EWMA covariance needs at least one half-life");
+    }
+
+    const Eigen::Index n = static_cast<Eigen::Index>(indicatorNames.size());
+    horizons_.reserve(halfLives.size());
+    for (double halfLife : halfLives) {
+        Horizon horizon;
+        horizon.decay = decayFromHalfLife(halfLife);
+        horizon.mean = Eigen::VectorXd::Zero(n);
+        horizon.scatter = Eigen::MatrixXd::Zero(n, n);
+        horizons_.push_back(std::move(horizon));
+    }
+    deviation_.resize(n);
+}
+
+void EwmaCovariance::update(const Eigen::VectorXd& observation) {
+    if (observation.size() != static_cast<Eigen::Index>(indicatorNames_.size())) {
+        throw std::invalid_argument("Observation has " + std::to_string(observation.size()) +
+                                    " values, expected " + std::to_string(indicatorNames_.size()));
+    }
+    if (!observation.allFinite()) {
+        throw std::invalid_argument("Observation contains NaN or infinite values");
+    }
+
+    for (Horizon& horizon : horizons_) {
+        const double decay = horizon.decay;
+        const double decayedWeight = decay * horizon.weightSum;
+        horizon.weightSum = decayedWeight + 1.0;
+        horizon.squaredWeightSum = decay * decay * horizon.squaredWeightSum + 1.0;
+
+        horizon.scatter.triangularView<Eigen::Lower>() *= decay;
+        if (demean_) {
+            // Weighted Welford step: M ← λM + (λW / W') d dᵀ, μ ← μ + d / W'
+            deviation_ = observation - horizon.mean;
+            horizon.scatter.selfadjointView<Eigen::Lower>().rankUpdate(deviation_, decayedWeight / horizon.weightSum);
+            horizon.mean += deviation_ / horizon.weightSum;
+        } else {
+            horizon.scatter.selfadjointView<Eigen::Lower>().rankUpdate(observation);
+        }
+    }
+    observationCount_++;
+}
+
+void EwmaCovariance::update(const std::map<std::string, std::vector<double>>& series) {
+    if (series.size() != indicatorNames_.size()) {
+        throw std::invalid_argument("Series must cover exactly the engine's indicators");
+    }
+
+    std::vector<const std::vector<double>*> columns;
+    columns.reserve(indicatorNames_.size());
+    for (const auto& name : indicatorNames_) {
+        auto it = series.find(name);
+        if (it == series.end()) {
+            throw std::invalid_argument("Missing series for indicator '" + name + "'");
+        }
+        columns.push_back(&it->second);
+    }
+
+    const size_t length = columns.front()->size();
+    for (const auto* column : columns) {
+        if (column->size() != length) {
+            throw std::invalid_argument("All series must have the same length");
+        }
+    }
+
+    Eigen::VectorXd observation(static_cast<Eigen::Index>(columns.size()));
+    for (size_t t = 0; t < length; t++) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            observation(i) = (*columns[i])[t];
+        }
+        update(observation);
+    }
+}
+
+const EwmaCovariance::Horizon& EwmaCovariance::horizonAt(size_t horizon) const {
+    if (horizon >= horizons_.size()) {
+        throw std::out_of_range("EWMA horizon " + std::to_string(horizon) + " out of range");
+    }
+    if (observationCount_ == 0) {
+        throw std::runtime_error("EWMA covariance has no observations yet");
+    }
+    return horizons_[horizon];
+}
+
+CovarianceMatrix EwmaCovariance::covariance(size_t horizon) const {
+    const Horizon& h = horizonAt(horizon);
+    Eigen::MatrixXd matrix = h.scatter.selfadjointView<Eigen::Lower>();
+    matrix /= h.weightSum;
+    return CovarianceMatrix(matrix, indicatorNames_);
+}
+
+std::vector<CovarianceMatrix> EwmaCovariance::termStructure() const {
+    std::vector<CovarianceMatrix> matrices;
+    matrices.reserve(horizons_.size());
+    for (size_t h = 0; h < horizons_.size(); h++) {
+        matrices.push_back(covariance(h));
+    }
+    return matrices;
+}
+
+Eigen::VectorXd EwmaCovariance::mean(size_t horizon) const {
+    return horizonAt(horizon).mean;
+}
+
+double EwmaCovariance::effectiveObservations(size_t horizon) const {
+    const Horizon& h = horizonAt(horizon);
+    return h.weightSum * h.weightSum / h.squaredWeightSum;
+}
@@ -0,0 +1,121 @@
+//
+//  EwmaCovariance.hpp
+//  InvertedYieldCurveTrader
+//
+//  Exponentially weighted (RiskMetrics-style) covariance, updated in place
+//  with each observation, for one or several half-lives at once.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef EWMA_COVARIANCE_HPP
+#define EWMA_COVARIANCE_HPP
+
+#include "CovarianceCalculator.hpp"
+#include <Eigen/Dense>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * EwmaCovariance: Term structure of exponentially weighted covariances
+ *
+ * Observation s (of n so far) gets weight λ^(n−1−s), with λ = 2^(−1/halfLife).
+ * Each horizon keeps the weight sum W and the weighted scatter M, so an
+ * update is one rank-1 update per horizon, O(N²) and allocation-free, and
+ * the estimate M / W is bias-corrected from the first observation (no
+ * warm-up toward zero). In steady state W → 1 / (1 − λ) and the zero-mean
+ * estimate equals the RiskMetrics recursion Σ_t = λ Σ_{t−1} + (1 − λ) x xᵀ.
+ *
+ * Indicators are in the order given at construction; feed them sorted by
+ * name to match CovarianceCalculator and MacroFactorModel.
+ */
+class EwmaCovariance {
+public:
+    /**
+     * RiskMetrics daily decay (λ = 0.94) expressed as a half-life in observations
+     */
+    static constexpr double RISKMETRICS_HALF_LIFE = 11.2;
+
+    /**
+     * Decay λ with λ^halfLife = 1/2
+     *
+     * @param halfLife: Half-life in observations (> 0)
+     * @throws std::invalid_argument if halfLife is not positive and finite
+     */
+    static double decayFromHalfLife(double halfLife);
+
+    /**
+     * @param indicatorNames: Names in column order (non-empty, unique)
+     * @param halfLives: One or more half-lives in observations, one covariance each
+     * @param demean: Subtract the exponentially weighted mean (false = zero-mean, as RiskMetrics)
+     * @throws std::invalid_argument on empty/duplicate names or bad half-lives
+     */
+    EwmaCovariance(const std::vector<std::string>& indicatorNames,
+                   const std::vector<double>& halfLives = {RISKMETRICS_HALF_LIFE},
+                   bool demean = false);
+
+    /**
+     * Fold one observation into every horizon
+     *
+     * @param observation: N values in indicator order
+     * @throws std::invalid_argument on size mismatch or non-finite values
+     */
+    void update(const Eigen::VectorXd& observation);
+
+    /**
+     * Fold a panel in date order (T updates, every horizon in the same pass)
+     *
+     * @param series: Map of indicator → series; keys must equal the indicator names
+     * @throws std::invalid_argument on missing indicators or unequal lengths
+     */
+    void update(const std::map<std::string, std::vector<double>>& series);
+
+    /**
+     * Current estimate for one horizon, usable wherever a CovarianceMatrix is accepted
+     *
+     * @param horizon: Index into halfLives() (default 0)
+     * @throws std::runtime_error before the first observation
+     * @throws std::out_of_range on a bad horizon
+     */
+    CovarianceMatrix covariance(size_t horizon = 0) const;
+
+    /**
+     * Current estimate for every horizon, in halfLives() order
+     */
+    std::vector<CovarianceMatrix> termStructure() const;
+
+    /**
+     * Exponentially weighted mean (zero when demean is off)
+     */
+    Eigen::VectorXd mean(size_t horizon = 0) const;
+
+    /**
+     * Kish effective sample size W² / Σ w², which tends to (1 + λ) / (1 − λ)
+     */
+    double effectiveObservations(size_t horizon = 0) const;
+
+    const std::vector<std::string>& getIndicatorNames() const { return indicatorNames_; }
+    const std::vector<double>& halfLives() const { return halfLives_; }
+    size_t observationCount() const { return observationCount_; }
+
+private:
+    struct Horizon {
+        double decay;                   // λ
+        double weightSum = 0.0;         // W = Σ λ^k
+        double squaredWeightSum = 0.0;  // Σ λ^2k
+        Eigen::VectorXd mean;           // Weighted mean (demean only)
+        Eigen::MatrixXd scatter;        // M, lower triangle maintained
+    };
+
+    const Horizon& horizonAt(size_t horizon) const;
+
+    std::vector<std::string> indicatorNames_;
+    std::vector<double> halfLives_;
+    std::vector<Horizon> horizons_;
+    Eigen::VectorXd deviation_;         // Scratch: x − μ
+    size_t observationCount_ = 0;
+    bool demean_;
+};
+
+#endif // EWMA_COVARIANCE_HPP
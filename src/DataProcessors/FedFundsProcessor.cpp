@@ -6,11 +6,19 @@
 //
 
 #include "FedFundsProcessor.hpp"
+#include "../Storage/HistoryStore.hpp"
 #include "../DataProviders/FREDDataClient.hpp"
 #include <stdexcept>
 #include <iostream>
 
 std::vector<double> FedFundsProcessor::process(const std::string& fredApiKey, int numValues) {
+    // Serve from the local history store when it is complete and current
+    // (monthly: the next release lands within ~80 days of the last observation)
+    std::vector<double> storedValues;
+    if (HistoryStore::readRecent("fed_funds", numValues, 80, storedValues)) {
+        return storedValues;
+    }
+
     try {
         FREDDataClient client(fredApiKey);
         auto observations = client.fetchFedFundsRate(numValues);
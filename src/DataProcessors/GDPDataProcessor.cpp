@@ -6,6 +6,7 @@
 //
 
 #include "GDPDataProcessor.hpp"
+#include "../Storage/HistoryStore.hpp"
 #include "../AwsClients/S3ObjectRetriever.hpp"
 #include "../Lambda/AlphaVantageDataRetriever.hpp"
 #include "../Utils/Date.hpp"
@@ -17,6 +18,13 @@
 #include <cmath>
 
 std::vector<double> GDPDataProcessor::process(const std::string& fredApiKey, int numValues) {
+    // Serve from the local history store when it is complete and current
+    // (quarterly: the next release lands within ~7 months of the last quarter's date)
+    std::vector<double> storedValues;
+    if (HistoryStore::readRecent("gdp", numValues, 220, storedValues)) {
+        return storedValues;
+    }
+
     const std::string jsonFilePath = "../Lambda/AlphaVantageConstants.json";
 
     std::ifstream jsonFile(jsonFilePath);
@@ -0,0 +1,206 @@
+//
+//  HistoricalSimulation.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of historical-simulation VaR / ES
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "HistoricalSimulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+void validateConfidenceLevels(const std::vector<double>& confidenceLevels) {
+    if (confidenceLevels.empty()) {
+        throw std::invalid_argument("At least one confidence level is required");
+    }
+    for (double confidence : confidenceLevels) {
+        if (!(confidence > 0.0 && confidence < 1.0)) {
+            throw std::invalid_argument("Confidence levels must lie in (0, 1)");
+        }
+    }
+}
+
+// Fenwick tree of counts and value sums indexed by scenario rank
+class RankTree {
+public:
+    explicit RankTree(size_t size) : counts_(size + 1, 0), sums_(size + 1, 0.0), topBit_(1) {
+        while (topBit_ * 2 <= size) {
+            topBit_ *= 2;
+        }
+    }
+
+    void insert(size_t rank, double value) { update(rank, 1, value); }
+    void erase(size_t rank, double value) { update(rank, -1, -value); }
+
+    // Rank of the m-th smallest element held (m ≥ 1) and the sum of the m − 1 below it
+    std::pair<size_t, double> select(size_t m) const {
+        size_t position = 0;
+        size_t remaining = m;
+        double sum = 0.0;
+        for (size_t step = topBit_; step > 0; step /= 2) {
+            const size_t next = position + step;
+            if (next < counts_.size() && static_cast<size_t>(counts_[next]) < remaining) {
+                position = next;
+                remaining -= static_cast<size_t>(counts_[next]);
+                sum += sums_[next];
+            }
+        }
+        return {position, sum};
+    }
+
+private:
+    void update(size_t rank, int delta, double value) {
+        for (size_t i = rank + 1; i < counts_.size(); i += i & (~i + 1)) {
+            counts_[i] += delta;
+            sums_[i] += value;
+        }
+    }
+
+    std::vector<int> counts_;
+    std::vector<double> sums_;
+    size_t topBit_;
+};
+
+}  // namespace
+
+Eigen::VectorXd HistoricalSimulation::scenarioPnl(
+    const Eigen::VectorXd& factorSensitivities,
+    const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+    double notional,
+    int horizonDays)
+{
+    if (factorSensitivities.size() == 0 || factorSensitivities.size() != factorShocks.cols()) {
+        throw std::invalid_argument("Factor sensitivities must match the shock columns");
+    }
+    if (horizonDays < 1) {
+        throw std::invalid_argument("Horizon must be at least one day");
+    }
+    if (factorShocks.rows() < horizonDays) {
+        throw std::invalid_argument("History has " + std::to_string(factorShocks.rows()) +
+                                    " days, fewer than the " + std::to_string(horizonDays) + "-day horizon");
+    }
+    if (!factorShocks.allFinite() || !factorSensitivities.allFinite() || !std::isfinite(notional)) {
+        throw std::invalid_argument("Shocks, sensitivities and notional must be finite");
+    }
+
+    Eigen::VectorXd daily = notional * (factorShocks * factorSensitivities);
+    if (horizonDays == 1) {
+        return daily;
+    }
+
+    // Overlapping h-day sums from a running total
+    const Eigen::Index h = horizonDays;
+    Eigen::VectorXd scenarios(daily.size() - h + 1);
+    double window = daily.head(h).sum();
+    scenarios(0) = window;
+    for (Eigen::Index s = 1; s < scenarios.size(); s++) {
+        window += daily(s + h - 1) - daily(s - 1);
+        scenarios(s) = window;
+    }
+    return scenarios;
+}
+
+TailRisk HistoricalSimulation::tailRisk(
+    const Eigen::Ref<const Eigen::VectorXd>& scenarioPnl,
+    const std::vector<double>& confidenceLevels)
+{
+    if (scenarioPnl.size() == 0) {
+        throw std::invalid_argument("Scenario P&L cannot be empty");
+    }
+    validateConfidenceLevels(confidenceLevels);
+
+    const size_t n = static_cast<size_t>(scenarioPnl.size());
+    std::vector<double> losses(n);
+    for (size_t i = 0; i < n; i++) {
+        losses[i] = -scenarioPnl(static_cast<Eigen::Index>(i));
+    }
+
+    // Deepest tail first; each selection narrows the prefix for the next
+    std::vector<size_t> order(confidenceLevels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return confidenceLevels[a] < confidenceLevels[b];
+    });
+
+    TailRisk result;
+    result.confidenceLevels = confidenceLevels;
+    result.valueAtRisk.resize(confidenceLevels.size());
+    result.expectedShortfall.resize(confidenceLevels.size());
+    result.numScenarios = n;
+    size_t prefix = n;
+    for (size_t level : order) {
+        const size_t m = tailCount(confidenceLevels[level], n);
+        std::nth_element(losses.begin(), losses.begin() + static_cast<std::ptrdiff_t>(m - 1),
+                         losses.begin() + static_cast<std::ptrdiff_t>(prefix), std::greater<double>());
+        result.valueAtRisk[level] = losses[m - 1];
+        result.expectedShortfall[level] =
+            std::accumulate(losses.begin(), losses.begin() + static_cast<std::ptrdiff_t>(m), 0.0) /
+            static_cast<double>(m);
+        prefix = m;
+    }
+    return result;
+}
+
+RollingTailRisk HistoricalSimulation::rollingTailRisk(
+    const Eigen::Ref<const Eigen::VectorXd>& scenarioPnl,
+    size_t windowLength,
+    const std::vector<double>& confidenceLevels)
+{
+    const size_t n = static_cast<size_t>(scenarioPnl.size());
+    if (windowLength == 0 || windowLength > n) {
+        throw std::invalid_argument("Window length must be between 1 and the scenario count");
+    }
+    validateConfidenceLevels(confidenceLevels);
+
+    // Rank every scenario once; ties are broken by date so ranks are unique
+    std::vector<size_t> byValue(n);
+    std::iota(byValue.begin(), byValue.end(), 0);
+    std::stable_sort(byValue.begin(), byValue.end(), [&](size_t a, size_t b) {
+        return scenarioPnl(static_cast<Eigen::Index>(a)) < scenarioPnl(static_cast<Eigen::Index>(b));
+    });
+    std::vector<size_t> rank(n);
+    std::vector<double> sortedPnl(n);
+    for (size_t r = 0; r < n; r++) {
+        rank[byValue[r]] = r;
+        sortedPnl[r] = scenarioPnl(static_cast<Eigen::Index>(byValue[r]));
+    }
+
+    const Eigen::Index L = static_cast<Eigen::Index>(confidenceLevels.size());
+    std::vector<size_t> tailCounts(confidenceLevels.size());
+    for (size_t l = 0; l < confidenceLevels.size(); l++) {
+        tailCounts[l] = tailCount(confidenceLevels[l], windowLength);
+    }
+
+    RollingTailRisk result;
+    result.confidenceLevels = confidenceLevels;
+    result.windowLength = windowLength;
+    result.valueAtRisk.resize(L, static_cast<Eigen::Index>(n - windowLength + 1));
+    result.expectedShortfall.resize(L, static_cast<Eigen::Index>(n - windowLength + 1));
+
+    RankTree tree(n);
+    for (size_t t = 0; t < n; t++) {
+        tree.insert(rank[t], sortedPnl[rank[t]]);
+        if (t >= windowLength) {
+            tree.erase(rank[t - windowLength], sortedPnl[rank[t - windowLength]]);
+        }
+        if (t + 1 < windowLength) {
+            continue;
+        }
+
+        // The m worst losses are the m smallest P&Ls in the window
+        const Eigen::Index column = static_cast<Eigen::Index>(t + 1 - windowLength);
+        for (Eigen::Index l = 0; l < L; l++) {
+            const size_t m = tailCounts[l];
+            auto [position, sumBelow] = tree.select(m);
+            result.valueAtRisk(l, column) = -sortedPnl[position];
+            result.expectedShortfall(l, column) = -(sumBelow + sortedPnl[position]) / static_cast<double>(m);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,120 @@
+//
+//  HistoricalSimulation.hpp
+//  InvertedYieldCurveTrader
+//
+//  Historical-simulation VaR and expected shortfall: today's factor
+//  exposures revalued against every historical factor-shock day, with
+//  rolling tail estimates from an order-statistic tree.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef HISTORICAL_SIMULATION_HPP
+#define HISTORICAL_SIMULATION_HPP
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * TailRisk: VaR and ES of one scenario set
+ *
+ * Losses are positive numbers (loss = −P&L). At confidence c with n
+ * scenarios and m = ⌈(1 − c) n⌉, VaR is the m-th largest loss and ES is
+ * the mean of the m largest, the same convention as MonteCarloRisk.
+ */
+struct TailRisk {
+    std::vector<double> confidenceLevels;
+    std::vector<double> valueAtRisk;
+    std::vector<double> expectedShortfall;
+    size_t numScenarios = 0;
+};
+
+/**
+ * Number of scenarios in the tail at confidence c: m = ⌈(1 − c) n⌉, at
+ * least 1. The small slack absorbs 1 − 0.99 ≠ 0.01.
+ *
+ * @param confidence: Confidence level in (0, 1)
+ * @param numScenarios: Scenario (or path) count, at least 1
+ */
+inline size_t tailCount(double confidence, size_t numScenarios) {
+    const double count = std::ceil((1.0 - confidence) * static_cast<double>(numScenarios) - 1e-9);
+    return std::clamp<size_t>(static_cast<size_t>(std::max(count, 1.0)), 1, numScenarios);
+}
+
+/**
+ * RollingTailRisk: VaR and ES for every full window
+ *
+ * Structure of arrays: row l is confidence level l, column s is the
+ * window of scenarios [s, s + W).
+ */
+struct RollingTailRisk {
+    std::vector<double> confidenceLevels;
+    Eigen::MatrixXd valueAtRisk;        // L × S
+    Eigen::MatrixXd expectedShortfall;  // L × S
+    size_t windowLength = 0;
+};
+
+/**
+ * HistoricalSimulation: Full-revaluation VaR without a distributional model
+ *
+ * The position's factor exposure γ (RiskDecomposition::factorSensitivities
+ * per unit notional) is applied to each historical day of factor shocks.
+ * The result is one P&L scenario per day: a single T × K GEMV. An h-day
+ * horizon sums h consecutive daily scenarios, overlapping, giving T − h + 1
+ * scenarios from a running sum. No √h scaling is involved.
+ *
+ * Rolling tails use a Fenwick tree over the scenarios' ranks. Sorting once
+ * fixes every scenario's rank. A window step is then one insert and one
+ * erase, and each VaR/ES query is one descent plus one prefix sum, all
+ * O(log T). Thirty years of daily history is a single pass.
+ */
+class HistoricalSimulation {
+public:
+    /**
+     * P&L of today's exposure under each historical shock
+     *
+     * @param factorSensitivities: γ ∈ ℝ^K per unit notional
+     * @param factorShocks: Historical factor shocks (T × K), one row per day
+     * @param notional: Position size
+     * @param horizonDays: Days per scenario (overlapping sums)
+     * @return T − horizonDays + 1 P&L scenarios, in date order
+     * @throws std::invalid_argument on mismatched sizes or too short a history
+     */
+    static Eigen::VectorXd scenarioPnl(
+        const Eigen::VectorXd& factorSensitivities,
+        const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+        double notional,
+        int horizonDays = 1
+    );
+
+    /**
+     * VaR and ES of a whole scenario set (selection, not a full sort)
+     *
+     * @param scenarioPnl: P&L per scenario
+     * @param confidenceLevels: Each in (0, 1)
+     * @throws std::invalid_argument on empty input or levels outside (0, 1)
+     */
+    static TailRisk tailRisk(
+        const Eigen::Ref<const Eigen::VectorXd>& scenarioPnl,
+        const std::vector<double>& confidenceLevels = {0.95, 0.99}
+    );
+
+    /**
+     * VaR and ES over a sliding window of scenarios, O(log T) per step and level
+     *
+     * @param scenarioPnl: P&L per scenario, in date order
+     * @param windowLength: Scenarios per window (W)
+     * @param confidenceLevels: Each in (0, 1)
+     * @return One column per full window, T − W + 1 in total
+     * @throws std::invalid_argument if W is 0 or exceeds the scenario count
+     */
+    static RollingTailRisk rollingTailRisk(
+        const Eigen::Ref<const Eigen::VectorXd>& scenarioPnl,
+        size_t windowLength,
+        const std::vector<double>& confidenceLevels = {0.95, 0.99}
+    );
+};
+
+#endif // HISTORICAL_SIMULATION_HPP
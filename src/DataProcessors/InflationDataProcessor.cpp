@@ -5,6 +5,7 @@
 //  Created by Ryan Hamby on 9/21/23.
 //
 #include "InflationDataProcessor.hpp"
+#include "../Storage/HistoryStore.hpp"
 #include "../AwsClients/S3ObjectRetriever.hpp"
 #include "../Lambda/AlphaVantageDataRetriever.hpp"
 #include "../Utils/Date.hpp"
@@ -17,6 +18,13 @@
 using json = nlohmann::json;
 
 std::vector<double> InflationDataProcessor::process(const std::string& fredApiKey, int numValues) {
+    // Serve from the local history store when it is complete and current
+    // (monthly: the next release lands within ~80 days of the last observation)
+    std::vector<double> storedValues;
+    if (HistoryStore::readRecent("inflation", numValues, 80, storedValues)) {
+        return storedValues;
+    }
+
     const std::string jsonFilePath = "../Lambda/AlphaVantageConstants.json";
 
     std::ifstream jsonFile(jsonFilePath);
@@ -8,13 +8,63 @@
 //
 
 #include "MacroFactorModel.hpp"
+#include "../Utils/Logger.hpp"
+#include "../Utils/Tracer.hpp"
 #include <Eigen/Eigenvalues>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <numeric>
 
+namespace {
+
+/**
+ * ψ_i = Var(x_i) − ‖B_i‖², floored at a fraction of Var(x_i)
+ */
+Eigen::VectorXd flooredUniquenesses(const Eigen::VectorXd& variances, const Eigen::MatrixXd& loadings) {
+    Eigen::VectorXd communalities = loadings.rowwise().squaredNorm();
+    Eigen::VectorXd uniquenesses(variances.size());
+    for (Eigen::Index i = 0; i < variances.size(); i++) {
+        double floor = std::max(MacroFactorModel::UNIQUENESS_FLOOR * variances(i), 1e-12);
+        uniquenesses(i) = std::max(variances(i) - communalities(i), floor);
+    }
+    return uniquenesses;
+}
+
+/**
+ * Clamped cosine of every loading column against every archetype (K × A)
+ */
+Eigen::MatrixXd archetypeScores(const Eigen::MatrixXd& loadings, const ArchetypeMatrix& archetypes) {
+    Eigen::MatrixXd scores = loadings.transpose() * archetypes.directions;
+    Eigen::VectorXd norms = loadings.colwise().norm();
+    for (Eigen::Index k = 0; k < scores.rows(); k++) {
+        if (norms(k) < 1e-10) {
+            scores.row(k).setZero();
+        } else {
+            scores.row(k) /= norms(k);
+        }
+    }
+    return scores.cwiseMax(0.0).cwiseMin(1.0);
+}
+
+}  // namespace
+
 MacroFactors MacroFactorModel::decomposeSurpriseCovariance(
+    const CovarianceMatrix& surpriseCov,
+    int numFactors,
+    double labelThreshold)
+{
+    MacroFactors result = decomposeUnlabeled(surpriseCov, numFactors);
+
+    for (const LabelResult& label : labelFactors(result.loadings, buildArchetypeMatrix(result.indicatorNames),
+                                                 labelThreshold)) {
+        result.factorLabels.push_back(label.label);
+        result.labelConfidences.push_back(label.cosineScore);
+    }
+    return result;
+}
+
+MacroFactors MacroFactorModel::decomposeUnlabeled(
     const CovarianceMatrix& surpriseCov,
     int numFactors)
 {
@@ -74,15 +124,6 @@ MacroFactors MacroFactorModel::decomposeSurpriseCovariance(
         cumulativeVarExplained = explainedVariance / totalVariance;
     }
 
-    // Label factors
-    std::vector<std::string> labels;
-    std::vector<double> confidences;
-    for (int k = 0; k < numFactors; k++) {
-        LabelResult result = labelFactorRobustly(loadings.col(k), indicatorNames);
-        labels.push_back(result.label);
-        confidences.push_back(result.cosineScore);
-    }
-
     // Residual covariance: Σ_u = Σ - B B^T
     Eigen::MatrixXd residualCov = cov - loadings * loadings.transpose();
 
@@ -90,47 +131,178 @@ MacroFactors MacroFactorModel::decomposeSurpriseCovariance(
     MacroFactors result;
     result.loadings = loadings;
     result.factorVariances = factorVariances;
-    result.factorLabels = labels;
-    result.labelConfidences = confidences;
     result.cumulativeVarianceExplained = cumulativeVarExplained;
     result.residualCovariance = residualCov;
+    result.uniquenesses = flooredUniquenesses(cov.diagonal(), loadings);
     result.numFactors = numFactors;
     result.indicatorNames = indicatorNames;
 
-    // Note: factors time series would be computed when applied to actual data
-    // For now, this is just the structural decomposition
+    // Factor time series are filled by computeFactorScores once a panel is at hand
 
     return result;
 }
 
+MacroFactors MacroFactorModel::decomposeSurprisePanel(
+    const std::map<std::string, std::vector<double>>& surprises,
+    int numFactors,
+    const RandomizedPCAOptions& pcaOptions,
+    double labelThreshold,
+    PrincipalComponents* diagnostics)
+{
+    if (numFactors < 1) {
+        throw std::invalid_argument("numFactors must be >= 1");
+    }
+
+    std::vector<std::string> indicatorNames;
+    Eigen::MatrixXd panel = RandomizedPCA::centeredPanel(surprises, indicatorNames);
+    if (numFactors > panel.cols()) {
+        throw std::invalid_argument("numFactors cannot exceed number of indicators");
+    }
+
+    PrincipalComponents pca = RandomizedPCA::compute(panel, numFactors, pcaOptions);
+
+    // Loadings: B = U * sqrt(Λ)
+    Eigen::MatrixXd loadings = pca.components * pca.eigenvalues.cwiseSqrt().asDiagonal();
+
+    MacroFactors result;
+    result.loadings = loadings;
+    result.factorVariances.assign(pca.eigenvalues.data(), pca.eigenvalues.data() + numFactors);
+    result.cumulativeVarianceExplained = pca.totalVariance > 1e-10
+        ? pca.eigenvalues.sum() / pca.totalVariance
+        : 0.0;
+    result.numFactors = numFactors;
+    result.indicatorNames = indicatorNames;
+
+    for (const LabelResult& label : labelFactors(loadings, buildArchetypeMatrix(indicatorNames), labelThreshold)) {
+        result.factorLabels.push_back(label.label);
+        result.labelConfidences.push_back(label.cosineScore);
+    }
+
+    result.uniquenesses = flooredUniquenesses(
+        panel.colwise().squaredNorm().transpose() / static_cast<double>(panel.rows() - 1), loadings);
+
+    // Residual covariance: Σ_u = Σ - B B^T (only while N × N stays small)
+    if (panel.cols() <= MAX_RESIDUAL_COVARIANCE_INDICATORS) {
+        Eigen::MatrixXd cov = panel.transpose() * panel / static_cast<double>(panel.rows() - 1);
+        result.residualCovariance = cov - loadings * loadings.transpose();
+    }
+
+    if (diagnostics != nullptr) {
+        *diagnostics = std::move(pca);
+    }
+    return result;
+}
+
+Eigen::MatrixXd MacroFactorModel::factorScoreWeights(
+    const Eigen::MatrixXd& loadings,
+    const Eigen::VectorXd& uniquenesses,
+    FactorScoreMethod method)
+{
+    if (uniquenesses.size() != loadings.rows()) {
+        throw std::invalid_argument("uniquenesses must have one entry per loading row");
+    }
+    if (uniquenesses.size() > 0 && uniquenesses.minCoeff() <= 0.0) {
+        throw std::invalid_argument("uniquenesses must be strictly positive");
+    }
+
+    // Ψ⁻¹ B and G = Bᵀ Ψ⁻¹ B (K × K)
+    Eigen::MatrixXd scaledLoadings = uniquenesses.cwiseInverse().asDiagonal() * loadings;
+    Eigen::MatrixXd gram = loadings.transpose() * scaledLoadings;
+
+    // Bartlett: Ψ⁻¹ B G⁻¹. Regression via Woodbury: (B Bᵀ + Ψ)⁻¹ B = Ψ⁻¹ B (I + G)⁻¹
+    if (method == FactorScoreMethod::Regression) {
+        gram.diagonal().array() += 1.0;
+    }
+
+    Eigen::LDLT<Eigen::MatrixXd> solver(gram);
+    if (solver.info() != Eigen::Success) {
+        throw std::runtime_error("Factor score system is singular");
+    }
+    return solver.solve(scaledLoadings.transpose()).transpose();
+}
+
+void MacroFactorModel::computeFactorScores(
+    MacroFactors& factors,
+    const std::map<std::string, std::vector<double>>& surprises,
+    FactorScoreMethod method)
+{
+    std::vector<std::string> indicatorNames;
+    Eigen::MatrixXd panel = RandomizedPCA::centeredPanel(surprises, indicatorNames);
+    if (indicatorNames != factors.indicatorNames) {
+        throw std::invalid_argument("Surprise indicators do not match the factor decomposition");
+    }
+    if (panel.rows() < 2) {
+        throw std::invalid_argument("Factor scores need at least 2 observations");
+    }
+
+    // Hand-built decompositions may lack Ψ; take it from this panel
+    Eigen::VectorXd uniquenesses = factors.uniquenesses;
+    if (uniquenesses.size() != panel.cols()) {
+        uniquenesses = flooredUniquenesses(
+            panel.colwise().squaredNorm().transpose() / static_cast<double>(panel.rows() - 1),
+            factors.loadings);
+    }
+
+    // One GEMM for every date: F = X W (T × K)
+    Eigen::MatrixXd scores = panel * factorScoreWeights(factors.loadings, uniquenesses, method);
+
+    factors.factors.resize(scores.cols());
+    for (Eigen::Index k = 0; k < scores.cols(); k++) {
+        factors.factors[k] = scores.col(k);
+    }
+}
+
 LabelResult MacroFactorModel::labelFactorRobustly(
     const Eigen::VectorXd& loading,
     const std::vector<std::string>& indicatorNames,
-    const LabelResult& previousLabel)
+    const LabelResult& previousLabel,
+    double labelThreshold)
 {
-    // Get archetypes for these indicators
-    auto archetypes = getEconomicArchetypes(indicatorNames);
-
-    if (archetypes.empty()) {
+    ArchetypeMatrix archetypes = buildArchetypeMatrix(indicatorNames);
+    if (archetypes.labels.empty()) {
         return {"Unclassified", 0.0, true, "No archetypes available"};
     }
 
-    // Compute cosine similarity to each archetype
-    std::map<std::string, double> scores;
-    for (auto& [name, archetype] : archetypes) {
-        double score = cosineSimilarity(loading, archetype);
-        scores[name] = score;
+    // First maximum wins; labels are alphabetical like the old map scan
+    Eigen::Index best;
+    double bestScore = archetypeScores(loading, archetypes).row(0).maxCoeff(&best);
+    return resolveLabel(archetypes.labels[best], bestScore, previousLabel, labelThreshold);
+}
+
+std::vector<LabelResult> MacroFactorModel::labelFactors(
+    const Eigen::MatrixXd& loadings,
+    const ArchetypeMatrix& archetypes,
+    double labelThreshold)
+{
+    if (loadings.rows() != archetypes.directions.rows()) {
+        throw std::invalid_argument("Loadings and archetypes must cover the same indicators");
+    }
+
+    std::vector<LabelResult> results;
+    results.reserve(loadings.cols());
+    if (archetypes.labels.empty()) {
+        results.assign(loadings.cols(), LabelResult{"Unclassified", 0.0, true, "No archetypes available"});
+        return results;
     }
 
-    // Find best match
-    auto bestMatch = std::max_element(
-        scores.begin(),
-        scores.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; }
-    );
+    // K × A cosine scores in one product, then the best match per row
+    Eigen::MatrixXd scores = archetypeScores(loadings, archetypes);
+    for (Eigen::Index k = 0; k < scores.rows(); k++) {
+        Eigen::Index best;
+        double bestScore = scores.row(k).maxCoeff(&best);
+        results.push_back(resolveLabel(archetypes.labels[best], bestScore, LabelResult{"", 0.0, true, ""},
+                                       labelThreshold));
+    }
+    return results;
+}
 
-    std::string label = bestMatch->first;
-    double bestScore = bestMatch->second;
+LabelResult MacroFactorModel::resolveLabel(
+    const std::string& bestLabel,
+    double bestScore,
+    const LabelResult& previousLabel,
+    double labelThreshold)
+{
+    std::string label = bestLabel;
 
     // Check stability: did label change from previous window?
     bool isStable = true;
@@ -143,10 +315,11 @@ LabelResult MacroFactorModel::labelFactorRobustly(
         }
     }
 
-    // Apply confidence threshold: if best score < 0.65, mark as Unclassified
-    if (bestScore < 0.65) {
+    // Apply confidence threshold: if best score < threshold (0.65 by default), mark as Unclassified
+    if (bestScore < labelThreshold) {
         label = "Unclassified";
-        message = "Best archetype match score " + std::to_string(bestScore) + " < 0.65 threshold";
+        message = "Best archetype match score " + std::to_string(bestScore) + " < " +
+                  std::to_string(labelThreshold) + " threshold";
         isStable = false;
     }
 
@@ -157,7 +330,8 @@ std::vector<MacroFactors> MacroFactorModel::rollingDecompositionWithDriftDetecti
     const std::map<std::string, std::vector<double>>& surprises,
     int windowMonths,
     int numFactors,
-    double stabilityThreshold)
+    double stabilityThreshold,
+    FactorScoreMethod scoreMethod)
 {
     if (windowMonths < 1) {
         throw std::invalid_argument("windowMonths must be >= 1");
@@ -175,11 +349,23 @@ std::vector<MacroFactors> MacroFactorModel::rollingDecompositionWithDriftDetecti
         }
     }
 
+    // Stack the panel once (map order = indicator order); window sums are updated incrementally
+    Eigen::MatrixXd panel(static_cast<Eigen::Index>(timeSeriesLength), static_cast<Eigen::Index>(surprises.size()));
+    Eigen::Index column = 0;
+    for (const auto& [ind, series] : surprises) {
+        panel.col(column++) = Eigen::Map<const Eigen::VectorXd>(series.data(), panel.rows());
+    }
+    Eigen::RowVectorXd windowSum = Eigen::RowVectorXd::Zero(panel.cols());
+    if (timeSeriesLength >= static_cast<size_t>(windowMonths)) {
+        windowSum = panel.topRows(windowMonths).colwise().sum();
+    }
+
     std::vector<MacroFactors> results;
-    LabelResult previousLabel{"", 0.0, true, ""};
 
     // Rolling window: slide through time
     for (size_t t = windowMonths; t <= timeSeriesLength; t++) {
+        TRACE_SCOPE_ARGS("factor", "decompose_window", {{"t", t}});
+
         // Extract window [t - windowMonths, t)
         std::map<std::string, std::vector<double>> windowData;
         for (const auto& [ind, fullSeries] : surprises) {
@@ -194,20 +380,61 @@ std::vector<MacroFactors> MacroFactorModel::rollingDecompositionWithDriftDetecti
         CovarianceCalculator covCalc;
         CovarianceMatrix windowCov = covCalc.calculateCovarianceMatrix(windowData);
 
-        // Decompose
-        MacroFactors factorization = decomposeSurpriseCovariance(windowCov, numFactors);
+        // Decompose (labels are assigned for all windows at once below)
+        MacroFactors factorization = decomposeUnlabeled(windowCov, numFactors);
+
+        // Scores for the window: (X_w − 1 μᵀ) W = X_w W − 1 (μᵀ W), on a block view of the panel
+        Eigen::MatrixXd weights = factorScoreWeights(
+            factorization.loadings, factorization.uniquenesses, scoreMethod);
+        Eigen::MatrixXd scores = panel.middleRows(t - windowMonths, windowMonths) * weights;
+        scores.rowwise() -= (windowSum / static_cast<double>(windowMonths)) * weights;
 
-        // Track label stability
+        factorization.factors.resize(numFactors);
         for (int k = 0; k < numFactors; k++) {
-            LabelResult currentLabel = labelFactorRobustly(
-                factorization.loadings.col(k),
-                factorization.indicatorNames,
-                previousLabel
-            );
+            factorization.factors[k] = scores.col(k);
+        }
+
+        if (t < timeSeriesLength) {
+            windowSum += panel.row(t) - panel.row(t - windowMonths);
+        }
+
+        results.push_back(std::move(factorization));
+    }
+
+    if (results.empty()) {
+        return results;
+    }
+
+    // Every window shares the indicator order: build the archetypes once and
+    // score all W·K loading columns in a single (W·K) × A cosine product
+    ArchetypeMatrix archetypes = buildArchetypeMatrix(results.front().indicatorNames);
+    Eigen::MatrixXd allLoadings(results.front().loadings.rows(), results.size() * numFactors);
+    for (size_t w = 0; w < results.size(); w++) {
+        allLoadings.middleCols(w * numFactors, numFactors) = results[w].loadings;
+    }
 
-            if (!currentLabel.isStable && currentLabel.cosineScore >= 0.65) {
-                std::cerr << "Warning at t=" << t << ", factor " << k << ": "
-                          << currentLabel.message << std::endl;
+    Eigen::MatrixXd scores;
+    if (!archetypes.labels.empty()) {
+        scores = archetypeScores(allLoadings, archetypes);
+    }
+
+    // Track label stability (sequential: each label is compared with the one before it)
+    LabelResult previousLabel{"", 0.0, true, ""};
+    for (size_t w = 0; w < results.size(); w++) {
+        MacroFactors& factorization = results[w];
+        factorization.factorLabels.resize(numFactors);
+        factorization.labelConfidences.resize(numFactors);
+
+        for (int k = 0; k < numFactors; k++) {
+            LabelResult currentLabel{"Unclassified", 0.0, true, "No archetypes available"};
+            if (!archetypes.labels.empty()) {
+                Eigen::Index best;
+                double bestScore = scores.row(w * numFactors + k).maxCoeff(&best);
+                currentLabel = resolveLabel(archetypes.labels[best], bestScore, previousLabel, DEFAULT_LABEL_THRESHOLD);
+            }
+
+            if (!currentLabel.isStable && currentLabel.cosineScore >= DEFAULT_LABEL_THRESHOLD) {
+                LOG_WARN("Factor label unstable", "t", w + windowMonths, "factor", k, "detail", currentLabel.message);
             }
 
             factorization.factorLabels[k] = currentLabel.label;
@@ -215,8 +442,6 @@ std::vector<MacroFactors> MacroFactorModel::rollingDecompositionWithDriftDetecti
 
             previousLabel = currentLabel;
         }
-
-        results.push_back(factorization);
     }
 
     return results;
@@ -224,6 +449,18 @@ std::vector<MacroFactors> MacroFactorModel::rollingDecompositionWithDriftDetecti
 
 std::map<std::string, Eigen::VectorXd> MacroFactorModel::getEconomicArchetypes(
     const std::vector<std::string>& indicatorNames)
+{
+    ArchetypeMatrix matrix = buildArchetypeMatrix(indicatorNames);
+
+    std::map<std::string, Eigen::VectorXd> archetypes;
+    for (size_t a = 0; a < matrix.labels.size(); a++) {
+        archetypes[matrix.labels[a]] = matrix.directions.col(a);
+    }
+    return archetypes;
+}
+
+ArchetypeMatrix MacroFactorModel::buildArchetypeMatrix(
+    const std::vector<std::string>& indicatorNames)
 {
     // Create index map: indicator name -> position in vector
     std::map<std::string, int> indexMap;
@@ -232,61 +469,36 @@ std::map<std::string, Eigen::VectorXd> MacroFactorModel::getEconomicArchetypes(
     }
 
     int n = indicatorNames.size();
-    std::map<std::string, Eigen::VectorXd> archetypes;
+    Eigen::MatrixXd candidates = Eigen::MatrixXd::Zero(n, 4);
+    const std::vector<std::string> names = {"Growth", "Inflation", "Policy", "Volatility"};  // Alphabetical
 
     // Growth archetype: GDP↑, unemployment↓, sentiment↑
-    Eigen::VectorXd growth = Eigen::VectorXd::Zero(n);
-    if (indexMap.count("gdp")) growth(indexMap["gdp"]) = 1.0;
-    if (indexMap.count("unemployment")) growth(indexMap["unemployment"]) = -1.0;
-    if (indexMap.count("consumer_sentiment")) growth(indexMap["consumer_sentiment"]) = 1.0;
-    if (growth.norm() > 1e-10) {
-        archetypes["Growth"] = growth.normalized();
-    }
+    if (indexMap.count("gdp")) candidates(indexMap["gdp"], 0) = 1.0;
+    if (indexMap.count("unemployment")) candidates(indexMap["unemployment"], 0) = -1.0;
+    if (indexMap.count("consumer_sentiment")) candidates(indexMap["consumer_sentiment"], 0) = 1.0;
 
     // Inflation archetype: CPI↑, inflation↑
-    Eigen::VectorXd inflation = Eigen::VectorXd::Zero(n);
-    if (indexMap.count("inflation")) inflation(indexMap["inflation"]) = 1.0;
-    if (indexMap.count("cpi")) inflation(indexMap["cpi"]) = 1.0;
-    if (inflation.norm() > 1e-10) {
-        archetypes["Inflation"] = inflation.normalized();
-    }
+    if (indexMap.count("inflation")) candidates(indexMap["inflation"], 1) = 1.0;
+    if (indexMap.count("cpi")) candidates(indexMap["cpi"], 1) = 1.0;
 
     // Policy archetype: Fed funds↑, spreads↑
-    Eigen::VectorXd policy = Eigen::VectorXd::Zero(n);
-    if (indexMap.count("fed_funds")) policy(indexMap["fed_funds"]) = 1.0;
-    if (indexMap.count("treasury_10y")) policy(indexMap["treasury_10y"]) = 0.5;
-    if (policy.norm() > 1e-10) {
-        archetypes["Policy"] = policy.normalized();
-    }
+    if (indexMap.count("fed_funds")) candidates(indexMap["fed_funds"], 2) = 1.0;
+    if (indexMap.count("treasury_10y")) candidates(indexMap["treasury_10y"], 2) = 0.5;
 
     // Volatility archetype: VIX↑, MOVE↑
-    Eigen::VectorXd volatility = Eigen::VectorXd::Zero(n);
-    if (indexMap.count("vix")) volatility(indexMap["vix"]) = 1.0;
-    if (indexMap.count("move")) volatility(indexMap["move"]) = 1.0;
-    if (volatility.norm() > 1e-10) {
-        archetypes["Volatility"] = volatility.normalized();
+    if (indexMap.count("vix")) candidates(indexMap["vix"], 3) = 1.0;
+    if (indexMap.count("move")) candidates(indexMap["move"], 3) = 1.0;
+
+    // Keep archetypes with at least one matching indicator, normalized
+    ArchetypeMatrix archetypes;
+    archetypes.directions.resize(n, 0);
+    for (int a = 0; a < 4; a++) {
+        double norm = candidates.col(a).norm();
+        if (norm > 1e-10) {
+            archetypes.labels.push_back(names[a]);
+            archetypes.directions.conservativeResize(Eigen::NoChange, archetypes.directions.cols() + 1);
+            archetypes.directions.rightCols(1) = candidates.col(a) / norm;
+        }
     }
-
     return archetypes;
 }
-
-double MacroFactorModel::cosineSimilarity(
-    const Eigen::VectorXd& v1,
-    const Eigen::VectorXd& v2)
-{
-    if (v1.size() != v2.size()) {
-        throw std::invalid_argument("Vectors must have same size");
-    }
-
-    double numerator = v1.dot(v2);
-    double denominator = v1.norm() * v2.norm();
-
-    if (denominator < 1e-10) {
-        return 0.0;
-    }
-
-    double similarity = numerator / denominator;
-
-    // Clamp to [0, 1] in case of numerical issues
-    return std::max(0.0, std::min(1.0, similarity));
-}
@@ -12,6 +12,7 @@
 #define MACRO_FACTOR_MODEL_HPP
 
 #include "CovarianceCalculator.hpp"
+#include "RandomizedPCA.hpp"
 #include <Eigen/Dense>
 #include <vector>
 #include <string>
@@ -28,6 +29,28 @@ struct LabelResult {
     std::string message;            // Diagnostic message
 };
 
+/**
+ * ArchetypeMatrix: Economic archetypes for one indicator ordering, built once
+ *
+ * Column a of directions is the unit-norm archetype labels[a] over the N
+ * indicators. Labels are alphabetical, so ties resolve as they always have.
+ */
+struct ArchetypeMatrix {
+    std::vector<std::string> labels;                // "Growth", "Inflation", "Policy", "Volatility" (present ones)
+    Eigen::MatrixXd directions;                     // N × A, unit columns
+};
+
+/**
+ * FactorScoreMethod: Estimator for factor scores f̂_t = Wᵀ x_t given loadings B and Ψ = diag(Σ_u)
+ *
+ * Regression (Thomson): W = Σ⁻¹ B with Σ = B Bᵀ + Ψ, minimum mean-squared error, shrunk toward zero
+ * Bartlett:             W = Ψ⁻¹ B (Bᵀ Ψ⁻¹ B)⁻¹, unbiased (Wᵀ B = I), noisier
+ */
+enum class FactorScoreMethod {
+    Regression,
+    Bartlett
+};
+
 /**
  * MacroFactors: Complete factor decomposition result
  */
@@ -39,6 +62,7 @@ struct MacroFactors {
     std::vector<double> labelConfidences;           // Cosine score (0.0-1.0) for each label
     double cumulativeVarianceExplained;             // % of total covariance explained
     Eigen::MatrixXd residualCovariance;             // Σ_u: unexplained covariance
+    Eigen::VectorXd uniquenesses;                   // Ψ = diag(Σ_u), filled even when Σ_u is skipped
 
     // Metadata
     int numFactors;
@@ -53,16 +77,94 @@ struct MacroFactors {
  */
 class MacroFactorModel {
 public:
+    /**
+     * Minimum archetype cosine score for a factor to get a label
+     */
+    static constexpr double DEFAULT_LABEL_THRESHOLD = 0.65;
+
     /**
      * Decompose surprise covariance using PCA
      *
      * @param surpriseCov: 8x8 covariance matrix of macro surprises
      * @param numFactors: Number of factors to extract (default 3)
+     * @param labelThreshold: Minimum cosine score to label a factor (default 0.65)
      * @return MacroFactors struct with loadings, variances, labels
      */
     static MacroFactors decomposeSurpriseCovariance(
         const CovarianceMatrix& surpriseCov,
-        int numFactors = 3
+        int numFactors = 3,
+        double labelThreshold = DEFAULT_LABEL_THRESHOLD
+    );
+
+    /**
+     * Largest panel for which decomposeSurprisePanel still fills the N × N residualCovariance
+     */
+    static constexpr int MAX_RESIDUAL_COVARIANCE_INDICATORS = 512;
+
+    /**
+     * Decompose a surprise panel with randomized truncated PCA
+     *
+     * Equivalent to decomposeSurpriseCovariance on the panel's covariance, up
+     * to the sketch error and the sign of each factor, but Σ is never formed,
+     * so it scales to thousands of screened series. Above
+     * MAX_RESIDUAL_COVARIANCE_INDICATORS, residualCovariance is left empty.
+     *
+     * @param surprises: Map of indicator → surprise series (equal lengths)
+     * @param numFactors: Number of factors to extract (default 3)
+     * @param pcaOptions: Oversampling, power iterations, seed
+     * @param labelThreshold: Minimum cosine score to label a factor (default 0.65)
+     * @param diagnostics: If non-null, receives the eigenpairs and their error bounds
+     * @return MacroFactors struct with loadings, variances, labels
+     */
+    static MacroFactors decomposeSurprisePanel(
+        const std::map<std::string, std::vector<double>>& surprises,
+        int numFactors = 3,
+        const RandomizedPCAOptions& pcaOptions = RandomizedPCAOptions(),
+        double labelThreshold = DEFAULT_LABEL_THRESHOLD,
+        PrincipalComponents* diagnostics = nullptr
+    );
+
+    /**
+     * Relative floor on each uniqueness ψ_i, as a fraction of Var(x_i)
+     *
+     * Keeps Ψ⁻¹ finite when K approaches N or an indicator is fully explained.
+     */
+    static constexpr double UNIQUENESS_FLOOR = 1e-4;
+
+    /**
+     * Score weights W (N × K) such that the factor scores of a panel X are X W
+     *
+     * Both estimators go through the K × K system Bᵀ Ψ⁻¹ B (Woodbury for the
+     * regression variant), so the cost is O(N·K²) and Σ is never inverted.
+     *
+     * @param loadings: B (N × K)
+     * @param uniquenesses: Ψ diagonal (N), strictly positive
+     * @param method: Regression or Bartlett
+     * @return W (N × K)
+     * @throws std::invalid_argument on size mismatch or non-positive ψ_i
+     */
+    static Eigen::MatrixXd factorScoreWeights(
+        const Eigen::MatrixXd& loadings,
+        const Eigen::VectorXd& uniquenesses,
+        FactorScoreMethod method = FactorScoreMethod::Regression
+    );
+
+    /**
+     * Fill factors.factors with one score series per factor
+     *
+     * The panel is stacked and centered once, then projected with a single
+     * T × N by N × K product. Scores are relative to the panel mean, and
+     * each factor keeps the (arbitrary) sign of its loading column.
+     *
+     * @param factors: Decomposition to score; indicatorNames must match the map keys
+     * @param surprises: Map of indicator → surprise series (equal lengths)
+     * @param method: Regression (default) or Bartlett
+     * @throws std::invalid_argument if the indicators differ from the decomposition
+     */
+    static void computeFactorScores(
+        MacroFactors& factors,
+        const std::map<std::string, std::vector<double>>& surprises,
+        FactorScoreMethod method = FactorScoreMethod::Regression
     );
 
     /**
@@ -73,12 +175,31 @@ public:
      * @param loading: Column of loadings matrix (one factor)
      * @param indicatorNames: Names of indicators (must be sorted)
      * @param previousLabel: Label from previous window (for stability check)
+     * @param labelThreshold: Scores below this are "Unclassified" (default 0.65)
      * @return LabelResult with label, confidence, stability flag
      */
     static LabelResult labelFactorRobustly(
         const Eigen::VectorXd& loading,
         const std::vector<std::string>& indicatorNames,
-        const LabelResult& previousLabel = LabelResult{"", 0.0, true, ""}
+        const LabelResult& previousLabel = LabelResult{"", 0.0, true, ""},
+        double labelThreshold = DEFAULT_LABEL_THRESHOLD
+    );
+
+    /**
+     * Label every loading column against a prebuilt archetype matrix
+     *
+     * Scores all K columns with one K × A cosine product. Each result is
+     * judged on its own (no previous-window stability check).
+     *
+     * @param loadings: B (N × K), rows in the archetype matrix's indicator order
+     * @param archetypes: From buildArchetypeMatrix
+     * @param labelThreshold: Scores below this are "Unclassified" (default 0.65)
+     * @return One LabelResult per column
+     */
+    static std::vector<LabelResult> labelFactors(
+        const Eigen::MatrixXd& loadings,
+        const ArchetypeMatrix& archetypes,
+        double labelThreshold = DEFAULT_LABEL_THRESHOLD
     );
 
     /**
@@ -87,17 +208,23 @@ public:
      * Decomposes surprise covariance in rolling windows, detects when factors
      * become unstable (labels flip), and flags for manual review.
      *
+     * Each window's factors hold that window's scores (windowMonths per
+     * factor). The panel is stacked once and the window mean is updated
+     * incrementally, so scoring a window is one product on a block view.
+     *
      * @param surprises: Map of indicator → surprise time series
      * @param windowMonths: Size of rolling window (default 12)
      * @param numFactors: Number of factors (default 3)
      * @param stabilityThreshold: Cosine similarity threshold for stability (default 0.85)
+     * @param scoreMethod: Factor score estimator (default Regression)
      * @return Vector of MacroFactors, one per window
      */
     static std::vector<MacroFactors> rollingDecompositionWithDriftDetection(
         const std::map<std::string, std::vector<double>>& surprises,
         int windowMonths = 12,
         int numFactors = 3,
-        double stabilityThreshold = 0.85
+        double stabilityThreshold = 0.85,
+        FactorScoreMethod scoreMethod = FactorScoreMethod::Regression
     );
 
     /**
@@ -115,17 +242,44 @@ public:
         const std::vector<std::string>& indicatorNames
     );
 
+    /**
+     * Economic archetypes as a normalized N × A matrix
+     *
+     * Same vectors as getEconomicArchetypes; archetypes with no matching
+     * indicator are left out.
+     *
+     * @param indicatorNames: Indicator order of the loadings to be labeled
+     * @return ArchetypeMatrix (A may be 0)
+     */
+    static ArchetypeMatrix buildArchetypeMatrix(
+        const std::vector<std::string>& indicatorNames
+    );
+
 private:
     /**
-     * Compute cosine similarity between two vectors
+     * Eigendecomposition, loadings and residuals without labels
+     *
+     * Shared by decomposeSurpriseCovariance and the rolling loop, which
+     * labels all windows in one pass afterwards.
+     */
+    static MacroFactors decomposeUnlabeled(
+        const CovarianceMatrix& surpriseCov,
+        int numFactors
+    );
+
+    /**
+     * Turn a best archetype match into a LabelResult
      *
-     * @param v1: First vector
-     * @param v2: Second vector
-     * @return Cosine similarity (0 to 1)
+     * @param bestLabel: Best-scoring archetype
+     * @param bestScore: Its clamped cosine score
+     * @param previousLabel: Label to compare against for stability
+     * @param labelThreshold: Scores below this are "Unclassified"
      */
-    static double cosineSimilarity(
-        const Eigen::VectorXd& v1,
-        const Eigen::VectorXd& v2
+    static LabelResult resolveLabel(
+        const std::string& bestLabel,
+        double bestScore,
+        const LabelResult& previousLabel,
+        double labelThreshold
     );
 };
 
@@ -0,0 +1,313 @@
+//
+//  MonteCarloRisk.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the Monte Carlo VaR / ES engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "MonteCarloRisk.hpp"
+#include "HistoricalSimulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+// ===== Philox4x32 Implementation =====
+
+Philox4x32::Counter Philox4x32::generate(Counter counter, Key key) {
+    constexpr uint32_t MULTIPLIER_0 = 0xD2511F53u;
+    constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57u;
+    constexpr uint32_t WEYL_0 = 0x9E3779B9u;
+    constexpr uint32_t WEYL_1 = 0xBB67AE85u;
+
+    for (int round = 0; round < 10; round++) {
+        const uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * counter[0];
+        const uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * counter[2];
+        counter = {
+            static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+            static_cast<uint32_t>(product1),
+            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+            static_cast<uint32_t>(product0)
+        };
+        key[0] += WEYL_0;
+        key[1] += WEYL_1;
+    }
+    return counter;
+}
+
+namespace {
+
+constexpr double TWO_PI = 6.283185307179586;
+
+// Uniforms and normals for one path, read from consecutive Philox counters
+class PathStream {
+public:
+    PathStream(Philox4x32::Key key, uint64_t path)
+        : key_(key),
+          pathLow_(static_cast<uint32_t>(path)),
+          pathHigh_(static_cast<uint32_t>(path >> 32)) {}
+
+    double uniform() {
+        if (next_ == uniforms_.size()) {
+            refill();
+        }
+        return uniforms_[next_++];
+    }
+
+    // Box–Muller; the second normal of each pair is kept for the next call
+    double normal() {
+        if (hasSpare_) {
+            hasSpare_ = false;
+            return spare_;
+        }
+        const double radius = std::sqrt(-2.0 * std::log(uniform()));
+        const double angle = TWO_PI * uniform();
+        spare_ = radius * std::sin(angle);
+        hasSpare_ = true;
+        return radius * std::cos(angle);
+    }
+
+private:
+    void refill() {
+        const Philox4x32::Counter bits = Philox4x32::generate({call_++, pathLow_, pathHigh_, 0u}, key_);
+        uniforms_[0] = toUnit((static_cast<uint64_t>(bits[0]) << 32) | bits[1]);
+        uniforms_[1] = toUnit((static_cast<uint64_t>(bits[2]) << 32) | bits[3]);
+        next_ = 0;
+    }
+
+    // Top 53 bits → (0, 1); never exactly 0, so log() stays finite
+    static double toUnit(uint64_t bits) {
+        return (static_cast<double>(bits >> 11) + 0.5) * 0x1.0p-53;
+    }
+
+    Philox4x32::Key key_;
+    uint32_t pathLow_;
+    uint32_t pathHigh_;
+    uint32_t call_ = 0;
+    std::array<double, 2> uniforms_{};
+    size_t next_ = 2;
+    double spare_ = 0.0;
+    bool hasSpare_ = false;
+};
+
+// Marsaglia–Tsang Gamma(shape, 1) for shape ≥ 1
+double gammaVariate(PathStream& stream, double shape) {
+    const double d = shape - 1.0 / 3.0;
+    const double c = 1.0 / std::sqrt(9.0 * d);
+    while (true) {
+        double z = 0.0;
+        double v = 0.0;
+        do {
+            z = stream.normal();
+            v = 1.0 + c * z;
+        } while (v <= 0.0);
+        v = v * v * v;
+        if (std::log(stream.uniform()) < 0.5 * z * z + d - d * v + d * std::log(v)) {
+            return d * v;
+        }
+    }
+}
+
+}  // namespace
+
+// ===== MonteCarloRisk Implementation =====
+
+MonteCarloRiskResult MonteCarloRisk::simulate(
+    const Eigen::VectorXd& assetSensitivities,
+    const MacroFactors& factors,
+    double notional,
+    const MonteCarloOptions& options)
+{
+    const Eigen::Index N = assetSensitivities.size();
+    if (N != static_cast<Eigen::Index>(factors.indicatorNames.size()) || N != factors.loadings.rows()) {
+        throw std::invalid_argument("Asset sensitivities size must match number of indicators");
+    }
+    if (factors.numFactors < 1 || factors.factorVariances.size() != static_cast<size_t>(factors.numFactors)) {
+        throw std::invalid_argument("Factors must have at least 1 factor with a variance each");
+    }
+    if (!std::isfinite(notional)) {
+        throw std::invalid_argument("Notional must be finite");
+    }
+    if (options.numPaths == 0) {
+        throw std::invalid_argument("Monte Carlo needs at least one path");
+    }
+    if (options.confidenceLevels.empty()) {
+        throw std::invalid_argument("At least one confidence level is required");
+    }
+    for (double confidence : options.confidenceLevels) {
+        if (!(confidence > 0.0 && confidence < 1.0)) {
+            throw std::invalid_argument("Confidence levels must lie in (0, 1)");
+        }
+    }
+    const bool studentT = options.innovations == InnovationDistribution::StudentT;
+    if (studentT && !(std::isfinite(options.degreesOfFreedom) && options.degreesOfFreedom > 2.0)) {
+        throw std::invalid_argument("Student-t innovations need degrees of freedom > 2");
+    }
+
+    // Regime mixture as a cumulative distribution over multipliers
+    std::vector<double> regimeCumulative;
+    std::vector<double> regimeMultipliers;
+    double totalProbability = 0.0;
+    for (const VolatilityRegime& regime : options.regimes) {
+        if (!(regime.probability >= 0.0) || !(regime.volatilityMultiplier >= 0.0) ||
+            !std::isfinite(regime.probability) || !std::isfinite(regime.volatilityMultiplier)) {
+            throw std::invalid_argument("Regime probabilities and multipliers must be finite and non-negative");
+        }
+        totalProbability += regime.probability;
+        regimeCumulative.push_back(totalProbability);
+        regimeMultipliers.push_back(regime.volatilityMultiplier);
+    }
+    if (!options.regimes.empty()) {
+        if (totalProbability <= 0.0) {
+            throw std::invalid_argument("Regime probabilities must not all be zero");
+        }
+        for (double& cumulative : regimeCumulative) {
+            cumulative /= totalProbability;
+        }
+    }
+
+    // Per-path P&L is notional · s · (Σ_k γ_k σ_k z_k + √(βᵀ Σ_u β) z_0)
+    const Eigen::Index K = factors.numFactors;
+    const Eigen::VectorXd gamma = factors.loadings.transpose() * assetSensitivities;
+    Eigen::VectorXd factorScales(K);
+    for (Eigen::Index k = 0; k < K; k++) {
+        factorScales(k) = gamma(k) * std::sqrt(std::max(0.0, factors.factorVariances[k]));
+    }
+    double residualVariance = 0.0;
+    if (factors.residualCovariance.rows() == N && factors.residualCovariance.cols() == N) {
+        residualVariance = assetSensitivities.dot(factors.residualCovariance * assetSensitivities);
+    } else if (factors.uniquenesses.size() == N) {
+        residualVariance = assetSensitivities.cwiseAbs2().dot(factors.uniquenesses);
+    }
+    const double residualScale = std::sqrt(std::max(0.0, residualVariance));
+
+    const size_t numPaths = options.numPaths;
+    const Philox4x32::Key key = {static_cast<uint32_t>(options.seed), static_cast<uint32_t>(options.seed >> 32)};
+    const double gammaShape = 0.5 * options.degreesOfFreedom;
+    const double tScale = options.degreesOfFreedom - 2.0;
+
+    size_t maxTail = 0;
+    for (double confidence : options.confidenceLevels) {
+        maxTail = std::max(maxTail, tailCount(confidence, numPaths));
+    }
+
+    int numThreads = options.numThreads;
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    numThreads = static_cast<int>(std::min<size_t>(static_cast<size_t>(numThreads), numPaths));
+
+    std::vector<double> losses(numPaths);
+    std::vector<double> pnlSums(numThreads, 0.0);
+    std::vector<double> pnlSquareSums(numThreads, 0.0);
+    std::vector<double> localThresholds(numThreads, -std::numeric_limits<double>::infinity());
+    auto sliceBegin = [&](int t) { return numPaths * static_cast<size_t>(t) / static_cast<size_t>(numThreads); };
+
+    // Phase 1: each worker simulates a contiguous slice and moves its worst maxTail losses to the front
+    auto worker = [&](int t) {
+        const size_t begin = sliceBegin(t);
+        const size_t end = sliceBegin(t + 1);
+        double sum = 0.0;
+        double sumSquares = 0.0;
+
+        for (size_t path = begin; path < end; path++) {
+            PathStream stream(key, path);
+            double scale = notional;
+            if (!regimeCumulative.empty()) {
+                const double u = stream.uniform();
+                const size_t regime = static_cast<size_t>(
+                    std::upper_bound(regimeCumulative.begin(), regimeCumulative.end() - 1, u) - regimeCumulative.begin());
+                scale *= regimeMultipliers[regime];
+            }
+            if (studentT) {
+                scale *= std::sqrt(tScale / (2.0 * gammaVariate(stream, gammaShape)));
+            }
+
+            double pnl = 0.0;
+            for (Eigen::Index k = 0; k < K; k++) {
+                pnl += factorScales(k) * stream.normal();
+            }
+            pnl += residualScale * stream.normal();
+            pnl *= scale;
+
+            losses[path] = -pnl;
+            sum += pnl;
+            sumSquares += pnl * pnl;
+        }
+
+        const size_t sliceSize = end - begin;
+        const size_t localTail = std::min(maxTail, sliceSize);
+        if (localTail > 0) {
+            auto first = losses.begin() + static_cast<std::ptrdiff_t>(begin);
+            std::nth_element(first, first + static_cast<std::ptrdiff_t>(localTail - 1),
+                             losses.begin() + static_cast<std::ptrdiff_t>(end), std::greater<double>());
+            if (sliceSize >= maxTail) {
+                localThresholds[t] = *(first + static_cast<std::ptrdiff_t>(localTail - 1));
+            }
+        }
+        pnlSums[t] = sum;
+        pnlSquareSums[t] = sumSquares;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; t++) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);  // The calling thread works too
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    // Phase 2: the global top maxTail is within every slice's local top maxTail, and
+    // none of it lies below the largest local threshold
+    const double threshold = *std::max_element(localThresholds.begin(), localThresholds.end());
+    std::vector<double> candidates;
+    for (int t = 0; t < numThreads; t++) {
+        const size_t begin = sliceBegin(t);
+        const size_t localTail = std::min(maxTail, sliceBegin(t + 1) - begin);
+        for (size_t i = begin; i < begin + localTail; i++) {
+            if (losses[i] >= threshold) {
+                candidates.push_back(losses[i]);
+            }
+        }
+    }
+
+    // Deepest tail first; each selection narrows the prefix for the next
+    std::vector<size_t> order(options.confidenceLevels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return options.confidenceLevels[a] < options.confidenceLevels[b];
+    });
+
+    MonteCarloRiskResult result;
+    result.confidenceLevels = options.confidenceLevels;
+    result.valueAtRisk.resize(order.size());
+    result.expectedShortfall.resize(order.size());
+    size_t prefix = candidates.size();
+    for (size_t level : order) {
+        const size_t m = tailCount(options.confidenceLevels[level], numPaths);
+        std::nth_element(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(m - 1),
+                         candidates.begin() + static_cast<std::ptrdiff_t>(prefix), std::greater<double>());
+        result.valueAtRisk[level] = candidates[m - 1];
+        result.expectedShortfall[level] =
+            std::accumulate(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(m), 0.0) /
+            static_cast<double>(m);
+        prefix = m;
+    }
+
+    const double n = static_cast<double>(numPaths);
+    const double sum = std::accumulate(pnlSums.begin(), pnlSums.end(), 0.0);
+    const double sumSquares = std::accumulate(pnlSquareSums.begin(), pnlSquareSums.end(), 0.0);
+    result.meanPnl = sum / n;
+    result.pnlVolatility = numPaths > 1
+        ? std::sqrt(std::max(0.0, (sumSquares - n * result.meanPnl * result.meanPnl) / (n - 1.0)))
+        : 0.0;
+    result.numPaths = numPaths;
+
+    return result;
+}
@@ -0,0 +1,178 @@
+//
+//  PairwiseCovariance.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the pairwise-complete covariance kernel
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "PairwiseCovariance.hpp"
+#include <Eigen/Eigenvalues>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+// ===== ValidityMask Implementation =====
+
+ValidityMask::ValidityMask(size_t observations, size_t indicators)
+    : observations_(observations),
+      indicators_(indicators),
+      wordsPerColumn_((observations + 63) / 64),
+      words_(wordsPerColumn_ * indicators, 0) {}
+
+void ValidityMask::set(size_t observation, size_t indicator) {
+    words_[indicator * wordsPerColumn_ + observation / 64] |= uint64_t{1} << (observation % 64);
+}
+
+bool ValidityMask::test(size_t observation, size_t indicator) const {
+    return (column(indicator)[observation / 64] >> (observation % 64)) & 1u;
+}
+
+size_t ValidityMask::overlap(size_t indicatorA, size_t indicatorB) const {
+    const uint64_t* a = column(indicatorA);
+    const uint64_t* b = column(indicatorB);
+    size_t common = 0;
+    for (size_t w = 0; w < wordsPerColumn_; w++) {
+        common += static_cast<size_t>(std::popcount(a[w] & b[w]));
+    }
+    return common;
+}
+
+// ===== PairwiseCovariance Implementation =====
+
+CovarianceMatrix PairwiseCovariance::compute(
+    const std::map<std::string, std::vector<double>>& data,
+    const PairwiseCovarianceOptions& options,
+    PairwiseCovarianceDiagnostics* diagnostics)
+{
+    if (data.empty()) {
+        throw std::invalid_argument("Data map cannot be empty");
+    }
+    if (options.minPairObservations < 2) {
+        throw std::invalid_argument("minPairObservations must be at least 2");
+    }
+
+    const size_t T = data.begin()->second.size();
+    const size_t N = data.size();
+    std::vector<std::string> indicatorNames;
+    indicatorNames.reserve(N);
+
+    // Validity bitmasks, and Y = x − (observed mean) with missing entries 0.
+    // The shift leaves every pairwise covariance unchanged but keeps S − A Aᵀ/n well conditioned.
+    ValidityMask mask(T, N);
+    Eigen::MatrixXd shifted = Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(T), static_cast<Eigen::Index>(N));
+    Eigen::MatrixXd validity = Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(T), static_cast<Eigen::Index>(N));
+
+    size_t column = 0;
+    for (const auto& [indicator, values] : data) {
+        if (values.size() != T) {
+            throw std::invalid_argument(
+                "All indicators must have the same number of observations (pad with NaN). "
+                "Expected " + std::to_string(T) + ", got " + std::to_string(values.size()) + " for " + indicator
+            );
+        }
+
+        double sum = 0.0;
+        size_t observed = 0;
+        for (size_t t = 0; t < T; t++) {
+            if (std::isnan(values[t])) {
+                continue;
+            }
+            if (!std::isfinite(values[t])) {
+                throw std::invalid_argument(
+                    "Infinite value in indicator '" + indicator + "' at index " + std::to_string(t));
+            }
+            mask.set(t, column);
+            sum += values[t];
+            observed++;
+        }
+        if (observed < options.minPairObservations) {
+            throw std::invalid_argument(
+                "Indicator '" + indicator + "' has only " + std::to_string(observed) + " observations");
+        }
+
+        const double mean = sum / static_cast<double>(observed);
+        for (size_t t = 0; t < T; t++) {
+            if (mask.test(t, column)) {
+                shifted(t, column) = values[t] - mean;
+                validity(t, column) = 1.0;
+            }
+        }
+
+        indicatorNames.push_back(indicator);
+        column++;
+    }
+
+    // Masked cross-products as two GEMMs: S = Yᵀ Y, A = Yᵀ V
+    Eigen::MatrixXd crossProducts(N, N);
+    crossProducts.setZero();
+    crossProducts.selfadjointView<Eigen::Lower>().rankUpdate(shifted.transpose());
+    Eigen::MatrixXd maskedSums = shifted.transpose() * validity;
+
+    Eigen::MatrixXd covariance(N, N);
+    Eigen::MatrixXi pairObservations(N, N);
+    for (size_t j = 0; j < N; j++) {
+        for (size_t i = j; i < N; i++) {
+            const size_t common = mask.overlap(i, j);
+            if (common < options.minPairObservations) {
+                throw std::invalid_argument(
+                    "Indicators '" + indicatorNames[i] + "' and '" + indicatorNames[j] + "' share only " +
+                    std::to_string(common) + " observations");
+            }
+
+            const double n = static_cast<double>(common);
+            const double value = (crossProducts(i, j) - maskedSums(i, j) * maskedSums(j, i) / n) / (n - 1.0);
+            covariance(i, j) = value;
+            covariance(j, i) = value;
+            pairObservations(i, j) = static_cast<int>(common);
+            pairObservations(j, i) = static_cast<int>(common);
+        }
+    }
+
+    for (size_t i = 0; i < N; i++) {
+        covariance(i, i) = std::max(covariance(i, i), 0.0);
+    }
+
+    PairwiseCovarianceDiagnostics result;
+    if (options.repairPsd || diagnostics != nullptr) {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(covariance, Eigen::EigenvaluesOnly);
+        result.minEigenvalue = solver.eigenvalues().minCoeff();
+    }
+    if (options.repairPsd && result.minEigenvalue < 0.0) {
+        Eigen::MatrixXd repaired = repairPsd(covariance, options.eigenvalueFloor);
+        result.repaired = true;
+        result.repairDistance = (repaired - covariance).norm();
+        covariance = std::move(repaired);
+    }
+
+    if (diagnostics != nullptr) {
+        result.pairObservations = std::move(pairObservations);
+        *diagnostics = std::move(result);
+    }
+    return CovarianceMatrix(covariance, indicatorNames);
+}
+
+Eigen::MatrixXd PairwiseCovariance::repairPsd(const Eigen::MatrixXd& covariance, double eigenvalueFloor) {
+    if (covariance.rows() != covariance.cols()) {
+        throw std::invalid_argument("Covariance matrix must be square");
+    }
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(covariance);
+    if (solver.info() != Eigen::Success) {
+        throw std::runtime_error("Eigendecomposition failed during PSD repair");
+    }
+
+    const Eigen::VectorXd variances = covariance.diagonal();
+    const double floor = eigenvalueFloor * std::max(variances.mean(), 1e-300);
+    Eigen::VectorXd clipped = solver.eigenvalues().cwiseMax(floor);
+    Eigen::MatrixXd repaired = solver.eigenvectors() * clipped.asDiagonal() * solver.eigenvectors().transpose();
+
+    // D Σ D with D = diag(√(σ²_i / Σ_ii)) keeps PSD and restores each variance
+    Eigen::VectorXd scale(variances.size());
+    for (Eigen::Index i = 0; i < variances.size(); i++) {
+        scale(i) = repaired(i, i) > 0.0 ? std::sqrt(variances(i) / repaired(i, i)) : 0.0;
+    }
+    repaired = scale.asDiagonal() * repaired * scale.asDiagonal();
+    return 0.5 * (repaired + repaired.transpose());
+}
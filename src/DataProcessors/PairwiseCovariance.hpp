@@ -0,0 +1,130 @@
+//
+//  PairwiseCovariance.hpp
+//  InvertedYieldCurveTrader
+//
+//  Pairwise-complete covariance for panels with gaps and ragged starts.
+//  Validity is tracked as bitmask columns; the masked cross-products are
+//  Eigen GEMMs, with an optional projection back onto the PSD cone.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef PAIRWISE_COVARIANCE_HPP
+#define PAIRWISE_COVARIANCE_HPP
+
+#include "CovarianceCalculator.hpp"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * ValidityMask: One bit per observation per indicator (1 = observed)
+ */
+class ValidityMask {
+public:
+    /**
+     * @param observations: T
+     * @param indicators: N
+     */
+    ValidityMask(size_t observations, size_t indicators);
+
+    void set(size_t observation, size_t indicator);
+    bool test(size_t observation, size_t indicator) const;
+
+    /**
+     * Observations where both indicators are valid (AND + popcount over the words)
+     */
+    size_t overlap(size_t indicatorA, size_t indicatorB) const;
+
+    /**
+     * Observations where the indicator is valid
+     */
+    size_t count(size_t indicator) const { return overlap(indicator, indicator); }
+
+    size_t observations() const { return observations_; }
+    size_t indicators() const { return indicators_; }
+
+private:
+    const uint64_t* column(size_t indicator) const { return words_.data() + indicator * wordsPerColumn_; }
+
+    size_t observations_;
+    size_t indicators_;
+    size_t wordsPerColumn_;
+    std::vector<uint64_t> words_;       // Column-major: indicator i owns words [i·W, (i+1)·W)
+};
+
+/**
+ * PairwiseCovarianceOptions: Overlap requirement and PSD repair
+ */
+struct PairwiseCovarianceOptions {
+    size_t minPairObservations = 2;     // Fewer common observations for any pair → throw
+    bool repairPsd = true;              // Project onto the PSD cone if any eigenvalue < 0
+    double eigenvalueFloor = 1e-10;     // Clip floor, relative to the mean variance
+};
+
+/**
+ * PairwiseCovarianceDiagnostics: What the estimator did
+ */
+struct PairwiseCovarianceDiagnostics {
+    Eigen::MatrixXi pairObservations;   // N × N common-observation counts
+    double minEigenvalue = 0.0;         // Before repair
+    bool repaired = false;              // PSD projection applied
+    double repairDistance = 0.0;        // ‖Σ_repaired − Σ_pairwise‖_F
+};
+
+/**
+ * PairwiseCovariance: Covariance from every pair's common observations
+ *
+ * Each entry (i, j) is the unbiased sample covariance over the dates where
+ * both i and j are observed, with means taken over that same overlap. With
+ * no missing values this is exactly CovarianceCalculator's estimator. With
+ * gaps or ragged starts nothing is truncated to the shortest common window.
+ *
+ * Missing values are NaN. Series must have equal length: pad late starters
+ * with leading NaNs. Every entry comes from three sums over the overlap. Let
+ * Y be the column-shifted data with missing entries set to 0, and V its 0/1
+ * validity matrix:
+ *   S = Yᵀ Y   (Σ y_i y_j)
+ *   A = Yᵀ V   (Σ y_i over the dates where j is valid)
+ *   n_ij       (popcount of the ANDed validity bitmasks)
+ *   cov_ij = (S_ij − A_ij A_ji / n_ij) / (n_ij − 1)
+ * S and A are Eigen's blocked, vectorized GEMM. The per-pair loop only
+ * touches the N × N results.
+ *
+ * Pairwise estimates need not be jointly PSD. With repairPsd, negative
+ * eigenvalues are clipped to a small floor and the matrix is rescaled so
+ * the diagonal (each variance) is unchanged.
+ */
+class PairwiseCovariance {
+public:
+    /**
+     * Pairwise-complete covariance of a NaN-padded panel
+     *
+     * @param data: Map of indicator → series (equal lengths, NaN = missing); names are sorted
+     * @param options: Minimum overlap, PSD repair
+     * @param diagnostics: If non-null, receives overlap counts and repair details
+     * @return CovarianceMatrix usable wherever the complete-data estimate is
+     * @throws std::invalid_argument on empty input, unequal lengths, infinities or too little overlap
+     */
+    static CovarianceMatrix compute(
+        const std::map<std::string, std::vector<double>>& data,
+        const PairwiseCovarianceOptions& options = PairwiseCovarianceOptions(),
+        PairwiseCovarianceDiagnostics* diagnostics = nullptr
+    );
+
+    /**
+     * Nearest-in-spirit PSD matrix with the same diagonal
+     *
+     * Clips eigenvalues below floor · mean(diag) and rescales rows and columns
+     * to restore the original variances.
+     *
+     * @param covariance: Symmetric N × N
+     * @param eigenvalueFloor: Relative clip floor
+     * @return Repaired matrix
+     */
+    static Eigen::MatrixXd repairPsd(const Eigen::MatrixXd& covariance, double eigenvalueFloor = 1e-10);
+};
+
+#endif // PAIRWISE_COVARIANCE_HPP
@@ -97,6 +97,64 @@ RiskDecomposition PortfolioRiskAnalyzer::analyzeRisk(
     return result;
 }
 
+void PortfolioRiskAnalyzer::analyzeRiskBatch(
+    const Eigen::MatrixXd& assetSensitivities,
+    const MacroFactors& factors,
+    BatchRiskDecomposition& result)
+{
+    if (assetSensitivities.rows() != static_cast<Eigen::Index>(factors.indicatorNames.size()) ||
+        assetSensitivities.rows() != factors.loadings.rows()) {
+        throw std::invalid_argument("Asset sensitivities rows must match number of indicators");
+    }
+    if (factors.numFactors < 1 || factors.factorVariances.size() != static_cast<size_t>(factors.numFactors)) {
+        throw std::invalid_argument("Factors must have at least 1 factor with a variance each");
+    }
+
+    const Eigen::Index K = factors.numFactors;
+    const Eigen::Index P = assetSensitivities.cols();
+    const Eigen::Map<const Eigen::VectorXd> factorVariances(factors.factorVariances.data(), K);
+
+    // resize() is a no-op when the shape is unchanged
+    result.factorSensitivities.resize(K, P);
+    result.factorRiskContributions.resize(K, P);
+    result.marginalRiskContributions.resize(K, P);
+    result.componentContributions.resize(K, P);
+    result.totalVariance.resize(P);
+    result.totalRisk.resize(P);
+    result.residualVariance.resize(P);
+
+    // GEMM 1: Γ = Bᵀ β
+    result.factorSensitivities.noalias() = factors.loadings.transpose() * assetSensitivities;
+
+    // Σ_f diagonal: Σ_f Γ is a row scaling, stored as MRC / 2
+    result.marginalRiskContributions.noalias() = factorVariances.asDiagonal() * result.factorSensitivities;
+    result.factorRiskContributions = result.factorSensitivities.cwiseProduct(result.marginalRiskContributions);
+    result.marginalRiskContributions *= 2.0;
+
+    result.totalVariance.noalias() = result.factorRiskContributions.colwise().sum().transpose();
+    result.totalRisk = result.totalVariance.cwiseMax(0.0).cwiseSqrt();
+
+    for (Eigen::Index p = 0; p < P; p++) {
+        if (result.totalVariance(p) > 1e-10) {
+            result.componentContributions.col(p) = result.factorRiskContributions.col(p) / result.totalVariance(p);
+        } else {
+            result.componentContributions.col(p).setZero();
+        }
+    }
+
+    // GEMM 2: residual β_pᵀ Σ_u β_p for every portfolio
+    const Eigen::Index N = assetSensitivities.rows();
+    if (factors.residualCovariance.rows() == N && factors.residualCovariance.cols() == N) {
+        result.residualVariance.noalias() =
+            (factors.residualCovariance * assetSensitivities).cwiseProduct(assetSensitivities).colwise().sum().transpose();
+    } else if (factors.uniquenesses.size() == N) {
+        result.residualVariance.noalias() =
+            (factors.uniquenesses.asDiagonal() * assetSensitivities).cwiseProduct(assetSensitivities).colwise().sum().transpose();
+    } else {
+        result.residualVariance.setZero();
+    }
+}
+
 double PortfolioRiskAnalyzer::scenarioShockImpact(
     const Eigen::VectorXd& assetSensitivities,
     const Eigen::VectorXd& shockVector,
@@ -134,69 +192,98 @@ RiskDecomposition PortfolioRiskAnalyzer::explainHistoricalDrawdown(
         throw std::invalid_argument("Returns and shocks must have same length");
     }
 
-    int T = portfolioReturns.size();
-    int K = factorShocks[0].size();
+    const Eigen::Index T = static_cast<Eigen::Index>(portfolioReturns.size());
+    const Eigen::Index K = static_cast<Eigen::Index>(factorShocks[0].size());
 
     if (factorLabels.size() != static_cast<size_t>(K)) {
         throw std::invalid_argument("Factor labels size must match shock dimensions");
     }
 
-    // Perform OLS regression: r_t = γ^T f_t + ε_t
-    auto [gamma, rsquared] = regressRiskDecomposition(portfolioReturns, factorShocks);
-
-    // Compute historical average factor covariance
-    Eigen::MatrixXd covF = Eigen::MatrixXd::Zero(K, K);
-    for (int t = 0; t < T; t++) {
-        for (int k = 0; k < K; k++) {
-            for (int j = 0; j < K; j++) {
-                covF(k, j) += factorShocks[t][k] * factorShocks[t][j];
-            }
+    // Pack the rows once into a contiguous T × K matrix
+    Eigen::MatrixXd shocks(T, K);
+    for (Eigen::Index t = 0; t < T; t++) {
+        if (factorShocks[t].size() != static_cast<size_t>(K)) {
+            throw std::invalid_argument("Every shock row must have one value per factor");
         }
+        shocks.row(t) = Eigen::Map<const Eigen::RowVectorXd>(factorShocks[t].data(), K);
     }
-    covF /= T;
 
-    // Compute risk contributions RC_k = γ_k (Σ_f γ)_k
-    Eigen::VectorXd sigmaGamma = covF * gamma;
-    std::vector<double> riskContributions(K);
-    double totalVariance = 0.0;
+    return explainHistoricalDrawdown(
+        Eigen::Map<const Eigen::VectorXd>(portfolioReturns.data(), T), shocks, factorLabels);
+}
 
-    for (int k = 0; k < K; k++) {
-        riskContributions[k] = gamma(k) * sigmaGamma(k);
-        totalVariance += riskContributions[k];
+RiskDecomposition PortfolioRiskAnalyzer::explainHistoricalDrawdown(
+    const Eigen::Ref<const Eigen::VectorXd>& portfolioReturns,
+    const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+    const std::vector<std::string>& factorLabels)
+{
+    if (portfolioReturns.size() == 0) {
+        throw std::invalid_argument("Portfolio returns cannot be empty");
     }
 
-    // Compute component contributions
-    std::vector<double> componentContributions(K);
-    for (int k = 0; k < K; k++) {
-        if (totalVariance > 1e-10) {
-            componentContributions[k] = riskContributions[k] / totalVariance;
-        } else {
-            componentContributions[k] = 0.0;
-        }
+    if (factorShocks.rows() != portfolioReturns.size()) {
+        throw std::invalid_argument("Returns and shocks must have same length");
     }
 
-    // Compute portfolio variance over period
-    double portfolioVariance = 0.0;
-    double portfolioMeanReturn = std::accumulate(portfolioReturns.begin(),
-                                                 portfolioReturns.end(), 0.0) / T;
-    for (double r : portfolioReturns) {
-        portfolioVariance += (r - portfolioMeanReturn) * (r - portfolioMeanReturn);
+    if (factorLabels.size() != static_cast<size_t>(factorShocks.cols())) {
+        throw std::invalid_argument("Factor labels size must match shock dimensions");
     }
-    portfolioVariance /= T;
-    double portfolioRisk = std::sqrt(std::max(0.0, portfolioVariance));
 
-    // Construct result
-    RiskDecomposition result;
-    result.factorSensitivities = std::vector<double>(gamma.data(), gamma.data() + K);
-    result.factorRiskContributions = riskContributions;
-    result.factorLabels = factorLabels;
-    result.totalRisk = portfolioRisk;
-    result.totalVariance = portfolioVariance;
-    result.componentContributions = componentContributions;
-    result.varianceExplained = rsquared;
-    result.numFactors = K;
+    // OLS r_t = γᵀ f_t + ε_t from XᵀX and Xᵀy
+    DrawdownRegression regression(factorLabels);
+    regression.addBlock(factorShocks, portfolioReturns);
+    return regression.decomposition();
+}
 
-    return result;
+std::vector<RiskDecomposition> PortfolioRiskAnalyzer::rollingDrawdownAttribution(
+    const Eigen::Ref<const Eigen::VectorXd>& portfolioReturns,
+    const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+    const std::vector<std::string>& factorLabels,
+    size_t windowLength,
+    size_t minObservations)
+{
+    if (factorShocks.rows() != portfolioReturns.size()) {
+        throw std::invalid_argument("Returns and shocks must have same length");
+    }
+
+    if (factorLabels.size() != static_cast<size_t>(factorShocks.cols())) {
+        throw std::invalid_argument("Factor labels size must match shock dimensions");
+    }
+
+    const size_t T = static_cast<size_t>(portfolioReturns.size());
+    const size_t first = minObservations > 0 ? minObservations
+                       : windowLength > 0   ? windowLength
+                                            : factorLabels.size() + 1;
+    if (first > T) {
+        throw std::invalid_argument("Need at least " + std::to_string(first) +
+                                    " observations, got " + std::to_string(T));
+    }
+
+    DrawdownRegression regression(factorLabels);
+    std::vector<RiskDecomposition> results;
+    results.reserve(T - first + 1);
+
+    for (size_t t = 0; t < T; t++) {
+        const Eigen::Index row = static_cast<Eigen::Index>(t);
+        regression.add(factorShocks.row(row).transpose(), portfolioReturns(row));
+        if (windowLength > 0 && t >= windowLength) {
+            const Eigen::Index oldest = static_cast<Eigen::Index>(t - windowLength);
+            regression.remove(factorShocks.row(oldest).transpose(), portfolioReturns(oldest));
+
+            // Rebuild from the window once per full slide so add/remove rounding never accumulates
+            if ((t + 1) % windowLength == 0) {
+                const Eigen::Index start = oldest + 1;
+                const Eigen::Index length = static_cast<Eigen::Index>(windowLength);
+                regression.reset();
+                regression.addBlock(factorShocks.middleRows(start, length), portfolioReturns.segment(start, length));
+            }
+        }
+        if (t + 1 >= first) {
+            results.push_back(regression.decomposition());
+        }
+    }
+
+    return results;
 }
 
 std::vector<RiskDecomposition> PortfolioRiskAnalyzer::rollingRiskDecomposition(
@@ -298,48 +385,312 @@ RiskDecomposition PortfolioRiskAnalyzer::riskBudgetingAllocation(
     return result;
 }
 
-std::pair<Eigen::VectorXd, double> PortfolioRiskAnalyzer::regressRiskDecomposition(
-    const std::vector<double>& portfolioReturns,
-    const std::vector<std::vector<double>>& factorShocks)
+RiskDecomposition PortfolioRiskAnalyzer::riskBudgetingAllocation(
+    double targetRiskLevel,
+    const Eigen::MatrixXd& factorCovariance,
+    const Eigen::VectorXd& budgets,
+    const std::vector<std::string>& factorLabels,
+    const std::vector<double>& previousSensitivities)
 {
-    int T = portfolioReturns.size();
-    int K = factorShocks[0].size();
+    if (!(targetRiskLevel > 0.0)) {
+        throw std::invalid_argument("Target risk level must be positive");
+    }
+    if (factorLabels.size() != static_cast<size_t>(budgets.size())) {
+        throw std::invalid_argument("Factor labels must match the budgets");
+    }
 
-    // Build design matrix X (T × K) from factor shocks
-    Eigen::MatrixXd X(T, K);
-    for (int t = 0; t < T; t++) {
-        for (int k = 0; k < K; k++) {
-            X(t, k) = factorShocks[t][k];
+    const int K = static_cast<int>(budgets.size());
+    Eigen::VectorXd warmStart;
+    if (previousSensitivities.size() == static_cast<size_t>(K)) {
+        warmStart = Eigen::Map<const Eigen::VectorXd>(previousSensitivities.data(), K);
+    }
+    RiskBudgetSolution solution = solveRiskBudget(factorCovariance, budgets, warmStart);
+
+    Eigen::VectorXd gamma = solution.weights * (targetRiskLevel / solution.volatility);
+    Eigen::VectorXd sigmaGamma = factorCovariance * gamma;
+    const double portfolioVariance = gamma.dot(sigmaGamma);
+
+    RiskDecomposition result;
+    result.factorSensitivities.assign(gamma.data(), gamma.data() + K);
+    result.factorRiskContributions.resize(K);
+    result.marginalRiskContributions.resize(K);
+    result.componentContributions.assign(solution.riskContributions.data(), solution.riskContributions.data() + K);
+    for (int k = 0; k < K; k++) {
+        result.factorRiskContributions[k] = gamma(k) * sigmaGamma(k);
+        result.marginalRiskContributions[k] = 2.0 * sigmaGamma(k);
+    }
+    result.factorLabels = factorLabels;
+    result.totalRisk = std::sqrt(portfolioVariance);
+    result.totalVariance = portfolioVariance;
+    result.residualRisk = 0.0;
+    result.varianceExplained = 1.0;
+    result.numFactors = K;
+
+    return result;
+}
+
+RiskBudgetSolution PortfolioRiskAnalyzer::solveRiskBudget(
+    const Eigen::MatrixXd& covariance,
+    const Eigen::VectorXd& budgets,
+    const Eigen::VectorXd& warmStart,
+    const RiskBudgetOptions& options)
+{
+    const Eigen::Index n = budgets.size();
+    if (n == 0 || covariance.rows() != n || covariance.cols() != n) {
+        throw std::invalid_argument("Covariance must be square and match the budgets");
+    }
+    if (!covariance.allFinite() || (covariance.diagonal().array() <= 0.0).any()) {
+        throw std::invalid_argument("Covariance must be finite with positive variances");
+    }
+    if (!budgets.allFinite() || (budgets.array() <= 0.0).any()) {
+        throw std::invalid_argument("Risk budgets must be positive");
+    }
+    if (warmStart.size() != 0 && warmStart.size() != n) {
+        throw std::invalid_argument("Warm start must match the budgets");
+    }
+
+    const Eigen::VectorXd b = budgets / budgets.sum();
+
+    // Start from yesterday if it is usable, else from inverse volatility
+    Eigen::VectorXd y;
+    if (warmStart.size() == n && warmStart.allFinite() && (warmStart.array() > 0.0).all()) {
+        y = warmStart;
+    } else {
+        y = covariance.diagonal().array().rsqrt();
+    }
+    // Best point on the ray: f(t y) is minimized at t² = Σb / yᵀΣy = 1 / yᵀΣy
+    y /= std::sqrt(y.dot(covariance * y));
+
+    RiskBudgetSolution solution;
+    solution.iterations = 0;
+    solution.converged = false;
+
+    // f(y) = ½ yᵀΣy − bᵀ log y
+    auto objective = [&](const Eigen::VectorXd& point, const Eigen::VectorXd& sigmaPoint) {
+        return 0.5 * point.dot(sigmaPoint) - (b.array() * point.array().log()).sum();
+    };
+
+    Eigen::VectorXd sigmaY = covariance * y;
+    Eigen::VectorXd trial(n);
+    Eigen::VectorXd sigmaTrial(n);
+    Eigen::MatrixXd hessian(n, n);
+    Eigen::LLT<Eigen::MatrixXd> llt(n);
+    while (true) {
+        const double variance = y.dot(sigmaY);
+        solution.budgetError = ((y.array() * sigmaY.array()) / variance - b.array()).abs().maxCoeff();
+        if (solution.budgetError <= options.tolerance && (y.array() > 0.0).all()) {
+            solution.converged = true;
+            break;
+        }
+        if (solution.iterations >= options.maxIterations) {
+            break;
+        }
+
+        // ∇f = Σy − b / y, ∇²f = Σ + diag(b / y²)
+        const Eigen::VectorXd gradient = sigmaY.array() - b.array() / y.array();
+        hessian = covariance;
+        hessian.diagonal().array() += b.array() / y.array().square();
+        llt.compute(hessian);
+        if (llt.info() != Eigen::Success) {
+            throw std::runtime_error("Risk-budget Hessian is not positive definite");
         }
+        const Eigen::VectorXd step = llt.solve(gradient);
+
+        // Small budgets make f far from self-concordant, so the damped step
+        // alone can cross y_i = 0: cap the step at 99% of the distance to
+        // the boundary, then backtrack until f decreases enough (Armijo)
+        const double decrementSquared = std::max(0.0, gradient.dot(step));
+        double alpha = 1.0;
+        for (Eigen::Index i = 0; i < n; i++) {
+            if (step(i) > 0.0) {
+                alpha = std::min(alpha, 0.99 * y(i) / step(i));
+            }
+        }
+        const double f = objective(y, sigmaY);
+        const double roundoff = 1e-14 * (1.0 + std::abs(f));
+        bool accepted = false;
+        for (; alpha >= 1e-12; alpha *= 0.5) {
+            trial = y - alpha * step;
+            sigmaTrial.noalias() = covariance * trial;
+            if (objective(trial, sigmaTrial) <= f - 1e-4 * alpha * decrementSquared + roundoff) {
+                accepted = true;
+                break;
+            }
+        }
+        if (!accepted) {
+            break;
+        }
+        y.swap(trial);
+        sigmaY.swap(sigmaTrial);
+        solution.iterations++;
     }
 
-    // Build response vector y (T × 1)
-    Eigen::VectorXd y = Eigen::Map<const Eigen::VectorXd>(
-        portfolioReturns.data(), T);
+    const double total = y.sum();
+    const double variance = y.dot(sigmaY);
+    solution.weights = y / total;
+    solution.volatility = std::sqrt(variance) / total;
+    solution.riskContributions = (y.array() * sigmaY.array()) / variance;
+    return solution;
+}
 
-    // OLS: γ = (X^T X)^{-1} X^T y
-    Eigen::MatrixXd XtX = X.transpose() * X;
-    Eigen::VectorXd Xty = X.transpose() * y;
+// ===== DrawdownRegression Implementation =====
 
-    // Add small regularization to avoid singularity
-    Eigen::MatrixXd XtXReg = XtX;
-    for (int k = 0; k < K; k++) {
-        XtXReg(k, k) += 1e-8;
+DrawdownRegression::DrawdownRegression(std::vector<std::string> factorLabels)
+    : factorLabels_(std::move(factorLabels)) {
+    if (factorLabels_.empty()) {
+        throw std::invalid_argument("Drawdown regression needs at least one factor");
+    }
+    const Eigen::Index K = static_cast<Eigen::Index>(factorLabels_.size());
+    crossProduct_ = Eigen::MatrixXd::Zero(K, K);
+    crossResponse_ = Eigen::VectorXd::Zero(K);
+    refactor();
+}
+
+void DrawdownRegression::refactor() {
+    Eigen::MatrixXd regularized = crossProduct_;
+    regularized.diagonal().array() += RIDGE;
+    cholesky_.compute(regularized);
+    if (cholesky_.info() != Eigen::Success) {
+        throw std::runtime_error("Cholesky factorization of XᵀX failed");
+    }
+}
+
+void DrawdownRegression::add(const Eigen::Ref<const Eigen::VectorXd>& factorShocks, double portfolioReturn) {
+    if (factorShocks.size() != crossResponse_.size()) {
+        throw std::invalid_argument("Shock vector size must match number of factors");
+    }
+    if (!factorShocks.allFinite() || !std::isfinite(portfolioReturn)) {
+        throw std::invalid_argument("Shocks and returns must be finite");
+    }
+
+    crossProduct_.noalias() += factorShocks * factorShocks.transpose();
+    crossResponse_ += portfolioReturn * factorShocks;
+    sumSquaredReturns_ += portfolioReturn * portfolioReturn;
+    count_++;
+
+    // Welford: keep the spread of y centered instead of Σy² − n·ȳ²
+    const double delta = portfolioReturn - meanReturn_;
+    meanReturn_ += delta / static_cast<double>(count_);
+    centeredSquares_ += delta * (portfolioReturn - meanReturn_);
+
+    cholesky_.rankUpdate(factorShocks, 1.0);
+}
+
+void DrawdownRegression::remove(const Eigen::Ref<const Eigen::VectorXd>& factorShocks, double portfolioReturn) {
+    if (factorShocks.size() != crossResponse_.size()) {
+        throw std::invalid_argument("Shock vector size must match number of factors");
+    }
+    if (count_ == 0) {
+        throw std::runtime_error("No observations to remove");
+    }
+
+    if (count_ == 1) {
+        // Start clean rather than carry rounding residue
+        reset();
+        return;
+    }
+
+    crossProduct_.noalias() -= factorShocks * factorShocks.transpose();
+    crossResponse_ -= portfolioReturn * factorShocks;
+    sumSquaredReturns_ -= portfolioReturn * portfolioReturn;
+    count_--;
+
+    // Welford in reverse
+    const double delta = portfolioReturn - meanReturn_;
+    meanReturn_ -= delta / static_cast<double>(count_);
+    centeredSquares_ = std::max(0.0, centeredSquares_ - delta * (portfolioReturn - meanReturn_));
+
+    cholesky_.rankUpdate(factorShocks, -1.0);
+    if (cholesky_.info() != Eigen::Success) {
+        refactor();
+    }
+}
+
+void DrawdownRegression::addBlock(const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+                                  const Eigen::Ref<const Eigen::VectorXd>& portfolioReturns) {
+    if (factorShocks.cols() != crossResponse_.size()) {
+        throw std::invalid_argument("Shock matrix columns must match number of factors");
+    }
+    if (factorShocks.rows() != portfolioReturns.size()) {
+        throw std::invalid_argument("Returns and shocks must have same length");
+    }
+    if (!factorShocks.allFinite() || !portfolioReturns.allFinite()) {
+        throw std::invalid_argument("Shocks and returns must be finite");
+    }
+
+    if (portfolioReturns.size() == 0) {
+        return;
     }
 
-    Eigen::VectorXd gamma = XtXReg.ldlt().solve(Xty);
+    crossProduct_.noalias() += factorShocks.transpose() * factorShocks;
+    crossResponse_.noalias() += factorShocks.transpose() * portfolioReturns;
+    sumSquaredReturns_ += portfolioReturns.squaredNorm();
+
+    // Centered block statistics, combined with the held ones (Chan et al.)
+    const double blockCount = static_cast<double>(portfolioReturns.size());
+    const double blockMean = portfolioReturns.mean();
+    const double blockSquares = (portfolioReturns.array() - blockMean).square().sum();
+    const double heldCount = static_cast<double>(count_);
+    const double delta = blockMean - meanReturn_;
+    count_ += static_cast<size_t>(portfolioReturns.size());
+    meanReturn_ += delta * blockCount / static_cast<double>(count_);
+    centeredSquares_ += blockSquares + delta * delta * heldCount * blockCount / static_cast<double>(count_);
+    refactor();
+}
+
+void DrawdownRegression::reset() {
+    crossProduct_.setZero();
+    crossResponse_.setZero();
+    meanReturn_ = 0.0;
+    centeredSquares_ = 0.0;
+    sumSquaredReturns_ = 0.0;
+    count_ = 0;
+    refactor();
+}
+
+Eigen::VectorXd DrawdownRegression::coefficients() const {
+    if (count_ == 0) {
+        throw std::runtime_error("Drawdown regression has no observations");
+    }
+    return cholesky_.solve(crossResponse_);
+}
+
+RiskDecomposition DrawdownRegression::decomposition() const {
+    const Eigen::VectorXd gamma = coefficients();
+    const double n = static_cast<double>(count_);
+    const int K = numFactors();
+
+    // Σ_f γ with Σ_f = XᵀX / T
+    const Eigen::VectorXd sigmaGamma = crossProduct_ * gamma / n;
+    const Eigen::VectorXd riskContributions = gamma.cwiseProduct(sigmaGamma);
+    const double factorVariance = riskContributions.sum();
 
-    // Compute R² = 1 - (||y - X γ||^2 / ||y - mean(y)||^2)
-    Eigen::VectorXd yPred = X * gamma;
-    double meanY = y.mean();
-    double ssRes = (y - yPred).squaredNorm();
-    double ssTot = (y.array() - meanY).square().sum();
+    // R² from sufficient statistics: ‖y − Xγ‖² = yᵀy − 2γᵀXᵀy + γᵀXᵀXγ
+    const double ssTot = centeredSquares_;
+    const double ssRes = std::max(0.0, sumSquaredReturns_ - 2.0 * gamma.dot(crossResponse_) + n * gamma.dot(sigmaGamma));
 
     double rsquared = 1.0;
     if (ssTot > 1e-10) {
-        rsquared = 1.0 - (ssRes / ssTot);
-        rsquared = std::max(0.0, std::min(1.0, rsquared));  // Clamp to [0,1]
+        rsquared = std::clamp(1.0 - ssRes / ssTot, 0.0, 1.0);
     }
 
-    return {gamma, rsquared};
+    const double portfolioVariance = ssTot / n;
+
+    RiskDecomposition result;
+    result.factorSensitivities.assign(gamma.data(), gamma.data() + K);
+    result.factorRiskContributions.assign(riskContributions.data(), riskContributions.data() + K);
+    result.marginalRiskContributions.resize(K);
+    result.componentContributions.resize(K);
+    for (int k = 0; k < K; k++) {
+        result.marginalRiskContributions[k] = 2.0 * sigmaGamma(k);
+        result.componentContributions[k] = factorVariance > 1e-10 ? riskContributions(k) / factorVariance : 0.0;
+    }
+    result.factorLabels = factorLabels_;
+    result.totalRisk = std::sqrt(portfolioVariance);
+    result.totalVariance = portfolioVariance;
+    result.residualRisk = std::sqrt(ssRes / n);
+    result.varianceExplained = rsquared;
+    result.numFactors = K;
+
+    return result;
 }
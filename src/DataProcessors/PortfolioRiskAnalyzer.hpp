@@ -61,6 +61,126 @@ struct RiskDecomposition {
     int numFactors;
 };
 
+/**
+ * BatchRiskDecomposition: Risk attribution for P portfolios at once
+ *
+ * Structure of arrays: column p of every K × P matrix belongs to portfolio
+ * p. Factor labels are shared and live in MacroFactors. Pass the same
+ * object to repeated analyzeRiskBatch calls; storage is only reallocated
+ * when K or P changes.
+ */
+struct BatchRiskDecomposition {
+    Eigen::MatrixXd factorSensitivities;        // Γ = Bᵀ β (K × P)
+    Eigen::MatrixXd factorRiskContributions;    // RC_kp = Γ_kp (Σ_f Γ)_kp (K × P)
+    Eigen::MatrixXd marginalRiskContributions;  // MRC = 2 Σ_f Γ (K × P)
+    Eigen::MatrixXd componentContributions;     // RC_kp / Var_p (K × P)
+    Eigen::VectorXd totalVariance;              // Var_p = Σ_k RC_kp (P)
+    Eigen::VectorXd totalRisk;                  // √Var_p (P)
+    Eigen::VectorXd residualVariance;           // β_pᵀ Σ_u β_p (P)
+};
+
+/**
+ * RiskBudgetOptions: Stopping rule for the risk-budgeting solver
+ */
+struct RiskBudgetOptions {
+    double tolerance = 1e-10;       // Max |RC_i / Var − b_i| at convergence
+    int maxIterations = 50;         // Newton steps before giving up
+};
+
+/**
+ * RiskBudgetSolution: Long-only weights whose risk shares match the budgets
+ */
+struct RiskBudgetSolution {
+    Eigen::VectorXd weights;            // x > 0, Σ x_i = 1
+    Eigen::VectorXd riskContributions;  // x_i (Σ x)_i / xᵀΣx, sums to 1
+    double volatility;                  // √(xᵀ Σ x)
+    double budgetError;                 // max_i |RC_i − b_i|
+    int iterations;                     // Newton steps taken
+    bool converged;
+};
+
+/**
+ * DrawdownRegression: Running normal equations for r_t = γᵀ f_t + ε_t
+ *
+ * Keeps XᵀX, Xᵀy, yᵀy and the running mean and centered sum of squares
+ * of y (Welford) over the observations currently in the window, plus the
+ * Cholesky factor of XᵀX + λI. add() and remove() are rank-1 updates of
+ * both (O(K²)), so rolling or expanding attribution never refits from
+ * scratch. A downdate that loses positive definiteness refactors from the
+ * accumulated XᵀX. The regression does not keep the rows, so whoever
+ * slides it should reset() and addBlock() the retained window now and
+ * then to flush the add/remove rounding, as rollingDrawdownAttribution
+ * does once per window length.
+ *
+ * The attribution is the one explainHistoricalDrawdown has always
+ * reported: Σ_f is the uncentered second moment XᵀX / T, R² is measured
+ * against the demeaned returns, and totalVariance is their variance.
+ */
+class DrawdownRegression {
+public:
+    static constexpr double RIDGE = 1e-8;   // λ on the diagonal of XᵀX
+
+    /**
+     * @param factorLabels: One label per factor (K)
+     * @throws std::invalid_argument if there are no factors
+     */
+    explicit DrawdownRegression(std::vector<std::string> factorLabels);
+
+    /**
+     * Add one observation (O(K²))
+     *
+     * @param factorShocks: f_t ∈ ℝ^K
+     * @param portfolioReturn: r_t
+     */
+    void add(const Eigen::Ref<const Eigen::VectorXd>& factorShocks, double portfolioReturn);
+
+    /**
+     * Remove an observation previously added (O(K²))
+     */
+    void remove(const Eigen::Ref<const Eigen::VectorXd>& factorShocks, double portfolioReturn);
+
+    /**
+     * Add T observations at once: XᵀX via a symmetric rank-T update, then one factorization
+     *
+     * @param factorShocks: X (T × K), contiguous
+     * @param portfolioReturns: y (T)
+     */
+    void addBlock(const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+                  const Eigen::Ref<const Eigen::VectorXd>& portfolioReturns);
+
+    /**
+     * Drop every observation
+     */
+    void reset();
+
+    /**
+     * OLS coefficients γ from the cached factor (two triangular solves)
+     */
+    Eigen::VectorXd coefficients() const;
+
+    /**
+     * Attribution of the observations currently held
+     *
+     * @throws std::runtime_error if there are no observations
+     */
+    RiskDecomposition decomposition() const;
+
+    size_t observationCount() const { return count_; }
+    int numFactors() const { return static_cast<int>(factorLabels_.size()); }
+
+private:
+    void refactor();
+
+    std::vector<std::string> factorLabels_;
+    Eigen::MatrixXd crossProduct_;          // XᵀX
+    Eigen::VectorXd crossResponse_;         // Xᵀy
+    Eigen::LLT<Eigen::MatrixXd> cholesky_;  // XᵀX + λI
+    double meanReturn_ = 0.0;
+    double centeredSquares_ = 0.0;          // Σ(y − ȳ)²
+    double sumSquaredReturns_ = 0.0;        // yᵀy, for the residual sum of squares
+    size_t count_ = 0;
+};
+
 /**
  * PortfolioRiskAnalyzer: Exact factor-based risk attribution
  *
@@ -87,6 +207,24 @@ public:
         const MacroFactors& factors                 // B (N×K), Σ_f (K×K)
     );
 
+    /**
+     * Decompose the variance of P portfolios in one pass
+     *
+     * Same attribution as analyzeRisk for every column of β, via two GEMMs
+     * (Γ = Bᵀ β and Σ_u β). Σ_f is diagonal, so Σ_f Γ is a row scaling. The
+     * residual is the exact β_pᵀ Σ_u β_p, from Ψ = diag(Σ_u) when the
+     * decomposition skipped the full Σ_u.
+     *
+     * @param assetSensitivities: β (N × P), one portfolio per column
+     * @param factors: B, Σ_f (and Σ_u or Ψ) from MacroFactorModel
+     * @param result: Output, resized only when K or P changes
+     */
+    static void analyzeRiskBatch(
+        const Eigen::MatrixXd& assetSensitivities,
+        const MacroFactors& factors,
+        BatchRiskDecomposition& result
+    );
+
     /**
      * Scenario analysis: what if we had a macro shock?
      *
@@ -124,6 +262,46 @@ public:
         const std::vector<std::string>& factorLabels
     );
 
+    /**
+     * Historical crisis decomposition on a contiguous T × K matrix
+     *
+     * Same attribution as above without the per-row vectors. Accepts
+     * Eigen matrices and Eigen::Map views over existing buffers.
+     *
+     * @param portfolioReturns: y (T)
+     * @param factorShocks: X (T × K)
+     * @param factorLabels: Names of factors (K)
+     */
+    static RiskDecomposition explainHistoricalDrawdown(
+        const Eigen::Ref<const Eigen::VectorXd>& portfolioReturns,
+        const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+        const std::vector<std::string>& factorLabels
+    );
+
+    /**
+     * Drawdown attribution through time
+     *
+     * Slides (or, with windowLength = 0, expands) a DrawdownRegression
+     * over the sample: each step adds the newest row and drops the oldest,
+     * O(K²) per step. Every windowLength steps the regression is rebuilt
+     * from the rows in the window, so rounding never builds up. The first
+     * result covers rows [0, minObservations).
+     *
+     * @param portfolioReturns: y (T)
+     * @param factorShocks: X (T × K)
+     * @param factorLabels: Names of factors (K)
+     * @param windowLength: Rows per window; 0 = expanding from the start
+     * @param minObservations: Rows in the first result (default windowLength, or K + 1 when expanding)
+     * @return One RiskDecomposition per step, T − minObservations + 1 in total
+     */
+    static std::vector<RiskDecomposition> rollingDrawdownAttribution(
+        const Eigen::Ref<const Eigen::VectorXd>& portfolioReturns,
+        const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+        const std::vector<std::string>& factorLabels,
+        size_t windowLength = 0,
+        size_t minObservations = 0
+    );
+
     /**
      * Rolling risk decomposition over time
      *
@@ -160,19 +338,50 @@ public:
         const MacroFactors& factors
     );
 
-private:
     /**
-     * Regress portfolio returns on factor shocks via OLS
+     * Risk-budgeting allocation against a full factor covariance
+     *
+     * Finds γ > 0 with γ_k (Σ_f γ)_k / γᵀΣ_f γ = b_k for arbitrary budgets b
+     * (equal budgets give equal risk contribution), then scales γ to the
+     * target risk. Pass yesterday's sensitivities to warm-start the solver.
+     *
+     * @param targetRiskLevel: Target portfolio volatility
+     * @param factorCovariance: Σ_f (K × K), e.g. from EwmaCovariance
+     * @param budgets: b ∈ ℝ^K, positive; normalized to sum to 1
+     * @param factorLabels: Names for readability
+     * @param previousSensitivities: Prior γ to start from (empty = inverse volatility)
+     * @return Recommended γ and its risk decomposition
+     */
+    static RiskDecomposition riskBudgetingAllocation(
+        double targetRiskLevel,
+        const Eigen::MatrixXd& factorCovariance,
+        const Eigen::VectorXd& budgets,
+        const std::vector<std::string>& factorLabels,
+        const std::vector<double>& previousSensitivities = {}
+    );
+
+    /**
+     * Solve the risk-budgeting problem for any covariance
      *
-     * Used in explainHistoricalDrawdown() to recover γ from data
+     * Minimizes ½ yᵀΣy − Σ_i b_i log y_i over y > 0. At the minimum
+     * y_i (Σy)_i = b_i, so x = y / Σy_i has risk shares b. Each iteration is
+     * a Newton step (Hessian Σ + diag(b / y²), one Cholesky) cut to stay
+     * inside y > 0 and shortened by Armijo backtracking; near the solution
+     * full steps are taken and convergence is quadratic. A warm start is
+     * rescaled onto the optimal ray before the first step. A solve that
+     * stalls is reported as not converged.
      *
-     * @param portfolioReturns: Y (T×1)
-     * @param factorShocks: X (T×K)
-     * @return Estimated γ and R²
+     * @param covariance: Σ (n × n), positive definite
+     * @param budgets: b ∈ ℝ^n, positive; normalized to sum to 1
+     * @param warmStart: Previous weights (any positive scale), or empty
+     * @param options: Tolerance and iteration cap
+     * @return Weights, achieved risk shares and convergence report
      */
-    static std::pair<Eigen::VectorXd, double> regressRiskDecomposition(
-        const std::vector<double>& portfolioReturns,
-        const std::vector<std::vector<double>>& factorShocks
+    static RiskBudgetSolution solveRiskBudget(
+        const Eigen::MatrixXd& covariance,
+        const Eigen::VectorXd& budgets,
+        const Eigen::VectorXd& warmStart = Eigen::VectorXd(),
+        const RiskBudgetOptions& options = RiskBudgetOptions()
     );
 };
 
@@ -12,12 +12,23 @@
 #include <algorithm>
 #include <sstream>
 #include <iostream>
+#include <limits>
 
 PositionSizing PositionSizer::computePositionSize(
     double baseNotional,
     const RiskDecomposition& riskDecomp,
     const MacroRegime& regime,
     const PositionConstraint& constraints)
+{
+    return computePositionSize(baseNotional, riskDecomp, regime, constraints, defaultRegimeWeights());
+}
+
+PositionSizing PositionSizer::computePositionSize(
+    double baseNotional,
+    const RiskDecomposition& riskDecomp,
+    const MacroRegime& regime,
+    const PositionConstraint& constraints,
+    const RegimeWeights& weights)
 {
     if (baseNotional <= 0.0) {
         throw std::invalid_argument("Base notional must be positive");
@@ -28,7 +39,7 @@ PositionSizing PositionSizer::computePositionSize(
     }
 
     // Step 1: Compute volatility multiplier from regime
-    double volMultiplier = computeVolatilityMultiplier(regime);
+    double volMultiplier = computeVolatilityMultiplier(regime, weights);
 
     // Step 2: Adjust position inversely to volatility
     // Core formula: Position = Base × (1 / Vol Multiplier)
@@ -103,12 +114,199 @@ PositionSizing PositionSizer::computePositionSize(
     return sizing;
 }
 
+void PositionSizer::computeBookSizing(
+    const InstrumentBook& book,
+    const Eigen::MatrixXd& factorCovariance,
+    const std::vector<std::string>& factorLabels,
+    const MacroRegime& regime,
+    const PositionConstraint& constraints,
+    BookSizing& result)
+{
+    computeBookSizing(book, factorCovariance, factorLabels, regime, constraints, defaultRegimeWeights(), result);
+}
+
+void PositionSizer::computeBookSizing(
+    const InstrumentBook& book,
+    const Eigen::MatrixXd& factorCovariance,
+    const std::vector<std::string>& factorLabels,
+    const MacroRegime& regime,
+    const PositionConstraint& constraints,
+    const RegimeWeights& weights,
+    BookSizing& result)
+{
+    const Eigen::Index M = book.baseNotional.size();
+    const Eigen::Index K = book.factorSensitivities.rows();
+    if (M == 0 || book.symbols.size() != static_cast<size_t>(M) || book.maxNotional.size() != M ||
+        book.contractNotional.size() != M || book.factorSensitivities.cols() != M ||
+        book.residualVariance.size() != M) {
+        throw std::invalid_argument("Instrument book arrays must all have one entry per instrument");
+    }
+    if (K < 1 || factorCovariance.rows() != K || factorCovariance.cols() != K ||
+        factorLabels.size() != static_cast<size_t>(K)) {
+        throw std::invalid_argument("Factor covariance and labels must match the sensitivity rows");
+    }
+    if (K > 32) {
+        throw std::invalid_argument("Factor breach flags support at most 32 factors");
+    }
+    if ((book.baseNotional.array() <= 0.0).any() || (book.contractNotional.array() <= 0.0).any()) {
+        throw std::invalid_argument("Base and contract notionals must be positive");
+    }
+
+    // Step 1: Regime multiplier, shared by the whole book
+    const double volMultiplier = computeVolatilityMultiplier(regime, weights);
+
+    // Step 2: Inverse-volatility sizing and the per-instrument cap
+    Eigen::VectorXd& notional = result.recommendedNotional;
+    notional = (book.baseNotional / volMultiplier).cwiseMin(book.maxNotional).cwiseMax(0.0);
+
+    // Step 3: Book covariance per unit notional, C = Γᵀ Σ_f Γ + diag(residual)
+    Eigen::MatrixXd& unitCovariance = result.correlation;
+    unitCovariance.noalias() = book.factorSensitivities.transpose() * (factorCovariance * book.factorSensitivities);
+    unitCovariance.diagonal() += book.residualVariance;
+    const Eigen::VectorXd unitVol = unitCovariance.diagonal().cwiseMax(0.0).cwiseSqrt();
+
+    // Step 4: Hard limits, as flags
+    std::vector<double> factorLimits(static_cast<size_t>(K), std::numeric_limits<double>::infinity());
+    for (Eigen::Index k = 0; k < K; k++) {
+        auto limit = constraints.maxFactorExposure.find(factorLabels[k]);
+        if (limit != constraints.maxFactorExposure.end()) {
+            factorLimits[k] = limit->second;
+        }
+    }
+    result.breaches.assign(static_cast<size_t>(M), 0u);
+    result.factorBreaches.assign(static_cast<size_t>(M), 0u);
+    for (Eigen::Index i = 0; i < M; i++) {
+        uint32_t& flags = result.breaches[i];
+        if (notional(i) > book.maxNotional(i)) {
+            flags |= BookSizing::BREACH_MAX_NOTIONAL;
+        }
+        if ((notional(i) / book.baseNotional(i)) * constraints.maxLeverageMultiple > constraints.maxLeverageMultiple) {
+            flags |= BookSizing::BREACH_LEVERAGE;
+        }
+        for (Eigen::Index k = 0; k < K; k++) {
+            if (std::abs(book.factorSensitivities(k, i)) > factorLimits[k]) {
+                result.factorBreaches[i] |= 1u << k;
+                flags |= BookSizing::BREACH_FACTOR_EXPOSURE;
+            }
+        }
+    }
+
+    // Step 5: Scale the whole book if its correlated 2σ loss exceeds the daily limit
+    Eigen::VectorXd covTimesNotional = unitCovariance * notional;
+    double bookVariance = std::max(0.0, notional.dot(covTimesNotional));
+    result.bookScale = 1.0;
+    if (constraints.maxDailyLoss > 0.0 && 2.0 * std::sqrt(bookVariance) > constraints.maxDailyLoss) {
+        result.bookScale = constraints.maxDailyLoss / (2.0 * std::sqrt(bookVariance));
+        notional *= result.bookScale;
+        covTimesNotional *= result.bookScale;
+        bookVariance *= result.bookScale * result.bookScale;
+        for (uint32_t& flags : result.breaches) {
+            flags |= BookSizing::BREACH_BOOK_LOSS;
+        }
+    }
+
+    // Step 6: Risk at the final size
+    result.bookVolatility = std::sqrt(bookVariance);
+    result.expectedDailyVol = notional.cwiseProduct(unitVol);
+    result.recommendedContracts = notional.cwiseQuotient(book.contractNotional);
+    if (result.bookVolatility > 0.0) {
+        result.riskContributions = notional.cwiseProduct(covTimesNotional) / result.bookVolatility;
+    } else {
+        result.riskContributions.setZero(M);
+    }
+
+    // Step 7: Built-in stress scenario, one GEMV
+    Eigen::VectorXd scenario(K);
+    for (Eigen::Index k = 0; k < K; k++) {
+        scenario(k) = stressMagnitude(factorLabels[k]);
+    }
+    result.stressLoss.noalias() = book.factorSensitivities.transpose() * scenario;
+    result.stressLoss.array() *= notional.array();
+
+    // Step 8: C → correlation in place
+    const Eigen::VectorXd inverseVol = (unitVol.array() > 0.0).select(unitVol.cwiseInverse(), 0.0);
+    result.correlation = inverseVol.asDiagonal() * result.correlation * inverseVol.asDiagonal();
+
+    result.volatilityMultiplier = volMultiplier;
+    result.isWithinConstraints = std::none_of(result.breaches.begin(), result.breaches.end(),
+                                              [](uint32_t flags) { return flags != 0u; });
+    result.baseNotional = book.baseNotional;
+    result.factorLabels = factorLabels;
+    result.regimeLabel = regime.riskLabel;
+    result.vixLevel = regime.vixLevel;
+}
+
+std::string BookSizing::rationale(size_t instrument) const
+{
+    if (instrument >= static_cast<size_t>(baseNotional.size())) {
+        throw std::out_of_range("Instrument " + std::to_string(instrument) + " out of range");
+    }
+    std::ostringstream text;
+    text << "Base=" << baseNotional(static_cast<Eigen::Index>(instrument))
+         << ", VolMult=" << volatilityMultiplier
+         << ", Regime=" << regimeLabel
+         << ", VIX=" << vixLevel;
+    if (bookScale < 1.0) {
+        text << ", BookScale=" << bookScale;
+    }
+    return text.str();
+}
+
+std::vector<std::string> BookSizing::constraintBreaches(size_t instrument) const
+{
+    if (instrument >= breaches.size()) {
+        throw std::out_of_range("Instrument " + std::to_string(instrument) + " out of range");
+    }
+    std::vector<std::string> messages;
+    const uint32_t flags = breaches[instrument];
+    if (flags & BREACH_MAX_NOTIONAL) {
+        messages.push_back("Exceeds max notional");
+    }
+    if (flags & BREACH_LEVERAGE) {
+        messages.push_back("Exceeds leverage limit");
+    }
+    for (size_t k = 0; k < factorLabels.size(); k++) {
+        if (factorBreaches[instrument] & (1u << k)) {
+            messages.push_back("Factor " + factorLabels[k] + " exposure too high");
+        }
+    }
+    if (flags & BREACH_BOOK_LOSS) {
+        messages.push_back("Book scaled to daily loss limit");
+    }
+    return messages;
+}
+
 MacroRegime PositionSizer::classifyRegime(
     double vixLevel,
     double moveIndex,
     double creditSpread,
     double yieldCurveSlope,
     double putCallRatio)
+{
+    return classifyRegime(vixLevel, moveIndex, creditSpread, yieldCurveSlope, putCallRatio,
+                          defaultRegimeWeights());
+}
+
+MacroRegime PositionSizer::classifyRegime(
+    double vixLevel,
+    double moveIndex,
+    double creditSpread,
+    double yieldCurveSlope,
+    double putCallRatio,
+    const RegimeWeights& weights)
+{
+    return classifyRegime(vixLevel, moveIndex, creditSpread, yieldCurveSlope, putCallRatio,
+                          weights, defaultRegimeThresholds());
+}
+
+MacroRegime PositionSizer::classifyRegime(
+    double vixLevel,
+    double moveIndex,
+    double creditSpread,
+    double yieldCurveSlope,
+    double putCallRatio,
+    const RegimeWeights& weights,
+    const RegimeThresholds& thresholds)
 {
     MacroRegime regime;
     regime.vixLevel = vixLevel;
@@ -118,38 +316,38 @@ MacroRegime PositionSizer::classifyRegime(
     regime.putCallRatio = putCallRatio;
 
     // Risk-On/Off classification
-    if (vixLevel > VIX_RISK_OFF && creditSpread > SPREAD_WIDE) {
+    if (vixLevel > thresholds.vixRiskOff && creditSpread > thresholds.spreadWide) {
         regime.riskLabel = "Risk-Off";
-    } else if (vixLevel < VIX_RISK_ON && creditSpread < SPREAD_TIGHT) {
+    } else if (vixLevel < thresholds.vixRiskOn && creditSpread < thresholds.spreadTight) {
         regime.riskLabel = "Risk-On";
     } else {
         regime.riskLabel = "Neutral";
     }
 
     // Inflation/Growth classification
-    if (yieldCurveSlope > CURVE_STEEP) {
+    if (yieldCurveSlope > thresholds.curveSteep) {
         regime.inflationLabel = "Growth-Sensitive";
-    } else if (yieldCurveSlope < CURVE_FLAT) {
+    } else if (yieldCurveSlope < thresholds.curveFlat) {
         regime.inflationLabel = "Inflation-Sensitive";
     } else {
         regime.inflationLabel = "Balanced";
     }
 
     // Stable/Fragile classification
-    if (vixLevel > 25.0 || moveIndex > 120.0) {
+    if (vixLevel > thresholds.fragileVix || moveIndex > thresholds.fragileMove) {
         regime.fragileLabel = "Fragile";
     } else {
         regime.fragileLabel = "Stable";
     }
 
     // Volatility multiplier
-    regime.volatilityMultiplier = computeVolatilityMultiplier(regime);
+    regime.volatilityMultiplier = computeVolatilityMultiplier(regime, weights);
 
     // Confidence
     double confidence = 0.7;  // Default
-    if (vixLevel > VIX_RISK_OFF && creditSpread > SPREAD_WIDE) {
+    if (vixLevel > thresholds.vixRiskOff && creditSpread > thresholds.spreadWide) {
         confidence = 0.85;  // Clear risk-off signal
-    } else if (vixLevel < VIX_RISK_ON && creditSpread < SPREAD_TIGHT) {
+    } else if (vixLevel < thresholds.vixRiskOn && creditSpread < thresholds.spreadTight) {
         confidence = 0.80;  // Clear risk-on
     }
     regime.confidence = confidence;
@@ -172,6 +370,21 @@ std::vector<double> PositionSizer::regimeAdjustedVolatilities(
 }
 
 double PositionSizer::computeVolatilityMultiplier(const MacroRegime& regime)
+{
+    return computeVolatilityMultiplier(regime, defaultRegimeWeights());
+}
+
+RegimeWeights PositionSizer::defaultRegimeWeights()
+{
+    return {VIX_WEIGHT, MOVE_WEIGHT, SPREAD_WEIGHT, CURVE_WEIGHT, PUTCALL_WEIGHT};
+}
+
+RegimeThresholds PositionSizer::defaultRegimeThresholds()
+{
+    return {VIX_RISK_ON, VIX_RISK_OFF, SPREAD_TIGHT, SPREAD_WIDE, CURVE_FLAT, CURVE_STEEP, FRAGILE_VIX, FRAGILE_MOVE};
+}
+
+double PositionSizer::computeVolatilityMultiplier(const MacroRegime& regime, const RegimeWeights& weights)
 {
     // Normalize state variables to [0, 1]
     // VIX: 10 → 0, 50 → 1
@@ -190,11 +403,11 @@ double PositionSizer::computeVolatilityMultiplier(const MacroRegime& regime)
     double putcallScore = std::min(1.0, std::max(0.0, (regime.putCallRatio - 0.8) / 0.4));
 
     // Weighted average
-    double stressScore = VIX_WEIGHT * vixScore
-                       + MOVE_WEIGHT * moveScore
-                       + SPREAD_WEIGHT * spreadScore
-                       + CURVE_WEIGHT * curveScore
-                       + PUTCALL_WEIGHT * putcallScore;
+    double stressScore = weights.vix * vixScore
+                       + weights.move * moveScore
+                       + weights.spread * spreadScore
+                       + weights.curve * curveScore
+                       + weights.putCall * putcallScore;
 
     // Convert stress score to multiplier
     // stressScore=0 → multiplier=1.0 (calm)
@@ -285,31 +498,46 @@ double PositionSizer::stressTestPosition(
     double totalLoss = 0.0;
 
     for (int k = 0; k < riskDecomp.numFactors; k++) {
-        double gamma = riskDecomp.factorSensitivities[k];
-        double stressMagnitude = 0.0;
-
-        // Determine stress based on factor label
-        const std::string& label = riskDecomp.factorLabels[k];
-        if (label == "Growth") {
-            stressMagnitude = -2.0;  // -2σ growth shock
-        } else if (label == "Inflation") {
-            stressMagnitude = 1.0;   // +1σ inflation
-        } else if (label == "Volatility") {
-            stressMagnitude = 2.0;   // +2σ volatility
-        } else if (label == "Policy") {
-            stressMagnitude = 1.0;   // +1σ policy tightening
-        } else {
-            stressMagnitude = 0.5;   // Other factors: mild stress
-        }
-
         // Impact: shock × sensitivity
-        totalLoss += gamma * stressMagnitude;
+        totalLoss += riskDecomp.factorSensitivities[k] * stressMagnitude(riskDecomp.factorLabels[k]);
     }
 
     // Convert to dollar loss
     return positionSize * totalLoss;
 }
 
+double PositionSizer::stressMagnitude(const std::string& label)
+{
+    // Determine stress based on factor label
+    if (label == "Growth") {
+        return -2.0;  // -2σ growth shock
+    } else if (label == "Inflation") {
+        return 1.0;   // +1σ inflation
+    } else if (label == "Volatility") {
+        return 2.0;   // +2σ volatility
+    } else if (label == "Policy") {
+        return 1.0;   // +1σ policy tightening
+    }
+    return 0.5;       // Other factors: mild stress
+}
+
+double PositionSizer::stressTestPosition(
+    double positionSize,
+    const RiskDecomposition& riskDecomp,
+    const ScenarioLibrary& scenarios)
+{
+    if (scenarios.factorLabels() != riskDecomp.factorLabels) {
+        throw std::invalid_argument("Scenario library factors must match the risk decomposition");
+    }
+    if (scenarios.size() == 0) {
+        throw std::invalid_argument("Scenario library is empty");
+    }
+
+    Eigen::MatrixXd exposure = positionSize * Eigen::Map<const Eigen::VectorXd>(
+        riskDecomp.factorSensitivities.data(), static_cast<Eigen::Index>(riskDecomp.factorSensitivities.size()));
+    return ScenarioEvaluator::worstCases(scenarios, exposure, 1).front().front().pnl;
+}
+
 double PositionSizer::computeDailyVaR(
     double position,
     const RiskDecomposition& riskDecomp,
@@ -325,3 +553,19 @@ double PositionSizer::computeDailyVaR(
 
     return var;
 }
+
+double PositionSizer::computeHistoricalVaR(
+    double position,
+    const RiskDecomposition& riskDecomp,
+    const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+    double confidenceLevel,
+    int horizonDays)
+{
+    if (riskDecomp.factorSensitivities.size() != static_cast<size_t>(factorShocks.cols())) {
+        throw std::invalid_argument("Factor shocks must have one column per factor sensitivity");
+    }
+
+    Eigen::Map<const Eigen::VectorXd> gamma(riskDecomp.factorSensitivities.data(), factorShocks.cols());
+    Eigen::VectorXd scenarios = HistoricalSimulation::scenarioPnl(gamma, factorShocks, position, horizonDays);
+    return HistoricalSimulation::tailRisk(scenarios, {confidenceLevel}).valueAtRisk[0];
+}
@@ -12,6 +12,9 @@
 #define POSITION_SIZER_HPP
 
 #include "PortfolioRiskAnalyzer.hpp"
+#include "HistoricalSimulation.hpp"
+#include "ScenarioLibrary.hpp"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <map>
@@ -44,6 +47,37 @@ struct MacroRegime {
     double volatilityMultiplier;  // 1.0 = baseline, 2.0 = double volatility
 };
 
+/**
+ * RegimeWeights: Contribution of each market observable to the volatility multiplier
+ *
+ * Defaults come from PositionSizer::defaultRegimeWeights(); overridden by
+ * parameter sweeps.
+ */
+struct RegimeWeights {
+    double vix;
+    double move;
+    double spread;
+    double curve;
+    double putCall;
+};
+
+/**
+ * RegimeThresholds: Levels that separate the regime labels
+ *
+ * Defaults come from PositionSizer::defaultRegimeThresholds();
+ * AdaptiveRegimeThresholds replaces them with rolling percentiles.
+ */
+struct RegimeThresholds {
+    double vixRiskOn;          // Risk-On below, with tight spreads
+    double vixRiskOff;         // Risk-Off above, with wide spreads
+    double spreadTight;        // BAA-AAA (bps)
+    double spreadWide;
+    double curveFlat;          // 2s10s (bps); Inflation-Sensitive below
+    double curveSteep;         // Growth-Sensitive above
+    double fragileVix;         // Fragile above either
+    double fragileMove;
+};
+
 /**
  * PositionConstraint: Risk limits for a position
  */
@@ -84,6 +118,69 @@ struct PositionSizing {
     double hedgeRatio;                     // % of position to hedge (0-1)
 };
 
+/**
+ * InstrumentBook: Structure-of-arrays inputs for sizing M instruments at once
+ *
+ * Column i of factorSensitivities and entry i of every vector belong to
+ * instrument i (ES, NQ, RTY, ZN, CL, ...). Exposures are per dollar of
+ * notional, in the factor model's units.
+ */
+struct InstrumentBook {
+    std::vector<std::string> symbols;      // M
+    Eigen::VectorXd baseNotional;          // Max desired position per instrument
+    Eigen::VectorXd maxNotional;           // Hard cap per instrument
+    Eigen::VectorXd contractNotional;      // $ per contract
+    Eigen::MatrixXd factorSensitivities;   // Γ (K × M)
+    Eigen::VectorXd residualVariance;      // Idiosyncratic daily variance per unit notional (M)
+};
+
+/**
+ * BookSizing: Recommended sizes for a whole book, structure of arrays
+ *
+ * Instruments are correlated through the factor model: the book
+ * covariance is diag(n) (Γᵀ Σ_f Γ + diag(residual)) diag(n). Rationale and
+ * breach strings are not built during sizing. rationale(i) and
+ * constraintBreaches(i) format them from the stored numbers on request.
+ * Pass the same object to repeated computeBookSizing calls; storage is
+ * only reallocated when M or K changes.
+ */
+struct BookSizing {
+    static constexpr uint32_t BREACH_MAX_NOTIONAL = 1u << 0;
+    static constexpr uint32_t BREACH_LEVERAGE = 1u << 1;
+    static constexpr uint32_t BREACH_FACTOR_EXPOSURE = 1u << 2;
+    static constexpr uint32_t BREACH_BOOK_LOSS = 1u << 3;
+
+    Eigen::VectorXd recommendedNotional;   // After regime, caps and book scaling (M)
+    Eigen::VectorXd recommendedContracts;  // notional / contract notional (M)
+    Eigen::VectorXd expectedDailyVol;      // Standalone σ_i × notional (M)
+    Eigen::VectorXd riskContributions;     // n_i (C n)_i / σ_book, sums to σ_book (M)
+    Eigen::VectorXd stressLoss;            // Built-in stress scenario P&L (M)
+    Eigen::MatrixXd correlation;           // Instrument correlation (M × M)
+    std::vector<uint32_t> breaches;        // BREACH_* flags per instrument
+    std::vector<uint32_t> factorBreaches;  // Bit k set when |Γ_ki| exceeds factor k's limit
+
+    double bookVolatility;                 // √(nᵀ C n)
+    double volatilityMultiplier;           // From the regime, shared by every instrument
+    double bookScale;                      // ≤ 1: cut applied to respect maxDailyLoss
+    bool isWithinConstraints;
+
+    // Kept for on-demand formatting
+    Eigen::VectorXd baseNotional;
+    std::vector<std::string> factorLabels;
+    std::string regimeLabel;
+    double vixLevel;
+
+    /**
+     * Same text as PositionSizing::rationale for instrument i
+     */
+    std::string rationale(size_t instrument) const;
+
+    /**
+     * Same messages as PositionSizing::constraintBreaches for instrument i
+     */
+    std::vector<std::string> constraintBreaches(size_t instrument) const;
+};
+
 /**
  * HedgingStrategy: What derivative contracts to buy for downside protection
  */
@@ -131,6 +228,56 @@ public:
         const PositionConstraint& constraints
     );
 
+    /**
+     * Same as above with the volatility multiplier built from custom regime weights
+     */
+    static PositionSizing computePositionSize(
+        double baseNotional,
+        const RiskDecomposition& riskDecomp,
+        const MacroRegime& regime,
+        const PositionConstraint& constraints,
+        const RegimeWeights& weights
+    );
+
+    /**
+     * Size every instrument in a book in one pass
+     *
+     * Per instrument this applies the same rules as computePositionSize:
+     * base / volatility multiplier, the notional cap, leverage and factor
+     * exposure limits. The book is then scaled down as a whole if its 2σ
+     * daily loss, using the cross-instrument correlation from the factor
+     * model, exceeds constraints.maxDailyLoss.
+     *
+     * @param book: M instruments, structure of arrays
+     * @param factorCovariance: Σ_f (K × K)
+     * @param factorLabels: Labels matching the rows of Γ, for factor limits
+     * @param regime: Current market regime
+     * @param constraints: Factor limits, leverage and book loss limit (maxNotional is per instrument in book)
+     * @param weights: Regime weights for the volatility multiplier
+     * @param result: Output, reused across calls
+     */
+    static void computeBookSizing(
+        const InstrumentBook& book,
+        const Eigen::MatrixXd& factorCovariance,
+        const std::vector<std::string>& factorLabels,
+        const MacroRegime& regime,
+        const PositionConstraint& constraints,
+        const RegimeWeights& weights,
+        BookSizing& result
+    );
+
+    /**
+     * Same as above with the default regime weights
+     */
+    static void computeBookSizing(
+        const InstrumentBook& book,
+        const Eigen::MatrixXd& factorCovariance,
+        const std::vector<std::string>& factorLabels,
+        const MacroRegime& regime,
+        const PositionConstraint& constraints,
+        BookSizing& result
+    );
+
     /**
      * Classify market regime from observable data
      *
@@ -153,6 +300,34 @@ public:
         double putCallRatio
     );
 
+    /**
+     * Classify market regime with custom volatility multiplier weights
+     */
+    static MacroRegime classifyRegime(
+        double vixLevel,
+        double moveIndex,
+        double creditSpread,
+        double yieldCurveSlope,
+        double putCallRatio,
+        const RegimeWeights& weights
+    );
+
+    /**
+     * Classify market regime with custom weights and label thresholds
+     *
+     * The thresholds only move the labels and confidence; the volatility
+     * multiplier keeps its fixed scaling.
+     */
+    static MacroRegime classifyRegime(
+        double vixLevel,
+        double moveIndex,
+        double creditSpread,
+        double yieldCurveSlope,
+        double putCallRatio,
+        const RegimeWeights& weights,
+        const RegimeThresholds& thresholds
+    );
+
     /**
      * Compute factor volatilities conditioned on regime
      *
@@ -183,6 +358,21 @@ public:
      */
     static double computeVolatilityMultiplier(const MacroRegime& regime);
 
+    /**
+     * Compute factor volatility multiplier with custom weights
+     */
+    static double computeVolatilityMultiplier(const MacroRegime& regime, const RegimeWeights& weights);
+
+    /**
+     * Default regime weights (VIX_WEIGHT, MOVE_WEIGHT, ...)
+     */
+    static RegimeWeights defaultRegimeWeights();
+
+    /**
+     * Default label thresholds (VIX_RISK_ON, VIX_RISK_OFF, ...)
+     */
+    static RegimeThresholds defaultRegimeThresholds();
+
     /**
      * Recommend hedging strategy given position and regime
      *
@@ -240,6 +430,23 @@ public:
         const RiskDecomposition& riskDecomp
     );
 
+    /**
+     * Stress test a position against a scenario library
+     *
+     * Replaces the fixed scenario above with every row of a configured
+     * library (historical episodes and grids) and reports the worst one.
+     *
+     * @param positionSize: Notional to stress test
+     * @param riskDecomp: Factor sensitivities, columns in library order
+     * @param scenarios: Factor shocks in factor units
+     * @return Worst P&L across the library
+     */
+    static double stressTestPosition(
+        double positionSize,
+        const RiskDecomposition& riskDecomp,
+        const ScenarioLibrary& scenarios
+    );
+
     /**
      * Compute daily risk-adjusted position limit
      *
@@ -259,7 +466,34 @@ public:
         double confidenceLevel = 0.95
     );
 
+    /**
+     * Historical-simulation VaR: alternative to computeDailyVaR
+     *
+     * Revalues today's factor sensitivities against every historical day of
+     * factor shocks (columns in riskDecomp.factorLabels order) and reads the
+     * loss quantile directly. No normality or √h scaling is assumed.
+     *
+     * @param position: Current notional
+     * @param riskDecomp: γ per unit notional
+     * @param factorShocks: Historical factor shocks (T × K)
+     * @param confidenceLevel: Confidence for VaR (default 0.95)
+     * @param horizonDays: Loss horizon; overlapping h-day scenarios
+     * @return Loss not exceeded with the given confidence over the horizon
+     */
+    static double computeHistoricalVaR(
+        double position,
+        const RiskDecomposition& riskDecomp,
+        const Eigen::Ref<const Eigen::MatrixXd>& factorShocks,
+        double confidenceLevel = 0.95,
+        int horizonDays = 1
+    );
+
 private:
+    /**
+     * Built-in stress shock for a factor label (σ units), see stressTestPosition
+     */
+    static double stressMagnitude(const std::string& label);
+
     /**
      * Risk adjustment weights for regime classification
      *
@@ -278,6 +512,8 @@ private:
     static constexpr double CURVE_FLAT = 0.0;
     static constexpr double SPREAD_TIGHT = 100.0; // BAA-AAA in bps
     static constexpr double SPREAD_WIDE = 250.0;
+    static constexpr double FRAGILE_VIX = 25.0;
+    static constexpr double FRAGILE_MOVE = 120.0;
 };
 
 #endif // POSITION_SIZER_HPP
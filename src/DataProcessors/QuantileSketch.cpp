@@ -0,0 +1,282 @@
+//
+//  QuantileSketch.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the t-digest and rolling quantile sketch
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "QuantileSketch.hpp"
+#include "../Storage/BinaryIO.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// ===== TDigest Implementation =====
+
+TDigest::TDigest(double compression)
+    : compression_(compression),
+      min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {
+    if (!(compression >= 10.0)) {
+        throw std::invalid_argument("t-digest compression must be at least 10");
+    }
+    bufferLimit_ = static_cast<size_t>(5.0 * compression);
+    buffer_.reserve(bufferLimit_);
+}
+
+void TDigest::add(double value, double weight) {
+    if (std::isnan(value)) {
+        return;
+    }
+    if (!(weight > 0.0)) {
+        throw std::invalid_argument("t-digest weights must be positive");
+    }
+    buffer_.push_back({value, weight});
+    totalWeight_ += weight;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= bufferLimit_) {
+        flush();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.empty()) {
+        return;
+    }
+    other.flush();
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    totalWeight_ += other.totalWeight_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    flush();
+}
+
+void TDigest::flush() const {
+    if (buffer_.empty()) {
+        return;
+    }
+    // Centroids are already sorted: sort only the new points and merge
+    auto byMean = [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; };
+    std::sort(buffer_.begin(), buffer_.end(), byMean);
+    merged_.resize(buffer_.size() + centroids_.size());
+    std::merge(buffer_.begin(), buffer_.end(), centroids_.begin(), centroids_.end(), merged_.begin(), byMean);
+
+    double total = 0.0;
+    for (const Centroid& centroid : merged_) {
+        total += centroid.weight;
+    }
+
+    // Greedy left-to-right pass: a centroid may span at most one unit of
+    // k(q) = δ/2π · asin(2q − 1), which is finest at the tails
+    const double scale = compression_ / (2.0 * M_PI);
+    auto limitFrom = [&](double weightSoFar) {
+        const double k = scale * std::asin(std::min(1.0, 2.0 * weightSoFar / total - 1.0)) + 1.0;
+        return k >= compression_ / 4.0 ? 1.0 : (std::sin(k / scale) + 1.0) / 2.0;
+    };
+
+    centroids_.clear();
+    Centroid current = merged_.front();
+    double weightSoFar = 0.0;
+    double qLimit = limitFrom(weightSoFar);
+    for (size_t i = 1; i < merged_.size(); i++) {
+        const Centroid& next = merged_[i];
+        const double proposed = current.weight + next.weight;
+        if ((weightSoFar + proposed) / total <= qLimit) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed;
+            current.weight = proposed;
+        } else {
+            weightSoFar += current.weight;
+            centroids_.push_back(current);
+            current = next;
+            qLimit = limitFrom(weightSoFar);
+        }
+    }
+    centroids_.push_back(current);
+    buffer_.clear();
+}
+
+double TDigest::quantile(double q) const {
+    if (!(q >= 0.0 && q <= 1.0)) {
+        throw std::invalid_argument("Quantile probability must be in [0, 1]");
+    }
+    if (empty()) {
+        throw std::logic_error("Quantile of an empty t-digest");
+    }
+    flush();
+
+    // Each centroid's weight is spread evenly around its mean; interpolate
+    // between neighbouring means, and against min/max at the ends
+    const double index = q * totalWeight_;
+    if (index <= 0.0) {
+        return min_;
+    }
+    if (index >= totalWeight_) {
+        return max_;
+    }
+
+    const Centroid& first = centroids_.front();
+    if (index < first.weight / 2.0) {
+        return min_ + (first.mean - min_) * index / (first.weight / 2.0);
+    }
+
+    double cumulative = first.weight / 2.0;
+    for (size_t i = 0; i + 1 < centroids_.size(); i++) {
+        const double gap = (centroids_[i].weight + centroids_[i + 1].weight) / 2.0;
+        if (index < cumulative + gap) {
+            return centroids_[i].mean + (centroids_[i + 1].mean - centroids_[i].mean) * (index - cumulative) / gap;
+        }
+        cumulative += gap;
+    }
+
+    const Centroid& last = centroids_.back();
+    return last.mean + (max_ - last.mean) * (index - cumulative) / (last.weight / 2.0);
+}
+
+size_t TDigest::centroidCount() const {
+    flush();
+    return centroids_.size();
+}
+
+void TDigest::clear() {
+    centroids_.clear();
+    buffer_.clear();
+    totalWeight_ = 0.0;
+    min_ = std::numeric_limits<double>::infinity();
+    max_ = -std::numeric_limits<double>::infinity();
+}
+
+void TDigest::serialize(ByteWriter& writer) const {
+    writer.put<double>(compression_);
+    writer.put<double>(totalWeight_);
+    writer.put<double>(min_);
+    writer.put<double>(max_);
+    for (const std::vector<Centroid>* list : {&centroids_, &buffer_}) {
+        writer.put<uint64_t>(list->size());
+        for (const Centroid& centroid : *list) {
+            writer.put<double>(centroid.mean);
+            writer.put<double>(centroid.weight);
+        }
+    }
+}
+
+TDigest TDigest::deserialize(ByteReader& reader) {
+    const double compression = reader.get<double>();
+    if (!(compression >= 10.0)) {
+        throw std::runtime_error("t-digest record has an invalid compression");
+    }
+    TDigest digest(compression);
+    digest.totalWeight_ = reader.get<double>();
+    digest.min_ = reader.get<double>();
+    digest.max_ = reader.get<double>();
+    for (std::vector<Centroid>* list : {&digest.centroids_, &digest.buffer_}) {
+        const uint64_t size = reader.get<uint64_t>();
+        if (size > reader.remaining() / (2 * sizeof(double))) {
+            throw std::runtime_error("t-digest record is truncated");
+        }
+        list->resize(size);
+        for (Centroid& centroid : *list) {
+            centroid.mean = reader.get<double>();
+            centroid.weight = reader.get<double>();
+        }
+    }
+    if (digest.buffer_.size() >= digest.bufferLimit_ || !(digest.totalWeight_ >= 0.0)) {
+        throw std::runtime_error("t-digest record is inconsistent");
+    }
+    return digest;
+}
+
+// ===== RollingQuantileSketch Implementation =====
+
+RollingQuantileSketch::RollingQuantileSketch(size_t windowLength, size_t numBlocks, double compression)
+    : windowLength_(windowLength),
+      numBlocks_(numBlocks),
+      blockLength_(numBlocks == 0 ? 0 : (windowLength + numBlocks - 1) / numBlocks),
+      maxCompleted_(0),
+      compression_(compression),
+      completedMerged_(compression),
+      current_(compression),
+      view_(compression) {
+    if (numBlocks < 2) {
+        throw std::invalid_argument("Rolling quantile sketch needs at least two blocks");
+    }
+    if (windowLength < numBlocks) {
+        throw std::invalid_argument("Rolling quantile window must be at least one point per block");
+    }
+    // Largest k with k full blocks plus B − 1 newer points still within W
+    maxCompleted_ = (windowLength + 1) / blockLength_ - 1;
+}
+
+void RollingQuantileSketch::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    current_.add(value);
+    if (++currentCount_ < blockLength_) {
+        view_.add(value);
+        return;
+    }
+
+    // Roll over: retire the oldest block and rebuild the cached merges once
+    completed_.push_back(std::move(current_));
+    if (completed_.size() > maxCompleted_) {
+        completed_.pop_front();
+    }
+    completedMerged_.clear();
+    for (const TDigest& block : completed_) {
+        completedMerged_.merge(block);
+    }
+    view_ = completedMerged_;
+    current_ = TDigest(compression_);
+    currentCount_ = 0;
+}
+
+double RollingQuantileSketch::quantile(double q) const {
+    if (count() == 0) {
+        throw std::logic_error("Quantile of an empty rolling window");
+    }
+    return view_.quantile(q);
+}
+
+size_t RollingQuantileSketch::count() const {
+    return completed_.size() * blockLength_ + currentCount_;
+}
+
+void RollingQuantileSketch::serialize(ByteWriter& writer) const {
+    writer.put<uint64_t>(windowLength_);
+    writer.put<uint64_t>(numBlocks_);
+    writer.put<double>(compression_);
+    writer.put<uint64_t>(currentCount_);
+    writer.put<uint64_t>(completed_.size());
+    for (const TDigest& block : completed_) {
+        block.serialize(writer);
+    }
+    completedMerged_.serialize(writer);
+    current_.serialize(writer);
+    view_.serialize(writer);
+}
+
+RollingQuantileSketch RollingQuantileSketch::deserialize(ByteReader& reader) {
+    const uint64_t windowLength = reader.get<uint64_t>();
+    const uint64_t numBlocks = reader.get<uint64_t>();
+    const double compression = reader.get<double>();
+    if (numBlocks < 2 || windowLength < numBlocks || !(compression >= 10.0)) {
+        throw std::runtime_error("Rolling quantile sketch record has invalid sizing");
+    }
+    RollingQuantileSketch sketch(windowLength, numBlocks, compression);
+    sketch.currentCount_ = reader.get<uint64_t>();
+    const uint64_t completed = reader.get<uint64_t>();
+    if (sketch.currentCount_ >= sketch.blockLength_ || completed > sketch.maxCompleted_) {
+        throw std::runtime_error("Rolling quantile sketch record is inconsistent");
+    }
+    for (uint64_t b = 0; b < completed; b++) {
+        sketch.completed_.push_back(TDigest::deserialize(reader));
+    }
+    sketch.completedMerged_ = TDigest::deserialize(reader);
+    sketch.current_ = TDigest::deserialize(reader);
+    sketch.view_ = TDigest::deserialize(reader);
+    return sketch;
+}
@@ -0,0 +1,180 @@
+//
+//  QuantileSketch.hpp
+//  InvertedYieldCurveTrader
+//
+//  Mergeable quantile sketches: a merging t-digest and a rolling window
+//  built from per-block digests.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+class ByteWriter;
+class ByteReader;
+
+/**
+ * TDigest: Merging t-digest (Dunning & Ertl)
+ *
+ * Points are buffered and folded into a sorted list of centroids once the
+ * buffer fills, so add() is O(1) amortized. Each centroid spans at most
+ * one unit of the scale k(q) = δ/2π · asin(2q − 1), which keeps the tails
+ * nearly exact and bounds the digest to about δ centroids whatever the
+ * stream length. Two digests merge by re-compressing their centroids.
+ */
+class TDigest {
+public:
+    /**
+     * @param compression: Accuracy/size trade-off (δ); about δ centroids at most
+     * @throws std::invalid_argument if compression < 10
+     */
+    explicit TDigest(double compression = 100.0);
+
+    /**
+     * Add one observation (NaN is ignored)
+     *
+     * @throws std::invalid_argument if weight is not positive
+     */
+    void add(double value, double weight = 1.0);
+
+    /**
+     * Fold another digest into this one
+     */
+    void merge(const TDigest& other);
+
+    /**
+     * Estimated q-quantile, interpolating between centroid means
+     *
+     * @param q: Probability in [0, 1]
+     * @throws std::invalid_argument if q is outside [0, 1]
+     * @throws std::logic_error if the digest is empty
+     */
+    double quantile(double q) const;
+
+    double count() const { return totalWeight_; }
+    bool empty() const { return totalWeight_ == 0.0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double compression() const { return compression_; }
+
+    /**
+     * Centroids after flushing the buffer (bounded by the compression)
+     */
+    size_t centroidCount() const;
+
+    void clear();
+
+    /**
+     * Append the digest, unflushed buffer included, so a restored copy
+     * continues bit for bit
+     */
+    void serialize(ByteWriter& writer) const;
+
+    /**
+     * Read a digest written by serialize()
+     *
+     * @throws std::runtime_error on a truncated or inconsistent record
+     */
+    static TDigest deserialize(ByteReader& reader);
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void flush() const;
+
+    double compression_;
+    size_t bufferLimit_;
+    mutable std::vector<Centroid> centroids_;   // Sorted by mean
+    mutable std::vector<Centroid> buffer_;      // Unsorted, not yet merged
+    mutable std::vector<Centroid> merged_;      // Scratch for flush()
+    double totalWeight_ = 0.0;
+    double min_;
+    double max_;
+};
+
+/**
+ * RollingQuantileSketch: Quantiles over the last W observations
+ *
+ * The window is cut into blocks of B = ceil(W / numBlocks) points, each
+ * with its own digest. When the newest block fills, the oldest is dropped
+ * and the completed blocks are re-merged once into a cached digest. A
+ * second cached digest adds each new point to that merge, so a query
+ * reads it directly: updates stay O(1) amortized and memory stays at
+ * (numBlocks + 2) digests. Only as many completed blocks are kept as fit
+ * beside a partly filled one, so the window slides a block at a time,
+ * never holds more than W points, and holds at least minimumCount() once
+ * the first block has rolled off.
+ */
+class RollingQuantileSketch {
+public:
+    /**
+     * @param windowLength: W, observations in the window
+     * @param numBlocks: Blocks per window (granularity of the slide)
+     * @param compression: Per-block digest compression
+     * @throws std::invalid_argument if numBlocks < 2 or windowLength < numBlocks
+     */
+    explicit RollingQuantileSketch(size_t windowLength, size_t numBlocks = 20, double compression = 100.0);
+
+    /**
+     * Add one observation (NaN is ignored)
+     */
+    void add(double value);
+
+    /**
+     * Digest of everything currently in the window (valid until the next add)
+     */
+    const TDigest& window() const { return view_; }
+
+    /**
+     * Estimated q-quantile of the window
+     *
+     * @throws std::logic_error if the window is empty
+     */
+    double quantile(double q) const;
+
+    /**
+     * Observations currently in the window
+     */
+    size_t count() const;
+
+    /**
+     * Fewest observations in the window once it has started to slide
+     */
+    size_t minimumCount() const { return maxCompleted_ * blockLength_; }
+
+    size_t windowLength() const { return windowLength_; }
+
+    /**
+     * Append the window: sizing, every block digest and both caches
+     */
+    void serialize(ByteWriter& writer) const;
+
+    /**
+     * Read a sketch written by serialize()
+     *
+     * @throws std::runtime_error on a truncated or inconsistent record
+     */
+    static RollingQuantileSketch deserialize(ByteReader& reader);
+
+private:
+    size_t windowLength_;
+    size_t numBlocks_;
+    size_t blockLength_;
+    size_t maxCompleted_;               // Full blocks kept: (maxCompleted_ + 1)·B − 1 ≤ W
+    double compression_;
+    std::deque<TDigest> completed_;     // Oldest first
+    TDigest completedMerged_;           // Cache of completed_, rebuilt on roll-over
+    TDigest current_;
+    size_t currentCount_ = 0;
+    TDigest view_;                      // completedMerged_ plus the points in current_
+};
+
+#endif // QUANTILE_SKETCH_HPP
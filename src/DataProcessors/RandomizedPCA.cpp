@@ -0,0 +1,133 @@
+//
+//  RandomizedPCA.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of randomized truncated PCA
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "RandomizedPCA.hpp"
+#include <Eigen/SVD>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * rows × cols standard normal matrix via Box-Muller over mt19937_64, so a
+ * seed yields the same sketch on every standard library
+ */
+Eigen::MatrixXd gaussianMatrix(Eigen::Index rows, Eigen::Index cols, std::mt19937_64& rng) {
+    auto uniform = [&rng]() {
+        return (static_cast<double>(rng() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    };
+
+    Eigen::MatrixXd omega(rows, cols);
+    double* data = omega.data();
+    const Eigen::Index size = omega.size();
+    for (Eigen::Index i = 0; i < size; i += 2) {
+        double radius = std::sqrt(-2.0 * std::log(uniform()));
+        double angle = 2.0 * M_PI * uniform();
+        data[i] = radius * std::cos(angle);
+        if (i + 1 < size) {
+            data[i + 1] = radius * std::sin(angle);
+        }
+    }
+    return omega;
+}
+
+/**
+ * Orthonormal basis for the column space of Y (thin Householder Q)
+ */
+Eigen::MatrixXd orthonormalize(const Eigen::MatrixXd& y) {
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr(y);
+    return qr.householderQ() * Eigen::MatrixXd::Identity(y.rows(), y.cols());
+}
+
+}  // namespace
+
+PrincipalComponents RandomizedPCA::compute(
+    const Eigen::MatrixXd& centered,
+    int numComponents,
+    const RandomizedPCAOptions& options)
+{
+    const Eigen::Index T = centered.rows();
+    const Eigen::Index N = centered.cols();
+
+    if (T < 2 || N < 1) {
+        throw std::invalid_argument("Randomized PCA needs at least 2 observations and 1 indicator");
+    }
+    if (numComponents < 1 || numComponents > std::min(T, N)) {
+        throw std::invalid_argument("numComponents must be between 1 and min(T, N)");
+    }
+    if (options.oversampling < 0 || options.powerIterations < 0 || options.errorProbes < 1) {
+        throw std::invalid_argument("Randomized PCA options must be non-negative (errorProbes >= 1)");
+    }
+
+    const Eigen::Index sketchSize = std::min<Eigen::Index>(numComponents + options.oversampling,
+                                                           std::min(T, N));
+    const double scale = 1.0 / static_cast<double>(T - 1);
+    std::mt19937_64 rng(options.seed);
+
+    // Range finder: Q spans (X Xᵀ)^q X Ω, re-orthonormalized each half-step
+    Eigen::MatrixXd q = orthonormalize(centered * gaussianMatrix(N, sketchSize, rng));
+    for (int i = 0; i < options.powerIterations; i++) {
+        Eigen::MatrixXd z = orthonormalize(centered.transpose() * q);
+        q = orthonormalize(centered * z);
+    }
+
+    // Project: B = Qᵀ X (l × N); Bᵀ = U S Vᵀ gives X's right singular vectors in U
+    Eigen::MatrixXd projectedT = centered.transpose() * q;
+    Eigen::BDCSVD<Eigen::MatrixXd> svd(projectedT, Eigen::ComputeThinU | Eigen::ComputeThinV);
+
+    PrincipalComponents result;
+    result.sketchSize = static_cast<int>(sketchSize);
+    result.components = svd.matrixU().leftCols(numComponents);
+    result.eigenvalues = svd.singularValues().head(numComponents).array().square() * scale;
+    result.totalVariance = centered.squaredNorm() * scale;
+
+    // Residuals r_k = Σ v_k − λ_k v_k, with Σ v_k = Xᵀ (X v_k) / (T − 1)
+    Eigen::MatrixXd sigmaV = centered.transpose() * (centered * result.components) * scale;
+    Eigen::MatrixXd residual = sigmaV - result.components * result.eigenvalues.asDiagonal();
+    result.eigenvalueErrorBounds = residual.colwise().norm().transpose();
+
+    // ‖(I − QQᵀ)X‖₂ ≤ 10·√(2/π)·max_i ‖(I − QQᵀ)X ω_i‖ with probability ≥ 1 − 10^-r
+    Eigen::MatrixXd probes = centered * gaussianMatrix(N, options.errorProbes, rng);
+    Eigen::MatrixXd missed = probes - q * (q.transpose() * probes);
+    double rangeError = 10.0 * std::sqrt(2.0 / M_PI) * missed.colwise().norm().maxCoeff();
+    result.uncapturedVarianceBound = rangeError * rangeError * scale;
+
+    return result;
+}
+
+Eigen::MatrixXd RandomizedPCA::centeredPanel(
+    const std::map<std::string, std::vector<double>>& series,
+    std::vector<std::string>& indicatorNames)
+{
+    if (series.empty()) {
+        throw std::invalid_argument("Surprise panel is empty");
+    }
+
+    const size_t T = series.begin()->second.size();
+    Eigen::MatrixXd panel(static_cast<Eigen::Index>(T), static_cast<Eigen::Index>(series.size()));
+
+    indicatorNames.clear();
+    indicatorNames.reserve(series.size());
+    Eigen::Index column = 0;
+    for (const auto& [name, values] : series) {
+        if (values.size() != T) {
+            throw std::invalid_argument("Surprise series '" + name + "' has " +
+                                        std::to_string(values.size()) + " observations, expected " +
+                                        std::to_string(T));
+        }
+        panel.col(column) = Eigen::Map<const Eigen::VectorXd>(values.data(), static_cast<Eigen::Index>(T));
+        indicatorNames.push_back(name);
+        column++;
+    }
+
+    panel.rowwise() -= panel.colwise().mean();
+    return panel;
+}
@@ -0,0 +1,86 @@
+//
+//  RandomizedPCA.hpp
+//  InvertedYieldCurveTrader
+//
+//  Truncated PCA of a wide surprise panel by randomized range finding
+//  (Halko, Martinsson & Tropp), without forming the N×N covariance.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef RANDOMIZED_PCA_HPP
+#define RANDOMIZED_PCA_HPP
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * RandomizedPCAOptions: Accuracy / cost knobs for the sketch
+ */
+struct RandomizedPCAOptions {
+    int oversampling = 10;          // Extra sketch columns beyond K (p)
+    int powerIterations = 2;        // Subspace iterations (q); sharpens slowly decaying spectra
+    uint64_t seed = 20261018;       // Test-matrix seed (results are deterministic per seed)
+    int errorProbes = 10;           // Gaussian probes for the uncaptured-variance bound
+};
+
+/**
+ * PrincipalComponents: Top-K eigenpairs of Σ = XᵀX / (T − 1) plus a posteriori error bounds
+ *
+ * The bounds need no reference solve. For each k there is an exact
+ * eigenvalue of Σ within eigenvalueErrorBounds(k) of eigenvalues(k)
+ * (residual bound for symmetric matrices). The variance of X in any
+ * direction the sketch missed is at most uncapturedVarianceBound, with
+ * probability at least 1 − 10^-errorProbes.
+ */
+struct PrincipalComponents {
+    Eigen::MatrixXd components;             // N × K orthonormal eigenvectors, descending eigenvalue
+    Eigen::VectorXd eigenvalues;            // K
+    double totalVariance = 0.0;             // tr(Σ)
+
+    Eigen::VectorXd eigenvalueErrorBounds;  // ‖Σ v_k − λ_k v_k‖₂
+    double uncapturedVarianceBound = 0.0;   // ≥ ‖(I − QQᵀ) X‖₂² / (T − 1)
+    int sketchSize = 0;                     // K + p, capped at min(T, N)
+};
+
+/**
+ * RandomizedPCA: Top-K principal components in O(T·N·(K + p)·(q + 1))
+ *
+ * X (T × N, columns centered) is only touched through products X·M and
+ * Xᵀ·M, so memory is O((T + N)(K + p)) beyond X itself. The exact path
+ * (MacroFactorModel::decomposeSurpriseCovariance) needs Σ (N²) and a
+ * dense eigensolve (N³), which stops scaling beyond a few hundred series.
+ */
+class RandomizedPCA {
+public:
+    /**
+     * Top components of a column-centered panel
+     *
+     * @param centered: T × N surprises, each column mean zero
+     * @param numComponents: K ≥ 1, at most min(T, N)
+     * @param options: Oversampling, power iterations, seed
+     * @throws std::invalid_argument on bad shapes or options
+     */
+    static PrincipalComponents compute(
+        const Eigen::MatrixXd& centered,
+        int numComponents,
+        const RandomizedPCAOptions& options = RandomizedPCAOptions()
+    );
+
+    /**
+     * Stack a name → series map into a column-centered T × N matrix
+     *
+     * @param series: Equal-length surprise series (map order = column order)
+     * @param indicatorNames: Filled with the column names
+     * @throws std::invalid_argument if empty or lengths differ
+     */
+    static Eigen::MatrixXd centeredPanel(
+        const std::map<std::string, std::vector<double>>& series,
+        std::vector<std::string>& indicatorNames
+    );
+};
+
+#endif // RANDOMIZED_PCA_HPP
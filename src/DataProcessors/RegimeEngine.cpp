@@ -0,0 +1,380 @@
+//
+//  RegimeEngine.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the streaming regime engine and adaptive thresholds
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "RegimeEngine.hpp"
+#include "../Storage/BinaryIO.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char ENGINE_MAGIC[8] = {'I', 'Y', 'C', 'R', 'G', 'M', 'E', '1'};
+constexpr uint32_t FORMAT_VERSION = 2;   // 2: per-tick thresholds; 1 is read with the defaults
+constexpr char THRESHOLDS_MAGIC[8] = {'I', 'Y', 'C', 'R', 'G', 'A', 'T', '1'};
+constexpr uint32_t THRESHOLDS_FORMAT_VERSION = 1;
+
+void putTick(ByteWriter& writer, const RegimeTick& tick) {
+    writer.put<int32_t>(tick.date);
+    writer.put<double>(tick.vixLevel);
+    writer.put<double>(tick.moveIndex);
+    writer.put<double>(tick.creditSpread);
+    writer.put<double>(tick.yieldCurveSlope);
+    writer.put<double>(tick.putCallRatio);
+}
+
+RegimeTick getTick(ByteReader& reader) {
+    RegimeTick tick;
+    tick.date = reader.get<int32_t>();
+    tick.vixLevel = reader.get<double>();
+    tick.moveIndex = reader.get<double>();
+    tick.creditSpread = reader.get<double>();
+    tick.yieldCurveSlope = reader.get<double>();
+    tick.putCallRatio = reader.get<double>();
+    return tick;
+}
+
+void putThresholds(ByteWriter& writer, const RegimeThresholds& thresholds) {
+    writer.put<double>(thresholds.vixRiskOn);
+    writer.put<double>(thresholds.vixRiskOff);
+    writer.put<double>(thresholds.spreadTight);
+    writer.put<double>(thresholds.spreadWide);
+    writer.put<double>(thresholds.curveFlat);
+    writer.put<double>(thresholds.curveSteep);
+    writer.put<double>(thresholds.fragileVix);
+    writer.put<double>(thresholds.fragileMove);
+}
+
+RegimeThresholds getThresholds(ByteReader& reader) {
+    RegimeThresholds thresholds;
+    thresholds.vixRiskOn = reader.get<double>();
+    thresholds.vixRiskOff = reader.get<double>();
+    thresholds.spreadTight = reader.get<double>();
+    thresholds.spreadWide = reader.get<double>();
+    thresholds.curveFlat = reader.get<double>();
+    thresholds.curveSteep = reader.get<double>();
+    thresholds.fragileVix = reader.get<double>();
+    thresholds.fragileMove = reader.get<double>();
+    return thresholds;
+}
+
+MacroRegime classify(const RegimeTick& tick, const RegimeWeights& weights, const RegimeThresholds& thresholds) {
+    return PositionSizer::classifyRegime(tick.vixLevel, tick.moveIndex, tick.creditSpread,
+                                         tick.yieldCurveSlope, tick.putCallRatio, weights, thresholds);
+}
+
+// Check magic and trailing checksum; the reader covers the body after the magic
+ByteReader openSnapshot(const std::string& bytes, const char (&magic)[8], const std::string& what) {
+    if (bytes.size() < sizeof(magic) + sizeof(uint32_t) || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a " + what);
+    }
+    const size_t body = bytes.size() - sizeof(uint32_t);
+    uint32_t stored;
+    std::memcpy(&stored, bytes.data() + body, sizeof(stored));
+    if (stored != fnv1a32(bytes.data(), body)) {
+        throw std::runtime_error("Checksum mismatch in " + what);
+    }
+    return ByteReader(bytes.data() + sizeof(magic), body - sizeof(magic));
+}
+
+void writeSnapshot(const std::string& path, const std::string& bytes, const std::string& what) {
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot write " + what + " " + tempPath);
+        }
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out.good()) {
+            std::remove(tempPath.c_str());
+            throw std::runtime_error("Failed to write " + what + " " + tempPath);
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace " + what + " " + path);
+    }
+}
+
+std::string readSnapshot(const std::string& path, const std::string& what) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Cannot open " + what + " " + path);
+    }
+    std::ostringstream bytes;
+    bytes << in.rdbuf();
+    return bytes.str();
+}
+
+// Percentile of a rolling window, or the fixed default until the window is warm
+double thresholdFrom(const TDigest& window, size_t minObservations, double percentile, double fallback) {
+    return window.count() >= static_cast<double>(minObservations) ? window.quantile(percentile) : fallback;
+}
+
+}  // namespace
+
+RegimeEngine::RegimeEngine(const RegimeWeights& weights, const RegimeThresholds& thresholds)
+    : weights_(weights), thresholds_(thresholds) {}
+
+const MacroRegime& RegimeEngine::observe(const RegimeTick& tick) {
+    if (hasRegime_ && tick.date <= lastTick_.date) {
+        throw std::invalid_argument("Regime tick " + std::to_string(tick.date) +
+                                    " does not follow " + std::to_string(lastTick_.date));
+    }
+
+    MacroRegime regime = classify(tick, weights_, thresholds_);
+    if (hasRegime_ && regime.riskLabel == regime_.riskLabel) {
+        daysInCurrentRegime_++;
+    } else {
+        if (hasRegime_) {
+            regimeChanges_++;
+        }
+        daysInCurrentRegime_ = 1;
+    }
+
+    if (hasRegime_) {
+        previousTick_ = lastTick_;
+        previousThresholds_ = lastThresholds_;
+        previousRegime_ = std::move(regime_);
+        hasPreviousRegime_ = true;
+    }
+    lastTick_ = tick;
+    lastThresholds_ = thresholds_;
+    regime_ = std::move(regime);
+    hasRegime_ = true;
+    return regime_;
+}
+
+double RegimeEngine::rebalance(double recommendedNotional) {
+    if (!hasRegime_) {
+        throw std::logic_error("Observe a regime tick before rebalancing");
+    }
+    currentSize_ = sized_
+        ? PositionSizer::applyHysteresis(currentSize_, recommendedNotional,
+                                         hasPreviousRegime_ ? previousRegime_ : regime_,
+                                         regime_, daysInCurrentRegime_)
+        : recommendedNotional;
+    sized_ = true;
+    return currentSize_;
+}
+
+const MacroRegime& RegimeEngine::regime() const {
+    if (!hasRegime_) {
+        throw std::logic_error("No regime tick observed yet");
+    }
+    return regime_;
+}
+
+// ===== Snapshot =====
+
+std::string RegimeEngine::serialize() const {
+    ByteWriter writer;
+    writer.putBytes(ENGINE_MAGIC, sizeof(ENGINE_MAGIC));
+    writer.put<uint32_t>(FORMAT_VERSION);
+    writer.put<double>(weights_.vix);
+    writer.put<double>(weights_.move);
+    writer.put<double>(weights_.spread);
+    writer.put<double>(weights_.curve);
+    writer.put<double>(weights_.putCall);
+    putThresholds(writer, thresholds_);
+    writer.put<uint8_t>(hasRegime_);
+    writer.put<uint8_t>(hasPreviousRegime_);
+    writer.put<uint8_t>(sized_);
+    putTick(writer, lastTick_);
+    putThresholds(writer, lastThresholds_);
+    putTick(writer, previousTick_);
+    putThresholds(writer, previousThresholds_);
+    writer.put<int32_t>(daysInCurrentRegime_);
+    writer.put<int64_t>(regimeChanges_);
+    writer.put<double>(currentSize_);
+    writer.put<uint32_t>(fnv1a32(writer.bytes().data(), writer.size()));
+    return writer.bytes();
+}
+
+RegimeEngine RegimeEngine::deserialize(const std::string& bytes) {
+    ByteReader reader = openSnapshot(bytes, ENGINE_MAGIC, "regime engine snapshot");
+    const uint32_t version = reader.get<uint32_t>();
+    if (version != FORMAT_VERSION && version != 1) {
+        throw std::runtime_error("Unsupported regime engine snapshot version " + std::to_string(version));
+    }
+
+    RegimeWeights weights;
+    weights.vix = reader.get<double>();
+    weights.move = reader.get<double>();
+    weights.spread = reader.get<double>();
+    weights.curve = reader.get<double>();
+    weights.putCall = reader.get<double>();
+
+    const bool hasThresholds = version >= 2;
+    const RegimeThresholds defaults = PositionSizer::defaultRegimeThresholds();
+
+    RegimeEngine engine(weights, hasThresholds ? getThresholds(reader) : defaults);
+    engine.hasRegime_ = reader.get<uint8_t>() != 0;
+    engine.hasPreviousRegime_ = reader.get<uint8_t>() != 0;
+    engine.sized_ = reader.get<uint8_t>() != 0;
+    engine.lastTick_ = getTick(reader);
+    engine.lastThresholds_ = hasThresholds ? getThresholds(reader) : defaults;
+    engine.previousTick_ = getTick(reader);
+    engine.previousThresholds_ = hasThresholds ? getThresholds(reader) : defaults;
+    engine.daysInCurrentRegime_ = reader.get<int32_t>();
+    engine.regimeChanges_ = reader.get<int64_t>();
+    engine.currentSize_ = reader.get<double>();
+    if (reader.remaining() != 0) {
+        throw std::runtime_error("Regime engine snapshot has trailing bytes");
+    }
+
+    // Labels are a pure function of the tick, so they are rebuilt rather than stored
+    if (engine.hasRegime_) {
+        engine.regime_ = classify(engine.lastTick_, weights, engine.lastThresholds_);
+    }
+    if (engine.hasPreviousRegime_) {
+        engine.previousRegime_ = classify(engine.previousTick_, weights, engine.previousThresholds_);
+    }
+    return engine;
+}
+
+void RegimeEngine::save(const std::string& path) const {
+    writeSnapshot(path, serialize(), "regime engine snapshot");
+}
+
+RegimeEngine RegimeEngine::load(const std::string& path) {
+    return deserialize(readSnapshot(path, "regime engine snapshot"));
+}
+
+// ===== AdaptiveRegimeThresholds Implementation =====
+
+AdaptiveRegimeThresholds::AdaptiveRegimeThresholds(const AdaptiveThresholdOptions& options)
+    : options_(options),
+      vix_(options.windowDays, options.numBlocks, options.compression),
+      move_(options.windowDays, options.numBlocks, options.compression),
+      spread_(options.windowDays, options.numBlocks, options.compression),
+      curve_(options.windowDays, options.numBlocks, options.compression),
+      thresholds_(PositionSizer::defaultRegimeThresholds()) {
+    for (double percentile : {options.vixRiskOn, options.vixRiskOff, options.spreadTight, options.spreadWide,
+                              options.curveFlat, options.curveSteep, options.fragileVix, options.fragileMove}) {
+        if (!(percentile >= 0.0 && percentile <= 1.0)) {
+            throw std::invalid_argument("Adaptive threshold percentiles must be in [0, 1]");
+        }
+    }
+    if (options.vixRiskOn > options.vixRiskOff || options.spreadTight > options.spreadWide ||
+        options.curveFlat > options.curveSteep) {
+        throw std::invalid_argument("Adaptive threshold lower percentiles must not exceed upper ones");
+    }
+    // The window shrinks by a block on each roll-over; stay warm through it
+    if (options.minObservations == 0 || options.minObservations > vix_.minimumCount()) {
+        throw std::invalid_argument("Adaptive threshold minObservations must fit in the sliding window");
+    }
+}
+
+const RegimeThresholds& AdaptiveRegimeThresholds::observe(const RegimeTick& tick) {
+    vix_.add(tick.vixLevel);
+    move_.add(tick.moveIndex);
+    spread_.add(tick.creditSpread);
+    curve_.add(tick.yieldCurveSlope);
+
+    // Each sketch keeps its merged view current; read off each percentile
+    const RegimeThresholds defaults = PositionSizer::defaultRegimeThresholds();
+    const size_t minimum = options_.minObservations;
+    const TDigest& vix = vix_.window();
+    const TDigest& move = move_.window();
+    const TDigest& spread = spread_.window();
+    const TDigest& curve = curve_.window();
+
+    thresholds_.vixRiskOn = thresholdFrom(vix, minimum, options_.vixRiskOn, defaults.vixRiskOn);
+    thresholds_.vixRiskOff = thresholdFrom(vix, minimum, options_.vixRiskOff, defaults.vixRiskOff);
+    thresholds_.fragileVix = thresholdFrom(vix, minimum, options_.fragileVix, defaults.fragileVix);
+    thresholds_.fragileMove = thresholdFrom(move, minimum, options_.fragileMove, defaults.fragileMove);
+    thresholds_.spreadTight = thresholdFrom(spread, minimum, options_.spreadTight, defaults.spreadTight);
+    thresholds_.spreadWide = thresholdFrom(spread, minimum, options_.spreadWide, defaults.spreadWide);
+    thresholds_.curveFlat = thresholdFrom(curve, minimum, options_.curveFlat, defaults.curveFlat);
+    thresholds_.curveSteep = thresholdFrom(curve, minimum, options_.curveSteep, defaults.curveSteep);
+    return thresholds_;
+}
+
+bool AdaptiveRegimeThresholds::isWarm() const {
+    const size_t minimum = options_.minObservations;
+    return vix_.count() >= minimum && move_.count() >= minimum &&
+           spread_.count() >= minimum && curve_.count() >= minimum;
+}
+
+// ===== Adaptive Threshold Snapshot =====
+
+std::string AdaptiveRegimeThresholds::serialize() const {
+    ByteWriter writer;
+    writer.putBytes(THRESHOLDS_MAGIC, sizeof(THRESHOLDS_MAGIC));
+    writer.put<uint32_t>(THRESHOLDS_FORMAT_VERSION);
+    writer.put<uint64_t>(options_.windowDays);
+    writer.put<uint64_t>(options_.minObservations);
+    writer.put<uint64_t>(options_.numBlocks);
+    writer.put<double>(options_.compression);
+    writer.put<double>(options_.vixRiskOn);
+    writer.put<double>(options_.vixRiskOff);
+    writer.put<double>(options_.spreadTight);
+    writer.put<double>(options_.spreadWide);
+    writer.put<double>(options_.curveFlat);
+    writer.put<double>(options_.curveSteep);
+    writer.put<double>(options_.fragileVix);
+    writer.put<double>(options_.fragileMove);
+    putThresholds(writer, thresholds_);
+    for (const RollingQuantileSketch* sketch : {&vix_, &move_, &spread_, &curve_}) {
+        sketch->serialize(writer);
+    }
+    writer.put<uint32_t>(fnv1a32(writer.bytes().data(), writer.size()));
+    return writer.bytes();
+}
+
+AdaptiveRegimeThresholds AdaptiveRegimeThresholds::deserialize(const std::string& bytes) {
+    ByteReader reader = openSnapshot(bytes, THRESHOLDS_MAGIC, "adaptive threshold snapshot");
+    const uint32_t version = reader.get<uint32_t>();
+    if (version != THRESHOLDS_FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported adaptive threshold snapshot version " + std::to_string(version));
+    }
+
+    AdaptiveThresholdOptions options;
+    options.windowDays = reader.get<uint64_t>();
+    options.minObservations = reader.get<uint64_t>();
+    options.numBlocks = reader.get<uint64_t>();
+    options.compression = reader.get<double>();
+    options.vixRiskOn = reader.get<double>();
+    options.vixRiskOff = reader.get<double>();
+    options.spreadTight = reader.get<double>();
+    options.spreadWide = reader.get<double>();
+    options.curveFlat = reader.get<double>();
+    options.curveSteep = reader.get<double>();
+    options.fragileVix = reader.get<double>();
+    options.fragileMove = reader.get<double>();
+
+    AdaptiveRegimeThresholds adaptive = [&] {
+        try {
+            return AdaptiveRegimeThresholds(options);
+        } catch (const std::invalid_argument& e) {
+            throw std::runtime_error(std::string("Adaptive threshold snapshot has invalid options: ") + e.what());
+        }
+    }();
+    adaptive.thresholds_ = getThresholds(reader);
+    for (RollingQuantileSketch* sketch : {&adaptive.vix_, &adaptive.move_, &adaptive.spread_, &adaptive.curve_}) {
+        RollingQuantileSketch stored = RollingQuantileSketch::deserialize(reader);
+        if (stored.windowLength() != options.windowDays || stored.minimumCount() != sketch->minimumCount()) {
+            throw std::runtime_error("Adaptive threshold snapshot window does not match its options");
+        }
+        *sketch = std::move(stored);
+    }
+    if (reader.remaining() != 0) {
+        throw std::runtime_error("Adaptive threshold snapshot has trailing bytes");
+    }
+    return adaptive;
+}
+
+void AdaptiveRegimeThresholds::save(const std::string& path) const {
+    writeSnapshot(path, serialize(), "adaptive threshold snapshot");
+}
+
+AdaptiveRegimeThresholds AdaptiveRegimeThresholds::load(const std::string& path) {
+    return deserialize(readSnapshot(path, "adaptive threshold snapshot"));
+}
@@ -0,0 +1,223 @@
+//
+//  RegimeEngine.hpp
+//  InvertedYieldCurveTrader
+//
+//  Streaming regime classification with dwell time and hysteresis-smoothed
+//  sizing, a binary snapshot so a daemon or backtest can resume, and
+//  label thresholds that adapt to rolling percentiles of each input.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef REGIME_ENGINE_HPP
+#define REGIME_ENGINE_HPP
+
+#include "PositionSizer.hpp"
+#include "QuantileSketch.hpp"
+#include <cstdint>
+#include <string>
+
+/**
+ * RegimeTick: One day of market observables
+ */
+struct RegimeTick {
+    int32_t date;              // YYYYMMDD
+    double vixLevel;
+    double moveIndex;
+    double creditSpread;       // bps
+    double yieldCurveSlope;    // 2s10s, bps
+    double putCallRatio;
+};
+
+/**
+ * RegimeEngine: Stateful wrapper around classifyRegime and applyHysteresis
+ *
+ * observe() classifies one tick and tracks how many consecutive days the
+ * risk label has held. rebalance() passes the day's recommended size
+ * through applyHysteresis against the size the engine last returned. Both
+ * are O(1) and keep no history.
+ *
+ * The state is the last two ticks with the thresholds each was classified
+ * under, the dwell counter, the change count and the current size.
+ * serialize() writes it as a small checksummed record, and deserialize()
+ * recomputes both regimes from the stored ticks, so a restarted process
+ * continues exactly where it stopped.
+ */
+class RegimeEngine {
+public:
+    /**
+     * @param weights: Volatility multiplier weights passed to classifyRegime
+     * @param thresholds: Label thresholds passed to classifyRegime
+     */
+    explicit RegimeEngine(const RegimeWeights& weights = PositionSizer::defaultRegimeWeights(),
+                          const RegimeThresholds& thresholds = PositionSizer::defaultRegimeThresholds());
+
+    /**
+     * Classify today's observables and update the dwell time
+     *
+     * @param tick: Today's VIX, MOVE, spread, curve and put/call
+     * @return Today's regime (valid until the next observe)
+     * @throws std::invalid_argument if the date does not advance
+     */
+    const MacroRegime& observe(const RegimeTick& tick);
+
+    /**
+     * Apply hysteresis to today's recommended size and make it current
+     *
+     * The first call adopts the recommendation as is.
+     *
+     * @param recommendedNotional: Output of computePositionSize for today's regime
+     * @return Size to hold
+     * @throws std::logic_error if no tick has been observed
+     */
+    double rebalance(double recommendedNotional);
+
+    /**
+     * Thresholds for the next observe() (e.g. from AdaptiveRegimeThresholds)
+     *
+     * Ticks already observed keep the thresholds they were classified with.
+     */
+    void setThresholds(const RegimeThresholds& thresholds) { thresholds_ = thresholds; }
+
+    bool hasRegime() const { return hasRegime_; }
+    const MacroRegime& regime() const;
+    int daysInCurrentRegime() const { return daysInCurrentRegime_; }
+    int64_t regimeChanges() const { return regimeChanges_; }
+    bool isSized() const { return sized_; }
+    double currentSize() const { return currentSize_; }
+    int32_t lastDate() const { return hasRegime_ ? lastTick_.date : 0; }
+    const RegimeWeights& weights() const { return weights_; }
+    const RegimeThresholds& thresholds() const { return thresholds_; }
+
+    /**
+     * Snapshot of the engine state (magic, version, fields, FNV-1a checksum)
+     */
+    std::string serialize() const;
+
+    /**
+     * Restore an engine from serialize() output
+     *
+     * @throws std::runtime_error on a bad magic, version or checksum, or a truncated record
+     */
+    static RegimeEngine deserialize(const std::string& bytes);
+
+    /**
+     * Write the snapshot via temp file + rename
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * Read a snapshot written by save()
+     */
+    static RegimeEngine load(const std::string& path);
+
+private:
+    RegimeWeights weights_;
+    RegimeThresholds thresholds_;
+    RegimeTick lastTick_{};
+    RegimeTick previousTick_{};
+    RegimeThresholds lastThresholds_{};
+    RegimeThresholds previousThresholds_{};
+    MacroRegime regime_{};
+    MacroRegime previousRegime_{};      // Yesterday's, for applyHysteresis
+    bool hasRegime_ = false;
+    bool hasPreviousRegime_ = false;
+    int daysInCurrentRegime_ = 0;
+    int64_t regimeChanges_ = 0;
+    double currentSize_ = 0.0;
+    bool sized_ = false;
+};
+
+/**
+ * AdaptiveThresholdOptions: Rolling windows and percentiles for adaptive thresholds
+ *
+ * Each RegimeThresholds field becomes the given percentile of its own
+ * variable over the trailing window.
+ */
+struct AdaptiveThresholdOptions {
+    size_t windowDays = 2520;              // ~10 years of trading days
+    size_t minObservations = 252;          // Fixed thresholds until a year of history
+    size_t numBlocks = 20;                 // Window slides in windowDays / numBlocks steps
+    double compression = 100.0;            // t-digest δ per block
+
+    double vixRiskOn = 0.10;
+    double vixRiskOff = 0.90;
+    double spreadTight = 0.25;
+    double spreadWide = 0.85;
+    double curveFlat = 0.20;
+    double curveSteep = 0.80;
+    double fragileVix = 0.80;
+    double fragileMove = 0.80;
+};
+
+/**
+ * AdaptiveRegimeThresholds: Regime thresholds from rolling quantile sketches
+ *
+ * Keeps one RollingQuantileSketch each for VIX, MOVE, spread and curve.
+ * observe() is O(1) amortized and memory is fixed by the options, so the
+ * same object runs in the daemon or across decades of backtest. A
+ * variable with fewer than minObservations points in its window (or only
+ * NaNs) keeps its PositionSizer default. serialize() stores the window
+ * digests so a restarted daemon resumes without replaying history.
+ */
+class AdaptiveRegimeThresholds {
+public:
+    /**
+     * @throws std::invalid_argument if a percentile is outside [0, 1], a
+     *         lower percentile exceeds its upper one, the window is invalid,
+     *         or minObservations exceeds the fewest points a sliding window
+     *         holds (RollingQuantileSketch::minimumCount)
+     */
+    explicit AdaptiveRegimeThresholds(const AdaptiveThresholdOptions& options = AdaptiveThresholdOptions());
+
+    /**
+     * Add today's observables to the windows and refresh the thresholds
+     *
+     * @return Thresholds including today (valid until the next observe)
+     */
+    const RegimeThresholds& observe(const RegimeTick& tick);
+
+    const RegimeThresholds& current() const { return thresholds_; }
+
+    /**
+     * True once every variable has minObservations points in its window
+     */
+    bool isWarm() const;
+
+    const AdaptiveThresholdOptions& options() const { return options_; }
+
+    /**
+     * Snapshot of the options, current thresholds and every window digest
+     * (magic, version, fields, FNV-1a checksum). Save it next to the
+     * RegimeEngine snapshot; a restored object continues exactly.
+     */
+    std::string serialize() const;
+
+    /**
+     * Restore from serialize() output
+     *
+     * @throws std::runtime_error on a bad magic, version or checksum,
+     *         invalid options or a truncated record
+     */
+    static AdaptiveRegimeThresholds deserialize(const std::string& bytes);
+
+    /**
+     * Write the snapshot via temp file + rename
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * Read a snapshot written by save()
+     */
+    static AdaptiveRegimeThresholds load(const std::string& path);
+
+private:
+    AdaptiveThresholdOptions options_;
+    RollingQuantileSketch vix_;
+    RollingQuantileSketch move_;
+    RollingQuantileSketch spread_;
+    RollingQuantileSketch curve_;
+    RegimeThresholds thresholds_;
+};
+
+#endif // REGIME_ENGINE_HPP
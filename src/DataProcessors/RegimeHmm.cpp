@@ -0,0 +1,330 @@
+//
+//  RegimeHmm.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the Gaussian HMM regime model and online filter
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "RegimeHmm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+constexpr int D = GaussianHmm::NUM_VARIABLES;
+constexpr double PROBABILITY_FLOOR = 1e-12;     // Keeps every transition reachable
+
+Eigen::MatrixXd observationMatrix(const std::vector<RegimeTick>& history) {
+    Eigen::MatrixXd observations(static_cast<Eigen::Index>(history.size()), D);
+    for (size_t t = 0; t < history.size(); t++) {
+        observations.row(static_cast<Eigen::Index>(t)) = GaussianHmm::observation(history[t]).transpose();
+    }
+    if (!observations.allFinite()) {
+        throw std::invalid_argument("HMM history must not contain NaN or infinite values");
+    }
+    return observations;
+}
+
+// Floor and renormalize each row so no transition becomes impossible
+void normalizeRows(Eigen::MatrixXd& matrix) {
+    matrix = matrix.cwiseMax(PROBABILITY_FLOOR);
+    const Eigen::VectorXd totals = matrix.rowwise().sum();
+    matrix.array().colwise() /= totals.array();
+}
+
+}  // namespace
+
+// ===== GaussianHmm Implementation =====
+
+GaussianHmm::GaussianHmm(const Eigen::VectorXd& initial,
+                         const Eigen::MatrixXd& transition,
+                         const Eigen::MatrixXd& means,
+                         const Eigen::MatrixXd& variances,
+                         const RegimeWeights& weights)
+    : initial_(initial), transition_(transition), means_(means), variances_(variances), weights_(weights) {
+    prepare();
+}
+
+void GaussianHmm::prepare() {
+    const Eigen::Index S = initial_.size();
+    if (S < 1) {
+        throw std::invalid_argument("HMM needs at least one state");
+    }
+    if (transition_.rows() != S || transition_.cols() != S ||
+        means_.rows() != S || means_.cols() != D || variances_.rows() != S || variances_.cols() != D) {
+        throw std::invalid_argument("HMM parameters must be S, S×S, S×5 and S×5");
+    }
+    if (!initial_.allFinite() || initial_.minCoeff() < 0.0 || std::abs(initial_.sum() - 1.0) > 1e-9) {
+        throw std::invalid_argument("HMM initial probabilities must be non-negative and sum to 1");
+    }
+    if (!transition_.allFinite() || transition_.minCoeff() < 0.0 ||
+        (transition_.rowwise().sum().array() - 1.0).abs().maxCoeff() > 1e-9) {
+        throw std::invalid_argument("HMM transition rows must be non-negative and sum to 1");
+    }
+    if (!means_.allFinite() || !variances_.allFinite() || variances_.minCoeff() <= 0.0) {
+        throw std::invalid_argument("HMM means must be finite and variances positive");
+    }
+
+    precisions_ = variances_.cwiseInverse();
+    logNormalizers_ = -0.5 * (2.0 * M_PI * variances_.array()).log().rowwise().sum().matrix();
+
+    stateRegimes_.clear();
+    stateMultipliers_.resize(S);
+    for (Eigen::Index s = 0; s < S; s++) {
+        stateRegimes_.push_back(PositionSizer::classifyRegime(
+            means_(s, 0), means_(s, 1), means_(s, 2), means_(s, 3), means_(s, 4), weights_));
+        stateMultipliers_(s) = stateRegimes_.back().volatilityMultiplier;
+    }
+}
+
+Eigen::VectorXd GaussianHmm::observation(const RegimeTick& tick) {
+    Eigen::VectorXd x(D);
+    x << tick.vixLevel, tick.moveIndex, tick.creditSpread, tick.yieldCurveSlope, tick.putCallRatio;
+    return x;
+}
+
+Eigen::MatrixXd GaussianHmm::emissionLogDensities(const Eigen::MatrixXd& observations) const {
+    // Σ_d (x − μ)²/σ² expanded so every state is one matrix product: S×T
+    const Eigen::MatrixXd weightedMeans = precisions_.cwiseProduct(means_);
+    Eigen::MatrixXd quadratic = precisions_ * observations.array().square().matrix().transpose();
+    quadratic.noalias() -= 2.0 * weightedMeans * observations.transpose();
+    quadratic.colwise() += weightedMeans.cwiseProduct(means_).rowwise().sum();
+    return (-0.5 * quadratic).colwise() + logNormalizers_;
+}
+
+GaussianHmm::ForwardPass GaussianHmm::forward(const Eigen::MatrixXd& observations) const {
+    const Eigen::Index T = observations.rows();
+    const Eigen::Index S = numStates();
+
+    // Shift each day's log-densities by their maximum before exponentiating
+    ForwardPass pass;
+    pass.emission = emissionLogDensities(observations);
+    const Eigen::RowVectorXd shift = pass.emission.colwise().maxCoeff();
+    pass.emission.rowwise() -= shift;
+    pass.emission = pass.emission.array().exp().matrix();
+
+    pass.alpha.resize(S, T);
+    pass.scale.resize(T);
+    for (Eigen::Index t = 0; t < T; t++) {
+        if (t == 0) {
+            pass.alpha.col(0) = initial_.cwiseProduct(pass.emission.col(0));
+        } else {
+            pass.alpha.col(t).noalias() = transition_.transpose() * pass.alpha.col(t - 1);
+            pass.alpha.col(t).array() *= pass.emission.col(t).array();
+        }
+        pass.scale(t) = pass.alpha.col(t).sum();
+        pass.alpha.col(t) /= pass.scale(t);
+    }
+    pass.logLikelihood = pass.scale.array().log().sum() + shift.sum();
+    return pass;
+}
+
+Eigen::MatrixXd GaussianHmm::backward(const ForwardPass& pass) const {
+    const Eigen::Index T = pass.alpha.cols();
+    Eigen::MatrixXd beta(numStates(), T);
+    beta.col(T - 1).setOnes();
+    for (Eigen::Index t = T - 1; t > 0; t--) {
+        beta.col(t - 1).noalias() = transition_ * pass.emission.col(t).cwiseProduct(beta.col(t));
+        beta.col(t - 1) /= pass.scale(t);
+    }
+    return beta;
+}
+
+double GaussianHmm::logLikelihood(const std::vector<RegimeTick>& history) const {
+    if (history.empty()) {
+        return 0.0;
+    }
+    return forward(observationMatrix(history)).logLikelihood;
+}
+
+Eigen::MatrixXd GaussianHmm::filteredProbabilities(const std::vector<RegimeTick>& history) const {
+    if (history.empty()) {
+        return Eigen::MatrixXd(0, numStates());
+    }
+    return forward(observationMatrix(history)).alpha.transpose();
+}
+
+Eigen::MatrixXd GaussianHmm::smoothedProbabilities(const std::vector<RegimeTick>& history) const {
+    if (history.empty()) {
+        return Eigen::MatrixXd(0, numStates());
+    }
+    ForwardPass pass = forward(observationMatrix(history));
+    Eigen::MatrixXd gamma = pass.alpha.cwiseProduct(backward(pass));
+    const Eigen::RowVectorXd totals = gamma.colwise().sum();
+    gamma.array().rowwise() /= totals.array();
+    return gamma.transpose();
+}
+
+double GaussianHmm::volatilityMultiplier(const Eigen::VectorXd& probabilities) const {
+    if (probabilities.size() != numStates()) {
+        throw std::invalid_argument("Expected one probability per HMM state");
+    }
+    return probabilities.dot(stateMultipliers_);
+}
+
+GaussianHmm GaussianHmm::fit(const std::vector<RegimeTick>& history, const HmmOptions& options) {
+    const int S = options.numStates;
+    if (S < 1 || options.maxIterations < 1 || !(options.tolerance >= 0.0) || !(options.varianceFloor > 0.0) ||
+        !(options.initialPersistence >= 0.0 && options.initialPersistence < 1.0)) {
+        throw std::invalid_argument("Invalid HMM options");
+    }
+    if (history.size() < static_cast<size_t>(2 * S)) {
+        throw std::invalid_argument("HMM fit needs at least " + std::to_string(2 * S) + " days of history");
+    }
+
+    const Eigen::MatrixXd X = observationMatrix(history);
+    const Eigen::MatrixXd X2 = X.array().square().matrix();
+    const Eigen::Index T = X.rows();
+
+    const Eigen::RowVectorXd sampleMean = X.colwise().mean();
+    const Eigen::MatrixXd centered = X.rowwise() - sampleMean;
+    const Eigen::RowVectorXd sampleVariance = centered.array().square().colwise().sum() / static_cast<double>(T - 1);
+    const Eigen::RowVectorXd floor = (options.varianceFloor * sampleVariance).cwiseMax(1e-12);
+
+    // Start from S quantile bands of the first principal component
+    const Eigen::MatrixXd standardized = centered.array().rowwise() / sampleVariance.cwiseMax(1e-12).array().sqrt();
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen(standardized.transpose() * standardized);
+    const Eigen::VectorXd scores = standardized * eigen.eigenvectors().col(D - 1);
+    std::vector<Eigen::Index> order(static_cast<size_t>(T));
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](Eigen::Index a, Eigen::Index b) { return scores(a) < scores(b); });
+
+    Eigen::MatrixXd means(S, D);
+    Eigen::MatrixXd variances(S, D);
+    for (int s = 0; s < S; s++) {
+        const size_t begin = static_cast<size_t>(T) * s / S;
+        const size_t end = static_cast<size_t>(T) * (s + 1) / S;
+        Eigen::MatrixXd band(static_cast<Eigen::Index>(end - begin), D);
+        for (size_t i = begin; i < end; i++) {
+            band.row(static_cast<Eigen::Index>(i - begin)) = X.row(order[i]);
+        }
+        means.row(s) = band.colwise().mean();
+        variances.row(s) = ((band.rowwise() - means.row(s)).array().square().colwise().mean().matrix() + floor);
+    }
+
+    Eigen::VectorXd initial = Eigen::VectorXd::Constant(S, 1.0 / S);
+    Eigen::MatrixXd transition = S == 1
+        ? Eigen::MatrixXd::Ones(1, 1)
+        : Eigen::MatrixXd::Constant(S, S, (1.0 - options.initialPersistence) / (S - 1));
+    if (S > 1) {
+        transition.diagonal().setConstant(options.initialPersistence);
+    }
+
+    // Baum-Welch: E-step by scaled forward-backward, closed-form M-step
+    double previous = -std::numeric_limits<double>::infinity();
+    int iterations = 0;
+    bool converged = false;
+    for (int iteration = 0; iteration < options.maxIterations; iteration++) {
+        const GaussianHmm model(initial, transition, means, variances, options.weights);
+        const ForwardPass pass = model.forward(X);
+        if (pass.logLikelihood - previous < options.tolerance * static_cast<double>(T)) {
+            converged = true;
+            break;
+        }
+        previous = pass.logLikelihood;
+
+        const Eigen::MatrixXd beta = model.backward(pass);
+        Eigen::MatrixXd gamma = pass.alpha.cwiseProduct(beta);
+        const Eigen::RowVectorXd totals = gamma.colwise().sum();
+        gamma.array().rowwise() /= totals.array();
+
+        // Expected transitions Σ_t α_t (b_{t+1} ∘ β_{t+1} / c_{t+1})ᵀ ∘ A in one product
+        if (T > 1) {
+            Eigen::MatrixXd next = pass.emission.rightCols(T - 1).cwiseProduct(beta.rightCols(T - 1));
+            next.array().rowwise() /= pass.scale.tail(T - 1).transpose().array();
+            Eigen::MatrixXd counts = transition.cwiseProduct(pass.alpha.leftCols(T - 1) * next.transpose());
+            normalizeRows(counts);
+            transition = counts;
+        }
+
+        initial = gamma.col(0).cwiseMax(PROBABILITY_FLOOR);
+        initial /= initial.sum();
+
+        const Eigen::VectorXd occupancy = gamma.rowwise().sum();
+        const Eigen::MatrixXd firstMoments = gamma * X;
+        const Eigen::MatrixXd secondMoments = gamma * X2;
+        for (int s = 0; s < S; s++) {
+            if (occupancy(s) < 1e-8) {
+                continue;  // Empty state keeps its parameters
+            }
+            means.row(s) = firstMoments.row(s) / occupancy(s);
+            variances.row(s) = (secondMoments.row(s) / occupancy(s) - means.row(s).cwiseProduct(means.row(s)))
+                                   .cwiseMax(floor);
+        }
+        iterations = iteration + 1;
+    }
+
+    // Order states from calmest to most stressed
+    std::vector<int> rank(static_cast<size_t>(S));
+    std::iota(rank.begin(), rank.end(), 0);
+    const GaussianHmm unordered(initial, transition, means, variances, options.weights);
+    std::stable_sort(rank.begin(), rank.end(), [&](int a, int b) {
+        return unordered.stateMultipliers_(a) < unordered.stateMultipliers_(b);
+    });
+    Eigen::MatrixXd P = Eigen::MatrixXd::Zero(S, S);     // Row s of P·M is row rank[s] of M
+    for (int s = 0; s < S; s++) {
+        P(s, rank[s]) = 1.0;
+    }
+
+    GaussianHmm model(P * initial, P * transition * P.transpose(), P * means, P * variances, options.weights);
+    model.trainingLogLikelihood_ = model.forward(X).logLikelihood;
+    model.iterations_ = iterations;
+    model.converged_ = converged;
+    return model;
+}
+
+// ===== HmmRegimeFilter Implementation =====
+
+HmmRegimeFilter::HmmRegimeFilter(const GaussianHmm& model)
+    : model_(model), probabilities_(model.initialProbabilities()) {}
+
+const Eigen::VectorXd& HmmRegimeFilter::update(const RegimeTick& tick) {
+    if (days_ > 0 && tick.date <= lastTick_.date) {
+        throw std::invalid_argument("HMM tick " + std::to_string(tick.date) +
+                                    " does not follow " + std::to_string(lastTick_.date));
+    }
+
+    // Emission over the variables present today
+    const Eigen::VectorXd x = GaussianHmm::observation(tick);
+    const Eigen::ArrayXd present = x.array().isFinite().cast<double>();
+    const Eigen::ArrayXd value = (present > 0.0).select(x.array(), 0.0);
+    const Eigen::ArrayXXd deviation = model_.means_.array().rowwise() - value.transpose();
+    Eigen::ArrayXd logDensity =
+        -0.5 * ((deviation.square() * model_.precisions_.array() +
+                 (2.0 * M_PI * model_.variances_.array()).log()).matrix() * present.matrix()).array();
+    logDensity = (logDensity - logDensity.maxCoeff()).exp();
+
+    // Predict with the transition matrix, then correct
+    Eigen::VectorXd predicted = days_ == 0
+        ? model_.initial_
+        : Eigen::VectorXd(model_.transition_.transpose() * probabilities_);
+    probabilities_ = predicted.cwiseProduct(logDensity.matrix());
+    probabilities_ /= probabilities_.sum();
+
+    lastTick_ = tick;
+    days_++;
+    return probabilities_;
+}
+
+MacroRegime HmmRegimeFilter::regime() const {
+    if (days_ == 0) {
+        throw std::logic_error("Update the HMM filter before reading a regime");
+    }
+    Eigen::Index state;
+    const double confidence = probabilities_.maxCoeff(&state);
+
+    MacroRegime regime = model_.stateRegimes_[static_cast<size_t>(state)];
+    regime.vixLevel = lastTick_.vixLevel;
+    regime.moveIndex = lastTick_.moveIndex;
+    regime.creditSpread = lastTick_.creditSpread;
+    regime.yieldCurveSlope = lastTick_.yieldCurveSlope;
+    regime.putCallRatio = lastTick_.putCallRatio;
+    regime.volatilityMultiplier = volatilityMultiplier();
+    regime.confidence = confidence;
+    return regime;
+}
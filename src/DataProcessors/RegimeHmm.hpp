@@ -0,0 +1,186 @@
+//
+//  RegimeHmm.hpp
+//  InvertedYieldCurveTrader
+//
+//  Gaussian hidden Markov model of market regimes over the daily state
+//  variables, fitted by Baum-Welch, with an O(S²) online filter.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef REGIME_HMM_HPP
+#define REGIME_HMM_HPP
+
+#include "RegimeEngine.hpp"
+#include <Eigen/Dense>
+#include <vector>
+
+/**
+ * HmmOptions: Baum-Welch settings
+ */
+struct HmmOptions {
+    int numStates = 3;
+    int maxIterations = 200;
+    double tolerance = 1e-7;               // Stop when log-likelihood per day improves less
+    double varianceFloor = 1e-3;           // Fraction of each variable's sample variance
+    double initialPersistence = 0.95;      // Starting diagonal of the transition matrix
+    RegimeWeights weights = PositionSizer::defaultRegimeWeights();
+};
+
+/**
+ * GaussianHmm: Hidden Markov regime model with diagonal Gaussian emissions
+ *
+ * Observations are the five RegimeTick variables (VIX, MOVE, spread,
+ * 2s10s, put/call). Forward-backward uses per-day scaling with the
+ * emission log-densities shifted by their daily maximum, so nothing
+ * underflows over decades of history. Each kernel is written across all
+ * states at once: emissions are one T×D by D×S product, the forward and
+ * backward steps are S×S matrix-vector products, and the expected
+ * transition counts are a single S×T by T×S product.
+ *
+ * States are ordered by the volatility multiplier of their mean
+ * observables (state 0 is the calmest), and each state carries the
+ * MacroRegime that classifyRegime assigns to its mean.
+ */
+class GaussianHmm {
+public:
+    static constexpr int NUM_VARIABLES = 5;
+
+    /**
+     * Build a model from explicit parameters
+     *
+     * @param initial: π, S starting probabilities
+     * @param transition: A, S×S row-stochastic, A(i, j) = P(j tomorrow | i today)
+     * @param means: S×5 emission means
+     * @param variances: S×5 emission variances (diagonal covariance)
+     * @param weights: Volatility multiplier weights for the state regimes
+     * @throws std::invalid_argument on mismatched shapes, non-stochastic
+     *         rows or non-positive variances
+     */
+    GaussianHmm(const Eigen::VectorXd& initial,
+                const Eigen::MatrixXd& transition,
+                const Eigen::MatrixXd& means,
+                const Eigen::MatrixXd& variances,
+                const RegimeWeights& weights = PositionSizer::defaultRegimeWeights());
+
+    /**
+     * Fit by Baum-Welch (EM)
+     *
+     * Starting means split the history into S quantile bands of its first
+     * principal component, so the fit is deterministic.
+     *
+     * @param history: Daily ticks, all fields finite
+     * @throws std::invalid_argument if the history is shorter than 2·S days,
+     *         has non-finite values or the options are invalid
+     */
+    static GaussianHmm fit(const std::vector<RegimeTick>& history, const HmmOptions& options = HmmOptions());
+
+    /**
+     * Log-likelihood of a history under the model
+     */
+    double logLikelihood(const std::vector<RegimeTick>& history) const;
+
+    /**
+     * P(state on day t | days 0..t), T×S
+     */
+    Eigen::MatrixXd filteredProbabilities(const std::vector<RegimeTick>& history) const;
+
+    /**
+     * P(state on day t | whole history), T×S
+     */
+    Eigen::MatrixXd smoothedProbabilities(const std::vector<RegimeTick>& history) const;
+
+    /**
+     * Posterior-weighted volatility multiplier Σ_s p_s · m_s
+     */
+    double volatilityMultiplier(const Eigen::VectorXd& probabilities) const;
+
+    int numStates() const { return static_cast<int>(initial_.size()); }
+    const Eigen::VectorXd& initialProbabilities() const { return initial_; }
+    const Eigen::MatrixXd& transitionMatrix() const { return transition_; }
+    const Eigen::MatrixXd& means() const { return means_; }
+    const Eigen::MatrixXd& variances() const { return variances_; }
+    const std::vector<MacroRegime>& stateRegimes() const { return stateRegimes_; }
+
+    // Fit diagnostics (zero / false for a model built from parameters)
+    double trainingLogLikelihood() const { return trainingLogLikelihood_; }
+    int iterations() const { return iterations_; }
+    bool converged() const { return converged_; }
+
+    /**
+     * Five-variable observation vector of a tick
+     */
+    static Eigen::VectorXd observation(const RegimeTick& tick);
+
+private:
+    friend class HmmRegimeFilter;
+
+    struct ForwardPass {
+        Eigen::MatrixXd alpha;           // S×T, each column sums to 1
+        Eigen::MatrixXd emission;        // S×T, exp(log b − daily max)
+        Eigen::VectorXd scale;           // c_t
+        double logLikelihood;
+    };
+
+    void prepare();
+    Eigen::MatrixXd emissionLogDensities(const Eigen::MatrixXd& observations) const;
+    ForwardPass forward(const Eigen::MatrixXd& observations) const;
+    Eigen::MatrixXd backward(const ForwardPass& pass) const;
+
+    Eigen::VectorXd initial_;
+    Eigen::MatrixXd transition_;
+    Eigen::MatrixXd means_;
+    Eigen::MatrixXd variances_;
+    RegimeWeights weights_;
+
+    // Derived
+    Eigen::MatrixXd precisions_;         // 1 / σ², S×5
+    Eigen::VectorXd logNormalizers_;     // −½ Σ_d log 2πσ², per state
+    Eigen::VectorXd stateMultipliers_;
+    std::vector<MacroRegime> stateRegimes_;
+
+    double trainingLogLikelihood_ = 0.0;
+    int iterations_ = 0;
+    bool converged_ = false;
+};
+
+/**
+ * HmmRegimeFilter: Online forward filter over a fitted GaussianHmm
+ *
+ * update() is one S×S predict step and one emission evaluation, O(S² + S·D)
+ * per day with no history kept. Variables that are NaN on a day are left
+ * out of that day's likelihood.
+ */
+class HmmRegimeFilter {
+public:
+    explicit HmmRegimeFilter(const GaussianHmm& model);
+
+    /**
+     * Absorb today's tick
+     *
+     * @return P(state today | days so far)
+     * @throws std::invalid_argument if the date does not advance
+     */
+    const Eigen::VectorXd& update(const RegimeTick& tick);
+
+    /**
+     * Today's regime: labels of the most likely state, today's observables,
+     * the posterior-weighted volatility multiplier and the top probability
+     * as confidence
+     *
+     * @throws std::logic_error before the first update
+     */
+    MacroRegime regime() const;
+
+    const Eigen::VectorXd& probabilities() const { return probabilities_; }
+    double volatilityMultiplier() const { return model_.volatilityMultiplier(probabilities_); }
+    int64_t days() const { return days_; }
+
+private:
+    GaussianHmm model_;
+    Eigen::VectorXd probabilities_;
+    RegimeTick lastTick_{};
+    int64_t days_ = 0;
+};
+
+#endif // REGIME_HMM_HPP
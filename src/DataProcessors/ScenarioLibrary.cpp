@@ -0,0 +1,333 @@
+//
+//  ScenarioLibrary.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the scenario library and stress evaluator
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "ScenarioLibrary.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+void checkKeys(const json& object, const std::vector<std::string>& allowed, const std::string& context) {
+    for (const auto& [key, _] : object.items()) {
+        if (std::find(allowed.begin(), allowed.end(), key) == allowed.end()) {
+            throw std::invalid_argument("Unknown " + context + " key '" + key + "'");
+        }
+    }
+}
+
+// An axis is either a list of values or {"from": a, "to": b, "steps": n}
+std::vector<double> readAxis(const json& axis, const std::string& label) {
+    if (axis.is_array()) {
+        std::vector<double> values = axis.get<std::vector<double>>();
+        if (values.empty()) {
+            throw std::invalid_argument("Grid axis '" + label + "' must not be empty");
+        }
+        return values;
+    }
+    if (!axis.is_object()) {
+        throw std::invalid_argument("Grid axis '" + label + "' must be an array or {from, to, steps}");
+    }
+    checkKeys(axis, {"from", "to", "steps"}, "grid axis");
+    const double from = axis.at("from").get<double>();
+    const double to = axis.at("to").get<double>();
+    const int steps = axis.at("steps").get<int>();
+    if (steps < 1) {
+        throw std::invalid_argument("Grid axis '" + label + "' needs at least one step");
+    }
+    std::vector<double> values(static_cast<size_t>(steps));
+    for (int i = 0; i < steps; i++) {
+        values[i] = steps == 1 ? from : from + (to - from) * i / (steps - 1);
+    }
+    return values;
+}
+
+}  // namespace
+
+// ===== ScenarioLibrary Implementation =====
+
+ScenarioLibrary::ScenarioLibrary(std::vector<std::string> factorLabels)
+    : factorLabels_(std::move(factorLabels)) {
+    if (factorLabels_.empty()) {
+        throw std::invalid_argument("Scenario library needs at least one factor");
+    }
+}
+
+int ScenarioLibrary::findFactor(const std::string& label) const {
+    auto it = std::find(factorLabels_.begin(), factorLabels_.end(), label);
+    if (it == factorLabels_.end()) {
+        return -1;
+    }
+    // Two factors labeled alike (e.g. both "Unclassified") cannot be told apart
+    if (std::find(it + 1, factorLabels_.end(), label) != factorLabels_.end()) {
+        return -2;
+    }
+    return static_cast<int>(it - factorLabels_.begin());
+}
+
+int ScenarioLibrary::factorIndex(const std::string& label) const {
+    const int k = findFactor(label);
+    if (k == -1) {
+        throw std::invalid_argument("Unknown factor label '" + label + "'");
+    }
+    if (k == -2) {
+        throw std::invalid_argument("Factor label '" + label + "' names more than one factor");
+    }
+    return k;
+}
+
+void ScenarioLibrary::addEpisode(const std::string& name, const Eigen::VectorXd& shocks) {
+    if (shocks.size() != numFactors()) {
+        throw std::invalid_argument("Episode '" + name + "' has " + std::to_string(shocks.size()) +
+                                    " shocks, expected " + std::to_string(numFactors()));
+    }
+    if (!shocks.allFinite()) {
+        throw std::invalid_argument("Episode '" + name + "' has non-finite shocks");
+    }
+    segments_.push_back({size(), 1, name, {}, {}});
+    shocks_.insert(shocks_.end(), shocks.data(), shocks.data() + shocks.size());
+}
+
+void ScenarioLibrary::addGrid(const std::string& name,
+                              const std::vector<std::pair<std::string, std::vector<double>>>& axes) {
+    if (axes.empty()) {
+        throw std::invalid_argument("Grid '" + name + "' has no axes");
+    }
+
+    Segment segment{size(), 1, name, {}, {}};
+    for (const auto& [label, values] : axes) {
+        const int factor = factorIndex(label);
+        if (std::find(segment.axisFactors.begin(), segment.axisFactors.end(), factor) != segment.axisFactors.end()) {
+            throw std::invalid_argument("Grid '" + name + "' repeats axis '" + label + "'");
+        }
+        if (values.empty()) {
+            throw std::invalid_argument("Grid axis '" + label + "' must not be empty");
+        }
+        for (double value : values) {
+            if (!std::isfinite(value)) {
+                throw std::invalid_argument("Grid axis '" + label + "' has non-finite values");
+            }
+        }
+        if (segment.numRows > std::numeric_limits<size_t>::max() / values.size()) {
+            throw std::invalid_argument("Grid '" + name + "' is too large");
+        }
+        segment.numRows *= values.size();
+        segment.axisFactors.push_back(factor);
+        segment.axisValues.push_back(values);
+    }
+
+    // Odometer over the axes, last axis fastest
+    const size_t K = factorLabels_.size();
+    const size_t numAxes = axes.size();
+    shocks_.resize(shocks_.size() + segment.numRows * K, 0.0);
+    std::vector<size_t> digit(numAxes, 0);
+    for (size_t row = 0; row < segment.numRows; row++) {
+        double* shock = shocks_.data() + (segment.firstRow + row) * K;
+        for (size_t a = 0; a < numAxes; a++) {
+            shock[segment.axisFactors[a]] = segment.axisValues[a][digit[a]];
+        }
+        for (size_t a = numAxes; a-- > 0;) {
+            if (++digit[a] < segment.axisValues[a].size()) {
+                break;
+            }
+            digit[a] = 0;
+        }
+    }
+    segments_.push_back(std::move(segment));
+}
+
+Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> ScenarioLibrary::shocks() const {
+    return {shocks_.data(), static_cast<Eigen::Index>(size()), static_cast<Eigen::Index>(factorLabels_.size())};
+}
+
+std::string ScenarioLibrary::scenarioName(size_t scenario) const {
+    if (scenario >= size()) {
+        throw std::out_of_range("Scenario " + std::to_string(scenario) + " out of range");
+    }
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), scenario,
+                               [](size_t row, const Segment& segment) { return row < segment.firstRow; });
+    const Segment& segment = *(it - 1);
+    if (segment.axisFactors.empty()) {
+        return segment.name;
+    }
+
+    // Mixed-radix digits of the offset, last axis fastest
+    size_t offset = scenario - segment.firstRow;
+    std::vector<size_t> digit(segment.axisValues.size());
+    for (size_t a = digit.size(); a-- > 0;) {
+        digit[a] = offset % segment.axisValues[a].size();
+        offset /= segment.axisValues[a].size();
+    }
+
+    std::ostringstream name;
+    name << segment.name << " [";
+    for (size_t a = 0; a < digit.size(); a++) {
+        name << (a > 0 ? ", " : "") << factorLabels_[segment.axisFactors[a]] << '='
+             << segment.axisValues[a][digit[a]];
+    }
+    name << ']';
+    return name.str();
+}
+
+ScenarioLibrary ScenarioLibrary::fromSpec(const json& spec, const MacroFactors& factors) {
+    if (!spec.is_object()) {
+        throw std::invalid_argument("Scenario spec must be a JSON object");
+    }
+    checkKeys(spec, {"description", "units", "episodes", "grids"}, "scenario spec");
+
+    const size_t K = factors.factorLabels.size();
+    ScenarioLibrary library(factors.factorLabels);
+
+    // Specs outlive any one factor model: a label the model lacks (or
+    // carries twice) is dropped with a warning rather than failing the load
+    auto resolve = [&](const std::string& label, const std::string& scenario) {
+        const int k = library.findFactor(label);
+        if (k < 0) {
+            Logger::warn(k == -1 ? "Scenario factor not in the model; shock dropped"
+                                 : "Scenario factor label is ambiguous; shock dropped", {
+                {"scenario", scenario},
+                {"factor", label},
+                {"model_factors", factors.factorLabels}
+            });
+        }
+        return k;
+    };
+
+    try {
+        const std::string units = spec.value("units", std::string("sigma"));
+        if (units != "sigma" && units != "factor") {
+            throw std::invalid_argument("Scenario units must be \"sigma\" or \"factor\"");
+        }
+        std::vector<double> scale(K, 1.0);
+        if (units == "sigma") {
+            if (factors.factorVariances.size() != K) {
+                throw std::invalid_argument("Sigma units need one factor variance per label");
+            }
+            for (size_t k = 0; k < K; k++) {
+                scale[k] = std::sqrt(std::max(0.0, factors.factorVariances[k]));
+            }
+        }
+
+        for (const json& episode : spec.value("episodes", json::array())) {
+            checkKeys(episode, {"name", "description", "shocks"}, "episode");
+            const std::string name = episode.at("name").get<std::string>();
+            Eigen::VectorXd shocks = Eigen::VectorXd::Zero(static_cast<Eigen::Index>(K));
+            size_t dropped = 0;
+            for (const auto& [label, value] : episode.at("shocks").items()) {
+                const double shock = value.get<double>();
+                const int k = resolve(label, name);
+                if (k < 0) {
+                    dropped++;
+                    continue;
+                }
+                shocks(k) = shock * scale[k];
+            }
+            if (dropped > 0 && dropped == episode.at("shocks").size()) {
+                Logger::warn("Scenario episode has no factors in the model; skipped", {{"scenario", name}});
+                continue;
+            }
+            library.addEpisode(name, shocks);
+        }
+
+        for (const json& grid : spec.value("grids", json::array())) {
+            checkKeys(grid, {"name", "description", "axes"}, "grid");
+            const std::string name = grid.at("name").get<std::string>();
+            std::vector<std::pair<std::string, std::vector<double>>> axes;
+            for (const auto& [label, axis] : grid.at("axes").items()) {
+                std::vector<double> values = readAxis(axis, label);
+                const int k = resolve(label, name);
+                if (k < 0) {
+                    continue;
+                }
+                for (double& value : values) {
+                    value *= scale[k];
+                }
+                axes.emplace_back(label, std::move(values));
+            }
+            if (axes.empty() && !grid.at("axes").empty()) {
+                Logger::warn("Scenario grid has no axes in the model; skipped", {{"scenario", name}});
+                continue;
+            }
+            library.addGrid(name, axes);
+        }
+    } catch (const json::exception& e) {
+        throw std::invalid_argument(std::string("Malformed scenario spec: ") + e.what());
+    }
+
+    return library;
+}
+
+// ===== ScenarioEvaluator Implementation =====
+
+Eigen::MatrixXd ScenarioEvaluator::evaluate(const ScenarioLibrary& library, const Eigen::MatrixXd& exposures) {
+    if (exposures.rows() != library.numFactors()) {
+        throw std::invalid_argument("Exposure rows must match the library's factors");
+    }
+    return library.shocks() * exposures;
+}
+
+std::vector<std::vector<StressTableRow>> ScenarioEvaluator::worstCases(
+    const ScenarioLibrary& library,
+    const Eigen::MatrixXd& exposures,
+    size_t topN)
+{
+    if (exposures.rows() != library.numFactors()) {
+        throw std::invalid_argument("Exposure rows must match the library's factors");
+    }
+
+    const Eigen::Index S = static_cast<Eigen::Index>(library.size());
+    const Eigen::Index P = exposures.cols();
+    std::vector<std::vector<StressTableRow>> tables(static_cast<size_t>(P));
+    if (topN == 0 || S == 0) {
+        return tables;
+    }
+
+    // Max-heap on (P&L, row): the top is the mildest of the worst kept so far
+    using Entry = std::pair<double, size_t>;
+    std::vector<std::vector<Entry>> heaps(static_cast<size_t>(P));
+    for (auto& heap : heaps) {
+        heap.reserve(topN);
+    }
+
+    const auto shocks = library.shocks();
+    Eigen::MatrixXd block(std::min(BLOCK_ROWS, S), P);
+    for (Eigen::Index start = 0; start < S; start += BLOCK_ROWS) {
+        const Eigen::Index rows = std::min(BLOCK_ROWS, S - start);
+        block.topRows(rows).noalias() = shocks.middleRows(start, rows) * exposures;
+
+        for (Eigen::Index p = 0; p < P; p++) {
+            std::vector<Entry>& heap = heaps[static_cast<size_t>(p)];
+            for (Eigen::Index r = 0; r < rows; r++) {
+                const Entry entry{block(r, p), static_cast<size_t>(start + r)};
+                if (heap.size() < topN) {
+                    heap.push_back(entry);
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (entry < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = entry;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+    }
+
+    for (Eigen::Index p = 0; p < P; p++) {
+        std::vector<Entry>& heap = heaps[static_cast<size_t>(p)];
+        std::sort_heap(heap.begin(), heap.end());
+        std::vector<StressTableRow>& table = tables[static_cast<size_t>(p)];
+        table.reserve(heap.size());
+        for (const auto& [pnl, scenario] : heap) {
+            table.push_back({scenario, library.scenarioName(scenario), pnl});
+        }
+    }
+    return tables;
+}
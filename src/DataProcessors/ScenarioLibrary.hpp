@@ -0,0 +1,161 @@
+//
+//  ScenarioLibrary.hpp
+//  InvertedYieldCurveTrader
+//
+//  Named stress episodes and parametric shock grids, loaded from JSON,
+//  and an evaluator that prices S scenarios × P portfolios as GEMMs.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef SCENARIO_LIBRARY_HPP
+#define SCENARIO_LIBRARY_HPP
+
+#include "MacroFactorModel.hpp"
+#include <Eigen/Dense>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+
+/**
+ * ScenarioLibrary: S factor-shock scenarios over K labeled factors
+ *
+ * Scenarios are rows of an S × K matrix in factor units, the same units as
+ * PortfolioRiskAnalyzer::scenarioShockImpact. Episodes are single named
+ * rows. A grid is the Cartesian product of per-factor values, and factors
+ * that are not on an axis stay at 0. Grid rows are named on demand, so a
+ * million-row grid stores no strings.
+ *
+ * Spec (shocks in factor standard deviations unless "units": "factor"):
+ *   {
+ *     "units": "sigma",
+ *     "episodes": [{"name": "2008 Q4", "shocks": {"Growth": -3.0, "Volatility": 4.0}}],
+ *     "grids": [{"name": "growth x vol",
+ *                "axes": {"Growth": [-3, -2, -1], "Volatility": {"from": 0, "to": 4, "steps": 9}}}]
+ *   }
+ */
+class ScenarioLibrary {
+public:
+    /**
+     * Empty library over the given factors
+     *
+     * @param factorLabels: Column labels (K), e.g. MacroFactors::factorLabels
+     * @throws std::invalid_argument if there are no factors
+     */
+    explicit ScenarioLibrary(std::vector<std::string> factorLabels);
+
+    /**
+     * Build a library from a JSON spec against the current factor model
+     *
+     * @param spec: Episodes and grids (see class comment)
+     * Shocks and axes on factors the model lacks, or whose label it gives
+     * to more than one factor, are dropped with a logged warning; an
+     * episode or grid left with nothing is skipped.
+     *
+     * @param factors: Labels and, for "sigma" units, factor variances
+     * @throws std::invalid_argument on unknown keys, empty axes or non-finite shocks
+     */
+    static ScenarioLibrary fromSpec(const json& spec, const MacroFactors& factors);
+
+    /**
+     * Append one named scenario
+     *
+     * @param name: Episode name
+     * @param shocks: f ∈ ℝ^K in factor units
+     */
+    void addEpisode(const std::string& name, const Eigen::VectorXd& shocks);
+
+    /**
+     * Append the Cartesian product of the axes (last axis varies fastest)
+     *
+     * @param name: Grid name; row names are "name [Label=value, ...]"
+     * @param axes: (factor label, values in factor units) per axis
+     * @throws std::invalid_argument if a label is unknown, repeated or names
+     *         more than one factor
+     */
+    void addGrid(const std::string& name, const std::vector<std::pair<std::string, std::vector<double>>>& axes);
+
+    size_t size() const { return static_cast<size_t>(shocks_.size()) / factorLabels_.size(); }
+    int numFactors() const { return static_cast<int>(factorLabels_.size()); }
+    const std::vector<std::string>& factorLabels() const { return factorLabels_; }
+
+    /**
+     * S × K shock matrix (row-major view over the library's storage)
+     */
+    Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> shocks() const;
+
+    /**
+     * Name of scenario s, built on request for grid rows
+     *
+     * @throws std::out_of_range if s ≥ size()
+     */
+    std::string scenarioName(size_t scenario) const;
+
+private:
+    // A run of consecutive rows: one episode, or one whole grid
+    struct Segment {
+        size_t firstRow;
+        size_t numRows;
+        std::string name;
+        std::vector<int> axisFactors;               // Grid only: column per axis
+        std::vector<std::vector<double>> axisValues;
+    };
+
+    int findFactor(const std::string& label) const;     // −1 unknown, −2 ambiguous
+    int factorIndex(const std::string& label) const;
+
+    std::vector<std::string> factorLabels_;
+    std::vector<double> shocks_;                    // Row-major S × K
+    std::vector<Segment> segments_;
+};
+
+/**
+ * StressTableRow: One line of a worst-case table
+ */
+struct StressTableRow {
+    size_t scenario;        // Row in the library
+    std::string name;
+    double pnl;
+};
+
+/**
+ * ScenarioEvaluator: Every scenario against every portfolio
+ *
+ * Exposures are a K × P matrix of factor sensitivities, e.g.
+ * BatchRiskDecomposition::factorSensitivities scaled by notional. P&L is
+ * shocks · exposures (S × P). worstCases never materializes that matrix.
+ * It multiplies fixed blocks of scenarios and keeps a bounded heap of the
+ * worst rows per portfolio.
+ */
+class ScenarioEvaluator {
+public:
+    /**
+     * Full P&L matrix: one GEMM
+     *
+     * @param library: S scenarios
+     * @param exposures: Γ (K × P)
+     * @return P&L (S × P)
+     */
+    static Eigen::MatrixXd evaluate(const ScenarioLibrary& library, const Eigen::MatrixXd& exposures);
+
+    /**
+     * Worst topN scenarios per portfolio, most negative P&L first
+     *
+     * @param library: S scenarios
+     * @param exposures: Γ (K × P)
+     * @param topN: Rows per table
+     * @return One sorted table per portfolio
+     */
+    static std::vector<std::vector<StressTableRow>> worstCases(
+        const ScenarioLibrary& library,
+        const Eigen::MatrixXd& exposures,
+        size_t topN = 10
+    );
+
+    static constexpr Eigen::Index BLOCK_ROWS = 4096;    // Scenarios per GEMM in worstCases
+};
+
+#endif // SCENARIO_LIBRARY_HPP
@@ -6,11 +6,19 @@
 //
 
 #include "UnemploymentProcessor.hpp"
+#include "../Storage/HistoryStore.hpp"
 #include "../DataProviders/FREDDataClient.hpp"
 #include <stdexcept>
 #include <iostream>
 
 std::vector<double> UnemploymentProcessor::process(const std::string& fredApiKey, int numValues) {
+    // Serve from the local history store when it is complete and current
+    // (monthly: the next release lands within ~80 days of the last observation)
+    std::vector<double> storedValues;
+    if (HistoryStore::readRecent("unemployment", numValues, 80, storedValues)) {
+        return storedValues;
+    }
+
     try {
         FREDDataClient client(fredApiKey);
         auto observations = client.fetchUnemployment(numValues);
@@ -8,6 +8,8 @@
 //
 
 #include "VIXDataProcessor.hpp"
+#include "../Storage/HistoryStore.hpp"
+#include "../Utils/Metrics.hpp"
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
@@ -46,9 +48,15 @@ std::string VIXDataProcessor::fetchFromAlphaVantage(const std::string& apiKey) {
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res;
+    {
+        METRICS_SCOPED_TIMER("http.alpha_vantage");
+        res = curl_easy_perform(curl);
+    }
+    METRICS_COUNT("http.requests", 1);
 
     if (res != CURLE_OK) {
+        METRICS_COUNT("http.errors", 1);
         std::string error = "VIX fetch failed: " + std::string(curl_easy_strerror(res));
         curl_easy_cleanup(curl);
         throw std::runtime_error(error);
@@ -110,6 +118,13 @@ std::vector<double> VIXDataProcessor::parseAlphaVantageResponse(const std::strin
 }
 
 std::vector<double> VIXDataProcessor::process(const std::string& alphaVantageApiKey, int numDays) {
+    // Serve from the local history store when it is complete and current
+    // (daily: allow for a long weekend)
+    std::vector<double> storedValues;
+    if (HistoryStore::readRecent("vix", numDays, 5, storedValues)) {
+        return storedValues;
+    }
+
     try {
         std::string jsonData = fetchFromAlphaVantage(alphaVantageApiKey);
         return parseAlphaVantageResponse(jsonData, numDays);
@@ -8,6 +8,7 @@
 //
 
 #include "FREDDataClient.hpp"
+#include "../Utils/Metrics.hpp"
 #include <curl/curl.h>
 #include <stdexcept>
 #include <sstream>
@@ -18,6 +19,7 @@ using json = nlohmann::json;
 
 // Base URL for FRED API
 const std::string FREDDataClient::BASE_URL = "https://api.stlouisfed.org/fred/series/observations";
+const int FREDDataClient::VINTAGE_PAGE_LIMIT = 100000;
 
 // FRED Series IDs mapping
 const std::map<std::string, std::string> FREDDataClient::SERIES_IDS = {
@@ -80,9 +82,15 @@ std::string FREDDataClient::fetchSeries(
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);  // 10 second timeout
 
-    CURLcode res = curl_easy_perform(curl);
+    CURLcode res;
+    {
+        METRICS_SCOPED_TIMER("http.fred");
+        res = curl_easy_perform(curl);
+    }
+    METRICS_COUNT("http.requests", 1);
 
     if (res != CURLE_OK) {
+        METRICS_COUNT("http.errors", 1);
         std::string error = "FRED API request failed for series " + seriesId + ": " +
                           std::string(curl_easy_strerror(res));
         curl_easy_cleanup(curl);
@@ -107,6 +115,109 @@ std::string FREDDataClient::fetchSeries(
     return response;
 }
 
+std::string FREDDataClient::fetchVintages(
+    const std::string& seriesId,
+    const std::string& realtimeStart,
+    const std::string& realtimeEnd,
+    const std::string& observationStart,
+    const std::string& observationEnd
+) {
+    // Build URL with real-time period parameters (ALFRED)
+    std::ostringstream urlStream;
+    urlStream << BASE_URL
+              << "?series_id=" << seriesId
+              << "&api_key=" << apiKey_
+              << "&file_type=json"
+              << "&limit=" << VINTAGE_PAGE_LIMIT
+              << "&sort_order=asc"
+              << "&realtime_start=" << realtimeStart
+              << "&realtime_end=" << realtimeEnd;
+
+    if (!observationStart.empty()) {
+        urlStream << "&observation_start=" << observationStart;
+    }
+    if (!observationEnd.empty()) {
+        urlStream << "&observation_end=" << observationEnd;
+    }
+    const std::string baseUrl = urlStream.str();
+
+    auto fetchPage = [&](size_t offset) {
+        CURL* curl = curl_easy_init();
+        if (!curl) {
+            throw std::runtime_error("Failed to initialize cURL");
+        }
+
+        std::string url = baseUrl + "&offset=" + std::to_string(offset);
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+
+        std::string response;
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 60L);  // Full revision histories are large
+
+        CURLcode res;
+        {
+            METRICS_SCOPED_TIMER("http.fred_vintages");
+            res = curl_easy_perform(curl);
+        }
+        METRICS_COUNT("http.requests", 1);
+
+        if (res != CURLE_OK) {
+            METRICS_COUNT("http.errors", 1);
+            std::string error = "FRED vintage request failed for series " + seriesId + ": " +
+                              std::string(curl_easy_strerror(res));
+            curl_easy_cleanup(curl);
+            throw std::runtime_error(error);
+        }
+
+        curl_easy_cleanup(curl);
+        return response;
+    };
+
+    return collectVintagePages(seriesId, fetchPage);
+}
+
+std::string FREDDataClient::collectVintagePages(
+    const std::string& seriesId,
+    const std::function<std::string(size_t offset)>& fetchPage
+) {
+    json combined;
+    combined["observations"] = json::array();
+    json& observations = combined["observations"];
+    size_t expected = 0;
+
+    do {
+        std::string response = fetchPage(observations.size());
+        json page;
+        try {
+            page = json::parse(response);
+        } catch (const json::exception& e) {
+            throw std::runtime_error("Failed to parse FRED vintage response: " + std::string(e.what()));
+        }
+        if (!page.contains("observations") || !page.contains("count")) {
+            std::cerr << "FRED API Response (first 500 chars): " << response.substr(0, 500) << "\n";
+            throw std::runtime_error("Invalid FRED vintage response: missing 'observations' or 'count' key");
+        }
+
+        expected = page["count"].get<size_t>();
+        if (page["observations"].empty()) {
+            break;
+        }
+        for (auto& observation : page["observations"]) {
+            observations.push_back(std::move(observation));
+        }
+    } while (observations.size() < expected);
+
+    if (observations.size() != expected) {
+        throw std::runtime_error("FRED vintage response for series " + seriesId + " returned " +
+                                 std::to_string(observations.size()) + " of " +
+                                 std::to_string(expected) + " observations");
+    }
+
+    combined["count"] = expected;
+    return combined.dump();
+}
+
 std::vector<FREDObservation> FREDDataClient::fetchLatestValue(
     const std::string& seriesId,
     int numValues
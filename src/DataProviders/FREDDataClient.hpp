@@ -15,6 +15,7 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <functional>
 
 struct FREDObservation {
     std::string date;
@@ -37,6 +38,26 @@ public:
         const std::string& observationEnd = ""
     );
 
+    // ALFRED vintage fetch - every value the series had between realtimeStart
+    // and realtimeEnd (YYYY-MM-DD), one row per (observation, realtime period).
+    // Pages through the API until all `count` rows have arrived.
+    // Defaults cover the full revision history; parse with VintageStore::parseALFRED
+    std::string fetchVintages(
+        const std::string& seriesId,
+        const std::string& realtimeStart = "1776-07-04",
+        const std::string& realtimeEnd = "9999-12-31",
+        const std::string& observationStart = "",
+        const std::string& observationEnd = ""
+    );
+
+    // Stitch paged ALFRED responses into one {"count", "observations"} response.
+    // fetchPage(offset) returns the raw page starting at that row offset.
+    // Throws if the pages run out before `count` rows have arrived.
+    static std::string collectVintagePages(
+        const std::string& seriesId,
+        const std::function<std::string(size_t offset)>& fetchPage
+    );
+
     // Convenience method - fetches and parses latest N values for a series
     std::vector<FREDObservation> fetchLatestValue(
         const std::string& seriesId,
@@ -60,6 +81,7 @@ public:
 private:
     std::string apiKey_;
     static const std::string BASE_URL;
+    static const int VINTAGE_PAGE_LIMIT;    // FRED's maximum rows per request
 
     // Helper function for cURL callbacks
     static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* output);
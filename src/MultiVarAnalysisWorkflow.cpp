@@ -8,11 +8,18 @@
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/S3Errors.h>
+#include <aws/core/http/HttpResponse.h>
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <ctime>
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+#include <filesystem>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
 #include "DataProcessors/InflationDataProcessor.hpp"
 #include "DataProcessors/GDPDataProcessor.hpp"
@@ -31,22 +38,147 @@
 #include "DataProcessors/MacroFactorModel.hpp"
 #include "DataProcessors/PortfolioRiskAnalyzer.hpp"
 #include "DataProcessors/PositionSizer.hpp"
+#include "DataProcessors/RegimeEngine.hpp"
+#include "Storage/ResultsLog.hpp"
+#include "Storage/VintageStore.hpp"
+#include "Storage/HistoryStore.hpp"
+#include "Backtest/BacktestEngine.hpp"
+#include "Backtest/ParameterSweep.hpp"
+#include "DataProviders/FREDDataClient.hpp"
 #include "Utils/Date.hpp"
 #include "Utils/Logger.hpp"
+#include "Utils/Metrics.hpp"
 #include "Utils/SecretsManager.hpp"
 
 using json = nlohmann::json;
 using namespace Aws;
 using namespace Aws::Auth;
 
+// Local append-only results log (see Storage/ResultsLog.hpp).
+// /tmp is the only writable directory inside Lambda.
+static std::string resultsLogPath() {
+    const char* pathEnv = std::getenv("RESULTS_LOG_PATH");
+    return pathEnv ? pathEnv : "/tmp/results.log";
+}
+
+// Regime engine snapshot carried between runs (dwell time, last size)
+static std::string regimeStatePath() {
+    const char* pathEnv = std::getenv("REGIME_STATE_PATH");
+    return pathEnv ? pathEnv : "/tmp/regime_engine.bin";
+}
+
+// Resume the regime engine, or start fresh if there is no usable snapshot
+static RegimeEngine loadRegimeEngine(const std::string& path) {
+    if (!std::filesystem::exists(path)) {
+        return RegimeEngine();
+    }
+    try {
+        return RegimeEngine::load(path);
+    } catch (const std::exception& e) {
+        Logger::warn("Regime engine snapshot unreadable; starting fresh", {
+            {"path", path},
+            {"error", e.what()}
+        });
+        return RegimeEngine();
+    }
+}
+
+// Backtest config over whichever indicators exist in the local stores,
+// with the same ES exposure pattern as the covariance mode
+static BacktestConfig localBacktestConfig(const HistoryStore& history, const VintageStore* vintages) {
+    BacktestConfig config;
+    config.indicatorBetas = {
+        {"fed_funds", 0.3}, {"unemployment", -0.5}, {"consumer_sentiment", 0.4},
+        {"gdp", 0.6}, {"inflation", -0.2}, {"inverted_yield", -0.1}, {"vix", -0.8}
+    };
+    for (const auto& [name, beta] : config.indicatorBetas) {
+        if (history.hasSeries(name) || (vintages != nullptr && vintages->hasSeries(name))) {
+            config.indicators.push_back(name);
+        }
+    }
+    return config;
+}
+
+// Result of pulling an S3 object down to a local file
+enum class S3Download { Found, NotFound, Failed };
+
+// Download an S3 object byte-for-byte to a local file. Only an explicit
+// NoSuchKey / 404 counts as missing; any other error is a failure.
+static S3Download downloadS3Object(Aws::S3::S3Client& s3Client, const std::string& bucket,
+                                   const std::string& key, const std::string& localPath) {
+    Aws::S3::Model::GetObjectRequest getRequest;
+    getRequest.SetBucket(bucket);
+    getRequest.SetKey(key);
+
+    METRICS_TIMER_START(getTimer, "s3.get");
+    auto outcome = s3Client.GetObject(getRequest);
+    METRICS_TIMER_STOP(getTimer);
+    METRICS_COUNT("s3.requests", 1);
+    if (!outcome.IsSuccess()) {
+        const auto& error = outcome.GetError();
+        if (error.GetErrorType() == Aws::S3::S3Errors::NO_SUCH_KEY ||
+            error.GetResponseCode() == Aws::Http::HttpResponseCode::NOT_FOUND) {
+            return S3Download::NotFound;
+        }
+        METRICS_COUNT("s3.errors", 1);
+        Logger::error("S3 download failed", {
+            {"key", key},
+            {"error", error.GetMessage()}
+        });
+        return S3Download::Failed;
+    }
+
+    std::ofstream localFile(localPath, std::ios::binary | std::ios::trunc);
+    localFile << outcome.GetResult().GetBody().rdbuf();
+    if (!localFile.good()) {
+        Logger::error("Failed to write downloaded S3 object", {
+            {"key", key},
+            {"path", localPath}
+        });
+        return S3Download::Failed;
+    }
+    return S3Download::Found;
+}
+
+// Upload a local file byte-for-byte to S3
+static bool uploadS3File(Aws::S3::S3Client& s3Client, const std::string& bucket,
+                         const std::string& key, const std::string& localPath) {
+    Aws::S3::Model::PutObjectRequest putRequest;
+    putRequest.SetBucket(bucket);
+    putRequest.SetKey(key);
+    putRequest.SetBody(Aws::MakeShared<Aws::FStream>("ResultsLogUpload", localPath.c_str(),
+                                                     std::ios_base::in | std::ios_base::binary));
+
+    METRICS_TIMER_START(putTimer, "s3.put");
+    auto outcome = s3Client.PutObject(putRequest);
+    METRICS_TIMER_STOP(putTimer);
+    METRICS_COUNT("s3.requests", 1);
+    if (!outcome.IsSuccess()) {
+        METRICS_COUNT("s3.errors", 1);
+        Logger::error("S3 upload failed", {
+            {"key", key},
+            {"error", outcome.GetError().GetMessage()}
+        });
+    }
+    return outcome.IsSuccess();
+}
+
 int main(int argc, char **argv) {
     
     Aws::SDKOptions options;
     Aws::InitAPI(options); // Should only be called once.
+
+    // LOG_ASYNC=1 moves log writes onto a background thread (drained before exit)
+    AsyncLogSession asyncLogSession(std::getenv("LOG_ASYNC") != nullptr);
     
     int result = 0;
     
     if (argc > 1) {
+        // One "Run metrics" record (stage timings, request counts) on every exit path
+        METRICS_REPORT_ON_EXIT({{"mode", argv[1]}});
+        // Chrome trace-event timeline of the run, written on exit when TRACE_OUTPUT is set
+        TraceSession traceSession(std::getenv("TRACE_OUTPUT"));
+
         Aws::Client::ClientConfiguration clientConfig;
         clientConfig.region = "us-east-1";
                
@@ -66,7 +198,7 @@ int main(int argc, char **argv) {
                 Logger::info("Analysis started", {
                     {"phase", "1"},
                     {"mode", "covariance"},
-                    {"timestamp", std::time(nullptr)}
+                    {"epoch", std::time(nullptr)}
                 });
 
                 // Fetch all 8 economic indicators
@@ -75,6 +207,7 @@ int main(int argc, char **argv) {
                 // Get API keys securely
                 std::map<std::string, std::string> secrets;
                 try {
+                    METRICS_SCOPED_TIMER("stage.secrets");
                     secrets = SecretsManager::getAllSecrets();
                 } catch (const std::exception& e) {
                     Logger::critical("Failed to retrieve API keys", e);
@@ -94,6 +227,7 @@ int main(int argc, char **argv) {
                 Logger::info("Fetching economic indicators");
 
                 try {
+                    METRICS_SCOPED_TIMER("stage.fetch");
                     InflationDataProcessor inflationProcessor;
                     FedFundsProcessor fedFundsProcessor;
                     UnemploymentProcessor unemploymentProcessor;
@@ -128,7 +262,9 @@ int main(int argc, char **argv) {
                 // STEP 2: Align to monthly frequency
                 std::cout << "Step 2: Aligning all indicators to monthly frequency..." << std::endl;
 
+                METRICS_TIMER_START(alignTimer, "stage.align");
                 auto alignedData = DataAligner::alignAllIndicators(rawData);
+                METRICS_TIMER_STOP(alignTimer);
 
                 std::cout << "✓ Aligned to 12 monthly observations" << std::endl;
                 std::cout << std::endl;
@@ -141,6 +277,7 @@ int main(int argc, char **argv) {
                 std::map<std::string, IndicatorSurprise> allSurprises;
                 std::map<std::string, std::vector<double>> surpriseVectors;
 
+                METRICS_TIMER_START(surpriseTimer, "stage.surprises");
                 for (auto& [indicator, levels] : alignedData) {
                     IndicatorSurprise surprise = SurpriseTransformer::extractSurprise(levels, indicator, 6);
                     allSurprises[indicator] = surprise;
@@ -151,6 +288,7 @@ int main(int argc, char **argv) {
                     std::cout << "source=" << surprise.expectationSource << ", ";
                     std::cout << "validated=" << (surprise.isValidated ? "yes" : "no") << std::endl;
                 }
+                METRICS_TIMER_STOP(surpriseTimer);
                 std::cout << std::endl;
 
                 // STEP 4: Calculate covariance of SURPRISES (not levels)
@@ -158,8 +296,10 @@ int main(int argc, char **argv) {
                 std::cout << "  Σ_ε = Cov(ε_1, ..., ε_8)" << std::endl;
                 std::cout << std::endl;
 
+                METRICS_TIMER_START(covarianceTimer, "stage.covariance");
                 CovarianceCalculator covCalculator;
                 CovarianceMatrix surpriseCovMatrix = covCalculator.calculateCovarianceMatrix(surpriseVectors);
+                METRICS_TIMER_STOP(covarianceTimer);
 
                 double frobenius = surpriseCovMatrix.getFrobeniusNorm();
                 std::cout << "✓ Covariance matrix computed. Frobenius norm (regime volatility): " << frobenius << std::endl;
@@ -170,7 +310,9 @@ int main(int argc, char **argv) {
                 std::cout << "  ε_t = B f_t + u_t  (PCA decomposition)" << std::endl;
                 std::cout << std::endl;
 
+                METRICS_TIMER_START(decomposeTimer, "stage.decompose");
                 MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(surpriseCovMatrix, 3);
+                METRICS_TIMER_STOP(decomposeTimer);
 
                 std::cout << "✓ Factor decomposition complete" << std::endl;
                 std::cout << std::endl;
@@ -225,7 +367,9 @@ int main(int argc, char **argv) {
                     esPortfolioBeta(7) = -0.7;  // MOVE: negative
                 }
 
+                METRICS_TIMER_START(riskTimer, "stage.risk");
                 RiskDecomposition portfolioRisk = PortfolioRiskAnalyzer::analyzeRisk(esPortfolioBeta, factors);
+                METRICS_TIMER_STOP(riskTimer);
 
                 std::cout << "Portfolio Total Risk (Daily Vol): " << portfolioRisk.totalRisk << std::endl;
                 std::cout << "Portfolio Total Variance: " << portfolioRisk.totalVariance << std::endl;
@@ -252,9 +396,19 @@ int main(int argc, char **argv) {
                 double yieldCurveSlope = 120.0; // 2s10s (bps)
                 double putCallRatio = 0.92;     // Option positioning
 
-                MacroRegime currentRegime = PositionSizer::classifyRegime(
-                    currentVIX, currentMOVE, creditSpread, yieldCurveSlope, putCallRatio
-                );
+                // The engine carries yesterday's regime and the dwell time
+                // between runs; a second run on the same day reuses today's tick
+                const std::string regimePath = regimeStatePath();
+                RegimeEngine regimeEngine = loadRegimeEngine(regimePath);
+                const int32_t today = dateToInt(getDateDaysAgo(0));
+                const bool newDay = regimeEngine.lastDate() < today;
+
+                METRICS_TIMER_START(regimeTimer, "stage.regime");
+                if (newDay) {
+                    regimeEngine.observe({today, currentVIX, currentMOVE, creditSpread, yieldCurveSlope, putCallRatio});
+                }
+                MacroRegime currentRegime = regimeEngine.regime();
+                METRICS_TIMER_STOP(regimeTimer);
 
                 std::cout << "Current Market Regime:" << std::endl;
                 std::cout << "  VIX Level: " << currentVIX << std::endl;
@@ -270,6 +424,7 @@ int main(int argc, char **argv) {
                 std::cout << "  Stability: " << currentRegime.fragileLabel << std::endl;
                 std::cout << "  Volatility Multiplier: " << currentRegime.volatilityMultiplier << std::endl;
                 std::cout << "  Confidence: " << (currentRegime.confidence * 100.0) << "%" << std::endl;
+                std::cout << "  Days in Regime: " << regimeEngine.daysInCurrentRegime() << std::endl;
                 std::cout << std::endl;
 
                 // Compute position sizing
@@ -283,13 +438,29 @@ int main(int argc, char **argv) {
                 constraints.maxDailyLoss = 100000.0;
                 constraints.maxDrawdownFromPeak = 500000.0;
 
+                METRICS_TIMER_START(sizingTimer, "stage.sizing");
                 PositionSizing sizing = PositionSizer::computePositionSize(
                     baseNotional, portfolioRisk, currentRegime, constraints
                 );
+                METRICS_TIMER_STOP(sizingTimer);
+
+                // Hysteresis against the size held after the last run
+                const double heldNotional = newDay || !regimeEngine.isSized()
+                    ? regimeEngine.rebalance(sizing.recommendedNotional)
+                    : regimeEngine.currentSize();
+                try {
+                    regimeEngine.save(regimePath);
+                } catch (const std::exception& e) {
+                    Logger::warn("Regime engine snapshot not saved", {
+                        {"path", regimePath},
+                        {"error", e.what()}
+                    });
+                }
 
                 std::cout << "Position Sizing Recommendation:" << std::endl;
                 std::cout << "  Base Notional: $" << baseNotional << std::endl;
                 std::cout << "  Recommended Notional: $" << sizing.recommendedNotional << std::endl;
+                std::cout << "  Held Notional (after hysteresis): $" << heldNotional << std::endl;
                 std::cout << "  Recommended Shares (ES contracts): " << sizing.recommendedShares << std::endl;
                 std::cout << "  Recommended Leverage: " << sizing.recommendedLeverage << "x" << std::endl;
                 std::cout << std::endl;
@@ -333,6 +504,7 @@ int main(int argc, char **argv) {
 
                 // Write results to file
                 try {
+                    METRICS_SCOPED_TIMER("stage.write_results");
                     std::ofstream outputFile("./output.txt");
                     if (!outputFile.is_open()) {
                         Logger::error("Failed to open output.txt for writing");
@@ -349,11 +521,43 @@ int main(int argc, char **argv) {
 
                     outputFile.close();
 
+                    // Append the full structured result to the binary results log
+                    DailyResult dailyResult;
+                    dailyResult.date = dateToInt(getDateDaysAgo(0));
+                    dailyResult.timestamp = std::time(nullptr);
+                    dailyResult.indicatorNames = surpriseCovMatrix.getIndicatorNames();
+                    dailyResult.covariance = surpriseCovMatrix.getMatrix();
+
+                    // Full spectrum Σ = U Λ U^T, descending (the factor model keeps only the top K)
+                    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> spectrum(dailyResult.covariance);
+                    dailyResult.eigenvalues = spectrum.eigenvalues().reverse();
+                    dailyResult.eigenvectors = spectrum.eigenvectors().rowwise().reverse();
+                    double smallestEigenvalue = dailyResult.eigenvalues.tail(1)(0);
+                    dailyResult.conditionNumber = (smallestEigenvalue > 1e-12)
+                        ? dailyResult.eigenvalues(0) / smallestEigenvalue
+                        : std::numeric_limits<double>::infinity();
+
+                    dailyResult.frobeniusNorm = frobenius;
+                    dailyResult.varianceExplained = factors.cumulativeVarianceExplained;
+                    dailyResult.factorLabels = factors.factorLabels;
+                    dailyResult.labelConfidences = factors.labelConfidences;
+                    dailyResult.recommendedNotional = sizing.recommendedNotional;
+                    dailyResult.recommendedShares = sizing.recommendedShares;
+                    dailyResult.recommendedLeverage = sizing.recommendedLeverage;
+                    dailyResult.riskLabel = currentRegime.riskLabel;
+                    dailyResult.volatilityMultiplier = currentRegime.volatilityMultiplier;
+
+                    ResultsLogWriter resultsLog(resultsLogPath());
+                    resultsLog.append(dailyResult);
+                    resultsLog.flush();
+
                     Logger::info("Analysis completed successfully", {
                         {"factors", factors.numFactors},
                         {"variance_explained", factors.cumulativeVarianceExplained},
                         {"position_notional", sizing.recommendedNotional},
-                        {"regime", currentRegime.riskLabel}
+                        {"held_notional", heldNotional},
+                        {"regime", currentRegime.riskLabel},
+                        {"days_in_regime", regimeEngine.daysInCurrentRegime()}
                     });
 
                 } catch (const std::exception& e) {
@@ -371,7 +575,7 @@ int main(int argc, char **argv) {
             }
         } else if (std::strcmp(argv[1], "upload-daily") == 0) {
             // Upload the daily analysis results to S3
-            // This is called after "covariance" mode generates output.txt
+            // This is called after "covariance" mode appends to the results log
 
             Logger::info("S3 upload started");
 
@@ -380,30 +584,26 @@ int main(int argc, char **argv) {
             std::string s3Bucket = s3BucketEnv ? s3BucketEnv : "inverted-yield-trader-daily-results";
 
             try {
-                // Read the local output.txt file
-                std::ifstream inputFile("./output.txt");
-                if (!inputFile.is_open()) {
-                    Logger::error("output.txt not found. Run 'covariance' mode first.");
+                // Today's result is the latest record of the local results log
+                DailyResult latest;
+                bool hasLatest = false;
+                try {
+                    ResultsLogReader localLog(resultsLogPath());
+                    hasLatest = localLog.readLatest(latest);
+                } catch (const std::exception& e) {
+                    Logger::warn("Results log unreadable", {{"error", e.what()}});
+                }
+                if (!hasLatest) {
+                    Logger::error("Results log is empty. Run 'covariance' mode first.");
                     return 1;
                 }
 
-                // Get today's date for S3 key
-                std::string today = getDateDaysAgo(0);
+                std::string today = intToDate(latest.date);
+                Aws::S3::S3Client s3Client;
 
-                // Create the S3 key structure: positions/YYYY-MM-DD.json
+                // Human-readable JSON export: positions/YYYY-MM-DD.json
                 std::string s3Key = "positions/" + today + ".json";
-
-                // Read output.txt and wrap in JSON with metadata
-                std::stringstream buffer;
-                buffer << inputFile.rdbuf();
-                inputFile.close();
-
-                json dailyResult;
-                dailyResult["date"] = today;
-                dailyResult["timestamp"] = std::time(nullptr);
-                dailyResult["output"] = buffer.str();
-
-                std::string jsonContent = dailyResult.dump(2);
+                std::string jsonContent = ResultsLogReader::toJson(latest).dump(2);
 
                 Logger::info("Uploading to S3", {
                     {"bucket", s3Bucket},
@@ -411,32 +611,199 @@ int main(int argc, char **argv) {
                     {"size_bytes", jsonContent.size()}
                 });
 
-                // Upload to S3
-                Aws::S3::S3Client s3Client;
                 Aws::S3::Model::PutObjectRequest putRequest;
                 putRequest.SetBucket(s3Bucket);
                 putRequest.SetKey(s3Key);
                 putRequest.SetBody(std::make_shared<std::stringstream>(jsonContent));
 
+                METRICS_TIMER_START(putTimer, "s3.put");
                 auto outcome = s3Client.PutObject(putRequest);
+                METRICS_TIMER_STOP(putTimer);
+                METRICS_COUNT("s3.requests", 1);
 
-                if (outcome.IsSuccess()) {
-                    Logger::info("S3 upload successful", {
-                        {"bucket", s3Bucket},
-                        {"key", s3Key}
-                    });
-                    std::cout << "✅ Successfully uploaded to s3://" << s3Bucket << "/" << s3Key << std::endl;
-                } else {
+                if (!outcome.IsSuccess()) {
+                    METRICS_COUNT("s3.errors", 1);
                     Logger::error("S3 upload failed", {
                         {"error", outcome.GetError().GetMessage()}
                     });
                     return 1;
                 }
 
+                // Append today's record to this month's results log in S3:
+                // positions/log/YYYY-MM.log. S3 has no append, so the month is
+                // pulled, appended locally and pushed back, which bounds the
+                // transfer at one month of records. Months are compacted
+                // offline by replaying them through ResultsLogWriter.
+                const std::string historyKey = "positions/log/" + today.substr(0, 7) + ".log";
+                const std::string historyPath = resultsLogPath() + ".month";
+                std::remove(historyPath.c_str());
+                std::remove((historyPath + ".idx").c_str());  // Rebuilt by the writer
+
+                switch (downloadS3Object(s3Client, s3Bucket, historyKey, historyPath)) {
+                    case S3Download::Found:
+                        break;
+                    case S3Download::NotFound:
+                        Logger::info("Starting a new monthly results log", {{"history_key", historyKey}});
+                        break;
+                    case S3Download::Failed:
+                        // Never overwrite a log that could not be read back
+                        Logger::error("Results log not appended", {{"history_key", historyKey}});
+                        return 1;
+                }
+
+                {
+                    ResultsLogWriter history(historyPath);
+                    if (history.recordCount() == 0 || history.lastDate() < latest.date) {
+                        history.append(latest);
+                    }
+                    history.flush();
+
+                    Logger::info("Results log appended", {
+                        {"records", history.recordCount()},
+                        {"last_date", intToDate(history.lastDate())}
+                    });
+                }
+
+                if (!uploadS3File(s3Client, s3Bucket, historyKey, historyPath) ||
+                    !uploadS3File(s3Client, s3Bucket, historyKey + ".idx", historyPath + ".idx")) {
+                    return 1;
+                }
+
+                Logger::info("S3 upload successful", {
+                    {"bucket", s3Bucket},
+                    {"key", s3Key},
+                    {"history_key", historyKey}
+                });
+                std::cout << "✅ Successfully uploaded to s3://" << s3Bucket << "/" << s3Key << std::endl;
+
             } catch (const std::exception& e) {
                 Logger::critical("S3 upload failed", e);
                 return 1;
             }
+        } else if (std::strcmp(argv[1], "backtest") == 0) {
+            // Replay the pipeline day by day over the local history store
+            // (point-in-time indicator levels when a vintage store is present)
+
+            const HistoryStore* history = HistoryStore::shared();
+            if (history == nullptr) {
+                Logger::error("HISTORY_STORE_PATH is not set; nothing to replay");
+                return 1;
+            }
+
+            try {
+                std::unique_ptr<VintageStore> vintages;
+                const char* vintagePathEnv = std::getenv("VINTAGE_STORE_PATH");
+                if (vintagePathEnv != nullptr) {
+                    vintages = std::make_unique<VintageStore>(vintagePathEnv);
+                }
+
+                BacktestConfig config = localBacktestConfig(*history, vintages.get());
+                METRICS_TIMER_START(backtestTimer, "stage.backtest");
+                BacktestResult backtest = BacktestEngine(*history, config, vintages.get()).run();
+                METRICS_TIMER_STOP(backtestTimer);
+
+                const char* outputEnv = std::getenv("BACKTEST_OUTPUT");
+                std::string outputPath = outputEnv ? outputEnv : "./backtest.csv";
+                BacktestEngine::writeStepsCsv(backtest, outputPath);
+
+                Logger::info("Backtest completed", {
+                    {"steps", backtest.steps.size()},
+                    {"total_return", backtest.totalReturn},
+                    {"sharpe", backtest.sharpeRatio},
+                    {"max_drawdown_pct", backtest.maxDrawdownPercent},
+                    {"turnover", backtest.totalTurnover},
+                    {"regime_changes", backtest.regimeChanges},
+                    {"factor_refits", backtest.factorRefits},
+                    {"output", outputPath}
+                });
+            } catch (const std::exception& e) {
+                Logger::critical("Backtest failed", e);
+                return 1;
+            }
+        } else if (std::strcmp(argv[1], "sweep") == 0) {
+            // Grid or random search over model hyperparameters, one backtest
+            // per point in parallel against the shared history store
+
+            if (argc < 3) {
+                Logger::error("Usage: sweep <spec.json>");
+                return 1;
+            }
+
+            const HistoryStore* history = HistoryStore::shared();
+            if (history == nullptr) {
+                Logger::error("HISTORY_STORE_PATH is not set; nothing to replay");
+                return 1;
+            }
+
+            try {
+                std::ifstream specFile(argv[2]);
+                if (!specFile.is_open()) {
+                    throw std::runtime_error(std::string("Cannot open sweep spec ") + argv[2]);
+                }
+                std::vector<SweepParameters> points = ParameterSweep::fromSpec(json::parse(specFile));
+
+                std::unique_ptr<VintageStore> vintages;
+                const char* vintagePathEnv = std::getenv("VINTAGE_STORE_PATH");
+                if (vintagePathEnv != nullptr) {
+                    vintages = std::make_unique<VintageStore>(vintagePathEnv);
+                }
+
+                BacktestConfig config = localBacktestConfig(*history, vintages.get());
+                Logger::info("Parameter sweep started", {{"points", points.size()}});
+
+                METRICS_TIMER_START(sweepTimer, "stage.sweep");
+                std::vector<SweepResult> results = ParameterSweep::run(*history, config, points, 0, vintages.get());
+                METRICS_TIMER_STOP(sweepTimer);
+
+                const char* outputEnv = std::getenv("SWEEP_OUTPUT");
+                std::string outputPath = outputEnv ? outputEnv : "./sweep.csv";
+                ParameterSweep::writeResultsCsv(results, outputPath);
+
+                size_t failed = std::count_if(results.begin(), results.end(),
+                                              [](const SweepResult& r) { return !r.error.empty(); });
+                Logger::info("Parameter sweep completed", {
+                    {"points", results.size()},
+                    {"failed", failed},
+                    {"output", outputPath}
+                });
+            } catch (const std::exception& e) {
+                Logger::critical("Parameter sweep failed", e);
+                return 1;
+            }
+        } else if (std::strcmp(argv[1], "import-vintages") == 0) {
+            // Import the full ALFRED revision history of each FRED macro series
+            // into the point-in-time store used for look-ahead-free backtests
+
+            const char* vintagePathEnv = std::getenv("VINTAGE_STORE_PATH");
+            std::string vintagePath = vintagePathEnv ? vintagePathEnv : "./vintages";
+
+            Logger::info("Vintage import started", {{"path", vintagePath}});
+
+            try {
+                std::map<std::string, std::string> secrets = SecretsManager::getAllSecrets();
+                FREDDataClient client(secrets["fred_api_key"]);
+
+                for (const auto& [name, seriesId] : FREDDataClient::SERIES_IDS) {
+                    // Daily Treasury yields are market prices and never revised
+                    if (name.rfind("treasury_", 0) == 0) {
+                        continue;
+                    }
+
+                    // Saved under the backtest's name, or it would never be looked up
+                    const std::string storeName = VintageStore::seriesNameForFRED(name);
+                    std::vector<VintageRecord> records = VintageStore::parseALFRED(client.fetchVintages(seriesId));
+                    VintageStore::writeSeries(vintagePath, storeName, records);
+
+                    Logger::info("Vintages imported", {
+                        {"series", storeName},
+                        {"series_id", seriesId},
+                        {"records", records.size()}
+                    });
+                }
+            } catch (const std::exception& e) {
+                Logger::critical("Vintage import failed", e);
+                return 1;
+            }
         }
     }
 
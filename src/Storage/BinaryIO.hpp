@@ -0,0 +1,114 @@
+//
+//  BinaryIO.hpp
+//  InvertedYieldCurveTrader
+//
+//  Little-endian encode/decode helpers shared by the binary stores
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef BINARY_IO_HPP
+#define BINARY_IO_HPP
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * Appends fixed-width values and length-prefixed strings to a byte buffer
+ *
+ * Values are written in host byte order. All supported targets (x86-64,
+ * arm64) are little-endian, which is the documented on-disk format.
+ */
+class ByteWriter {
+public:
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable_v<T>, "put() requires a trivially copyable type");
+        buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putBytes(const void* bytes, size_t length) {
+        buffer_.append(static_cast<const char*>(bytes), length);
+    }
+
+    void putString(const std::string& value) {
+        if (value.size() > UINT16_MAX) {
+            throw std::invalid_argument("String too long for binary record: " + value.substr(0, 32) + "...");
+        }
+        put<uint16_t>(static_cast<uint16_t>(value.size()));
+        buffer_.append(value);
+    }
+
+    const std::string& bytes() const { return buffer_; }
+    size_t size() const { return buffer_.size(); }
+    void clear() { buffer_.clear(); }
+
+private:
+    std::string buffer_;
+};
+
+/**
+ * Bounds-checked cursor over a byte range (typically a memory mapping)
+ *
+ * Every read checks the remaining length, so a truncated or corrupt record
+ * surfaces as std::runtime_error instead of reading past the mapping.
+ */
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t length) : cursor_(data), end_(data + length) {}
+
+    template <typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable_v<T>, "get() requires a trivially copyable type");
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, cursor_, sizeof(T));
+        cursor_ += sizeof(T);
+        return value;
+    }
+
+    void getBytes(void* out, size_t length) {
+        require(length);
+        std::memcpy(out, cursor_, length);
+        cursor_ += length;
+    }
+
+    std::string getString() {
+        uint16_t length = get<uint16_t>();
+        require(length);
+        std::string value(cursor_, length);
+        cursor_ += length;
+        return value;
+    }
+
+    const char* position() const { return cursor_; }
+    size_t remaining() const { return static_cast<size_t>(end_ - cursor_); }
+
+private:
+    const char* cursor_;
+    const char* end_;
+
+    void require(size_t length) const {
+        if (static_cast<size_t>(end_ - cursor_) < length) {
+            throw std::runtime_error("Binary record truncated");
+        }
+    }
+};
+
+/**
+ * FNV-1a 32-bit checksum, used to detect torn or corrupt records
+ */
+inline uint32_t fnv1a32(const char* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#endif // BINARY_IO_HPP
@@ -0,0 +1,534 @@
+//
+//  HistoryStore.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the columnar history store
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "HistoryStore.hpp"
+#include "BinaryIO.hpp"
+#include "../Utils/Logger.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char COLUMN_MAGIC[8] = {'I', 'Y', 'C', 'H', 'C', 'O', 'L', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 40;          // magic + version + codec + count + capacity + payloadBytes
+constexpr size_t COUNT_FIELD_OFFSET = 16;
+constexpr uint64_t MIN_CAPACITY = 64;
+const std::string COLUMN_EXTENSION = ".col";
+
+struct ColumnHeader {
+    uint32_t codec;
+    uint64_t count;
+    uint64_t capacity;
+    uint64_t payloadBytes;
+};
+
+uint64_t valuesOffset(uint64_t capacity) {
+    uint64_t end = HEADER_SIZE + sizeof(int32_t) * capacity;
+    return (end + 7) & ~uint64_t(7);  // Keep the float64 column 8-byte aligned
+}
+
+std::string encodeHeader(const ColumnHeader& header) {
+    ByteWriter writer;
+    writer.putBytes(COLUMN_MAGIC, sizeof(COLUMN_MAGIC));
+    writer.put<uint32_t>(FORMAT_VERSION);
+    writer.put<uint32_t>(header.codec);
+    writer.put<uint64_t>(header.count);
+    writer.put<uint64_t>(header.capacity);
+    writer.put<uint64_t>(header.payloadBytes);
+    return writer.bytes();
+}
+
+ColumnHeader decodeHeader(const char* data, size_t size, const std::string& path) {
+    if (size < HEADER_SIZE || std::memcmp(data, COLUMN_MAGIC, sizeof(COLUMN_MAGIC)) != 0) {
+        throw std::runtime_error("'" + path + "' is not a history column file");
+    }
+    ByteReader reader(data + sizeof(COLUMN_MAGIC), HEADER_SIZE - sizeof(COLUMN_MAGIC));
+    uint32_t version = reader.get<uint32_t>();
+    if (version != FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported history column version " + std::to_string(version) + " in '" + path + "'");
+    }
+    ColumnHeader header;
+    header.codec = reader.get<uint32_t>();
+    header.count = reader.get<uint64_t>();
+    header.capacity = reader.get<uint64_t>();
+    header.payloadBytes = reader.get<uint64_t>();
+    return header;
+}
+
+void validateSeries(const std::vector<int32_t>& dates, const std::vector<double>& values) {
+    if (dates.size() != values.size()) {
+        throw std::invalid_argument("Dates and values must have the same length");
+    }
+    for (size_t i = 1; i < dates.size(); i++) {
+        if (dates[i] <= dates[i - 1]) {
+            throw std::invalid_argument("Series dates must be strictly increasing (" +
+                                        std::to_string(dates[i - 1]) + " then " + std::to_string(dates[i]) + ")");
+        }
+    }
+}
+
+// ----- DeltaXor codec -----
+
+void putVarint(ByteWriter& writer, uint64_t value) {
+    while (value >= 0x80) {
+        writer.put<uint8_t>(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    writer.put<uint8_t>(static_cast<uint8_t>(value));
+}
+
+uint64_t getVarint(ByteReader& reader) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = reader.get<uint8_t>();
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Malformed varint in history column");
+}
+
+std::string encodeDeltaXor(const std::vector<int32_t>& dates, const std::vector<double>& values) {
+    ByteWriter dateBytes;
+    int64_t previousDate = 0;
+    for (int32_t date : dates) {
+        int64_t delta = static_cast<int64_t>(date) - previousDate;
+        putVarint(dateBytes, static_cast<uint64_t>((delta << 1) ^ (delta >> 63)));  // zigzag
+        previousDate = date;
+    }
+
+    ByteWriter valueBytes;
+    uint64_t previousBits = 0;
+    for (double value : values) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint64_t delta = bits ^ previousBits;
+        previousBits = bits;
+
+        if (delta == 0) {
+            valueBytes.put<uint8_t>(0x80);  // Repeat of the previous value
+            continue;
+        }
+        int leading = __builtin_clzll(delta) / 8;
+        int trailing = __builtin_ctzll(delta) / 8;
+        int width = 8 - leading - trailing;
+        valueBytes.put<uint8_t>(static_cast<uint8_t>((leading << 4) | trailing));
+        uint64_t middle = delta >> (trailing * 8);
+        for (int b = 0; b < width; b++) {
+            valueBytes.put<uint8_t>(static_cast<uint8_t>(middle >> (b * 8)));
+        }
+    }
+
+    ByteWriter payload;
+    payload.put<uint64_t>(dateBytes.size());
+    payload.putBytes(dateBytes.bytes().data(), dateBytes.size());
+    payload.putBytes(valueBytes.bytes().data(), valueBytes.size());
+    return payload.bytes();
+}
+
+void decodeDeltaXor(const char* data, size_t length, uint64_t count,
+                    std::vector<int32_t>& dates, std::vector<double>& values) {
+    ByteReader reader(data, length);
+    uint64_t dateBytes = reader.get<uint64_t>();
+    if (dateBytes > reader.remaining()) {
+        throw std::runtime_error("Corrupt compressed history column");
+    }
+
+    ByteReader dateReader(reader.position(), dateBytes);
+    ByteReader valueReader(reader.position() + dateBytes, reader.remaining() - dateBytes);
+
+    dates.resize(count);
+    values.resize(count);
+
+    int64_t previousDate = 0;
+    uint64_t previousBits = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t zigzag = getVarint(dateReader);
+        int64_t delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        previousDate += delta;
+        dates[i] = static_cast<int32_t>(previousDate);
+
+        uint8_t control = valueReader.get<uint8_t>();
+        uint64_t delta64 = 0;
+        if (control != 0x80) {
+            int leading = control >> 4;
+            int trailing = control & 0x0F;
+            int width = 8 - leading - trailing;
+            if (width <= 0 || width > 8) {
+                throw std::runtime_error("Corrupt compressed history column");
+            }
+            uint64_t middle = 0;
+            for (int b = 0; b < width; b++) {
+                middle |= static_cast<uint64_t>(valueReader.get<uint8_t>()) << (b * 8);
+            }
+            delta64 = middle << (trailing * 8);
+        }
+        previousBits ^= delta64;
+        std::memcpy(&values[i], &previousBits, sizeof(double));
+    }
+}
+
+// ----- File I/O -----
+
+void writeAll(int fd, const void* bytes, size_t length, uint64_t offset, const std::string& path) {
+    const char* cursor = static_cast<const char*>(bytes);
+    while (length > 0) {
+        ssize_t written = ::pwrite(fd, cursor, length, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write '" + path + "': " + std::strerror(errno));
+        }
+        cursor += written;
+        offset += static_cast<uint64_t>(written);
+        length -= static_cast<size_t>(written);
+    }
+}
+
+void readAll(int fd, void* bytes, size_t length, uint64_t offset, const std::string& path) {
+    char* cursor = static_cast<char*>(bytes);
+    while (length > 0) {
+        ssize_t got = ::pread(fd, cursor, length, static_cast<off_t>(offset));
+        if (got <= 0) {
+            if (got < 0 && errno == EINTR) continue;
+            throw std::runtime_error("Failed to read '" + path + "'");
+        }
+        cursor += got;
+        offset += static_cast<uint64_t>(got);
+        length -= static_cast<size_t>(got);
+    }
+}
+
+// Write a complete column file via temp file + rename, so readers never see a partial file
+void writeColumnFile(const std::string& path, const std::vector<int32_t>& dates,
+                     const std::vector<double>& values, HistoryCompression compression,
+                     uint64_t capacity) {
+    std::string tempPath = path + ".tmp";
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create '" + tempPath + "': " + std::strerror(errno));
+    }
+
+    try {
+        ColumnHeader header;
+        header.codec = static_cast<uint32_t>(compression);
+        header.count = dates.size();
+
+        if (compression == HistoryCompression::DeltaXor) {
+            std::string payload = encodeDeltaXor(dates, values);
+            header.capacity = dates.size();
+            header.payloadBytes = payload.size();
+            std::string headerBytes = encodeHeader(header);
+            writeAll(fd, headerBytes.data(), headerBytes.size(), 0, tempPath);
+            writeAll(fd, payload.data(), payload.size(), HEADER_SIZE, tempPath);
+        } else {
+            header.capacity = std::max<uint64_t>(capacity, dates.size());
+            header.payloadBytes = 0;
+            std::string headerBytes = encodeHeader(header);
+            writeAll(fd, headerBytes.data(), headerBytes.size(), 0, tempPath);
+            writeAll(fd, dates.data(), sizeof(int32_t) * dates.size(), HEADER_SIZE, tempPath);
+            writeAll(fd, values.data(), sizeof(double) * values.size(), valuesOffset(header.capacity), tempPath);
+
+            // Reserve the unused capacity so in-place appends never extend the file
+            uint64_t fileSize = valuesOffset(header.capacity) + sizeof(double) * header.capacity;
+            if (::ftruncate(fd, static_cast<off_t>(fileSize)) != 0) {
+                throw std::runtime_error("Failed to size '" + tempPath + "': " + std::strerror(errno));
+            }
+        }
+
+        if (::fsync(fd) != 0) {
+            throw std::runtime_error("Failed to sync '" + tempPath + "': " + std::strerror(errno));
+        }
+    } catch (...) {
+        ::close(fd);
+        std::remove(tempPath.c_str());
+        throw;
+    }
+
+    ::close(fd);
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace '" + path + "': " + std::strerror(errno));
+    }
+}
+
+// YYYYMMDD of the UTC calendar day `days` before today
+int32_t dateDaysAgo(int days) {
+    using namespace std::chrono;
+    const year_month_day ymd{floor<std::chrono::days>(system_clock::now()) - std::chrono::days(days)};
+    return static_cast<int32_t>(static_cast<int>(ymd.year()) * 10000 +
+                                static_cast<int>(static_cast<unsigned>(ymd.month())) * 100 +
+                                static_cast<int>(static_cast<unsigned>(ymd.day())));
+}
+
+}  // namespace
+
+// ===== SeriesView Implementation =====
+
+size_t SeriesView::lowerBound(int32_t date) const {
+    return static_cast<size_t>(std::lower_bound(dates, dates + size, date) - dates);
+}
+
+SeriesView SeriesView::slice(int32_t startDate, int32_t endDate) const {
+    SeriesView sub;
+    if (startDate > endDate) {
+        return sub;
+    }
+    size_t first = lowerBound(startDate);
+    size_t last = static_cast<size_t>(std::upper_bound(dates, dates + size, endDate) - dates);
+    sub.dates = dates + first;
+    sub.values = values + first;
+    sub.size = last - first;
+    return sub;
+}
+
+double SeriesView::valueAsOf(int32_t date) const {
+    size_t after = static_cast<size_t>(std::upper_bound(dates, dates + size, date) - dates);
+    return after == 0 ? std::nan("") : values[after - 1];
+}
+
+// ===== HistoryStore Implementation =====
+
+HistoryStore::HistoryStore(const std::string& rootDir) : root_(rootDir) {
+    namespace fs = std::filesystem;
+
+    if (!fs::is_directory(root_)) {
+        throw std::runtime_error("History store root '" + root_ + "' is not a directory");
+    }
+
+    for (const auto& entry : fs::directory_iterator(root_)) {
+        if (!entry.is_regular_file() || entry.path().extension() != COLUMN_EXTENSION) {
+            continue;
+        }
+
+        std::string path = entry.path().string();
+        auto column = std::make_unique<Column>();
+        column->file = std::make_unique<MappedFile>(path);
+        const MappedFile& file = *column->file;
+
+        ColumnHeader header = decodeHeader(file.data(), file.size(), path);
+
+        if (header.codec == static_cast<uint32_t>(HistoryCompression::None)) {
+            if (header.count > header.capacity ||
+                file.size() < valuesOffset(header.capacity) + sizeof(double) * header.count) {
+                throw std::runtime_error("History column '" + path + "' is truncated");
+            }
+            column->view.dates = reinterpret_cast<const int32_t*>(file.data() + HEADER_SIZE);
+            column->view.values = reinterpret_cast<const double*>(file.data() + valuesOffset(header.capacity));
+            column->view.size = header.count;
+        } else if (header.codec == static_cast<uint32_t>(HistoryCompression::DeltaXor)) {
+            if (file.size() < HEADER_SIZE + header.payloadBytes) {
+                throw std::runtime_error("History column '" + path + "' is truncated");
+            }
+            decodeDeltaXor(file.data() + HEADER_SIZE, header.payloadBytes, header.count,
+                           column->dates, column->values);
+            column->file.reset();  // Decoded copies own the data now
+            column->view.dates = column->dates.data();
+            column->view.values = column->values.data();
+            column->view.size = column->dates.size();
+        } else {
+            throw std::runtime_error("Unknown codec " + std::to_string(header.codec) + " in '" + path + "'");
+        }
+
+        columns_[entry.path().stem().string()] = std::move(column);
+    }
+}
+
+std::vector<std::string> HistoryStore::seriesNames() const {
+    std::vector<std::string> names;
+    names.reserve(columns_.size());
+    for (const auto& [name, _] : columns_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+bool HistoryStore::hasSeries(const std::string& name) const {
+    return columns_.count(name) > 0;
+}
+
+SeriesView HistoryStore::series(const std::string& name) const {
+    auto it = columns_.find(name);
+    if (it == columns_.end()) {
+        throw std::out_of_range("Series '" + name + "' not found in history store " + root_);
+    }
+    return it->second->view;
+}
+
+std::string HistoryStore::seriesPath(const std::string& rootDir, const std::string& name) {
+    if (name.empty() || name.find('/') != std::string::npos || name == "." || name == "..") {
+        throw std::invalid_argument("Invalid series name '" + name + "'");
+    }
+    return (std::filesystem::path(rootDir) / (name + COLUMN_EXTENSION)).string();
+}
+
+void HistoryStore::writeSeries(
+    const std::string& rootDir,
+    const std::string& name,
+    const std::vector<int32_t>& dates,
+    const std::vector<double>& values,
+    HistoryCompression compression)
+{
+    validateSeries(dates, values);
+    std::filesystem::create_directories(rootDir);
+    writeColumnFile(seriesPath(rootDir, name), dates, values, compression, dates.size());
+}
+
+void HistoryStore::appendSeries(
+    const std::string& rootDir,
+    const std::string& name,
+    const std::vector<int32_t>& dates,
+    const std::vector<double>& values)
+{
+    validateSeries(dates, values);
+    if (dates.empty()) {
+        return;
+    }
+
+    std::string path = seriesPath(rootDir, name);
+    if (!std::filesystem::exists(path)) {
+        std::filesystem::create_directories(rootDir);
+        writeColumnFile(path, dates, values, HistoryCompression::None,
+                        std::max<uint64_t>(MIN_CAPACITY, dates.size()));
+        return;
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open '" + path + "': " + std::strerror(errno));
+    }
+
+    try {
+        char headerBytes[HEADER_SIZE];
+        readAll(fd, headerBytes, HEADER_SIZE, 0, path);
+        ColumnHeader header = decodeHeader(headerBytes, HEADER_SIZE, path);
+
+        // Load existing rows only when the file has to be rewritten
+        auto loadExisting = [&](std::vector<int32_t>& oldDates, std::vector<double>& oldValues) {
+            if (header.codec == static_cast<uint32_t>(HistoryCompression::DeltaXor)) {
+                std::vector<char> payload(header.payloadBytes);
+                readAll(fd, payload.data(), payload.size(), HEADER_SIZE, path);
+                decodeDeltaXor(payload.data(), payload.size(), header.count, oldDates, oldValues);
+            } else {
+                oldDates.resize(header.count);
+                oldValues.resize(header.count);
+                readAll(fd, oldDates.data(), sizeof(int32_t) * header.count, HEADER_SIZE, path);
+                readAll(fd, oldValues.data(), sizeof(double) * header.count, valuesOffset(header.capacity), path);
+            }
+        };
+
+        if (header.codec == static_cast<uint32_t>(HistoryCompression::None)) {
+            if (header.count > 0) {
+                int32_t lastDate;
+                readAll(fd, &lastDate, sizeof(lastDate), HEADER_SIZE + sizeof(int32_t) * (header.count - 1), path);
+                if (dates.front() <= lastDate) {
+                    throw std::invalid_argument("Append to '" + name + "' must start after " + std::to_string(lastDate));
+                }
+            }
+
+            if (header.count + dates.size() <= header.capacity) {
+                // In place: write rows into reserved space, then commit the new count
+                writeAll(fd, dates.data(), sizeof(int32_t) * dates.size(),
+                         HEADER_SIZE + sizeof(int32_t) * header.count, path);
+                writeAll(fd, values.data(), sizeof(double) * values.size(),
+                         valuesOffset(header.capacity) + sizeof(double) * header.count, path);
+                if (::fsync(fd) != 0) {
+                    throw std::runtime_error("Failed to sync '" + path + "': " + std::strerror(errno));
+                }
+                uint64_t newCount = header.count + dates.size();
+                writeAll(fd, &newCount, sizeof(newCount), COUNT_FIELD_OFFSET, path);
+                ::close(fd);
+                return;
+            }
+        }
+
+        std::vector<int32_t> allDates;
+        std::vector<double> allValues;
+        loadExisting(allDates, allValues);
+        ::close(fd);
+        fd = -1;
+
+        if (!allDates.empty() && dates.front() <= allDates.back()) {
+            throw std::invalid_argument("Append to '" + name + "' must start after " + std::to_string(allDates.back()));
+        }
+        allDates.insert(allDates.end(), dates.begin(), dates.end());
+        allValues.insert(allValues.end(), values.begin(), values.end());
+
+        // Uncompressed: double the reservation so daily appends rewrite the file
+        // O(log n) times. DeltaXor keeps no reservation and is rewritten every time.
+        uint64_t capacity = std::max<uint64_t>({MIN_CAPACITY, header.capacity * 2, allDates.size()});
+        writeColumnFile(path, allDates, allValues, static_cast<HistoryCompression>(header.codec), capacity);
+    } catch (...) {
+        if (fd >= 0) ::close(fd);
+        throw;
+    }
+}
+
+const HistoryStore* HistoryStore::shared() {
+    static const std::unique_ptr<HistoryStore> store = []() -> std::unique_ptr<HistoryStore> {
+        const char* root = std::getenv("HISTORY_STORE_PATH");
+        if (root == nullptr || *root == '\0') {
+            return nullptr;
+        }
+        try {
+            return std::make_unique<HistoryStore>(root);
+        } catch (const std::exception& e) {
+            Logger::warn("History store unavailable", {
+                {"root", root},
+                {"error", e.what()}
+            });
+            return nullptr;
+        }
+    }();
+    return store.get();
+}
+
+bool HistoryStore::latestValues(const std::string& name, int numValues, int32_t notBefore,
+                                std::vector<double>& out) const {
+    auto it = columns_.find(name);
+    if (it == columns_.end() || numValues < 1) {
+        return false;
+    }
+
+    const SeriesView& view = it->second->view;
+    if (view.size < static_cast<size_t>(numValues) || view.dates[view.size - 1] < notBefore) {
+        return false;
+    }
+
+    out.assign(std::make_reverse_iterator(view.values + view.size),
+               std::make_reverse_iterator(view.values + view.size - numValues));
+    return true;
+}
+
+bool HistoryStore::readRecent(const std::string& name, int numValues, int maxAgeDays, std::vector<double>& out) {
+    const HistoryStore* store = shared();
+    if (store == nullptr || !store->hasSeries(name)) {
+        return false;
+    }
+
+    if (!store->latestValues(name, numValues, dateDaysAgo(maxAgeDays), out)) {
+        SeriesView view = store->series(name);
+        Logger::warn("History store series is short or stale; falling back", {
+            {"series", name},
+            {"stored", view.size},
+            {"requested", numValues},
+            {"last_date", view.empty() ? 0 : view.dates[view.size - 1]},
+            {"max_age_days", maxAgeDays}
+        });
+        return false;
+    }
+    return true;
+}
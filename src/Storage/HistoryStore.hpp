@@ -0,0 +1,166 @@
+//
+//  HistoryStore.hpp
+//  InvertedYieldCurveTrader
+//
+//  Columnar, memory-mapped store of raw indicator history.
+//  One file per series: int32 dates (YYYYMMDD) + float64 values.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef HISTORY_STORE_HPP
+#define HISTORY_STORE_HPP
+
+#include "MappedFile.hpp"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * SeriesView: Zero-copy view of one series (dates ascending)
+ *
+ * Points straight into the mapped file for uncompressed series, so it is
+ * only valid while the owning HistoryStore is alive.
+ */
+struct SeriesView {
+    const int32_t* dates = nullptr;   // YYYYMMDD, strictly increasing
+    const double* values = nullptr;
+    size_t size = 0;
+
+    bool empty() const { return size == 0; }
+
+    /**
+     * Index of the first observation with date >= date (size if none)
+     */
+    size_t lowerBound(int32_t date) const;
+
+    /**
+     * Sub-view of observations with startDate <= date <= endDate
+     */
+    SeriesView slice(int32_t startDate, int32_t endDate) const;
+
+    /**
+     * Last observed value on or before date (NaN if the series starts later)
+     */
+    double valueAsOf(int32_t date) const;
+};
+
+/**
+ * Column codec
+ *
+ * None:     dates and values stored as raw arrays, mapped zero-copy.
+ * DeltaXor: dates as zigzag-delta varints, values XOR'd against the previous
+ *           value with leading/trailing zero bytes dropped. Sticky macro
+ *           series (LOCF-filled monthly data) compress 4-8x. Decoded once
+ *           on open.
+ */
+enum class HistoryCompression : uint32_t {
+    None = 0,
+    DeltaXor = 1
+};
+
+/**
+ * HistoryStore: Read-only panel of series files under a root directory
+ *
+ * Opening maps every "<name>.col" file in the root; pages are faulted in on
+ * first access, so a 50-year × 500-series panel opens in milliseconds. A
+ * store is immutable after construction and safe to share across threads.
+ *
+ * Usage:
+ *   HistoryStore store("/data/history");
+ *   SeriesView vix = store.series("vix");
+ *   double latest = vix.values[vix.size - 1];
+ */
+class HistoryStore {
+public:
+    /**
+     * Map all series under rootDir
+     *
+     * @throws std::runtime_error if rootDir is missing or a file is corrupt
+     */
+    explicit HistoryStore(const std::string& rootDir);
+
+    const std::string& root() const { return root_; }
+
+    std::vector<std::string> seriesNames() const;
+    bool hasSeries(const std::string& name) const;
+
+    /**
+     * @throws std::out_of_range if the series is not in the store
+     */
+    SeriesView series(const std::string& name) const;
+
+    /**
+     * Write (replace) a whole series
+     *
+     * @throws std::invalid_argument if sizes differ or dates are not strictly increasing
+     */
+    static void writeSeries(
+        const std::string& rootDir,
+        const std::string& name,
+        const std::vector<int32_t>& dates,
+        const std::vector<double>& values,
+        HistoryCompression compression = HistoryCompression::None
+    );
+
+    /**
+     * Append observations to a series (created uncompressed if missing)
+     *
+     * Uncompressed series grow in place with reserved capacity (amortized
+     * O(1) per row); the row count is committed last, so a crash mid-append
+     * leaves the previous contents intact. A DeltaXor series has no spare
+     * capacity: every append decodes and rewrites the whole file, so keep
+     * compression for archived series. Stores opened earlier keep their
+     * snapshot; reopen to see new rows.
+     *
+     * @throws std::invalid_argument if dates do not extend the series in order
+     */
+    static void appendSeries(
+        const std::string& rootDir,
+        const std::string& name,
+        const std::vector<int32_t>& dates,
+        const std::vector<double>& values
+    );
+
+    /**
+     * Most recent numValues observations of a series, most recent first
+     * (the order the data processors return)
+     *
+     * @param notBefore: YYYYMMDD the newest observation must reach
+     * @return false if the series is missing, holds fewer than numValues
+     *         observations or ends before notBefore
+     */
+    bool latestValues(const std::string& name, int numValues, int32_t notBefore, std::vector<double>& out) const;
+
+    /**
+     * Process-wide store rooted at $HISTORY_STORE_PATH (nullptr if unset)
+     */
+    static const HistoryStore* shared();
+
+    /**
+     * latestValues() from the shared store, requiring the newest observation
+     * to be at most maxAgeDays calendar days old
+     *
+     * @return false (caller falls back to the API) if no shared store is
+     *         configured or its series is missing, short or stale
+     */
+    static bool readRecent(const std::string& name, int numValues, int maxAgeDays, std::vector<double>& out);
+
+private:
+    struct Column {
+        std::unique_ptr<MappedFile> file;   // Uncompressed: view points into the mapping
+        std::vector<int32_t> dates;         // Compressed: decoded copies
+        std::vector<double> values;
+        SeriesView view;
+    };
+
+    std::string root_;
+    std::map<std::string, std::unique_ptr<Column>> columns_;
+
+    static std::string seriesPath(const std::string& rootDir, const std::string& name);
+};
+
+#endif // HISTORY_STORE_HPP
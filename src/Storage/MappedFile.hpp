@@ -0,0 +1,56 @@
+//
+//  MappedFile.hpp
+//  InvertedYieldCurveTrader
+//
+//  Read-only memory mapping of an on-disk file (POSIX mmap)
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+/**
+ * RAII wrapper around a read-only memory mapping
+ *
+ * Readers of the binary stores parse records directly out of the mapping
+ * instead of copying the file into a buffer first. The OS pages data in on
+ * demand, so opening a multi-GB store is O(1).
+ *
+ * Usage:
+ *   MappedFile file("results.log");
+ *   const char* bytes = file.data();
+ *   size_t n = file.size();
+ */
+class MappedFile {
+public:
+    /**
+     * Map an existing file
+     *
+     * @param path: File to map (an empty file yields data() == nullptr, size() == 0)
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const char* data_;
+    size_t size_;
+
+    void release();
+};
+
+#endif // MAPPED_FILE_HPP
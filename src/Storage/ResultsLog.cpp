@@ -0,0 +1,476 @@
+//
+//  ResultsLog.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the append-only daily results log
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "ResultsLog.hpp"
+#include "BinaryIO.hpp"
+#include "../Utils/Date.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr char LOG_MAGIC[8] = {'I', 'Y', 'C', 'R', 'L', 'O', 'G', '1'};
+constexpr char INDEX_MAGIC[8] = {'I', 'Y', 'C', 'R', 'I', 'D', 'X', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t FILE_HEADER_SIZE = 16;     // magic[8] + u32 version + u32 reserved
+constexpr size_t RECORD_HEADER_SIZE = 8;    // u32 payloadLength + u32 checksum
+constexpr size_t INDEX_ENTRY_SIZE = 16;     // i32 date + u32 ordinal + u64 offset
+
+std::string fileHeader(const char (&magic)[8], uint32_t reserved) {
+    ByteWriter writer;
+    writer.putBytes(magic, sizeof(magic));
+    writer.put<uint32_t>(FORMAT_VERSION);
+    writer.put<uint32_t>(reserved);
+    return writer.bytes();
+}
+
+bool hasHeader(const char* data, size_t size, const char (&magic)[8]) {
+    return size >= FILE_HEADER_SIZE && std::memcmp(data, magic, sizeof(magic)) == 0;
+}
+
+void writeFully(int fd, const std::string& bytes, const std::string& path) {
+    const char* cursor = bytes.data();
+    size_t remaining = bytes.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, cursor, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write '" + path + "': " + std::strerror(errno));
+        }
+        cursor += written;
+        remaining -= static_cast<size_t>(written);
+    }
+}
+
+// Returns the end offset of a complete, checksum-valid record at offset, or 0
+uint64_t validRecordEnd(const char* data, size_t size, uint64_t offset) {
+    if (offset + RECORD_HEADER_SIZE > size) {
+        return 0;
+    }
+    uint32_t length, checksum;
+    std::memcpy(&length, data + offset, sizeof(length));
+    std::memcpy(&checksum, data + offset + 4, sizeof(checksum));
+    uint64_t end = offset + RECORD_HEADER_SIZE + length;
+    if (length < sizeof(int32_t) || end > size) {
+        return 0;
+    }
+    if (fnv1a32(data + offset + RECORD_HEADER_SIZE, length) != checksum) {
+        return 0;
+    }
+    return end;
+}
+
+int32_t recordDate(const char* data, uint64_t offset) {
+    int32_t date;
+    std::memcpy(&date, data + offset + RECORD_HEADER_SIZE, sizeof(date));
+    return date;
+}
+
+void putMatrix(ByteWriter& writer, const Eigen::MatrixXd& matrix) {
+    writer.put<uint32_t>(static_cast<uint32_t>(matrix.rows()));
+    writer.put<uint32_t>(static_cast<uint32_t>(matrix.cols()));
+    writer.putBytes(matrix.data(), sizeof(double) * matrix.size());
+}
+
+Eigen::MatrixXd getMatrix(ByteReader& reader) {
+    uint32_t rows = reader.get<uint32_t>();
+    uint32_t cols = reader.get<uint32_t>();
+    Eigen::MatrixXd matrix(rows, cols);
+    reader.getBytes(matrix.data(), sizeof(double) * matrix.size());
+    return matrix;
+}
+
+void putVector(ByteWriter& writer, const double* values, size_t count) {
+    writer.put<uint32_t>(static_cast<uint32_t>(count));
+    writer.putBytes(values, sizeof(double) * count);
+}
+
+std::vector<double> getVector(ByteReader& reader) {
+    uint32_t count = reader.get<uint32_t>();
+    std::vector<double> values(count);
+    reader.getBytes(values.data(), sizeof(double) * count);
+    return values;
+}
+
+void putStrings(ByteWriter& writer, const std::vector<std::string>& values) {
+    writer.put<uint32_t>(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+        writer.putString(value);
+    }
+}
+
+std::vector<std::string> getStrings(ByteReader& reader) {
+    uint32_t count = reader.get<uint32_t>();
+    std::vector<std::string> values;
+    values.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        values.push_back(reader.getString());
+    }
+    return values;
+}
+
+std::string encodePayload(const DailyResult& result) {
+    ByteWriter writer;
+    writer.put<int32_t>(result.date);       // Must stay first: readers peek at it
+    writer.put<int64_t>(result.timestamp);
+    putStrings(writer, result.indicatorNames);
+    putMatrix(writer, result.covariance);
+    putVector(writer, result.eigenvalues.data(), result.eigenvalues.size());
+    putMatrix(writer, result.eigenvectors);
+    writer.put<double>(result.frobeniusNorm);
+    writer.put<double>(result.conditionNumber);
+    writer.put<double>(result.varianceExplained);
+    putStrings(writer, result.factorLabels);
+    putVector(writer, result.labelConfidences.data(), result.labelConfidences.size());
+    writer.put<double>(result.recommendedNotional);
+    writer.put<double>(result.recommendedShares);
+    writer.put<double>(result.recommendedLeverage);
+    writer.putString(result.riskLabel);
+    writer.put<double>(result.volatilityMultiplier);
+    return writer.bytes();
+}
+
+}  // namespace
+
+// ===== ResultsLogWriter Implementation =====
+
+ResultsLogWriter::ResultsLogWriter(const std::string& path, int indexStride)
+    : path_(path), indexStride_(indexStride), logFd_(-1), indexFd_(-1),
+      endOffset_(0), recordCount_(0), lastDate_(0) {
+    if (indexStride_ < 1) {
+        throw std::invalid_argument("indexStride must be >= 1");
+    }
+
+    logFd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (logFd_ < 0) {
+        throw std::runtime_error("Failed to open '" + path_ + "': " + std::strerror(errno));
+    }
+
+    indexFd_ = ::open((path_ + ".idx").c_str(), O_RDWR | O_CREAT, 0644);
+    if (indexFd_ < 0) {
+        ::close(logFd_);
+        throw std::runtime_error("Failed to open '" + path_ + ".idx': " + std::strerror(errno));
+    }
+
+    try {
+        recover();
+    } catch (...) {
+        ::close(logFd_);
+        ::close(indexFd_);
+        throw;
+    }
+}
+
+ResultsLogWriter::~ResultsLogWriter() {
+    if (logFd_ >= 0) ::close(logFd_);
+    if (indexFd_ >= 0) ::close(indexFd_);
+}
+
+void ResultsLogWriter::recover() {
+    struct stat st;
+    if (::fstat(logFd_, &st) != 0) {
+        throw std::runtime_error("Failed to stat '" + path_ + "': " + std::strerror(errno));
+    }
+
+    std::vector<std::pair<int32_t, uint64_t>> entries;  // (date, offset) of indexed records
+
+    if (st.st_size == 0) {
+        writeFully(logFd_, fileHeader(LOG_MAGIC, 0), path_);
+        endOffset_ = FILE_HEADER_SIZE;
+    } else {
+        MappedFile log(path_);
+        if (!hasHeader(log.data(), log.size(), LOG_MAGIC)) {
+            throw std::runtime_error("'" + path_ + "' is not a results log");
+        }
+
+        // Trust existing index entries that still point at valid records, then
+        // only checksum the tail after the last one.
+        uint64_t offset = FILE_HEADER_SIZE;
+        size_t ordinal = 0;
+        try {
+            MappedFile index(path_ + ".idx");
+            if (hasHeader(index.data(), index.size(), INDEX_MAGIC)) {
+                for (size_t pos = FILE_HEADER_SIZE; pos + INDEX_ENTRY_SIZE <= index.size(); pos += INDEX_ENTRY_SIZE) {
+                    ByteReader reader(index.data() + pos, INDEX_ENTRY_SIZE);
+                    int32_t date = reader.get<int32_t>();
+                    uint32_t entryOrdinal = reader.get<uint32_t>();
+                    uint64_t entryOffset = reader.get<uint64_t>();
+                    if (entryOrdinal != entries.size() * static_cast<size_t>(indexStride_) ||
+                        validRecordEnd(log.data(), log.size(), entryOffset) == 0) {
+                        break;
+                    }
+                    entries.emplace_back(date, entryOffset);
+                }
+            }
+        } catch (const std::runtime_error&) {
+            entries.clear();  // Unreadable index: rebuild from the log
+        }
+
+        if (!entries.empty()) {
+            offset = entries.back().second;
+            ordinal = (entries.size() - 1) * indexStride_;
+            entries.pop_back();  // Re-added by the scan below
+        }
+
+        while (uint64_t end = validRecordEnd(log.data(), log.size(), offset)) {
+            if (ordinal % indexStride_ == 0) {
+                entries.emplace_back(recordDate(log.data(), offset), offset);
+            }
+            lastDate_ = recordDate(log.data(), offset);
+            ordinal++;
+            offset = end;
+        }
+
+        endOffset_ = offset;
+        recordCount_ = ordinal;
+
+        // Drop a torn tail so the next append starts on a record boundary
+        if (endOffset_ < log.size()) {
+            if (::ftruncate(logFd_, static_cast<off_t>(endOffset_)) != 0) {
+                throw std::runtime_error("Failed to truncate '" + path_ + "': " + std::strerror(errno));
+            }
+        }
+    }
+
+    // Rewrite the index to exactly match the recovered log
+    ByteWriter index;
+    index.putBytes(fileHeader(INDEX_MAGIC, static_cast<uint32_t>(indexStride_)).data(), FILE_HEADER_SIZE);
+    for (size_t i = 0; i < entries.size(); i++) {
+        index.put<int32_t>(entries[i].first);
+        index.put<uint32_t>(static_cast<uint32_t>(i * indexStride_));
+        index.put<uint64_t>(entries[i].second);
+    }
+    if (::ftruncate(indexFd_, 0) != 0 || ::lseek(indexFd_, 0, SEEK_SET) < 0) {
+        throw std::runtime_error("Failed to reset '" + path_ + ".idx': " + std::strerror(errno));
+    }
+    writeFully(indexFd_, index.bytes(), path_ + ".idx");
+
+    if (::lseek(logFd_, 0, SEEK_END) < 0) {
+        throw std::runtime_error("Failed to seek '" + path_ + "': " + std::strerror(errno));
+    }
+}
+
+void ResultsLogWriter::append(const DailyResult& result) {
+    if (recordCount_ > 0 && result.date < lastDate_) {
+        throw std::invalid_argument(
+            "Results must be appended in date order: " + std::to_string(result.date) +
+            " is older than " + std::to_string(lastDate_));
+    }
+
+    std::string payload = encodePayload(result);
+
+    ByteWriter frame;
+    frame.put<uint32_t>(static_cast<uint32_t>(payload.size()));
+    frame.put<uint32_t>(fnv1a32(payload.data(), payload.size()));
+    frame.putBytes(payload.data(), payload.size());
+
+    uint64_t recordOffset = endOffset_;
+    writeFully(logFd_, frame.bytes(), path_);
+    endOffset_ += frame.size();
+
+    if (recordCount_ % indexStride_ == 0) {
+        ByteWriter entry;
+        entry.put<int32_t>(result.date);
+        entry.put<uint32_t>(static_cast<uint32_t>(recordCount_));
+        entry.put<uint64_t>(recordOffset);
+        writeFully(indexFd_, entry.bytes(), path_ + ".idx");
+    }
+
+    recordCount_++;
+    lastDate_ = result.date;
+}
+
+void ResultsLogWriter::flush() {
+    if (::fsync(logFd_) != 0 || ::fsync(indexFd_) != 0) {
+        throw std::runtime_error("Failed to sync '" + path_ + "': " + std::strerror(errno));
+    }
+}
+
+// ===== ResultsLogReader Implementation =====
+
+ResultsLogReader::ResultsLogReader(const std::string& path)
+    : log_(path), recordCount_(0), lastRecordOffset_(0) {
+    if (!hasHeader(log_.data(), log_.size(), LOG_MAGIC)) {
+        throw std::runtime_error("'" + path + "' is not a results log");
+    }
+
+    try {
+        MappedFile index(path + ".idx");
+        if (hasHeader(index.data(), index.size(), INDEX_MAGIC)) {
+            for (size_t pos = FILE_HEADER_SIZE; pos + INDEX_ENTRY_SIZE <= index.size(); pos += INDEX_ENTRY_SIZE) {
+                ByteReader reader(index.data() + pos, INDEX_ENTRY_SIZE);
+                IndexEntry entry;
+                entry.date = reader.get<int32_t>();
+                entry.ordinal = reader.get<uint32_t>();
+                entry.offset = reader.get<uint64_t>();
+
+                // Stop at the first entry that disagrees with the log (stale index)
+                bool ordered = index_.empty() ||
+                    (entry.offset > index_.back().offset && entry.ordinal > index_.back().ordinal &&
+                     entry.date >= index_.back().date);
+                if (!ordered || validRecordEnd(log_.data(), log_.size(), entry.offset) == 0) {
+                    break;
+                }
+                index_.push_back(entry);
+            }
+        }
+    } catch (const std::runtime_error&) {
+        index_.clear();  // No index: queries scan from the first record
+    }
+
+    // Count the tail past the last index entry (at most indexStride records)
+    uint64_t offset = index_.empty() ? FILE_HEADER_SIZE : index_.back().offset;
+    size_t ordinal = index_.empty() ? 0 : index_.back().ordinal;
+    while (uint64_t end = validRecordEnd(log_.data(), log_.size(), offset)) {
+        lastRecordOffset_ = offset;
+        ordinal++;
+        offset = end;
+    }
+    recordCount_ = ordinal;
+}
+
+uint64_t ResultsLogReader::nextOffset(uint64_t offset) const {
+    if (offset + RECORD_HEADER_SIZE > log_.size()) {
+        return 0;
+    }
+    uint32_t length;
+    std::memcpy(&length, log_.data() + offset, sizeof(length));
+    uint64_t end = offset + RECORD_HEADER_SIZE + length;
+    return end <= log_.size() ? end : 0;
+}
+
+int ResultsLogReader::dateAt(uint64_t offset) const {
+    return recordDate(log_.data(), offset);
+}
+
+DailyResult ResultsLogReader::decodeAt(uint64_t offset) const {
+    if (validRecordEnd(log_.data(), log_.size(), offset) == 0) {
+        throw std::runtime_error("Corrupt results log record at offset " + std::to_string(offset));
+    }
+
+    uint32_t length;
+    std::memcpy(&length, log_.data() + offset, sizeof(length));
+    ByteReader reader(log_.data() + offset + RECORD_HEADER_SIZE, length);
+
+    DailyResult result;
+    result.date = reader.get<int32_t>();
+    result.timestamp = reader.get<int64_t>();
+    result.indicatorNames = getStrings(reader);
+    result.covariance = getMatrix(reader);
+    std::vector<double> eigenvalues = getVector(reader);
+    result.eigenvalues = Eigen::Map<Eigen::VectorXd>(eigenvalues.data(), eigenvalues.size());
+    result.eigenvectors = getMatrix(reader);
+    result.frobeniusNorm = reader.get<double>();
+    result.conditionNumber = reader.get<double>();
+    result.varianceExplained = reader.get<double>();
+    result.factorLabels = getStrings(reader);
+    result.labelConfidences = getVector(reader);
+    result.recommendedNotional = reader.get<double>();
+    result.recommendedShares = reader.get<double>();
+    result.recommendedLeverage = reader.get<double>();
+    result.riskLabel = reader.getString();
+    result.volatilityMultiplier = reader.get<double>();
+    return result;
+}
+
+void ResultsLogReader::forEachInRange(
+    int startDate,
+    int endDate,
+    const std::function<void(const DailyResult&)>& visitor) const
+{
+    if (recordCount_ == 0 || startDate > endDate) {
+        return;
+    }
+
+    // Start from the last index entry strictly before startDate: records with
+    // the same date may straddle an index boundary.
+    uint64_t offset = FILE_HEADER_SIZE;
+    auto it = std::lower_bound(index_.begin(), index_.end(), startDate,
+        [](const IndexEntry& entry, int date) { return entry.date < date; });
+    if (it != index_.begin()) {
+        offset = std::prev(it)->offset;
+    }
+
+    while (offset != 0 && offset <= lastRecordOffset_) {
+        int date = dateAt(offset);
+        if (date > endDate) {
+            break;
+        }
+        if (date >= startDate) {
+            visitor(decodeAt(offset));
+        }
+        offset = nextOffset(offset);
+    }
+}
+
+std::vector<DailyResult> ResultsLogReader::readRange(int startDate, int endDate) const {
+    std::vector<DailyResult> results;
+    forEachInRange(startDate, endDate, [&results](const DailyResult& result) {
+        results.push_back(result);
+    });
+    return results;
+}
+
+bool ResultsLogReader::readLatest(DailyResult& out) const {
+    if (recordCount_ == 0) {
+        return false;
+    }
+    out = decodeAt(lastRecordOffset_);
+    return true;
+}
+
+json ResultsLogReader::toJson(const DailyResult& result) {
+    auto matrixRows = [](const Eigen::MatrixXd& matrix) {
+        json rows = json::array();
+        for (int i = 0; i < matrix.rows(); i++) {
+            json row = json::array();
+            for (int j = 0; j < matrix.cols(); j++) {
+                row.push_back(matrix(i, j));
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    };
+
+    json factors = json::array();
+    for (size_t k = 0; k < result.factorLabels.size(); k++) {
+        factors.push_back({
+            {"label", result.factorLabels[k]},
+            {"confidence", k < result.labelConfidences.size() ? result.labelConfidences[k] : 0.0}
+        });
+    }
+
+    json output;
+    output["date"] = intToDate(result.date);
+    output["timestamp"] = result.timestamp;
+    output["indicators"] = result.indicatorNames;
+    output["covariance_matrix"] = matrixRows(result.covariance);
+    output["eigenvalues"] = std::vector<double>(result.eigenvalues.data(),
+                                                result.eigenvalues.data() + result.eigenvalues.size());
+    output["eigenvectors"] = matrixRows(result.eigenvectors);
+    output["frobenius_norm"] = result.frobeniusNorm;
+    output["condition_number"] = result.conditionNumber;
+    output["variance_explained"] = result.varianceExplained;
+    output["factors"] = factors;
+    output["position"] = {
+        {"notional", result.recommendedNotional},
+        {"contracts", result.recommendedShares},
+        {"leverage", result.recommendedLeverage}
+    };
+    output["regime"] = {
+        {"risk_label", result.riskLabel},
+        {"volatility_multiplier", result.volatilityMultiplier}
+    };
+    return output;
+}
@@ -0,0 +1,181 @@
+//
+//  ResultsLog.hpp
+//  InvertedYieldCurveTrader
+//
+//  Append-only binary log of daily analysis results with a sparse date index.
+//  Replaces one-JSON-object-per-day snapshots for historical queries.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef RESULTS_LOG_HPP
+#define RESULTS_LOG_HPP
+
+#include "MappedFile.hpp"
+#include <Eigen/Dense>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+using json = nlohmann::json;
+
+/**
+ * DailyResult: Everything one daily run produces
+ *
+ * The run's structured output: timestamp, Σ, Λ, U, ‖Σ‖_F, κ(Σ), variance
+ * explained, factor labels and the position sizing recommendation. The old
+ * S3 snapshots kept only the text dump of output.txt.
+ */
+struct DailyResult {
+    int date = 0;                                   // YYYYMMDD (see dateToInt)
+    int64_t timestamp = 0;                          // Unix seconds when the run finished
+
+    std::vector<std::string> indicatorNames;        // N indicator names (matrix order)
+    Eigen::MatrixXd covariance;                     // Σ (N × N)
+    Eigen::VectorXd eigenvalues;                    // Λ (N, descending)
+    Eigen::MatrixXd eigenvectors;                   // U (N × N, columns match Λ)
+
+    double frobeniusNorm = 0.0;                     // ‖Σ‖_F
+    double conditionNumber = 0.0;                   // κ(Σ) = λ_max / λ_min
+    double varianceExplained = 0.0;                 // Cumulative variance of the K factors
+
+    std::vector<std::string> factorLabels;          // K labels
+    std::vector<double> labelConfidences;           // K cosine scores
+
+    // Position sizing
+    double recommendedNotional = 0.0;
+    double recommendedShares = 0.0;
+    double recommendedLeverage = 0.0;
+    std::string riskLabel;
+    double volatilityMultiplier = 1.0;
+};
+
+/**
+ * ResultsLogWriter: Appends DailyResult records to the log
+ *
+ * On-disk layout:
+ *   <path>      16-byte header, then records: [u32 payloadLength][u32 fnv1a][payload]
+ *   <path>.idx  16-byte header, then one {i32 date, u32 ordinal, u64 offset} entry
+ *               every indexStride records (sparse date index)
+ *
+ * Records must be appended in non-decreasing date order. A record torn by a
+ * crash mid-write is detected by its checksum and truncated on the next open.
+ */
+class ResultsLogWriter {
+public:
+    /**
+     * Open (or create) a results log for appending
+     *
+     * @param path: Log file path; the index lives at path + ".idx"
+     * @param indexStride: Records between sparse index entries (default 64)
+     * @throws std::runtime_error on I/O failure or a foreign file at path
+     */
+    explicit ResultsLogWriter(const std::string& path, int indexStride = 64);
+    ~ResultsLogWriter();
+
+    ResultsLogWriter(const ResultsLogWriter&) = delete;
+    ResultsLogWriter& operator=(const ResultsLogWriter&) = delete;
+
+    /**
+     * Append one daily result
+     *
+     * @throws std::invalid_argument if result.date is older than the last record
+     */
+    void append(const DailyResult& result);
+
+    /**
+     * Flush both files to stable storage (fsync)
+     */
+    void flush();
+
+    size_t recordCount() const { return recordCount_; }
+    int lastDate() const { return lastDate_; }
+
+private:
+    std::string path_;
+    int indexStride_;
+    int logFd_;
+    int indexFd_;
+    uint64_t endOffset_;
+    size_t recordCount_;
+    int lastDate_;
+
+    void recover();
+};
+
+/**
+ * ResultsLogReader: Memory-mapped reader with date-range queries
+ *
+ * Range queries binary-search the sparse index, then scan at most
+ * indexStride record headers before reaching the first match.
+ */
+class ResultsLogReader {
+public:
+    /**
+     * Map a results log for reading
+     *
+     * A missing or stale index only costs a longer scan, never wrong results.
+     *
+     * @throws std::runtime_error if the log is missing or has a bad header
+     */
+    explicit ResultsLogReader(const std::string& path);
+
+    /**
+     * Number of complete records in the log
+     */
+    size_t size() const { return recordCount_; }
+
+    /**
+     * Visit every record with startDate <= date <= endDate, in log order
+     */
+    void forEachInRange(int startDate, int endDate,
+                        const std::function<void(const DailyResult&)>& visitor) const;
+
+    /**
+     * Read every record with startDate <= date <= endDate
+     */
+    std::vector<DailyResult> readRange(int startDate, int endDate) const;
+
+    /**
+     * Read the most recent record
+     *
+     * @return false if the log is empty
+     */
+    bool readLatest(DailyResult& out) const;
+
+    /**
+     * Human-readable JSON export of a record:
+     *   {date: "YYYY-MM-DD", timestamp, indicators, covariance_matrix, eigenvalues,
+     *    eigenvectors (rows), frobenius_norm, condition_number, variance_explained,
+     *    factors: [{label, confidence}], position: {notional, contracts, leverage},
+     *    regime: {risk_label, volatility_multiplier}}
+     *
+     * This replaces the old positions/YYYY-MM-DD.json snapshots, which were
+     * {date, timestamp, output} with the raw text of output.txt.
+     */
+    static json toJson(const DailyResult& result);
+
+private:
+    struct IndexEntry {
+        int32_t date;
+        uint32_t ordinal;       // Record number of the indexed record
+        uint64_t offset;        // Byte offset of the record header in the log
+    };
+
+    MappedFile log_;
+    std::vector<IndexEntry> index_;
+    size_t recordCount_;
+    uint64_t lastRecordOffset_;
+
+    /**
+     * Offset of the next record after the one at offset, or 0 at end/torn tail
+     */
+    uint64_t nextOffset(uint64_t offset) const;
+
+    int dateAt(uint64_t offset) const;
+    DailyResult decodeAt(uint64_t offset) const;
+};
+
+#endif // RESULTS_LOG_HPP
@@ -0,0 +1,297 @@
+//
+//  VintageStore.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the point-in-time vintage store
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "VintageStore.hpp"
+#include "BinaryIO.hpp"
+#include "../Utils/Date.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr char VINTAGE_MAGIC[8] = {'I', 'Y', 'C', 'V', 'I', 'N', 'T', '1'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t HEADER_SIZE = 24;  // magic + version + reserved + count
+const std::string VINTAGE_EXTENSION = ".vin";
+
+bool recordLess(const VintageRecord& a, const VintageRecord& b) {
+    return a.date != b.date ? a.date < b.date : a.realtimeStart < b.realtimeStart;
+}
+
+// Sorted records must have ordered, non-overlapping realtime periods per observation
+const char* findLayoutError(const VintageRecord* records, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (records[i].realtimeEnd < records[i].realtimeStart) {
+            return "realtime_end before realtime_start";
+        }
+        if (i > 0 && records[i].date == records[i - 1].date &&
+            records[i].realtimeStart <= records[i - 1].realtimeEnd) {
+            return "overlapping vintages of one observation";
+        }
+        if (i > 0 && recordLess(records[i], records[i - 1])) {
+            return "records out of order";
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+// ===== VintageSeries Implementation =====
+
+VintageSeries::VintageSeries(const VintageRecord* records, size_t count)
+    : records_(records), count_(count) {
+    for (size_t i = 0; i < count; i++) {
+        if (index_.empty() || index_.back().date != records[i].date) {
+            index_.push_back({records[i].date, static_cast<uint32_t>(i), static_cast<uint32_t>(i)});
+        }
+        index_.back().end = static_cast<uint32_t>(i + 1);
+    }
+}
+
+const VintageRecord* VintageSeries::currentRecord(const ObservationRange& range, int32_t asOfDate) const {
+    // Last vintage published on or before asOfDate
+    const VintageRecord* first = records_ + range.begin;
+    const VintageRecord* last = records_ + range.end;
+    const VintageRecord* after = std::upper_bound(first, last, asOfDate,
+        [](int32_t date, const VintageRecord& record) { return date < record.realtimeStart; });
+
+    if (after == first || asOfDate > (after - 1)->realtimeEnd) {
+        return nullptr;
+    }
+    return after - 1;
+}
+
+double VintageSeries::valueAsOf(int32_t date, int32_t asOfDate) const {
+    auto it = std::lower_bound(index_.begin(), index_.end(), date,
+        [](const ObservationRange& range, int32_t d) { return range.date < d; });
+    if (it == index_.end() || it->date != date) {
+        return std::nan("");
+    }
+    const VintageRecord* record = currentRecord(*it, asOfDate);
+    return record ? record->value : std::nan("");
+}
+
+VintageSnapshot VintageSeries::snapshotAsOf(int32_t asOfDate) const {
+    VintageSnapshot snapshot;
+
+    // Observations dated after asOfDate cannot have been published yet
+    auto end = std::upper_bound(index_.begin(), index_.end(), asOfDate,
+        [](int32_t d, const ObservationRange& range) { return d < range.date; });
+
+    snapshot.dates.reserve(end - index_.begin());
+    snapshot.values.reserve(end - index_.begin());
+
+    for (auto it = index_.begin(); it != end; ++it) {
+        const VintageRecord* record = currentRecord(*it, asOfDate);
+        if (record) {
+            snapshot.dates.push_back(it->date);
+            snapshot.values.push_back(record->value);
+        }
+    }
+    return snapshot;
+}
+
+std::vector<double> VintageSeries::recentAsOf(int32_t asOfDate, int numValues) const {
+    std::vector<double> values;
+    if (numValues < 1) {
+        return values;
+    }
+
+    // Walk back from the newest possible observation; stops after numValues hits
+    auto end = std::upper_bound(index_.begin(), index_.end(), asOfDate,
+        [](int32_t d, const ObservationRange& range) { return d < range.date; });
+
+    for (auto it = end; it != index_.begin() && values.size() < static_cast<size_t>(numValues); ) {
+        --it;
+        const VintageRecord* record = currentRecord(*it, asOfDate);
+        if (record) {
+            values.push_back(record->value);
+        }
+    }
+    return values;
+}
+
+// ===== VintageStore Implementation =====
+
+VintageStore::VintageStore(const std::string& rootDir) : root_(rootDir) {
+    namespace fs = std::filesystem;
+
+    if (!fs::is_directory(root_)) {
+        throw std::runtime_error("Vintage store root '" + root_ + "' is not a directory");
+    }
+
+    for (const auto& entry : fs::directory_iterator(root_)) {
+        if (!entry.is_regular_file() || entry.path().extension() != VINTAGE_EXTENSION) {
+            continue;
+        }
+
+        std::string path = entry.path().string();
+        Series series;
+        series.file = std::make_unique<MappedFile>(path);
+        const MappedFile& file = *series.file;
+
+        if (file.size() < HEADER_SIZE || std::memcmp(file.data(), VINTAGE_MAGIC, sizeof(VINTAGE_MAGIC)) != 0) {
+            throw std::runtime_error("'" + path + "' is not a vintage file");
+        }
+        ByteReader header(file.data() + sizeof(VINTAGE_MAGIC), HEADER_SIZE - sizeof(VINTAGE_MAGIC));
+        uint32_t version = header.get<uint32_t>();
+        header.get<uint32_t>();  // reserved
+        uint64_t count = header.get<uint64_t>();
+
+        if (version != FORMAT_VERSION) {
+            throw std::runtime_error("Unsupported vintage file version " + std::to_string(version) + " in '" + path + "'");
+        }
+        if (file.size() < HEADER_SIZE + sizeof(VintageRecord) * count) {
+            throw std::runtime_error("Vintage file '" + path + "' is truncated");
+        }
+
+        const VintageRecord* records = reinterpret_cast<const VintageRecord*>(file.data() + HEADER_SIZE);
+        if (const char* error = findLayoutError(records, count)) {
+            throw std::runtime_error("Vintage file '" + path + "' is corrupt: " + error);
+        }
+
+        series.view = std::make_unique<VintageSeries>(records, count);
+        series_[entry.path().stem().string()] = std::move(series);
+    }
+}
+
+std::vector<std::string> VintageStore::seriesNames() const {
+    std::vector<std::string> names;
+    names.reserve(series_.size());
+    for (const auto& [name, _] : series_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+bool VintageStore::hasSeries(const std::string& name) const {
+    return series_.count(name) > 0;
+}
+
+const VintageSeries& VintageStore::series(const std::string& name) const {
+    auto it = series_.find(name);
+    if (it == series_.end()) {
+        throw std::out_of_range("Series '" + name + "' not found in vintage store " + root_);
+    }
+    return *it->second.view;
+}
+
+std::map<std::string, VintageSnapshot> VintageStore::asOf(int32_t asOfDate) const {
+    std::map<std::string, VintageSnapshot> panel;
+    for (const auto& [name, series] : series_) {
+        panel[name] = series.view->snapshotAsOf(asOfDate);
+    }
+    return panel;
+}
+
+void VintageStore::writeSeries(
+    const std::string& rootDir,
+    const std::string& name,
+    std::vector<VintageRecord> records)
+{
+    if (name.empty() || name.find('/') != std::string::npos || name == "." || name == "..") {
+        throw std::invalid_argument("Invalid series name '" + name + "'");
+    }
+
+    std::sort(records.begin(), records.end(), recordLess);
+    if (const char* error = findLayoutError(records.data(), records.size())) {
+        throw std::invalid_argument("Invalid vintages for '" + name + "': " + error);
+    }
+
+    // Stage field by field so struct padding is written as zeros
+    ByteWriter writer;
+    writer.putBytes(VINTAGE_MAGIC, sizeof(VINTAGE_MAGIC));
+    writer.put<uint32_t>(FORMAT_VERSION);
+    writer.put<uint32_t>(0);
+    writer.put<uint64_t>(records.size());
+    for (const auto& record : records) {
+        writer.put<int32_t>(record.date);
+        writer.put<int32_t>(record.realtimeStart);
+        writer.put<int32_t>(record.realtimeEnd);
+        writer.put<int32_t>(0);
+        writer.put<double>(record.value);
+    }
+
+    std::filesystem::create_directories(rootDir);
+    std::string path = (std::filesystem::path(rootDir) / (name + VINTAGE_EXTENSION)).string();
+    std::string tempPath = path + ".tmp";
+
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create '" + tempPath + "': " + std::strerror(errno));
+    }
+
+    const std::string& bytes = writer.bytes();
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            int savedErrno = errno;
+            ::close(fd);
+            std::remove(tempPath.c_str());
+            throw std::runtime_error("Failed to write '" + tempPath + "': " + std::strerror(savedErrno));
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Failed to replace '" + path + "': " + std::strerror(errno));
+    }
+}
+
+std::vector<VintageRecord> VintageStore::parseALFRED(const std::string& jsonResponse) {
+    std::vector<VintageRecord> records;
+
+    try {
+        json jsonData = json::parse(jsonResponse);
+
+        for (const auto& obs : jsonData.at("observations")) {
+            // Filter out missing values (marked as '.')
+            std::string valueStr = obs.at("value").get<std::string>();
+            if (valueStr == ".") {
+                continue;
+            }
+
+            VintageRecord record;
+            record.date = dateToInt(obs.at("date").get<std::string>());
+            record.realtimeStart = dateToInt(obs.at("realtime_start").get<std::string>());
+            record.realtimeEnd = dateToInt(obs.at("realtime_end").get<std::string>());
+            record.value = std::stod(valueStr);
+            records.push_back(record);
+        }
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to parse ALFRED response: " + std::string(e.what()));
+    }
+
+    return records;
+}
+
+std::string VintageStore::seriesNameForFRED(const std::string& seriesKey) {
+    // Keys that differ from the processor / backtest series names
+    static const std::map<std::string, std::string> renames = {
+        {"fed_funds_rate", "fed_funds"}
+    };
+    auto it = renames.find(seriesKey);
+    return it == renames.end() ? seriesKey : it->second;
+}
@@ -0,0 +1,169 @@
+//
+//  VintageStore.hpp
+//  InvertedYieldCurveTrader
+//
+//  Point-in-time (vintage) store of revised macro series.
+//  Each record is (observation date, realtime start, realtime end, value),
+//  the ALFRED layout, so backtests see data only as it was known on the day.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef VINTAGE_STORE_HPP
+#define VINTAGE_STORE_HPP
+
+#include "MappedFile.hpp"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * VintageRecord: One value of one observation over the period it was current
+ *
+ * Dates are YYYYMMDD (see dateToInt). The realtime period is inclusive on
+ * both ends, as in ALFRED; the current vintage ends on REALTIME_OPEN_END.
+ */
+struct VintageRecord {
+    int32_t date;               // Observation period (e.g. 20240101 for January CPI)
+    int32_t realtimeStart;      // First day this value was published
+    int32_t realtimeEnd;        // Last day this value was current
+    double value;
+};
+
+// Records are mapped straight from disk, so the layout is part of the format
+static_assert(sizeof(VintageRecord) == 24, "VintageRecord layout changed");
+
+constexpr int32_t REALTIME_OPEN_END = 99991231;  // ALFRED "9999-12-31"
+
+/**
+ * VintageSnapshot: A series as it was known on one day (dates ascending)
+ */
+struct VintageSnapshot {
+    std::vector<int32_t> dates;
+    std::vector<double> values;
+};
+
+/**
+ * VintageSeries: Indexed view over one series' vintage records
+ *
+ * Records are sorted by (date, realtimeStart) with one range per observation
+ * date in a small index, so a point lookup is two binary searches:
+ * O(log D + log V) for D observations with V vintages each.
+ */
+class VintageSeries {
+public:
+    VintageSeries(const VintageRecord* records, size_t count);
+
+    size_t recordCount() const { return count_; }
+    size_t observationCount() const { return index_.size(); }
+
+    /**
+     * Value of observation date as known on asOfDate
+     *
+     * @return NaN if the observation was not yet published (or was withdrawn)
+     */
+    double valueAsOf(int32_t date, int32_t asOfDate) const;
+
+    /**
+     * Every observation published by asOfDate, at its then-current value
+     */
+    VintageSnapshot snapshotAsOf(int32_t asOfDate) const;
+
+    /**
+     * Most recent numValues observations known on asOfDate, most recent first
+     * (the order the data processors return)
+     */
+    std::vector<double> recentAsOf(int32_t asOfDate, int numValues) const;
+
+private:
+    struct ObservationRange {
+        int32_t date;
+        uint32_t begin;     // First record of this observation
+        uint32_t end;       // One past the last record
+    };
+
+    const VintageRecord* records_;
+    size_t count_;
+    std::vector<ObservationRange> index_;
+
+    /**
+     * Record current on asOfDate within one observation's range, or nullptr
+     */
+    const VintageRecord* currentRecord(const ObservationRange& range, int32_t asOfDate) const;
+};
+
+/**
+ * VintageStore: Read-only panel of vintage files under a root directory
+ *
+ * Opening maps every "<name>.vin" file and builds the per-observation index;
+ * record data stays in the page cache. Immutable after construction and safe
+ * to share across threads replaying different historical days.
+ *
+ * Usage:
+ *   VintageStore store("/data/vintages");
+ *   auto panel = store.asOf(20200315);           // What we knew on 2020-03-15
+ *   double cpi = panel["inflation"].values.back();
+ */
+class VintageStore {
+public:
+    /**
+     * @throws std::runtime_error if rootDir is missing or a file is corrupt
+     */
+    explicit VintageStore(const std::string& rootDir);
+
+    std::vector<std::string> seriesNames() const;
+    bool hasSeries(const std::string& name) const;
+
+    /**
+     * @throws std::out_of_range if the series is not in the store
+     */
+    const VintageSeries& series(const std::string& name) const;
+
+    /**
+     * Rebuild the whole panel as it was known on asOfDate
+     */
+    std::map<std::string, VintageSnapshot> asOf(int32_t asOfDate) const;
+
+    /**
+     * Write (replace) a series' vintages; records may be in any order
+     *
+     * @throws std::invalid_argument if a record's realtime period is inverted
+     *         or two vintages of the same observation overlap
+     */
+    static void writeSeries(
+        const std::string& rootDir,
+        const std::string& name,
+        std::vector<VintageRecord> records
+    );
+
+    /**
+     * Parse an ALFRED observations response (realtime_start/realtime_end set)
+     *
+     * Missing values (".") are dropped, leaving the observation unknown for
+     * that period.
+     *
+     * @param jsonResponse: Body returned by FREDDataClient::fetchVintages
+     * @throws std::runtime_error on malformed JSON
+     */
+    static std::vector<VintageRecord> parseALFRED(const std::string& jsonResponse);
+
+    /**
+     * Store name for a FREDDataClient::SERIES_IDS key: the name the data
+     * processors and BacktestConfig use (e.g. "fed_funds_rate" → "fed_funds")
+     */
+    static std::string seriesNameForFRED(const std::string& seriesKey);
+
+private:
+    struct Series {
+        std::unique_ptr<MappedFile> file;
+        std::unique_ptr<VintageSeries> view;
+    };
+
+    std::string root_;
+    std::map<std::string, Series> series_;
+};
+
+#endif // VINTAGE_STORE_HPP
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <stdexcept>
 
 std::string getDateDaysAgo(int daysAgo = 0) {
     // Get the current system time
@@ -33,3 +34,45 @@ std::string getDateDaysAgo(int daysAgo = 0) {
 
     return std::to_string(year) + "-" + monthString + "-" + dayString;
 }
+
+int dateToInt(const std::string& isoDate) {
+    // Expect "YYYY-MM-DD"
+    if (isoDate.size() != 10 || isoDate[4] != '-' || isoDate[7] != '-') {
+        throw std::invalid_argument("Invalid date '" + isoDate + "', expected YYYY-MM-DD");
+    }
+
+    int year = std::stoi(isoDate.substr(0, 4));
+    int month = std::stoi(isoDate.substr(5, 2));
+    int day = std::stoi(isoDate.substr(8, 2));
+
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        throw std::invalid_argument("Invalid date '" + isoDate + "', month/day out of range");
+    }
+
+    return year * 10000 + month * 100 + day;
+}
+
+std::string intToDate(int dateKey) {
+    int year = dateKey / 10000;
+    int month = (dateKey / 100) % 100;
+    int day = dateKey % 100;
+
+    std::string monthString = month < 10 ? "0" + std::to_string(month) : std::to_string(month);
+    std::string dayString = day < 10 ? "0" + std::to_string(day) : std::to_string(day);
+
+    return std::to_string(year) + "-" + monthString + "-" + dayString;
+}
+
+int addDays(int dateKey, int days) {
+    using namespace std::chrono;
+    const year_month_day date{year(dateKey / 10000),
+                              month(static_cast<unsigned>((dateKey / 100) % 100)),
+                              day(static_cast<unsigned>(dateKey % 100))};
+    if (!date.ok()) {
+        throw std::invalid_argument("Invalid date key " + std::to_string(dateKey));
+    }
+    const year_month_day shifted{sys_days(date) + std::chrono::days(days)};
+    return static_cast<int>(shifted.year()) * 10000 +
+           static_cast<int>(static_cast<unsigned>(shifted.month())) * 100 +
+           static_cast<int>(static_cast<unsigned>(shifted.day()));
+}
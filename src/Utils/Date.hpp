@@ -13,4 +13,12 @@
 
 std::string getDateDaysAgo(int backwardsOffset);
 
+// Compact integer date keys (YYYYMMDD) used by the on-disk stores.
+// Integer keys sort chronologically, so they can be binary-searched directly.
+int dateToInt(const std::string& isoDate);
+std::string intToDate(int dateKey);
+
+// Date key shifted by a number of calendar days (negative to go back)
+int addDays(int dateKey, int days);
+
 #endif /* Date_hpp */
@@ -6,11 +6,83 @@
 //
 
 #include "Logger.hpp"
-#include <iomanip>
-#include <sstream>
+#include "MpscRingBuffer.hpp"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr size_t MAX_BATCH_RECORDS = 1024;
+
+/**
+ * State of the asynchronous backend. Producers never touch the mutex; it
+ * only serialises startAsync()/stopAsync(). inFlight counts producers
+ * between checking `running` and finishing their push, so stopAsync() can
+ * wait them out before the drainer's final pass.
+ */
+struct AsyncBackend {
+    std::mutex lifecycleMutex;
+    std::unique_ptr<MpscRingBuffer<std::string>> queue;
+    std::thread drainer;
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<int> inFlight{0};
+
+    std::atomic<bool> drainerSleeping{false};
+    std::atomic<uint32_t> wakeups{0};
+
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+
+    // Static destruction at exit() still drains what was queued
+    ~AsyncBackend();
+};
+
+AsyncBackend& asyncBackend() {
+    static AsyncBackend instance;
+    return instance;
+}
+
+void wakeDrainer(AsyncBackend& backend) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (backend.drainerSleeping.load(std::memory_order_relaxed) &&
+        backend.drainerSleeping.exchange(false, std::memory_order_acq_rel)) {
+        backend.wakeups.fetch_add(1, std::memory_order_release);
+        backend.wakeups.notify_one();
+    }
+}
+
+void stopBackend(AsyncBackend& backend) {
+    std::lock_guard<std::mutex> lock(backend.lifecycleMutex);
+    if (!backend.running.load()) {
+        return;
+    }
+
+    // New records go to the synchronous path; wait for pushes already under way
+    backend.running.store(false, std::memory_order_seq_cst);
+    while (backend.inFlight.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+
+    backend.stopping.store(true, std::memory_order_release);
+    backend.wakeups.fetch_add(1, std::memory_order_release);
+    backend.wakeups.notify_one();
+    backend.drainer.join();
+}
+
+AsyncBackend::~AsyncBackend() {
+    stopBackend(*this);
+}
+
+}  // namespace
 
 // Static member initialization
-Logger::Level Logger::currentLevel_ = Logger::INFO;
+std::atomic<Logger::Level> Logger::currentLevel_{Logger::INFO};
 
 void Logger::info(const std::string& message, const json& context) {
     log(INFO, message, context);
@@ -41,21 +113,118 @@ void Logger::debug(const std::string& message, const json& context) {
 }
 
 void Logger::setLevel(Level level) {
-    currentLevel_ = level;
+    currentLevel_.store(level, std::memory_order_relaxed);
 }
 
 std::string Logger::getCurrentTimestamp() {
+    std::string timestamp;
+    appendTimestamp(timestamp);
+    return timestamp;
+}
+
+// ===== Record serialization =====
+
+namespace {
+
+// Reused by every record the thread writes; async pushes swap it with a drained slot
+thread_local std::string recordBuffer;
+
+}  // namespace
+
+void Logger::appendTimestamp(std::string& out) {
     auto now = std::chrono::system_clock::now();
     auto time = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
 
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time), "%Y-%m-%dT%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    ss << 'Z';
+    // gmtime() shares a static buffer; callers may log from several threads
+    std::tm utc{};
+    gmtime_r(&time, &utc);
+
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                               utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday,
+                               utc.tm_hour, utc.tm_min, utc.tm_sec, static_cast<int>(ms.count()));
+    out.append(text, static_cast<size_t>(length));
+}
+
+void Logger::appendString(std::string& out, std::string_view value) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0xF];
+                    out += HEX[c & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void Logger::appendKey(std::string& out, std::string_view key) {
+    out += ',';
+    // The header already wrote these; a second copy would make the record ambiguous
+    if (key == "level" || key == "timestamp" || key == "message") {
+        out += "\"context_";
+        out.append(key);
+        out += "\":";
+        return;
+    }
+    appendString(out, key);
+    out += ':';
+}
+
+void Logger::appendValue(std::string& out, double value) {
+    // Same convention as json::dump(): non-finite numbers are null
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
 
-    return ss.str();
+void Logger::appendValue(std::string& out, const json& value) {
+    out += value.dump();
+}
+
+void Logger::appendHeader(std::string& out, Level level, std::string_view message) {
+    out += "{\"level\":\"";
+    out += levelName(level);
+    out += "\",\"timestamp\":\"";
+    appendTimestamp(out);
+    out += "\",\"message\":";
+    appendString(out, message);
+}
+
+std::string& Logger::beginRecord(Level level, std::string_view message) {
+    recordBuffer.clear();
+    appendHeader(recordBuffer, level, message);
+    return recordBuffer;
+}
+
+std::string Logger::formatRecord(Level level, const std::string& message, const json& context) {
+    std::string record;
+    appendHeader(record, level, message);
+    for (auto& [key, value] : context.items()) {
+        appendKey(record, key);
+        appendValue(record, value);
+    }
+    record += '}';
+    return record;
 }
 
 void Logger::log(Level level, const std::string& message, const json& context) {
@@ -63,22 +232,134 @@ void Logger::log(Level level, const std::string& message, const json& context) {
         return;
     }
 
-    // Build JSON log entry
-    json logEntry;
-    logEntry["level"] = levelName(level);
-    logEntry["timestamp"] = getCurrentTimestamp();
-    logEntry["message"] = message;
-
-    // Merge context
+    std::string& record = beginRecord(level, message);
     for (auto& [key, value] : context.items()) {
-        logEntry[key] = value;
+        appendKey(record, key);
+        appendValue(record, value);
+    }
+    endRecord(level, record);
+}
+
+void Logger::endRecord(Level level, std::string& record) {
+    record += '}';
+
+    AsyncBackend& backend = asyncBackend();
+    backend.inFlight.fetch_add(1, std::memory_order_seq_cst);
+    if (backend.running.load(std::memory_order_seq_cst)) {
+        if (backend.queue->tryPush(std::move(record))) {
+            backend.accepted.fetch_add(1, std::memory_order_release);
+        } else {
+            backend.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        backend.inFlight.fetch_sub(1, std::memory_order_release);
+        wakeDrainer(backend);
+
+        if (level == CRITICAL) {
+            flush();
+        }
+        return;
     }
+    backend.inFlight.fetch_sub(1, std::memory_order_release);
 
     // Output to stdout (CloudWatch will capture this)
-    std::cout << logEntry.dump() << std::endl;
+    record += '\n';
+    std::cout.write(record.data(), static_cast<std::streamsize>(record.size()));
     std::cout.flush();
 }
 
+// ===== Asynchronous backend =====
+
+void Logger::startAsync(size_t capacity) {
+    AsyncBackend& backend = asyncBackend();
+    std::lock_guard<std::mutex> lock(backend.lifecycleMutex);
+    if (backend.running.load()) {
+        return;
+    }
+
+    backend.queue = std::make_unique<MpscRingBuffer<std::string>>(capacity);
+    backend.stopping.store(false);
+    backend.accepted.store(0);
+    backend.written.store(0);
+    backend.dropped.store(0);
+
+    backend.drainer = std::thread([&backend]() {
+        std::string batch;
+        std::string record;
+        uint64_t reportedDrops = 0;
+
+        for (;;) {
+            size_t count = 0;
+            while (count < MAX_BATCH_RECORDS && backend.queue->tryPop(record)) {
+                batch += record;
+                batch += '\n';
+                count++;
+            }
+
+            uint64_t drops = backend.dropped.load(std::memory_order_relaxed);
+            if (drops != reportedDrops) {
+                batch += formatRecord(WARN, "Log records dropped", {
+                    {"dropped", drops - reportedDrops},
+                    {"dropped_total", drops},
+                    {"capacity", backend.queue->capacity()}
+                });
+                batch += '\n';
+                reportedDrops = drops;
+            }
+
+            if (!batch.empty()) {
+                std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                std::cout.flush();
+                batch.clear();
+                backend.written.fetch_add(count, std::memory_order_release);
+                continue;
+            }
+
+            // Nothing popped: producers have been waited out, so the ring is drained
+            if (backend.stopping.load(std::memory_order_acquire)) {
+                break;
+            }
+
+            uint32_t seen = backend.wakeups.load(std::memory_order_acquire);
+            backend.drainerSleeping.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (backend.queue->empty() && !backend.stopping.load(std::memory_order_acquire) &&
+                backend.dropped.load(std::memory_order_relaxed) == reportedDrops) {
+                backend.wakeups.wait(seen, std::memory_order_acquire);
+            }
+            backend.drainerSleeping.store(false, std::memory_order_relaxed);
+        }
+    });
+
+    backend.running.store(true, std::memory_order_seq_cst);
+}
+
+void Logger::stopAsync() {
+    stopBackend(asyncBackend());
+}
+
+void Logger::flush() {
+    AsyncBackend& backend = asyncBackend();
+    if (!backend.running.load(std::memory_order_acquire)) {
+        std::cout.flush();
+        return;
+    }
+
+    uint64_t target = backend.accepted.load(std::memory_order_acquire);
+    while (backend.written.load(std::memory_order_acquire) < target) {
+        backend.wakeups.fetch_add(1, std::memory_order_release);
+        backend.wakeups.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+bool Logger::isAsync() {
+    return asyncBackend().running.load(std::memory_order_relaxed);
+}
+
+uint64_t Logger::droppedCount() {
+    return asyncBackend().dropped.load(std::memory_order_relaxed);
+}
+
 std::string Logger::levelName(Level level) {
     switch (level) {
         case DEBUG: return "DEBUG";
@@ -91,5 +372,5 @@ std::string Logger::levelName(Level level) {
 }
 
 bool Logger::shouldLog(Level level) {
-    return level >= currentLevel_;
+    return isEnabled(level);
 }
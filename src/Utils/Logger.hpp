@@ -2,7 +2,8 @@
 //  Logger.hpp
 //  InvertedYieldCurveTrader
 //
-//  Structured JSON logging for CloudWatch
+//  Structured JSON logging for CloudWatch, written synchronously or
+//  through an asynchronous ring-buffer backend
 //
 //  Created by Ryan Hamby on 12/25/25.
 //
@@ -11,13 +12,23 @@
 #define LOGGER_HPP
 
 #include <string>
+#include <string_view>
 #include <nlohmann/json.hpp>
 #include <iostream>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <concepts>
 #include <ctime>
+#include <cstdint>
 
 using json = nlohmann::json;
 
+// Levels below this are removed at compile time: 0 DEBUG, 1 INFO, 2 WARN, 3 ERROR, 4 CRITICAL
+#ifndef IYC_LOG_MIN_LEVEL
+#define IYC_LOG_MIN_LEVEL 0
+#endif
+
 /**
  * Structured logging for CloudWatch integration
  *
@@ -35,6 +46,26 @@ using json = nlohmann::json;
  *     "date": "2025-12-25",
  *     "indicators_fetched": 8
  *   }
+ *
+ * By default every record is written and flushed to stdout before the call
+ * returns. After startAsync() (or inside an AsyncLogSession), callers only
+ * format the record and push it onto a lock-free ring buffer; a background
+ * thread writes whatever has accumulated as one batch and flushes once per
+ * batch. If the ring is full the record is dropped rather than blocking the
+ * caller, and the drainer emits a "Log records dropped" warning with the
+ * count. CRITICAL records and stopAsync() wait until everything queued so
+ * far has been written.
+ *
+ * Hot paths use the LOG_* macros instead, which take key/value pairs:
+ *   LOG_DEBUG("Window decomposed", "t", t, "top_eigenvalue", lambda);
+ * Nothing after the message is evaluated unless the level is enabled, and
+ * levels below IYC_LOG_MIN_LEVEL (CMake: -DIYC_LOG_MIN_LEVEL=1 for INFO)
+ * are compiled out. Fields are written straight into a per-thread buffer
+ * that is reused from record to record, without building a json object.
+ *
+ * Context keys named level, timestamp or message are written as
+ * context_level, context_timestamp and context_message, so every record
+ * has each key exactly once.
  */
 class Logger {
 public:
@@ -78,24 +109,115 @@ public:
      */
     static void debug(const std::string& message, const json& context = json::object());
 
+    static constexpr size_t DEFAULT_ASYNC_CAPACITY = 1 << 14;   // Records
+
+    /**
+     * Switch to the asynchronous backend (no-op if already running)
+     * @param capacity: Ring buffer size in records (rounded up to a power of two)
+     */
+    static void startAsync(size_t capacity = DEFAULT_ASYNC_CAPACITY);
+
+    /**
+     * Write everything queued, stop the drain thread and return to synchronous output
+     */
+    static void stopAsync();
+
+    /**
+     * Block until every record logged before this call has been written
+     */
+    static void flush();
+
+    static bool isAsync();
+
+    /**
+     * Records dropped because the ring was full since the last startAsync()
+     */
+    static uint64_t droppedCount();
+
     /**
      * Set logging level
      */
     static void setLevel(Level level);
 
+    /**
+     * Would a record at this level be written? (compile-time floor and runtime level)
+     */
+    static bool isEnabled(Level level) {
+        return level >= IYC_LOG_MIN_LEVEL && level >= currentLevel_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Serialize and emit one record from alternating keys and values
+     * (strings, numbers, bools, json). Prefer the LOG_* macros, which
+     * check the level before evaluating any field.
+     */
+    template <typename... Fields>
+    static void write(Level level, std::string_view message, const Fields&... fields) {
+        static_assert(sizeof...(Fields) % 2 == 0, "Log fields must be key/value pairs");
+        std::string& record = beginRecord(level, message);
+        appendFields(record, fields...);
+        endRecord(level, record);
+    }
+
     /**
      * Get current timestamp in ISO 8601 format
      */
     static std::string getCurrentTimestamp();
 
 private:
-    static Level currentLevel_;
+    static std::atomic<Level> currentLevel_;
 
     /**
      * Internal logging function
      */
     static void log(Level level, const std::string& message, const json& context);
 
+    /**
+     * Serialize one record as a single JSON line (without the newline)
+     */
+    static std::string formatRecord(Level level, const std::string& message, const json& context);
+
+    /**
+     * Clear the calling thread's record buffer and write level, timestamp and message
+     */
+    static std::string& beginRecord(Level level, std::string_view message);
+
+    /**
+     * Close the record and hand it to the synchronous or asynchronous writer
+     */
+    static void endRecord(Level level, std::string& record);
+
+    static void appendHeader(std::string& out, Level level, std::string_view message);
+    static void appendTimestamp(std::string& out);
+    static void appendKey(std::string& out, std::string_view key);
+    static void appendString(std::string& out, std::string_view value);
+
+    static void appendValue(std::string& out, std::string_view value) { appendString(out, value); }
+    static void appendValue(std::string& out, const char* value) { appendString(out, value); }
+    static void appendValue(std::string& out, const std::string& value) { appendString(out, value); }
+    static void appendValue(std::string& out, bool value) { out += value ? "true" : "false"; }
+    static void appendValue(std::string& out, std::nullptr_t) { out += "null"; }
+    static void appendValue(std::string& out, double value);
+    static void appendValue(std::string& out, const json& value);
+
+    template <std::integral T>
+        requires (!std::same_as<T, bool>)
+    static void appendValue(std::string& out, T value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    static void appendFields(std::string&) {}
+
+    template <typename Value, typename... Rest>
+    static void appendFields(std::string& out, std::string_view key, const Value& value,
+                             const Rest&... rest) {
+        appendKey(out, key);
+        appendValue(out, value);
+        appendFields(out, rest...);
+    }
+
     /**
      * Level name for output
      */
@@ -107,4 +229,48 @@ private:
     static bool shouldLog(Level level);
 };
 
+#define IYC_LOG_AT(level, message, ...)                                                       \
+    do {                                                                                      \
+        if constexpr (Logger::level >= IYC_LOG_MIN_LEVEL) {                                   \
+            if (Logger::isEnabled(Logger::level)) {                                           \
+                Logger::write(Logger::level, message __VA_OPT__(,) __VA_ARGS__);              \
+            }                                                                                 \
+        }                                                                                     \
+    } while (0)
+
+#define LOG_DEBUG(message, ...) IYC_LOG_AT(DEBUG, message __VA_OPT__(,) __VA_ARGS__)
+#define LOG_INFO(message, ...) IYC_LOG_AT(INFO, message __VA_OPT__(,) __VA_ARGS__)
+#define LOG_WARN(message, ...) IYC_LOG_AT(WARN, message __VA_OPT__(,) __VA_ARGS__)
+#define LOG_ERROR(message, ...) IYC_LOG_AT(ERROR, message __VA_OPT__(,) __VA_ARGS__)
+#define LOG_CRITICAL(message, ...) IYC_LOG_AT(CRITICAL, message __VA_OPT__(,) __VA_ARGS__)
+
+/**
+ * AsyncLogSession: Runs the asynchronous backend for the lifetime of a scope
+ *
+ * Records written this way can land between the pieces of a multi-part
+ * `std::cout << ...` statement on another thread, so only enable it for
+ * runs whose stdout is (mostly) log records.
+ */
+class AsyncLogSession {
+public:
+    explicit AsyncLogSession(bool enabled = true, size_t capacity = Logger::DEFAULT_ASYNC_CAPACITY)
+        : enabled_(enabled)
+    {
+        if (enabled_) {
+            Logger::startAsync(capacity);
+        }
+    }
+    ~AsyncLogSession() {
+        if (enabled_) {
+            Logger::stopAsync();
+        }
+    }
+
+    AsyncLogSession(const AsyncLogSession&) = delete;
+    AsyncLogSession& operator=(const AsyncLogSession&) = delete;
+
+private:
+    bool enabled_;
+};
+
 #endif // LOGGER_HPP
@@ -0,0 +1,198 @@
+//
+//  Metrics.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the run instrumentation registry
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "Metrics.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// ===== LatencyHistogram =====
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<int>(value);
+    }
+    // Top SUB_BUCKET_BITS + 1 significant bits pick the bucket
+    int exponent = 63 - std::countl_zero(value);
+    int shift = exponent - SUB_BUCKET_BITS;
+    int subBucket = static_cast<int>(value >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t subBucket = static_cast<uint64_t>((index - SUB_BUCKETS) % SUB_BUCKETS);
+    uint64_t lower = (SUB_BUCKETS + subBucket) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t seen = min_.load(std::memory_order_relaxed);
+    while (value < seen && !min_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    seen = max_.load(std::memory_order_relaxed);
+    while (value > seen && !max_.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+}
+
+uint64_t LatencyHistogram::min() const {
+    return count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum()) / n;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    uint64_t n = count();
+    if (n == 0) {
+        return 0;
+    }
+
+    q = std::clamp(q, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * n)));
+
+    uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max());
+        }
+    }
+    return max();
+}
+
+json LatencyHistogram::summary() const {
+    auto micros = [](double nanos) { return nanos / 1000.0; };
+    return {
+        {"count", count()},
+        {"mean_us", micros(mean())},
+        {"p50_us", micros(static_cast<double>(percentile(0.50)))},
+        {"p90_us", micros(static_cast<double>(percentile(0.90)))},
+        {"p99_us", micros(static_cast<double>(percentile(0.99)))},
+        {"max_us", micros(static_cast<double>(max()))},
+        {"total_ms", static_cast<double>(sum()) / 1e6}
+    };
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+// ===== Metrics =====
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+};
+
+// Leaked on purpose: call sites cache references in function-local statics
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+}  // namespace
+
+LatencyHistogram& Metrics::histogram(const std::string& name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto& slot = r.histograms[name];
+    if (!slot) {
+        slot = std::make_unique<LatencyHistogram>();
+    }
+    return *slot;
+}
+
+Counter& Metrics::counter(const std::string& name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto& slot = r.counters[name];
+    if (!slot) {
+        slot = std::make_unique<Counter>();
+    }
+    return *slot;
+}
+
+json Metrics::summary() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    json timers = json::object();
+    for (const auto& [name, histogram] : r.histograms) {
+        if (histogram->count() > 0) {
+            timers[name] = histogram->summary();
+        }
+    }
+
+    json counters = json::object();
+    for (const auto& [name, counter] : r.counters) {
+        if (counter->value() > 0) {
+            counters[name] = counter->value();
+        }
+    }
+
+    return {{"timers", timers}, {"counters", counters}};
+}
+
+void Metrics::logSummary(const json& context) {
+    json record = context;
+    json metrics = summary();
+    record["timers"] = metrics["timers"];
+    record["counters"] = metrics["counters"];
+    Logger::info("Run metrics", record);
+}
+
+void Metrics::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& [name, histogram] : r.histograms) {
+        histogram->reset();
+    }
+    for (auto& [name, counter] : r.counters) {
+        counter->reset();
+    }
+}
+
+// ===== MetricsReport =====
+
+MetricsReport::MetricsReport(json context)
+    : context_(std::move(context)), start_(std::chrono::steady_clock::now()) {}
+
+MetricsReport::~MetricsReport() {
+    json context = context_;
+    context["elapsed_ms"] = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start_).count();
+    Metrics::logSummary(context);
+}
@@ -0,0 +1,245 @@
+//
+//  Metrics.hpp
+//  InvertedYieldCurveTrader
+//
+//  Lightweight run instrumentation: RAII scoped timers, counters and
+//  HDR-style latency histograms, reported once per run through Logger.
+//  Timers double as Tracer spans when TRACE_OUTPUT is set.
+//  Define IYC_DISABLE_METRICS (CMake: -DIYC_METRICS=OFF) to compile every
+//  METRICS_* macro down to nothing.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+#include "Tracer.hpp"
+
+using json = nlohmann::json;
+
+/**
+ * LatencyHistogram: Log-linear buckets in the style of HdrHistogram
+ *
+ * Values below 16 ns get exact buckets; above that every power of two is
+ * split into 16 linear sub-buckets, so any recorded value is known to
+ * within 1/16 (6.25%) across the full 64-bit range in under 8 KB.
+ * record() is a handful of relaxed atomic adds, safe from any thread.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int NUM_BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    /**
+     * Record one value (nanoseconds for timers)
+     */
+    void record(uint64_t value);
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t min() const;
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    double mean() const;
+
+    /**
+     * Value at quantile q ∈ [0, 1]: the highest value equivalent to the
+     * bucket holding the q-th recording, clamped to the observed max
+     */
+    uint64_t percentile(double q) const;
+
+    /**
+     * count, mean, p50, p90, p99, max in microseconds
+     */
+    json summary() const;
+
+    void reset();
+
+    /**
+     * Bucket holding a value / largest value in a bucket (exposed for tests)
+     */
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * Counter: Monotonic event count
+ */
+class Counter {
+public:
+    void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+    void reset() { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * ScopedTimer: Records the lifetime of the enclosing scope into a histogram
+ *
+ * Given a name, the same interval is also emitted as a Tracer span while
+ * tracing is on (category = name up to the first '.', e.g. "stage").
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(LatencyHistogram& histogram, const char* traceName = nullptr)
+        : histogram_(histogram),
+          traceName_(Tracer::enabled() ? traceName : nullptr),
+          traceStart_(traceName_ != nullptr ? Tracer::now() : 0),
+          start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() { stop(); }
+
+    /**
+     * Record now instead of at scope exit (for sequential stages that
+     * declare variables used afterwards); later calls are no-ops
+     */
+    void stop() {
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        histogram_.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+        if (traceName_ != nullptr) {
+            std::string_view name(traceName_);
+            Tracer::record(name.substr(0, name.find('.')), name, traceStart_, Tracer::now());
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    const char* traceName_;
+    uint64_t traceStart_;
+    std::chrono::steady_clock::time_point start_;
+    bool stopped_ = false;
+};
+
+/**
+ * Metrics: Process-wide registry of named timers and counters
+ *
+ * Lookup by name takes a lock, so hot paths go through the METRICS_*
+ * macros, which resolve the name once per call site and cache the
+ * reference in a function-local static. Names must therefore be constant
+ * at each call site. Instruments are never destroyed, so cached
+ * references stay valid for the life of the process.
+ *
+ * Usage:
+ *   {
+ *       METRICS_SCOPED_TIMER("stage.decompose");
+ *       factors = MacroFactorModel::decomposeSurpriseCovariance(cov, 3);
+ *   }
+ *   METRICS_COUNT("http.requests", 1);
+ *
+ *   int main() {
+ *       METRICS_REPORT_ON_EXIT({{"mode", "covariance"}});  // One summary record per run
+ *       ...
+ *   }
+ */
+class Metrics {
+public:
+    static LatencyHistogram& histogram(const std::string& name);
+    static Counter& counter(const std::string& name);
+
+    /**
+     * {"timers": {name: {...}}, "counters": {name: n}} for everything recorded so far
+     */
+    static json summary();
+
+    /**
+     * Emit the summary as a single Logger record ("Run metrics")
+     */
+    static void logSummary(const json& context = json::object());
+
+    /**
+     * Zero every instrument (registrations are kept)
+     */
+    static void reset();
+};
+
+/**
+ * MetricsReport: Logs the run summary when it goes out of scope
+ *
+ * Declared at the top of a run so every exit path, including early error
+ * returns, produces exactly one "Run metrics" record with the elapsed time.
+ */
+class MetricsReport {
+public:
+    explicit MetricsReport(json context = json::object());
+    ~MetricsReport();
+
+    MetricsReport(const MetricsReport&) = delete;
+    MetricsReport& operator=(const MetricsReport&) = delete;
+
+private:
+    json context_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define IYC_METRICS_CONCAT_INNER(a, b) a##b
+#define IYC_METRICS_CONCAT(a, b) IYC_METRICS_CONCAT_INNER(a, b)
+
+#ifndef IYC_DISABLE_METRICS
+
+#define METRICS_SCOPED_TIMER(name)                                                            \
+    static LatencyHistogram& IYC_METRICS_CONCAT(metricsHistogram_, __LINE__) =                \
+        Metrics::histogram(name);                                                             \
+    ScopedTimer IYC_METRICS_CONCAT(metricsTimer_, __LINE__)(IYC_METRICS_CONCAT(metricsHistogram_, __LINE__), name)
+
+// Named timer for sequential stages: METRICS_TIMER_START(t, "stage.x"); ...; METRICS_TIMER_STOP(t);
+#define METRICS_TIMER_START(var, name)                                                        \
+    static LatencyHistogram& IYC_METRICS_CONCAT(var, Histogram_) = Metrics::histogram(name);  \
+    ScopedTimer var(IYC_METRICS_CONCAT(var, Histogram_), name)
+
+#define METRICS_TIMER_STOP(var) var.stop()
+
+#define METRICS_COUNT(name, n)                                                                \
+    do {                                                                                      \
+        static Counter& metricsCounter_ = Metrics::counter(name);                             \
+        metricsCounter_.add(n);                                                               \
+    } while (0)
+
+#define METRICS_RECORD(name, value)                                                           \
+    do {                                                                                      \
+        static LatencyHistogram& metricsHistogram_ = Metrics::histogram(name);                \
+        metricsHistogram_.record(value);                                                      \
+    } while (0)
+
+// Variadic so a braced json literal with commas passes through intact
+#define METRICS_REPORT_ON_EXIT(...) MetricsReport IYC_METRICS_CONCAT(metricsReport_, __LINE__)(json(__VA_ARGS__))
+
+#else
+
+#define METRICS_SCOPED_TIMER(name) ((void)0)
+#define METRICS_TIMER_START(var, name) ((void)0)
+#define METRICS_TIMER_STOP(var) ((void)0)
+#define METRICS_COUNT(name, n) ((void)0)
+#define METRICS_RECORD(name, value) ((void)0)
+#define METRICS_REPORT_ON_EXIT(...) ((void)0)
+
+#endif // IYC_DISABLE_METRICS
+
+#endif // METRICS_HPP
@@ -0,0 +1,126 @@
+//
+//  MpscRingBuffer.hpp
+//  InvertedYieldCurveTrader
+//
+//  Bounded lock-free multi-producer / single-consumer queue
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef MPSC_RING_BUFFER_HPP
+#define MPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * MpscRingBuffer: Fixed-capacity ring of slots, each tagged with a sequence
+ * number (Vyukov's bounded queue, specialised for one consumer)
+ *
+ * Producers claim a position with a CAS on the enqueue counter and publish
+ * the slot by advancing its sequence; the consumer reads slots in order and
+ * hands them back by advancing the sequence one lap ahead. Neither side
+ * takes a lock or allocates, and a full ring makes tryPush() fail instead
+ * of blocking the producer.
+ *
+ * Values are swapped in and out of slots rather than moved, so for types
+ * like std::string the producer gets back the buffer the consumer last
+ * drained from that slot and, once warmed up, nothing is reallocated.
+ *
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    explicit MpscRingBuffer(size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Ring buffer capacity must be positive");
+        }
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * Enqueue from any thread; on success `value` is left holding the
+     * slot's previous (already consumed) contents
+     * @return false (value untouched) if the ring is full
+     */
+    bool tryPush(T&& value) {
+        Cell* cell;
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1,
+                                                           std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (lag < 0) {
+                return false;  // Slot still holds last lap's value
+            } else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::swap(cell->value, value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Dequeue the oldest published value (consumer thread only); the slot
+     * keeps `out`'s previous contents for reuse by a later push
+     * @return false if nothing is ready
+     */
+    bool tryPop(T& out) {
+        Cell& cell = cells_[dequeuePosition_ & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeuePosition_ + 1) {
+            return false;
+        }
+
+        std::swap(out, cell.value);
+        cell.sequence.store(dequeuePosition_ + mask_ + 1, std::memory_order_release);
+        dequeuePosition_++;
+        return true;
+    }
+
+    /**
+     * True if the next slot is not yet published (consumer thread only)
+     */
+    bool empty() const {
+        const Cell& cell = cells_[dequeuePosition_ & mask_];
+        return cell.sequence.load(std::memory_order_acquire) != dequeuePosition_ + 1;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePosition_{0};
+    alignas(64) size_t dequeuePosition_ = 0;
+};
+
+#endif // MPSC_RING_BUFFER_HPP
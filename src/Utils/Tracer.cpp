@@ -0,0 +1,208 @@
+//
+//  Tracer.cpp
+//  InvertedYieldCurveTrader
+//
+//  Implementation of the bounded trace-event recorder
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include "Tracer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+struct Slot {
+    TraceEvent event;
+    std::atomic<bool> ready{false};
+};
+
+struct TraceBuffer {
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> dropped{0};
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    std::mutex namesMutex;
+    std::map<uint32_t, std::string> threadNames;
+};
+
+TraceBuffer& buffer() {
+    static TraceBuffer instance;
+    return instance;
+}
+
+std::atomic<uint32_t> nextThreadId{1};
+
+}  // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+void Tracer::start(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Trace buffer capacity must be positive");
+    }
+
+    TraceBuffer& b = buffer();
+    enabled_.store(false, std::memory_order_relaxed);
+
+    b.slots = std::make_unique<Slot[]>(capacity);
+    b.capacity = capacity;
+    b.next.store(0, std::memory_order_relaxed);
+    b.dropped.store(0, std::memory_order_relaxed);
+    b.epoch = std::chrono::steady_clock::now();
+
+    enabled_.store(true, std::memory_order_release);
+}
+
+void Tracer::stop() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+uint64_t Tracer::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - buffer().epoch).count());
+}
+
+uint32_t Tracer::currentThreadId() {
+    thread_local uint32_t id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void Tracer::record(std::string_view category, std::string_view name,
+                    uint64_t startNanos, uint64_t endNanos, json args) {
+    if (!enabled()) {
+        return;
+    }
+
+    TraceBuffer& b = buffer();
+    size_t index = b.next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= b.capacity) {
+        b.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Slot& slot = b.slots[index];
+    slot.event.name = name;
+    slot.event.category = category;
+    slot.event.threadId = currentThreadId();
+    slot.event.startNanos = startNanos;
+    slot.event.durationNanos = endNanos > startNanos ? endNanos - startNanos : 0;
+    slot.event.args = std::move(args);
+    slot.ready.store(true, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    TraceBuffer& b = buffer();
+    std::lock_guard<std::mutex> lock(b.namesMutex);
+    b.threadNames[currentThreadId()] = name;
+}
+
+std::vector<TraceEvent> Tracer::events() {
+    TraceBuffer& b = buffer();
+    size_t count = std::min(b.next.load(std::memory_order_acquire), b.capacity);
+
+    std::vector<TraceEvent> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (b.slots[i].ready.load(std::memory_order_acquire)) {
+            result.push_back(b.slots[i].event);
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.startNanos < b.startNanos;
+    });
+    return result;
+}
+
+size_t Tracer::droppedCount() {
+    return buffer().dropped.load(std::memory_order_relaxed);
+}
+
+json Tracer::toJson() {
+    TraceBuffer& b = buffer();
+    json traceEvents = json::array();
+
+    traceEvents.push_back({
+        {"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 0},
+        {"args", {{"name", "InvertedYieldCurveTrader"}}}
+    });
+    {
+        std::lock_guard<std::mutex> lock(b.namesMutex);
+        for (const auto& [tid, name] : b.threadNames) {
+            traceEvents.push_back({
+                {"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", tid},
+                {"args", {{"name", name}}}
+            });
+        }
+    }
+
+    // Trace-event timestamps and durations are in microseconds
+    for (const auto& event : events()) {
+        json entry = {
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", "X"},
+            {"pid", 1},
+            {"tid", event.threadId},
+            {"ts", event.startNanos / 1000.0},
+            {"dur", event.durationNanos / 1000.0}
+        };
+        if (!event.args.is_null()) {
+            entry["args"] = event.args;
+        }
+        traceEvents.push_back(std::move(entry));
+    }
+
+    return {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"},
+        {"otherData", {
+            {"capacity", b.capacity},
+            {"dropped_events", droppedCount()}
+        }}
+    };
+}
+
+void Tracer::write(const std::string& path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open trace file '" + path + "' for writing");
+    }
+    file << toJson().dump();
+    if (!file.good()) {
+        throw std::runtime_error("Failed to write trace file '" + path + "'");
+    }
+}
+
+// ===== TraceSession =====
+
+TraceSession::TraceSession(const char* outputPath, size_t capacity)
+    : outputPath_(outputPath != nullptr ? outputPath : "")
+{
+    if (!outputPath_.empty()) {
+        Tracer::start(capacity);
+        Tracer::setThreadName("main");
+    }
+}
+
+TraceSession::~TraceSession() {
+    if (outputPath_.empty()) {
+        return;
+    }
+    Tracer::stop();
+    try {
+        Tracer::write(outputPath_);
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: " << e.what() << std::endl;
+    }
+}
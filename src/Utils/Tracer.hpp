@@ -0,0 +1,180 @@
+//
+//  Tracer.hpp
+//  InvertedYieldCurveTrader
+//
+//  Opt-in execution timeline recorder. Spans (name, category, thread,
+//  start, duration) go into a fixed-size in-memory buffer and are written
+//  as Chrome trace-event JSON, loadable in chrome://tracing or Perfetto.
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * TraceEvent: One completed span ("ph": "X" in the trace-event format)
+ */
+struct TraceEvent {
+    std::string name;
+    std::string category;
+    uint32_t threadId;          // Small sequential id, stable per thread
+    uint64_t startNanos;        // Since Tracer::start()
+    uint64_t durationNanos;
+    json args;                  // null if none
+};
+
+/**
+ * Tracer: Process-wide bounded span buffer
+ *
+ * Disabled until start() is called, and then recording is one relaxed
+ * atomic load plus a fetch_add to claim a slot in a pre-allocated buffer,
+ * so worker threads never contend on a lock. Once the buffer is full,
+ * further spans are dropped and counted (the count is written into the
+ * trace metadata) instead of growing memory without bound.
+ *
+ * Usage:
+ *   Tracer::start();
+ *   {
+ *       TRACE_SCOPE("factor", "decompose");
+ *       ...
+ *   }
+ *   Tracer::write("trace.json");   // Open in ui.perfetto.dev
+ */
+class Tracer {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 18;    // ~262k spans
+
+    /**
+     * Allocate the buffer and begin recording (clears previous spans).
+     * Not thread-safe with respect to concurrent recording.
+     */
+    static void start(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Stop recording; recorded spans are kept until the next start()
+     */
+    static void stop();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * Nanoseconds since start() on the steady clock
+     */
+    static uint64_t now();
+
+    /**
+     * Append a completed span (no-op when disabled)
+     */
+    static void record(std::string_view category, std::string_view name,
+                       uint64_t startNanos, uint64_t endNanos, json args = nullptr);
+
+    /**
+     * Name the calling thread in the trace viewer (e.g. "sweep-worker-3")
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * Sequential id of the calling thread (1 = first thread seen)
+     */
+    static uint32_t currentThreadId();
+
+    /**
+     * Completed spans, ordered by start time
+     */
+    static std::vector<TraceEvent> events();
+
+    static size_t droppedCount();
+
+    /**
+     * {"traceEvents": [...], "displayTimeUnit": "ms", "otherData": {...}}
+     */
+    static json toJson();
+
+    /**
+     * Write toJson() to a file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void write(const std::string& path);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * TraceSpan: Records the lifetime of the enclosing scope as one span
+ */
+class TraceSpan {
+public:
+    TraceSpan(std::string_view category, std::string_view name, json args = nullptr)
+        : active_(Tracer::enabled())
+    {
+        if (active_) {
+            category_ = category;
+            name_ = name;
+            args_ = std::move(args);
+            start_ = Tracer::now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (active_) {
+            Tracer::record(category_, name_, start_, Tracer::now(), std::move(args_));
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    bool active_;
+    std::string category_;
+    std::string name_;
+    json args_;
+    uint64_t start_ = 0;
+};
+
+/**
+ * TraceSession: Starts tracing if a path is given and writes the trace on scope exit
+ */
+class TraceSession {
+public:
+    explicit TraceSession(const char* outputPath, size_t capacity = Tracer::DEFAULT_CAPACITY);
+    ~TraceSession();
+
+    TraceSession(const TraceSession&) = delete;
+    TraceSession& operator=(const TraceSession&) = delete;
+
+private:
+    std::string outputPath_;
+};
+
+#define IYC_TRACE_CONCAT_INNER(a, b) a##b
+#define IYC_TRACE_CONCAT(a, b) IYC_TRACE_CONCAT_INNER(a, b)
+
+#ifndef IYC_DISABLE_METRICS
+
+#define TRACE_SCOPE(category, name) TraceSpan IYC_TRACE_CONCAT(traceSpan_, __LINE__)(category, name)
+
+// Args are only built when tracing is on: TRACE_SCOPE_ARGS("factor", "window", {{"t", t}})
+#define TRACE_SCOPE_ARGS(category, name, ...)                                                 \
+    TraceSpan IYC_TRACE_CONCAT(traceSpan_, __LINE__)(category, name,                          \
+        Tracer::enabled() ? json(__VA_ARGS__) : json())
+
+#else
+
+#define TRACE_SCOPE(category, name) ((void)0)
+#define TRACE_SCOPE_ARGS(category, name, ...) ((void)0)
+
+#endif // IYC_DISABLE_METRICS
+
+#endif // TRACER_HPP
@@ -0,0 +1,339 @@
+//
+//  BacktestEngineUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the event-driven backtest engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Backtest/BacktestEngine.hpp"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+class BacktestEngineTest : public ::testing::Test {
+protected:
+    static std::string root;
+
+    // 30 years × 12 months × 21 trading days of synthetic history, written once
+    static void SetUpTestSuite() {
+        root = (std::filesystem::temp_directory_path() /
+                ("backtest_engine_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove_all(root);
+
+        std::mt19937 rng(42);
+        std::normal_distribution<double> noise(0.0, 1.0);
+
+        std::vector<int32_t> days, months;
+        for (int year = 1995; year < 2025; year++) {
+            for (int month = 1; month <= 12; month++) {
+                months.push_back(year * 10000 + month * 100 + 1);
+                for (int day = 1; day <= 21; day++) {
+                    days.push_back(year * 10000 + month * 100 + day);
+                }
+            }
+        }
+
+        std::vector<double> returns, vix, spread;
+        double vixLevel = 18.0;
+        for (size_t i = 0; i < days.size(); i++) {
+            vixLevel = std::clamp(vixLevel + 0.8 * noise(rng) + 0.02 * (18.0 - vixLevel), 9.0, 80.0);
+            vix.push_back(vixLevel);
+            spread.push_back(vixLevel > 30.0 ? 300.0 : (vixLevel < 12.0 ? 90.0 : 150.0));
+            returns.push_back(0.0003 + 0.01 * noise(rng));
+        }
+        HistoryStore::writeSeries(root, "es_returns", days, returns);
+        HistoryStore::writeSeries(root, "vix", days, vix);
+        HistoryStore::writeSeries(root, "credit_spread", days, spread);
+
+        for (const std::string name : {"consumer_sentiment", "fed_funds", "gdp", "inflation", "unemployment"}) {
+            std::vector<double> levels;
+            double level = 5.0;
+            for (size_t m = 0; m < months.size(); m++) {
+                level += 0.1 * noise(rng);
+                levels.push_back(level);
+            }
+            HistoryStore::writeSeries(root, name, months, levels, HistoryCompression::DeltaXor);
+        }
+    }
+
+    static void TearDownTestSuite() {
+        std::filesystem::remove_all(root);
+    }
+
+    static BacktestConfig createConfig() {
+        BacktestConfig config;
+        config.indicators = {"unemployment", "gdp", "inflation", "fed_funds", "consumer_sentiment"};
+        config.indicatorBetas = {{"gdp", 0.6}, {"unemployment", -0.5}, {"consumer_sentiment", 0.4},
+                                 {"inflation", -0.2}, {"fed_funds", 0.3}};
+        return config;
+    }
+};
+
+std::string BacktestEngineTest::root;
+
+// ===== Replay Tests =====
+
+TEST_F(BacktestEngineTest, ReplaysThirtyYearsQuickly) {
+    HistoryStore store(root);
+    BacktestEngine engine(store, createConfig());
+
+    auto start = std::chrono::steady_clock::now();
+    BacktestResult result = engine.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(result.steps.size(), 30 * 12 * 21);
+    EXPECT_GT(result.factorRefits, 300);
+    EXPECT_TRUE(std::isfinite(result.steps.back().equity));
+    EXPECT_TRUE(std::isfinite(result.sharpeRatio));
+    EXPECT_LT(seconds, 5.0);
+}
+
+TEST_F(BacktestEngineTest, FlatUntilModelIsReady) {
+    HistoryStore store(root);
+    BacktestResult result = BacktestEngine(store, createConfig()).run();
+
+    // GDP (120-day lag) first shows up at the May 1995 close; 6-month AR(1)
+    // lookback + 12-month window: first refit 18 month ends later (October 1996)
+    size_t firstReady = 0;
+    while (firstReady < result.steps.size() && !result.steps[firstReady].modelReady) {
+        EXPECT_DOUBLE_EQ(result.steps[firstReady].notional, 0.0);
+        EXPECT_DOUBLE_EQ(result.steps[firstReady].pnl, 0.0);
+        firstReady++;
+    }
+    ASSERT_LT(firstReady, result.steps.size());
+    EXPECT_EQ(result.steps[firstReady].date, 19961101);
+    EXPECT_GT(result.steps[firstReady].notional, 0.0);
+}
+
+TEST_F(BacktestEngineTest, PnLDrawdownAndTurnoverAccounting) {
+    HistoryStore store(root);
+    BacktestConfig config = createConfig();
+    BacktestResult result = BacktestEngine(store, config).run();
+
+    double equity = config.initialCapital;
+    double peak = equity;
+    double notional = 0.0;
+    double turnover = 0.0;
+    double maxDrawdown = 0.0;
+
+    for (const auto& step : result.steps) {
+        double expectedPnL = notional * step.dailyReturn - step.turnover * config.transactionCostBps / 10000.0;
+        EXPECT_NEAR(step.pnl, expectedPnL, 1e-6);
+        EXPECT_NEAR(step.turnover, std::abs(step.notional - notional), 1e-6);
+
+        equity += step.pnl;
+        peak = std::max(peak, equity);
+        EXPECT_NEAR(step.equity, equity, 1e-4);
+        EXPECT_NEAR(step.drawdown, peak - equity, 1e-4);
+        EXPECT_GE(step.drawdown, 0.0);
+
+        maxDrawdown = std::max(maxDrawdown, step.drawdown);
+        turnover += step.turnover;
+        notional = step.notional;
+    }
+
+    EXPECT_NEAR(result.maxDrawdown, maxDrawdown, 1e-4);
+    EXPECT_NEAR(result.totalTurnover, turnover, 1e-4);
+    EXPECT_NEAR(result.totalPnL, equity - config.initialCapital, 1e-4);
+}
+
+TEST_F(BacktestEngineTest, TracksDaysInCurrentRegime) {
+    HistoryStore store(root);
+    BacktestResult result = BacktestEngine(store, createConfig()).run();
+
+    int changes = 0;
+    EXPECT_EQ(result.steps[0].daysInCurrentRegime, 1);
+    for (size_t i = 1; i < result.steps.size(); i++) {
+        if (result.steps[i].riskLabel == result.steps[i - 1].riskLabel) {
+            EXPECT_EQ(result.steps[i].daysInCurrentRegime, result.steps[i - 1].daysInCurrentRegime + 1);
+        } else {
+            EXPECT_EQ(result.steps[i].daysInCurrentRegime, 1);
+            changes++;
+        }
+    }
+    EXPECT_EQ(result.regimeChanges, changes);
+    EXPECT_GT(changes, 0);
+}
+
+TEST_F(BacktestEngineTest, DeterministicAndRespectsDateRange) {
+    HistoryStore store(root);
+    BacktestConfig config = createConfig();
+    config.startDate = 20100101;
+    config.endDate = 20141231;
+
+    BacktestEngine engine(store, config);
+    BacktestResult first = engine.run();
+    BacktestResult second = engine.run();
+
+    ASSERT_EQ(first.steps.size(), 5 * 12 * 21);
+    EXPECT_EQ(first.steps.front().date, 20100101);
+    EXPECT_EQ(first.steps.back().date, 20141221);
+    EXPECT_DOUBLE_EQ(first.totalPnL, second.totalPnL);
+    EXPECT_EQ(first.factorRefits, second.factorRefits);
+}
+
+TEST_F(BacktestEngineTest, AdaptiveThresholdsFollowTheHistory) {
+    HistoryStore store(root);
+    BacktestConfig config = createConfig();
+    BacktestResult fixed = BacktestEngine(store, config).run();
+
+    // Risk-Off above the rolling median VIX with any spread wider than the
+    // rolling minimum: about half the days, where VIX > 30 is almost never
+    config.adaptiveThresholds = true;
+    config.thresholdOptions.vixRiskOff = 0.5;
+    config.thresholdOptions.spreadTight = 0.0;
+    config.thresholdOptions.spreadWide = 0.0;
+    BacktestResult adaptive = BacktestEngine(store, config).run();
+
+    auto riskOffShare = [](const BacktestResult& result) {
+        size_t days = 0;
+        for (const BacktestStep& step : result.steps) {
+            days += step.riskLabel == "Risk-Off";
+        }
+        return static_cast<double>(days) / result.steps.size();
+    };
+    ASSERT_EQ(adaptive.steps.size(), fixed.steps.size());
+    EXPECT_LT(riskOffShare(fixed), 0.05);
+    EXPECT_GT(riskOffShare(adaptive), 0.3);
+    EXPECT_LT(riskOffShare(adaptive), 0.7);
+
+    // Fixed thresholds until a year of history is in the window
+    for (size_t i = 0; i < config.thresholdOptions.minObservations - 1; i++) {
+        EXPECT_EQ(adaptive.steps[i].riskLabel, fixed.steps[i].riskLabel);
+    }
+}
+
+// ===== Configuration Tests =====
+
+TEST_F(BacktestEngineTest, RejectsInvalidConfig) {
+    HistoryStore store(root);
+
+    BacktestConfig missing = createConfig();
+    missing.indicators.push_back("ism_manufacturing");
+    EXPECT_THROW(BacktestEngine(store, missing), std::invalid_argument);
+
+    BacktestConfig tooManyFactors = createConfig();
+    tooManyFactors.numFactors = 6;
+    EXPECT_THROW(BacktestEngine(store, tooManyFactors), std::invalid_argument);
+
+    BacktestConfig noReturns = createConfig();
+    noReturns.returnSeries = "spx_returns";
+    EXPECT_THROW(BacktestEngine(store, noReturns), std::invalid_argument);
+}
+
+TEST_F(BacktestEngineTest, MonthEndsOnlySeePublishedIndicators) {
+    HistoryStore store(root);
+    auto firstReadyDate = [&](const BacktestConfig& config) {
+        BacktestResult result = BacktestEngine(store, config).run();
+        for (const BacktestStep& step : result.steps) {
+            if (step.modelReady) {
+                return step.date;
+            }
+        }
+        return 0;
+    };
+
+    // Indicators start on 1995-01-01 and month ends fall on the 21st. With no
+    // lag January's close already samples January's observations, which in
+    // reality were only published in February or later
+    BacktestConfig config = createConfig();
+    config.publicationLagDays.clear();
+    config.defaultPublicationLagDays = 0;
+    EXPECT_EQ(firstReadyDate(config), 19960701);
+
+    // An observation becomes visible exactly lag days after its date
+    config.defaultPublicationLagDays = 20;
+    EXPECT_EQ(firstReadyDate(config), 19960701);
+    config.defaultPublicationLagDays = 21;
+    EXPECT_EQ(firstReadyDate(config), 19960801);
+
+    // The slowest release gates the panel: GDP alone at 120 days holds
+    // the first sample back to May 1995
+    config.defaultPublicationLagDays = 0;
+    config.publicationLagDays = {{"gdp", 120}};
+    EXPECT_EQ(firstReadyDate(config), 19961101);
+
+    config.publicationLagDays = {{"gdp", -1}};
+    EXPECT_THROW(BacktestEngine(store, config), std::invalid_argument);
+}
+
+TEST_F(BacktestEngineTest, UsesVintagesForPointInTimeLevels) {
+    HistoryStore store(root);
+    std::string vintageRoot = root + "_vintages";
+
+    // ISM only exists as vintages: each month published on the 5th of the next month
+    std::vector<VintageRecord> records;
+    for (int year = 1995; year < 2025; year++) {
+        for (int month = 1; month <= 12; month++) {
+            int32_t date = year * 10000 + month * 100 + 1;
+            int32_t published = (month == 12 ? (year + 1) * 10000 + 100 : year * 10000 + (month + 1) * 100) + 5;
+            records.push_back({date, published, REALTIME_OPEN_END, 50.0 + std::sin(year * 12 + month)});
+        }
+    }
+    VintageStore::writeSeries(vintageRoot, "ism_manufacturing", records);
+    VintageStore vintages(vintageRoot);
+
+    BacktestConfig config = createConfig();
+    config.indicators.push_back("ism_manufacturing");
+    EXPECT_THROW(BacktestEngine(store, config), std::invalid_argument);
+
+    BacktestResult result = BacktestEngine(store, config, &vintages).run();
+    EXPECT_GT(result.factorRefits, 300);
+
+    std::filesystem::remove_all(vintageRoot);
+}
+
+TEST_F(BacktestEngineTest, ImportedFedFundsVintagesReachTheBacktest) {
+    HistoryStore store(root);
+    std::string vintageRoot = root + "_fred_vintages";
+
+    // ALFRED response for FEDFUNDS where nothing was published before 2000
+    nlohmann::json response = {{"observations", nlohmann::json::array()}};
+    for (int year = 1995; year < 2025; year++) {
+        for (int month = 1; month <= 12; month++) {
+            char date[11], published[11];
+            std::snprintf(date, sizeof(date), "%04d-%02d-01", year, month);
+            std::snprintf(published, sizeof(published), "%04d-%02d-05",
+                          std::max(year + (month == 12), 2000), month == 12 ? 1 : month + 1);
+            response["observations"].push_back({{"date", date}, {"realtime_start", published},
+                                                {"realtime_end", "9999-12-31"},
+                                                {"value", std::to_string(5.0 + std::sin(year * 12 + month))}});
+        }
+    }
+    std::vector<VintageRecord> records = VintageStore::parseALFRED(response.dump());
+
+    auto firstReadyDate = [&](const VintageStore& vintages) {
+        for (const BacktestStep& step : BacktestEngine(store, createConfig(), &vintages).run().steps) {
+            if (step.modelReady) {
+                return step.date;
+            }
+        }
+        return 0;
+    };
+
+    // Under the FREDDataClient key the backtest never finds it and falls
+    // back to the revised history store
+    VintageStore::writeSeries(vintageRoot, "fed_funds_rate", records);
+    EXPECT_EQ(firstReadyDate(VintageStore(vintageRoot)), 19961101);
+    std::filesystem::remove_all(vintageRoot);
+
+    // Under the import name the point-in-time series gates the panel: first
+    // sample at the January 2000 close, first refit 17 month ends later
+    ASSERT_EQ(VintageStore::seriesNameForFRED("fed_funds_rate"), "fed_funds");
+    EXPECT_EQ(VintageStore::seriesNameForFRED("unemployment"), "unemployment");
+    VintageStore::writeSeries(vintageRoot, VintageStore::seriesNameForFRED("fed_funds_rate"), records);
+    EXPECT_EQ(firstReadyDate(VintageStore(vintageRoot)), 20010701);
+
+    std::filesystem::remove_all(vintageRoot);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
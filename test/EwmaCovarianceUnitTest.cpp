@@ -0,0 +1,185 @@
+//
+//  EwmaCovarianceUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the exponentially weighted covariance engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/EwmaCovariance.hpp"
+#include "../src/DataProcessors/MacroFactorModel.hpp"
+#include <cmath>
+#include <random>
+
+class EwmaCovarianceTest : public ::testing::Test {
+protected:
+    static std::vector<std::string> names() {
+        return {"fed_funds", "gdp", "inflation", "vix"};
+    }
+
+    // T × 4 correlated panel; volatility jumps by `shock` after `breakAt`
+    static Eigen::MatrixXd panel(int T, int breakAt = -1, double shock = 1.0, uint64_t seed = 3) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        Eigen::MatrixXd mixing(4, 4);
+        mixing << 1.0, 0.0, 0.0, 0.0,
+                  0.5, 0.8, 0.0, 0.0,
+                  0.2, -0.3, 0.9, 0.0,
+                  -0.4, 0.1, 0.2, 0.7;
+        Eigen::MatrixXd x(T, 4);
+        for (int t = 0; t < T; t++) {
+            Eigen::Vector4d z(normal(rng), normal(rng), normal(rng), normal(rng));
+            x.row(t) = (mixing * z).transpose() * (breakAt >= 0 && t >= breakAt ? shock : 1.0);
+            x.row(t).array() += 0.3;
+        }
+        return x;
+    }
+
+    static std::map<std::string, std::vector<double>> toMap(const Eigen::MatrixXd& x) {
+        std::map<std::string, std::vector<double>> series;
+        auto n = names();
+        for (int j = 0; j < x.cols(); j++) {
+            series[n[j]] = std::vector<double>(x.col(j).data(), x.col(j).data() + x.rows());
+        }
+        return series;
+    }
+
+    // Direct weighted estimate with weights λ^(T−1−s)
+    static Eigen::MatrixXd reference(const Eigen::MatrixXd& x, double decay, bool demean) {
+        const int T = static_cast<int>(x.rows());
+        Eigen::VectorXd weights(T);
+        for (int s = 0; s < T; s++) {
+            weights(s) = std::pow(decay, T - 1 - s);
+        }
+        double total = weights.sum();
+        Eigen::RowVectorXd mean = Eigen::RowVectorXd::Zero(x.cols());
+        if (demean) {
+            mean = (weights.transpose() * x) / total;
+        }
+        Eigen::MatrixXd centered = x.rowwise() - mean;
+        return centered.transpose() * weights.asDiagonal() * centered / total;
+    }
+};
+
+// ===== Estimator Tests =====
+
+TEST_F(EwmaCovarianceTest, HalfLifeHalvesWeight) {
+    for (double h : {1.0, 6.0, EwmaCovariance::RISKMETRICS_HALF_LIFE}) {
+        EXPECT_NEAR(std::pow(EwmaCovariance::decayFromHalfLife(h), h), 0.5, 1e-12);
+    }
+    EXPECT_NEAR(EwmaCovariance::decayFromHalfLife(EwmaCovariance::RISKMETRICS_HALF_LIFE), 0.94, 5e-4);
+}
+
+TEST_F(EwmaCovarianceTest, MatchesDirectWeightedEstimate) {
+    Eigen::MatrixXd x = panel(80);
+    for (bool demean : {false, true}) {
+        EwmaCovariance engine(names(), {6.0}, demean);
+        engine.update(toMap(x));
+
+        double decay = EwmaCovariance::decayFromHalfLife(6.0);
+        EXPECT_TRUE(engine.covariance().getMatrix().isApprox(reference(x, decay, demean), 1e-10));
+        EXPECT_EQ(engine.observationCount(), 80u);
+    }
+}
+
+TEST_F(EwmaCovarianceTest, ZeroMeanSteadyStateIsRiskMetricsRecursion) {
+    Eigen::MatrixXd x = panel(600);
+    EwmaCovariance engine(names(), {EwmaCovariance::RISKMETRICS_HALF_LIFE});
+    double decay = EwmaCovariance::decayFromHalfLife(EwmaCovariance::RISKMETRICS_HALF_LIFE);
+
+    // Σ_t = λ Σ_{t−1} + (1 − λ) x xᵀ, seeded with the first outer product
+    Eigen::MatrixXd recursion = x.row(0).transpose() * x.row(0);
+    engine.update(Eigen::VectorXd(x.row(0).transpose()));
+    for (int t = 1; t < x.rows(); t++) {
+        recursion = decay * recursion + (1.0 - decay) * x.row(t).transpose() * x.row(t);
+        engine.update(Eigen::VectorXd(x.row(t).transpose()));
+    }
+    EXPECT_TRUE(engine.covariance().getMatrix().isApprox(recursion, 1e-8));
+    EXPECT_NEAR(engine.effectiveObservations(), (1 + decay) / (1 - decay), 1e-6);
+}
+
+TEST_F(EwmaCovarianceTest, LongHalfLifeApproachesSampleCovariance) {
+    Eigen::MatrixXd x = panel(40);
+    EwmaCovariance engine(names(), {1e12}, true);
+    engine.update(toMap(x));
+
+    CovarianceCalculator calculator;
+    Eigen::MatrixXd sample = calculator.calculateCovarianceMatrix(toMap(x)).getMatrix();
+    EXPECT_TRUE(engine.covariance().getMatrix().isApprox(sample * 39.0 / 40.0, 1e-8));
+    EXPECT_NEAR(engine.effectiveObservations(), 40.0, 1e-6);
+}
+
+// ===== Term Structure Tests =====
+
+TEST_F(EwmaCovarianceTest, TermStructureMatchesSeparateEngines) {
+    Eigen::MatrixXd x = panel(120);
+    std::vector<double> halfLives = {3.0, 12.0, 60.0};
+    EwmaCovariance combined(names(), halfLives, true);
+    combined.update(toMap(x));
+
+    std::vector<CovarianceMatrix> curve = combined.termStructure();
+    ASSERT_EQ(curve.size(), 3u);
+    for (size_t h = 0; h < halfLives.size(); h++) {
+        EwmaCovariance single(names(), {halfLives[h]}, true);
+        single.update(toMap(x));
+        EXPECT_TRUE(curve[h].getMatrix().isApprox(single.covariance().getMatrix(), 1e-12));
+        EXPECT_TRUE(combined.mean(h).isApprox(single.mean(), 1e-12));
+    }
+}
+
+TEST_F(EwmaCovarianceTest, ShortHalfLifeReactsFirst) {
+    Eigen::MatrixXd x = panel(240, 230, 3.0);
+    EwmaCovariance engine(names(), {3.0, 60.0});
+    engine.update(toMap(x));
+
+    // Ten observations into a 3× volatility shock: the short end has repriced, the long end lags
+    double fastVariance = engine.covariance(0).getMatrix().trace();
+    double slowVariance = engine.covariance(1).getMatrix().trace();
+    EXPECT_GT(fastVariance, 2.0 * slowVariance);
+}
+
+// ===== Integration Tests =====
+
+TEST_F(EwmaCovarianceTest, FeedsFactorDecomposition) {
+    EwmaCovariance engine(names(), {12.0}, true);
+    engine.update(toMap(panel(60)));
+
+    MacroFactors factors = MacroFactorModel::decomposeSurpriseCovariance(engine.covariance(), 2);
+    EXPECT_EQ(factors.indicatorNames, names());
+    EXPECT_GT(factors.cumulativeVarianceExplained, 0.0);
+    EXPECT_DOUBLE_EQ(engine.covariance().getCovariance("gdp", "vix"), engine.covariance().getMatrix()(1, 3));
+}
+
+// ===== Error Handling =====
+
+TEST_F(EwmaCovarianceTest, RejectsBadInput) {
+    EXPECT_THROW(EwmaCovariance::decayFromHalfLife(0.0), std::invalid_argument);
+    EXPECT_THROW(EwmaCovariance::decayFromHalfLife(NAN), std::invalid_argument);
+    EXPECT_THROW(EwmaCovariance({}, {6.0}), std::invalid_argument);
+    EXPECT_THROW(EwmaCovariance({"a", "a"}, {6.0}), std::invalid_argument);
+    EXPECT_THROW(EwmaCovariance({"a"}, {}), std::invalid_argument);
+    EXPECT_THROW(EwmaCovariance({"a"}, {-1.0}), std::invalid_argument);
+
+    EwmaCovariance engine(names(), {6.0});
+    EXPECT_THROW(engine.covariance(), std::runtime_error);
+    EXPECT_THROW(engine.update(Eigen::VectorXd::Zero(3)), std::invalid_argument);
+    EXPECT_THROW(engine.update(Eigen::Vector4d(0.0, NAN, 0.0, 0.0)), std::invalid_argument);
+
+    auto series = toMap(panel(10));
+    series["vix"].pop_back();
+    EXPECT_THROW(engine.update(series), std::invalid_argument);
+    series.erase("vix");
+    EXPECT_THROW(engine.update(series), std::invalid_argument);
+    EXPECT_EQ(engine.observationCount(), 0u);
+
+    engine.update(Eigen::VectorXd::Ones(4));
+    EXPECT_THROW(engine.covariance(1), std::out_of_range);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
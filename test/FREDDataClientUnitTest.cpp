@@ -106,6 +106,47 @@ TEST_F(FREDDataClientUnitTest, ParseFREDResponse_ErrorResponse) {
     EXPECT_TRUE(errorResponse.contains("error_message"));
 }
 
+// ===== Vintage Paging Tests (No API required) =====
+
+TEST_F(FREDDataClientUnitTest, VintagePagesAreStitchedUntilCount) {
+    // 5 rows served 2 per page, like a 250k-row history at the 100k limit
+    json rows = json::array();
+    for (int i = 0; i < 5; i++) {
+        rows.push_back({{"date", "2020-0" + std::to_string(i + 1) + "-01"},
+                        {"realtime_start", "2020-06-01"}, {"realtime_end", "9999-12-31"},
+                        {"value", std::to_string(i)}});
+    }
+    std::vector<size_t> offsets;
+    auto fetchPage = [&](size_t offset) {
+        offsets.push_back(offset);
+        json page = {{"count", 5}, {"offset", offset}, {"observations", json::array()}};
+        for (size_t i = offset; i < std::min<size_t>(offset + 2, 5); i++) {
+            page["observations"].push_back(rows[i]);
+        }
+        return page.dump();
+    };
+
+    json combined = json::parse(FREDDataClient::collectVintagePages("UNRATE", fetchPage));
+    EXPECT_EQ(offsets, (std::vector<size_t>{0, 2, 4}));
+    EXPECT_EQ(combined["count"], 5);
+    EXPECT_EQ(combined["observations"], rows);
+}
+
+TEST_F(FREDDataClientUnitTest, VintagePagesEndingShortThrow) {
+    // The API stops returning rows before the advertised count
+    auto fetchPage = [](size_t offset) {
+        json page = {{"count", 3}, {"observations", json::array()}};
+        if (offset == 0) {
+            page["observations"].push_back({{"date", "2020-01-01"}, {"value", "1.0"}});
+        }
+        return page.dump();
+    };
+    EXPECT_THROW(FREDDataClient::collectVintagePages("UNRATE", fetchPage), std::runtime_error);
+
+    auto errorPage = [](size_t) { return std::string(MockData::INVALID_FRED_RESPONSE); };
+    EXPECT_THROW(FREDDataClient::collectVintagePages("UNRATE", errorPage), std::runtime_error);
+}
+
 // ===== Data Structure Tests (No API required) =====
 
 TEST_F(FREDDataClientUnitTest, FREDObservation_ValidConstruction) {
@@ -0,0 +1,140 @@
+//
+//  HistoricalSimulationUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for historical-simulation VaR / ES
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/HistoricalSimulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+class HistoricalSimulationTest : public ::testing::Test {
+protected:
+    // T days of K fat-tailed factor shocks
+    static Eigen::MatrixXd shockHistory(int T, int K, uint64_t seed = 7) {
+        std::mt19937_64 rng(seed);
+        std::student_t_distribution<double> shock(4.0);
+        Eigen::MatrixXd shocks(T, K);
+        for (int t = 0; t < T; t++) {
+            for (int k = 0; k < K; k++) {
+                shocks(t, k) = 0.01 * shock(rng);
+            }
+        }
+        return shocks;
+    }
+
+    // Reference: sort all losses, VaR = m-th largest, ES = mean of the m largest
+    static std::pair<double, double> sortedTail(const Eigen::VectorXd& pnl, double confidence) {
+        std::vector<double> losses(pnl.size());
+        for (Eigen::Index i = 0; i < pnl.size(); i++) {
+            losses[i] = -pnl(i);
+        }
+        std::sort(losses.begin(), losses.end(), std::greater<double>());
+        size_t m = static_cast<size_t>(std::ceil((1.0 - confidence) * losses.size() - 1e-9));
+        m = std::max<size_t>(m, 1);
+        double sum = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            sum += losses[i];
+        }
+        return {losses[m - 1], sum / m};
+    }
+};
+
+// ===== Scenario Tests =====
+
+TEST_F(HistoricalSimulationTest, ScenariosRevalueExposureOverHorizon) {
+    Eigen::MatrixXd shocks = shockHistory(50, 3);
+    Eigen::Vector3d gamma(0.4, -0.2, 0.7);
+
+    Eigen::VectorXd daily = HistoricalSimulation::scenarioPnl(gamma, shocks, 2.0);
+    ASSERT_EQ(daily.size(), 50);
+    EXPECT_TRUE(daily.isApprox(2.0 * shocks * gamma));
+
+    Eigen::VectorXd tenDay = HistoricalSimulation::scenarioPnl(gamma, shocks, 2.0, 10);
+    ASSERT_EQ(tenDay.size(), 41);
+    for (Eigen::Index s = 0; s < tenDay.size(); s++) {
+        EXPECT_NEAR(tenDay(s), daily.segment(s, 10).sum(), 1e-14);
+    }
+}
+
+TEST_F(HistoricalSimulationTest, TailRiskMatchesFullSort) {
+    Eigen::VectorXd pnl = HistoricalSimulation::scenarioPnl(Eigen::Vector2d(1.0, -0.5), shockHistory(1003, 2), 1.0);
+    std::vector<double> levels = {0.99, 0.9, 0.975, 0.95};
+    TailRisk tail = HistoricalSimulation::tailRisk(pnl, levels);
+
+    EXPECT_EQ(tail.confidenceLevels, levels);
+    EXPECT_EQ(tail.numScenarios, 1003u);
+    for (size_t l = 0; l < levels.size(); l++) {
+        auto [var, es] = sortedTail(pnl, levels[l]);
+        EXPECT_DOUBLE_EQ(tail.valueAtRisk[l], var) << levels[l];
+        EXPECT_NEAR(tail.expectedShortfall[l], es, 1e-14) << levels[l];
+        EXPECT_GE(tail.expectedShortfall[l], tail.valueAtRisk[l]);
+    }
+}
+
+// ===== Rolling Tests =====
+
+TEST_F(HistoricalSimulationTest, RollingMatchesPerWindowSort) {
+    Eigen::VectorXd pnl = HistoricalSimulation::scenarioPnl(Eigen::Vector3d(0.3, 0.5, -0.4), shockHistory(700, 3), 1.0);
+    const size_t window = 250;
+    std::vector<double> levels = {0.95, 0.99, 0.5};
+    RollingTailRisk rolling = HistoricalSimulation::rollingTailRisk(pnl, window, levels);
+
+    ASSERT_EQ(rolling.valueAtRisk.rows(), 3);
+    ASSERT_EQ(rolling.valueAtRisk.cols(), 700 - 250 + 1);
+    for (Eigen::Index s = 0; s < rolling.valueAtRisk.cols(); s += 13) {
+        Eigen::VectorXd segment = pnl.segment(s, window);
+        for (size_t l = 0; l < levels.size(); l++) {
+            auto [var, es] = sortedTail(segment, levels[l]);
+            EXPECT_DOUBLE_EQ(rolling.valueAtRisk(l, s), var) << "window " << s;
+            EXPECT_NEAR(rolling.expectedShortfall(l, s), es, 1e-12) << "window " << s;
+        }
+    }
+}
+
+TEST_F(HistoricalSimulationTest, RollingHandlesTiedScenarios) {
+    // Rounded P&L: many exact ties inside every window
+    Eigen::VectorXd pnl = HistoricalSimulation::scenarioPnl(Eigen::Vector2d(1.0, 1.0), shockHistory(300, 2, 19), 100.0);
+    pnl = pnl.array().round();
+    RollingTailRisk rolling = HistoricalSimulation::rollingTailRisk(pnl, 40, {0.9});
+
+    for (Eigen::Index s = 0; s < rolling.valueAtRisk.cols(); s++) {
+        auto [var, es] = sortedTail(pnl.segment(s, 40), 0.9);
+        EXPECT_DOUBLE_EQ(rolling.valueAtRisk(0, s), var);
+        EXPECT_NEAR(rolling.expectedShortfall(0, s), es, 1e-12);
+    }
+
+    // A full-length window is the whole-sample tail
+    RollingTailRisk whole = HistoricalSimulation::rollingTailRisk(pnl, 300, {0.95});
+    ASSERT_EQ(whole.valueAtRisk.cols(), 1);
+    EXPECT_DOUBLE_EQ(whole.valueAtRisk(0, 0), HistoricalSimulation::tailRisk(pnl, {0.95}).valueAtRisk[0]);
+}
+
+// ===== Error Handling =====
+
+TEST_F(HistoricalSimulationTest, RejectsInvalidInput) {
+    Eigen::MatrixXd shocks = shockHistory(20, 2);
+    EXPECT_THROW(HistoricalSimulation::scenarioPnl(Eigen::Vector3d::Ones(), shocks, 1.0), std::invalid_argument);
+    EXPECT_THROW(HistoricalSimulation::scenarioPnl(Eigen::Vector2d::Ones(), shocks, 1.0, 0), std::invalid_argument);
+    EXPECT_THROW(HistoricalSimulation::scenarioPnl(Eigen::Vector2d::Ones(), shocks, 1.0, 21), std::invalid_argument);
+    shocks(3, 1) = NAN;
+    EXPECT_THROW(HistoricalSimulation::scenarioPnl(Eigen::Vector2d::Ones(), shocks, 1.0), std::invalid_argument);
+
+    Eigen::VectorXd pnl = Eigen::VectorXd::LinSpaced(10, -1.0, 1.0);
+    EXPECT_THROW(HistoricalSimulation::tailRisk(Eigen::VectorXd()), std::invalid_argument);
+    EXPECT_THROW(HistoricalSimulation::tailRisk(pnl, {}), std::invalid_argument);
+    EXPECT_THROW(HistoricalSimulation::tailRisk(pnl, {1.0}), std::invalid_argument);
+    EXPECT_THROW(HistoricalSimulation::rollingTailRisk(pnl, 0), std::invalid_argument);
+    EXPECT_THROW(HistoricalSimulation::rollingTailRisk(pnl, 11), std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,252 @@
+//
+//  HistoryStoreUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the columnar memory-mapped history store
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Storage/HistoryStore.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+class HistoryStoreTest : public ::testing::Test {
+protected:
+    std::string root;
+
+    void SetUp() override {
+        auto dir = std::filesystem::temp_directory_path() /
+                   ("history_store_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                    "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir);
+        root = dir.string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    // Consecutive calendar-ish dates starting 2000-01-01 (day index packed into DD/MM)
+    static std::vector<int32_t> createDates(int count, int32_t start = 20000101) {
+        std::vector<int32_t> dates;
+        int32_t date = start;
+        for (int i = 0; i < count; i++) {
+            dates.push_back(date);
+            date += (date % 100 == 28) ? 73 : 1;   // Roll to the next month after day 28
+            if ((date / 100) % 100 == 13) date += 8800;
+        }
+        return dates;
+    }
+
+    // Sticky LOCF-style monthly series with occasional changes
+    static std::vector<double> createValues(int count) {
+        std::vector<double> values;
+        double level = 2.5;
+        for (int i = 0; i < count; i++) {
+            if (i % 21 == 0) level += 0.125 * ((i / 21) % 3 - 1);
+            values.push_back(level);
+        }
+        return values;
+    }
+
+    static bool bitwiseEqual(double a, double b) {
+        return std::memcmp(&a, &b, sizeof(double)) == 0;
+    }
+};
+
+// ===== Round-Trip Tests =====
+
+TEST_F(HistoryStoreTest, RawRoundTrip) {
+    auto dates = createDates(500);
+    auto values = createValues(500);
+    HistoryStore::writeSeries(root, "gdp", dates, values);
+
+    HistoryStore store(root);
+    SeriesView view = store.series("gdp");
+    ASSERT_EQ(view.size, 500);
+    for (size_t i = 0; i < view.size; i++) {
+        EXPECT_EQ(view.dates[i], dates[i]);
+        EXPECT_DOUBLE_EQ(view.values[i], values[i]);
+    }
+}
+
+TEST_F(HistoryStoreTest, CompressedRoundTripIsBitExact) {
+    auto dates = createDates(1000);
+    auto values = createValues(1000);
+    values[10] = std::nan("");
+    values[11] = -0.0;
+    values[12] = std::numeric_limits<double>::infinity();
+    values[13] = 1e-300;
+
+    HistoryStore::writeSeries(root, "vix", dates, values, HistoryCompression::DeltaXor);
+
+    HistoryStore store(root);
+    SeriesView view = store.series("vix");
+    ASSERT_EQ(view.size, 1000);
+    for (size_t i = 0; i < view.size; i++) {
+        EXPECT_EQ(view.dates[i], dates[i]);
+        EXPECT_TRUE(bitwiseEqual(view.values[i], values[i])) << "index " << i;
+    }
+}
+
+TEST_F(HistoryStoreTest, CompressionShrinksStickySeries) {
+    auto dates = createDates(5000);
+    auto values = createValues(5000);
+
+    HistoryStore::writeSeries(root, "raw", dates, values);
+    HistoryStore::writeSeries(root, "packed", dates, values, HistoryCompression::DeltaXor);
+
+    auto rawSize = std::filesystem::file_size(root + "/raw.col");
+    auto packedSize = std::filesystem::file_size(root + "/packed.col");
+    EXPECT_LT(packedSize * 4, rawSize);
+}
+
+TEST_F(HistoryStoreTest, EmptySeries) {
+    HistoryStore::writeSeries(root, "empty", {}, {});
+
+    HistoryStore store(root);
+    SeriesView view = store.series("empty");
+    EXPECT_TRUE(view.empty());
+    EXPECT_TRUE(std::isnan(view.valueAsOf(20250101)));
+}
+
+// ===== Append Tests =====
+
+TEST_F(HistoryStoreTest, AppendGrowsInPlaceAndAcrossCapacity) {
+    auto dates = createDates(300);
+    auto values = createValues(300);
+
+    // One row at a time, like the daily job
+    for (size_t i = 0; i < dates.size(); i++) {
+        HistoryStore::appendSeries(root, "fed_funds", {dates[i]}, {values[i]});
+    }
+
+    HistoryStore store(root);
+    SeriesView view = store.series("fed_funds");
+    ASSERT_EQ(view.size, 300);
+    EXPECT_EQ(view.dates[0], dates[0]);
+    EXPECT_EQ(view.dates[299], dates[299]);
+    EXPECT_DOUBLE_EQ(view.values[150], values[150]);
+}
+
+TEST_F(HistoryStoreTest, AppendToCompressedSeriesKeepsCodec) {
+    auto dates = createDates(200);
+    auto values = createValues(200);
+
+    HistoryStore::writeSeries(root, "cpi",
+                              std::vector<int32_t>(dates.begin(), dates.begin() + 150),
+                              std::vector<double>(values.begin(), values.begin() + 150),
+                              HistoryCompression::DeltaXor);
+    HistoryStore::appendSeries(root, "cpi",
+                               std::vector<int32_t>(dates.begin() + 150, dates.end()),
+                               std::vector<double>(values.begin() + 150, values.end()));
+
+    HistoryStore store(root);
+    SeriesView view = store.series("cpi");
+    ASSERT_EQ(view.size, 200);
+    EXPECT_EQ(view.dates[199], dates[199]);
+    EXPECT_DOUBLE_EQ(view.values[199], values[199]);
+    EXPECT_LT(std::filesystem::file_size(root + "/cpi.col"), 200 * sizeof(double));
+}
+
+TEST_F(HistoryStoreTest, RejectsOutOfOrderDates) {
+    EXPECT_THROW(HistoryStore::writeSeries(root, "bad", {20250102, 20250101}, {1.0, 2.0}),
+                 std::invalid_argument);
+    EXPECT_THROW(HistoryStore::writeSeries(root, "bad", {20250101}, {1.0, 2.0}),
+                 std::invalid_argument);
+
+    HistoryStore::appendSeries(root, "ok", {20250101, 20250102}, {1.0, 2.0});
+    EXPECT_THROW(HistoryStore::appendSeries(root, "ok", {20250102}, {3.0}), std::invalid_argument);
+
+    HistoryStore store(root);
+    EXPECT_EQ(store.series("ok").size, 2);
+}
+
+TEST_F(HistoryStoreTest, RejectsPathLikeNames) {
+    EXPECT_THROW(HistoryStore::writeSeries(root, "../escape", {20250101}, {1.0}), std::invalid_argument);
+    EXPECT_THROW(HistoryStore::writeSeries(root, "", {20250101}, {1.0}), std::invalid_argument);
+}
+
+// ===== Query Tests =====
+
+TEST_F(HistoryStoreTest, SliceAndAsOfQueries) {
+    HistoryStore::writeSeries(root, "unemployment",
+                              {20250101, 20250201, 20250301, 20250401},
+                              {4.0, 4.1, 4.2, 4.3});
+
+    HistoryStore store(root);
+    SeriesView view = store.series("unemployment");
+
+    EXPECT_EQ(view.lowerBound(20250115), 1);
+    EXPECT_EQ(view.lowerBound(20250501), 4);
+
+    SeriesView q1 = view.slice(20250115, 20250301);
+    ASSERT_EQ(q1.size, 2);
+    EXPECT_EQ(q1.dates[0], 20250201);
+    EXPECT_DOUBLE_EQ(q1.values[1], 4.2);
+    EXPECT_TRUE(view.slice(20250302, 20250331).empty());
+
+    EXPECT_DOUBLE_EQ(view.valueAsOf(20250315), 4.2);
+    EXPECT_DOUBLE_EQ(view.valueAsOf(20250401), 4.3);
+    EXPECT_TRUE(std::isnan(view.valueAsOf(20241231)));
+}
+
+TEST_F(HistoryStoreTest, LatestValuesRejectShortOrStaleSeries) {
+    HistoryStore::writeSeries(root, "fed_funds",
+                              {20250101, 20250201, 20250301, 20250401},
+                              {4.33, 4.33, 4.25, 4.10});
+
+    HistoryStore store(root);
+    std::vector<double> out;
+    ASSERT_TRUE(store.latestValues("fed_funds", 3, 20250401, out));
+    EXPECT_EQ(out, (std::vector<double>{4.10, 4.25, 4.33}));
+
+    // Fewer rows than requested, or a last observation before the cutoff,
+    // must send the caller back to the API rather than return partial data
+    out = {-1.0};
+    EXPECT_FALSE(store.latestValues("fed_funds", 5, 20250401, out));
+    EXPECT_FALSE(store.latestValues("fed_funds", 3, 20250402, out));
+    EXPECT_FALSE(store.latestValues("missing", 1, 0, out));
+    EXPECT_FALSE(store.latestValues("fed_funds", 0, 0, out));
+    EXPECT_EQ(out, (std::vector<double>{-1.0}));
+}
+
+TEST_F(HistoryStoreTest, RawViewsAreZeroCopy) {
+    HistoryStore::writeSeries(root, "gdp", createDates(100), createValues(100));
+
+    HistoryStore store(root);
+    SeriesView first = store.series("gdp");
+    SeriesView second = store.series("gdp");
+    EXPECT_EQ(first.values, second.values);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first.values) % alignof(double), 0);
+}
+
+TEST_F(HistoryStoreTest, ListsSeriesAndIgnoresForeignFiles) {
+    HistoryStore::writeSeries(root, "vix", {20250101}, {15.0});
+    HistoryStore::writeSeries(root, "gdp", {20250101}, {2.0});
+    std::ofstream(root + "/README.txt") << "not a column";
+
+    HistoryStore store(root);
+    EXPECT_EQ(store.seriesNames(), (std::vector<std::string>{"gdp", "vix"}));
+    EXPECT_TRUE(store.hasSeries("vix"));
+    EXPECT_FALSE(store.hasSeries("move"));
+    EXPECT_THROW(store.series("move"), std::out_of_range);
+}
+
+TEST_F(HistoryStoreTest, RejectsCorruptColumn) {
+    std::filesystem::create_directories(root);
+    std::ofstream(root + "/junk.col") << "definitely not a column file header";
+    EXPECT_THROW(HistoryStore store(root), std::runtime_error);
+    EXPECT_THROW(HistoryStore store(root + "/missing"), std::runtime_error);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
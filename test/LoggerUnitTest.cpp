@@ -0,0 +1,366 @@
+//
+//  LoggerUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for structured logging and the asynchronous ring-buffer backend
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Utils/Logger.hpp"
+#include "../src/Utils/MpscRingBuffer.hpp"
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        stdoutBuffer_ = std::cout.rdbuf(captured_.rdbuf());
+        Logger::setLevel(Logger::INFO);
+    }
+
+    void TearDown() override {
+        Logger::stopAsync();
+        std::cout.rdbuf(stdoutBuffer_);
+    }
+
+    std::vector<json> records() {
+        std::vector<json> result;
+        std::istringstream lines(captured_.str());
+        std::string line;
+        while (std::getline(lines, line)) {
+            result.push_back(json::parse(line));
+        }
+        return result;
+    }
+
+    std::ostringstream captured_;
+
+private:
+    std::streambuf* stdoutBuffer_ = nullptr;
+};
+
+// ===== MpscRingBuffer Tests =====
+
+TEST(MpscRingBufferTest, FifoAndCapacity) {
+    MpscRingBuffer<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 8; i++) {
+        int value = i;
+        ASSERT_TRUE(ring.tryPush(std::move(value)));
+    }
+    int overflow = 99;
+    EXPECT_FALSE(ring.tryPush(std::move(overflow)));
+
+    int value = -1;
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.tryPop(value));
+
+    // Wraps around once slots are handed back
+    int again = 8;
+    EXPECT_TRUE(ring.tryPush(std::move(again)));
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 8);
+    EXPECT_THROW(MpscRingBuffer<int>(0), std::invalid_argument);
+}
+
+TEST(MpscRingBufferTest, ConcurrentProducersPreserveOrderPerProducer) {
+    const int producers = 4;
+    const int perProducer = 20000;
+    MpscRingBuffer<int> ring(256);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&ring, p]() {
+            for (int i = 0; i < perProducer; i++) {
+                int value = p * perProducer + i;
+                while (!ring.tryPush(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> last(producers, -1);
+    int received = 0;
+    int value = 0;
+    while (received < producers * perProducer) {
+        if (!ring.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / perProducer;
+        ASSERT_GT(value % perProducer, last[producer]);
+        last[producer] = value % perProducer;
+        received++;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int p = 0; p < producers; p++) {
+        EXPECT_EQ(last[p], perProducer - 1);
+    }
+}
+
+// ===== Synchronous Logging Tests =====
+
+TEST_F(LoggerTest, SyncRecordIsOneJsonLine) {
+    Logger::info("Analysis started", {{"indicators_fetched", 8}});
+    Logger::debug("Hidden at INFO");
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0]["level"], "INFO");
+    EXPECT_EQ(lines[0]["message"], "Analysis started");
+    EXPECT_EQ(lines[0]["indicators_fetched"], 8);
+    EXPECT_TRUE(lines[0].contains("timestamp"));
+    EXPECT_FALSE(Logger::isAsync());
+}
+
+TEST_F(LoggerTest, MacroFieldsSerializeAsJson) {
+    std::string quoted = "say \"hi\"\n\tback\\slash\x01";
+    LOG_INFO("Fields",
+             "int", -42,
+             "size", size_t{7},
+             "double", 0.1,
+             "nan", std::nan(""),
+             "flag", true,
+             "text", quoted,
+             "view", std::string_view("abc"),
+             "object", json{{"nested", {1, 2}}});
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 1u);
+    const json& record = lines[0];
+    EXPECT_EQ(record["level"], "INFO");
+    EXPECT_EQ(record["message"], "Fields");
+    EXPECT_EQ(record["int"], -42);
+    EXPECT_EQ(record["size"], 7);
+    EXPECT_EQ(record["double"].get<double>(), 0.1);   // Round-trips exactly
+    EXPECT_TRUE(record["nan"].is_null());
+    EXPECT_EQ(record["flag"], true);
+    EXPECT_EQ(record["text"], quoted);
+    EXPECT_EQ(record["view"], "abc");
+    EXPECT_EQ(record["object"]["nested"][1], 2);
+
+    // Header fields come first, in a fixed order
+    EXPECT_EQ(captured_.str().rfind("{\"level\":\"INFO\",\"timestamp\":\"", 0), 0u);
+}
+
+TEST_F(LoggerTest, DisabledLevelSkipsArguments) {
+    int evaluations = 0;
+    auto expensive = [&]() { evaluations++; return 1; };
+
+    LOG_DEBUG("Hidden", "value", expensive());
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_FALSE(Logger::isEnabled(Logger::DEBUG));
+
+    Logger::setLevel(Logger::DEBUG);
+    LOG_DEBUG("Shown", "value", expensive());
+    LOG_DEBUG("No fields");
+    EXPECT_EQ(evaluations, 1);
+
+    Logger::setLevel(Logger::ERROR);
+    LOG_WARN("Hidden", "value", expensive());
+    EXPECT_EQ(evaluations, 1);
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0]["value"], 1);
+    EXPECT_EQ(lines[1]["message"], "No fields");
+}
+
+TEST_F(LoggerTest, JsonContextMatchesMacroOutput) {
+    Logger::warn("Same", {{"n", 3}, {"s", "x"}});
+    LOG_WARN("Same", "n", 3, "s", "x");
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 2u);
+    lines[0].erase("timestamp");
+    lines[1].erase("timestamp");
+    EXPECT_EQ(lines[0], lines[1]);
+}
+
+TEST_F(LoggerTest, ContextNeverRepeatsHeaderKeys) {
+    Logger::info("Analysis started", {{"timestamp", 1760000000}, {"level", "phase 1"}, {"mode", "covariance"}});
+    LOG_INFO("Macro", "message", "shadowed", "n", 1);
+
+    std::istringstream lines(captured_.str());
+    std::string line;
+    int parsed = 0;
+    while (std::getline(lines, line)) {
+        // Count top-level keys as the parser sees them; json::parse alone keeps the last duplicate
+        std::map<std::string, int> keys;
+        json record = json::parse(line, [&](int depth, json::parse_event_t event, json& value) {
+            if (depth == 1 && event == json::parse_event_t::key) {
+                keys[value.get<std::string>()]++;
+            }
+            return true;
+        });
+        for (const auto& [key, count] : keys) {
+            EXPECT_EQ(count, 1) << key << " in " << line;
+        }
+        EXPECT_EQ(record["level"], "INFO");
+        EXPECT_TRUE(record["timestamp"].is_string());
+        parsed++;
+    }
+    ASSERT_EQ(parsed, 2);
+
+    std::vector<json> all = records();
+    EXPECT_EQ(all[0]["message"], "Analysis started");
+    EXPECT_EQ(all[0]["context_timestamp"], 1760000000);
+    EXPECT_EQ(all[0]["context_level"], "phase 1");
+    EXPECT_EQ(all[0]["mode"], "covariance");
+    EXPECT_EQ(all[1]["message"], "Macro");
+    EXPECT_EQ(all[1]["context_message"], "shadowed");
+}
+
+// ===== Asynchronous Backend Tests =====
+
+TEST_F(LoggerTest, AsyncWritesEverythingByStop) {
+    Logger::startAsync(1 << 16);
+    EXPECT_TRUE(Logger::isAsync());
+
+    const int producers = 4;
+    const int perProducer = 2000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([p]() {
+            for (int i = 0; i < perProducer; i++) {
+                Logger::info("tick", {{"producer", p}, {"i", i}});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logger::stopAsync();
+    EXPECT_FALSE(Logger::isAsync());
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), static_cast<size_t>(producers * perProducer));
+    EXPECT_EQ(Logger::droppedCount(), 0u);
+
+    // Each producer's records stay in order
+    std::map<int, int> last;
+    for (const auto& line : lines) {
+        int producer = line["producer"];
+        int i = line["i"];
+        auto it = last.find(producer);
+        if (it != last.end()) {
+            EXPECT_EQ(i, it->second + 1);
+        }
+        last[producer] = i;
+    }
+}
+
+TEST_F(LoggerTest, FlushWaitsForQueuedRecords) {
+    Logger::startAsync(64);
+    for (int i = 0; i < 10; i++) {
+        Logger::warn("queued", {{"i", i}});
+    }
+    Logger::flush();
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 10u);
+    EXPECT_EQ(lines[9]["i"], 9);
+    EXPECT_EQ(lines[9]["level"], "WARN");
+}
+
+TEST_F(LoggerTest, CriticalIsWrittenBeforeReturning) {
+    Logger::startAsync(64);
+    Logger::critical("fatal", std::runtime_error("boom"));
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0]["exception"], "boom");
+}
+
+/**
+ * Stream buffer that holds the drain thread inside its first write until
+ * released, so the ring can be filled deterministically
+ */
+class GatedBuffer : public std::stringbuf {
+public:
+    std::atomic<bool> entered{false};
+    std::atomic<bool> open{false};
+
+protected:
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        entered.store(true);
+        while (!open.load()) {
+            std::this_thread::yield();
+        }
+        return std::stringbuf::xsputn(s, n);
+    }
+};
+
+TEST_F(LoggerTest, OverflowDropsAndReports) {
+    GatedBuffer gated;
+    std::streambuf* previous = std::cout.rdbuf(&gated);
+
+    Logger::startAsync(4);
+    Logger::info("burst", {{"i", 0}});
+    while (!gated.entered.load()) {
+        std::this_thread::yield();
+    }
+
+    // Drainer is stuck writing record 0: four more fit, the rest are dropped
+    for (int i = 1; i <= 20; i++) {
+        Logger::info("burst", {{"i", i}});
+    }
+    EXPECT_EQ(Logger::droppedCount(), 16u);
+
+    gated.open.store(true);
+    Logger::stopAsync();
+    std::cout.rdbuf(previous);
+    captured_ << gated.str();
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 6u);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(lines[i]["message"], "burst");
+        EXPECT_EQ(lines[i]["i"], i);
+    }
+    EXPECT_EQ(lines[5]["message"], "Log records dropped");
+    EXPECT_EQ(lines[5]["level"], "WARN");
+    EXPECT_EQ(lines[5]["dropped"], 16);
+    EXPECT_EQ(lines[5]["capacity"], 4);
+}
+
+TEST_F(LoggerTest, SessionRestoresSyncOutput) {
+    {
+        AsyncLogSession session;
+        EXPECT_TRUE(Logger::isAsync());
+        Logger::info("inside");
+    }
+    EXPECT_FALSE(Logger::isAsync());
+    Logger::info("after");
+
+    {
+        AsyncLogSession disabled(false);
+        EXPECT_FALSE(Logger::isAsync());
+    }
+
+    std::vector<json> lines = records();
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0]["message"], "inside");
+    EXPECT_EQ(lines[1]["message"], "after");
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -10,8 +10,10 @@
 #include <gtest/gtest.h>
 #include "../src/DataProcessors/MacroFactorModel.hpp"
 #include "../src/DataProcessors/CovarianceCalculator.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
 
 class MacroFactorModelTest : public ::testing::Test {
 protected:
@@ -229,6 +231,70 @@ TEST_F(MacroFactorModelTest, StabilityTrackingAcrossWindows) {
     }
 }
 
+TEST_F(MacroFactorModelTest, ArchetypeMatrixMatchesArchetypeMap) {
+    auto surprises = createMockSurprises();
+    std::vector<std::string> names = computeTestCovariance(surprises).getIndicatorNames();
+
+    ArchetypeMatrix matrix = MacroFactorModel::buildArchetypeMatrix(names);
+    auto archetypes = MacroFactorModel::getEconomicArchetypes(names);
+
+    ASSERT_EQ(matrix.labels.size(), archetypes.size());
+    ASSERT_EQ(matrix.directions.rows(), 8);
+    EXPECT_TRUE(std::is_sorted(matrix.labels.begin(), matrix.labels.end()));
+    for (size_t a = 0; a < matrix.labels.size(); a++) {
+        EXPECT_NEAR(matrix.directions.col(a).norm(), 1.0, 1e-12);
+        EXPECT_TRUE(matrix.directions.col(a).isApprox(archetypes.at(matrix.labels[a])));
+    }
+
+    ArchetypeMatrix none = MacroFactorModel::buildArchetypeMatrix({"x", "y"});
+    EXPECT_TRUE(none.labels.empty());
+    EXPECT_EQ(none.directions.cols(), 0);
+    std::vector<LabelResult> unlabeled = MacroFactorModel::labelFactors(Eigen::MatrixXd::Ones(2, 2), none);
+    ASSERT_EQ(unlabeled.size(), 2u);
+    EXPECT_EQ(unlabeled[0].label, "Unclassified");
+}
+
+TEST_F(MacroFactorModelTest, BatchLabelsMatchPerFactorLabels) {
+    auto surprises = createMockSurprises();
+    MacroFactors result = MacroFactorModel::decomposeSurpriseCovariance(computeTestCovariance(surprises), 5);
+    ArchetypeMatrix matrix = MacroFactorModel::buildArchetypeMatrix(result.indicatorNames);
+
+    for (double threshold : {0.3, 0.65}) {
+        std::vector<LabelResult> batch = MacroFactorModel::labelFactors(result.loadings, matrix, threshold);
+        ASSERT_EQ(batch.size(), 5u);
+        for (int k = 0; k < 5; k++) {
+            LabelResult single = MacroFactorModel::labelFactorRobustly(
+                result.loadings.col(k), result.indicatorNames, LabelResult{"", 0.0, true, ""}, threshold);
+            EXPECT_EQ(batch[k].label, single.label);
+            EXPECT_NEAR(batch[k].cosineScore, single.cosineScore, 1e-12);
+            EXPECT_EQ(batch[k].isStable, single.isStable);
+        }
+    }
+}
+
+TEST_F(MacroFactorModelTest, RollingLabelsMatchSequentialRelabeling) {
+    auto surprises = createMockSurprises();
+    for (auto& [key, series] : surprises) {
+        for (int t = 0; series.size() < 36; t++) {
+            series.push_back(series.back() * 0.85 + 0.05 * std::sin(1.3 * t + key.size()));
+        }
+    }
+
+    std::vector<MacroFactors> windows = MacroFactorModel::rollingDecompositionWithDriftDetection(surprises, 12, 3);
+
+    // Reference: one labelFactorRobustly call per factor, chained through the previous label
+    LabelResult previous{"", 0.0, true, ""};
+    for (const MacroFactors& window : windows) {
+        for (int k = 0; k < 3; k++) {
+            LabelResult expected = MacroFactorModel::labelFactorRobustly(
+                window.loadings.col(k), window.indicatorNames, previous);
+            EXPECT_EQ(window.factorLabels[k], expected.label);
+            EXPECT_NEAR(window.labelConfidences[k], expected.cosineScore, 1e-12);
+            previous = expected;
+        }
+    }
+}
+
 // ===== Edge Cases and Error Handling =====
 
 TEST_F(MacroFactorModelTest, SingleFactorDecomposition) {
@@ -365,6 +431,123 @@ TEST_F(MacroFactorModelTest, IndicatorNamesPreserved) {
     EXPECT_EQ(result.indicatorNames, cov.getIndicatorNames());
 }
 
+// ===== Factor Score Tests =====
+
+TEST_F(MacroFactorModelTest, BartlettWeightsAreUnbiased) {
+    auto surprises = createMockSurprises();
+    MacroFactors result = MacroFactorModel::decomposeSurpriseCovariance(computeTestCovariance(surprises), 3);
+
+    Eigen::MatrixXd weights = MacroFactorModel::factorScoreWeights(
+        result.loadings, result.uniquenesses, FactorScoreMethod::Bartlett);
+
+    // Wᵀ B = I: a pure factor shock is recovered exactly
+    EXPECT_TRUE((weights.transpose() * result.loadings).isApprox(Eigen::MatrixXd::Identity(3, 3), 1e-8));
+}
+
+TEST_F(MacroFactorModelTest, RegressionWeightsMatchDirectInverse) {
+    auto surprises = createMockSurprises();
+    MacroFactors result = MacroFactorModel::decomposeSurpriseCovariance(computeTestCovariance(surprises), 2);
+
+    Eigen::MatrixXd implied = result.loadings * result.loadings.transpose();
+    implied.diagonal() += result.uniquenesses;
+    Eigen::MatrixXd direct = implied.ldlt().solve(result.loadings);
+
+    Eigen::MatrixXd weights = MacroFactorModel::factorScoreWeights(result.loadings, result.uniquenesses);
+    EXPECT_TRUE(weights.isApprox(direct, 1e-8));
+}
+
+TEST_F(MacroFactorModelTest, ComputeFactorScoresMatchesPerDateProjection) {
+    auto surprises = createMockSurprises();
+    MacroFactors result = MacroFactorModel::decomposeSurpriseCovariance(computeTestCovariance(surprises), 3);
+    MacroFactorModel::computeFactorScores(result, surprises, FactorScoreMethod::Bartlett);
+
+    ASSERT_EQ(result.factors.size(), 3u);
+    Eigen::MatrixXd weights = MacroFactorModel::factorScoreWeights(
+        result.loadings, result.uniquenesses, FactorScoreMethod::Bartlett);
+
+    for (size_t t = 0; t < 12; t++) {
+        Eigen::VectorXd x(8);
+        for (size_t i = 0; i < result.indicatorNames.size(); i++) {
+            const auto& series = surprises[result.indicatorNames[i]];
+            double mean = std::accumulate(series.begin(), series.end(), 0.0) / series.size();
+            x(i) = series[t] - mean;
+        }
+        Eigen::VectorXd expected = weights.transpose() * x;
+        for (int k = 0; k < 3; k++) {
+            ASSERT_EQ(result.factors[k].size(), 12);
+            EXPECT_NEAR(result.factors[k](t), expected(k), 1e-10);
+        }
+    }
+}
+
+TEST_F(MacroFactorModelTest, BartlettScoresReconstructExactFactorPanel) {
+    // x_t = B f_t exactly, with two latent factors
+    std::vector<std::string> names = {"a", "b", "c", "d", "e", "f"};
+    Eigen::MatrixXd trueLoadings(6, 2);
+    trueLoadings << 1.0, 0.2,  0.8, -0.5,  -0.3, 1.0,  0.5, 0.5,  0.1, -0.9,  0.7, 0.3;
+    std::map<std::string, std::vector<double>> surprises;
+    for (int i = 0; i < 6; i++) {
+        for (int t = 0; t < 40; t++) {
+            double f1 = std::sin(0.3 * t), f2 = std::cos(0.7 * t + 1.0);
+            surprises[names[i]].push_back(trueLoadings(i, 0) * f1 + trueLoadings(i, 1) * f2);
+        }
+    }
+
+    MacroFactors result = MacroFactorModel::decomposeSurpriseCovariance(computeTestCovariance(surprises), 2);
+    MacroFactorModel::computeFactorScores(result, surprises, FactorScoreMethod::Bartlett);
+
+    for (int i = 0; i < 6; i++) {
+        const auto& series = surprises[names[i]];
+        double mean = std::accumulate(series.begin(), series.end(), 0.0) / series.size();
+        for (int t = 0; t < 40; t++) {
+            double fitted = result.loadings(i, 0) * result.factors[0](t) + result.loadings(i, 1) * result.factors[1](t);
+            EXPECT_NEAR(fitted, series[t] - mean, 1e-8);
+        }
+    }
+}
+
+TEST_F(MacroFactorModelTest, RollingWindowScoresMatchStandaloneScoring) {
+    auto surprises = createMockSurprises();
+    for (auto& [key, series] : surprises) {
+        for (int t = 0; series.size() < 30; t++) {
+            series.push_back(series.back() * 0.9 + 0.03 * std::sin(t + key.size()));
+        }
+    }
+
+    std::vector<MacroFactors> windows = MacroFactorModel::rollingDecompositionWithDriftDetection(
+        surprises, 12, 2, 0.85, FactorScoreMethod::Regression);
+    ASSERT_EQ(windows.size(), 19u);
+
+    for (size_t w = 0; w < windows.size(); w += 6) {
+        std::map<std::string, std::vector<double>> windowData;
+        for (const auto& [ind, series] : surprises) {
+            windowData[ind] = std::vector<double>(series.begin() + w, series.begin() + w + 12);
+        }
+        MacroFactors standalone = windows[w];
+        MacroFactorModel::computeFactorScores(standalone, windowData);
+
+        for (int k = 0; k < 2; k++) {
+            ASSERT_EQ(windows[w].factors[k].size(), 12);
+            EXPECT_TRUE(windows[w].factors[k].isApprox(standalone.factors[k], 1e-9));
+        }
+    }
+}
+
+TEST_F(MacroFactorModelTest, FactorScoresRejectMismatchedInputs) {
+    auto surprises = createMockSurprises();
+    MacroFactors result = MacroFactorModel::decomposeSurpriseCovariance(computeTestCovariance(surprises), 2);
+
+    auto missing = surprises;
+    missing.erase("vix");
+    EXPECT_THROW(MacroFactorModel::computeFactorScores(result, missing), std::invalid_argument);
+
+    Eigen::VectorXd badUniquenesses = result.uniquenesses;
+    badUniquenesses(0) = 0.0;
+    EXPECT_THROW(MacroFactorModel::factorScoreWeights(result.loadings, badUniquenesses), std::invalid_argument);
+    EXPECT_THROW(MacroFactorModel::factorScoreWeights(result.loadings, Eigen::VectorXd::Ones(3)),
+                 std::invalid_argument);
+}
+
 // Run tests
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,178 @@
+//
+//  MetricsUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for scoped timers, counters and latency histograms
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Utils/Metrics.hpp"
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+
+class MetricsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Metrics::reset();
+    }
+};
+
+// ===== LatencyHistogram Tests =====
+
+TEST_F(MetricsTest, SmallValuesAreExact) {
+    for (uint64_t v = 0; v < LatencyHistogram::SUB_BUCKETS; v++) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(v), static_cast<int>(v));
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(static_cast<int>(v)), v);
+    }
+}
+
+TEST_F(MetricsTest, BucketsBoundRelativeError) {
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 100000; i++) {
+        uint64_t value = rng() >> (rng() % 64);
+        int index = LatencyHistogram::bucketIndex(value);
+        ASSERT_GE(index, 0);
+        ASSERT_LT(index, LatencyHistogram::NUM_BUCKETS);
+
+        uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        ASSERT_GE(upper, value);
+        ASSERT_LE(static_cast<double>(upper - value), value / 16.0 + 1.0);
+    }
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::NUM_BUCKETS - 1);
+
+    // Buckets are contiguous: each starts right after the previous one ends
+    for (int i = 1; i < LatencyHistogram::NUM_BUCKETS; i++) {
+        uint64_t start = LatencyHistogram::bucketUpperBound(i - 1) + 1;
+        EXPECT_EQ(LatencyHistogram::bucketIndex(start), i);
+    }
+}
+
+TEST_F(MetricsTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 10000; v++) {
+        histogram.record(v * 1000);  // 1 µs .. 10 ms uniform
+    }
+
+    EXPECT_EQ(histogram.count(), 10000u);
+    EXPECT_EQ(histogram.min(), 1000u);
+    EXPECT_EQ(histogram.max(), 10000000u);
+    EXPECT_NEAR(histogram.mean(), 5000500.0, 1e-6);
+
+    for (double q : {0.5, 0.9, 0.99}) {
+        double exact = q * 10000 * 1000;
+        EXPECT_GE(static_cast<double>(histogram.percentile(q)), exact);
+        EXPECT_LE(static_cast<double>(histogram.percentile(q)), exact * 1.0625);
+    }
+    EXPECT_EQ(histogram.percentile(1.0), histogram.max());
+}
+
+TEST_F(MetricsTest, EmptyHistogramAndReset) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+
+    histogram.record(42);
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+}
+
+// ===== Concurrency Tests =====
+
+TEST_F(MetricsTest, ConcurrentRecordingLosesNothing) {
+    LatencyHistogram& histogram = Metrics::histogram("test.concurrent");
+    Counter& counter = Metrics::counter("test.concurrent");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 10000; i++) {
+                histogram.record(static_cast<uint64_t>(t * 10000 + i));
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(histogram.count(), 80000u);
+    EXPECT_EQ(counter.value(), 80000u);
+    EXPECT_EQ(histogram.min(), 0u);
+    EXPECT_EQ(histogram.max(), 79999u);
+    EXPECT_EQ(histogram.sum(), 79999ull * 80000ull / 2);
+}
+
+// ===== Registry / Macro Tests =====
+
+TEST_F(MetricsTest, RegistryReturnsSameInstrument) {
+    EXPECT_EQ(&Metrics::histogram("stage.align"), &Metrics::histogram("stage.align"));
+    EXPECT_NE(&Metrics::histogram("stage.align"), &Metrics::histogram("stage.decompose"));
+    EXPECT_EQ(&Metrics::counter("http.requests"), &Metrics::counter("http.requests"));
+}
+
+TEST_F(MetricsTest, MacrosRecordIntoNamedInstruments) {
+    for (int i = 0; i < 3; i++) {
+        METRICS_SCOPED_TIMER("test.scoped");
+        METRICS_COUNT("test.count", 2);
+        METRICS_RECORD("test.values", 500);
+    }
+
+    {
+        METRICS_TIMER_START(stageTimer, "test.stage");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        METRICS_TIMER_STOP(stageTimer);
+        METRICS_TIMER_STOP(stageTimer);  // Second stop is a no-op
+    }
+
+    EXPECT_EQ(Metrics::histogram("test.scoped").count(), 3u);
+    EXPECT_EQ(Metrics::counter("test.count").value(), 6u);
+    EXPECT_EQ(Metrics::histogram("test.values").max(), 500u);
+    EXPECT_EQ(Metrics::histogram("test.stage").count(), 1u);
+    EXPECT_GE(Metrics::histogram("test.stage").min(), 2000000u);
+}
+
+TEST_F(MetricsTest, SummaryOnlyListsRecordedInstruments) {
+    Metrics::histogram("test.idle");
+    Metrics::histogram("test.busy").record(1500);
+    Metrics::counter("test.events").add(4);
+
+    json summary = Metrics::summary();
+    EXPECT_FALSE(summary["timers"].contains("test.idle"));
+    ASSERT_TRUE(summary["timers"].contains("test.busy"));
+    EXPECT_EQ(summary["timers"]["test.busy"]["count"], 1);
+    EXPECT_DOUBLE_EQ(summary["timers"]["test.busy"]["max_us"].get<double>(), 1.5);
+    EXPECT_EQ(summary["counters"]["test.events"], 4);
+}
+
+TEST_F(MetricsTest, ReportEmitsSingleLogRecord) {
+    Metrics::counter("test.report").add(7);
+
+    std::ostringstream captured;
+    std::streambuf* stdoutBuffer = std::cout.rdbuf(captured.rdbuf());
+    {
+        METRICS_REPORT_ON_EXIT({{"mode", "covariance"}});
+    }
+    std::cout.rdbuf(stdoutBuffer);
+
+    std::string output = captured.str();
+    ASSERT_EQ(std::count(output.begin(), output.end(), '\n'), 1);
+
+    json record = json::parse(output);
+    EXPECT_EQ(record["message"], "Run metrics");
+    EXPECT_EQ(record["mode"], "covariance");
+    EXPECT_EQ(record["counters"]["test.report"], 7);
+    EXPECT_TRUE(record.contains("elapsed_ms"));
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,182 @@
+//
+//  MonteCarloRiskUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the Monte Carlo VaR / ES engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/MonteCarloRisk.hpp"
+#include <cmath>
+
+class MonteCarloRiskTest : public ::testing::Test {
+protected:
+    // Two factors over four indicators with a non-diagonal residual covariance
+    static MacroFactors createFactorModel() {
+        MacroFactors factors;
+        factors.numFactors = 2;
+        factors.indicatorNames = {"fed_funds", "gdp", "inflation", "vix"};
+        factors.factorLabels = {"Growth", "Volatility"};
+        factors.factorVariances = {0.04, 0.09};
+        factors.loadings = Eigen::MatrixXd(4, 2);
+        factors.loadings << 0.2, 0.1,
+                            0.7, -0.1,
+                            0.3, 0.2,
+                           -0.2, 0.9;
+        factors.residualCovariance = Eigen::MatrixXd(4, 4);
+        factors.residualCovariance << 0.010, 0.002, 0.000, 0.000,
+                                      0.002, 0.008, 0.001, 0.000,
+                                      0.000, 0.001, 0.012, 0.003,
+                                      0.000, 0.000, 0.003, 0.020;
+        return factors;
+    }
+
+    static Eigen::VectorXd createSensitivities() {
+        Eigen::VectorXd beta(4);
+        beta << 0.1, 0.6, -0.2, -0.8;
+        return beta;
+    }
+
+    // Exact P&L volatility per unit notional: √(γᵀ Σ_f γ + βᵀ Σ_u β)
+    static double analyticVolatility(const Eigen::VectorXd& beta, const MacroFactors& factors) {
+        Eigen::VectorXd gamma = factors.loadings.transpose() * beta;
+        double variance = beta.dot(factors.residualCovariance * beta);
+        for (int k = 0; k < factors.numFactors; k++) {
+            variance += gamma(k) * gamma(k) * factors.factorVariances[k];
+        }
+        return std::sqrt(variance);
+    }
+};
+
+// ===== Generator Tests =====
+
+TEST_F(MonteCarloRiskTest, PhiloxMatchesKnownAnswers) {
+    // Random123 philox4x32-10 known-answer vectors
+    EXPECT_EQ(Philox4x32::generate({0u, 0u, 0u, 0u}, {0u, 0u}),
+              (Philox4x32::Counter{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    EXPECT_EQ(Philox4x32::generate({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu}),
+              (Philox4x32::Counter{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+}
+
+// ===== Gaussian Tests =====
+
+TEST_F(MonteCarloRiskTest, GaussianTailMatchesClosedForm) {
+    MacroFactors factors = createFactorModel();
+    Eigen::VectorXd beta = createSensitivities();
+    MonteCarloOptions options;
+    options.numPaths = 200000;
+    options.confidenceLevels = {0.99, 0.95};
+
+    MonteCarloRiskResult result = MonteCarloRisk::simulate(beta, factors, 1000000.0, options);
+    const double sigma = 1000000.0 * analyticVolatility(beta, factors);
+
+    ASSERT_EQ(result.valueAtRisk.size(), 2u);
+    EXPECT_EQ(result.confidenceLevels, options.confidenceLevels);     // Input order kept
+    EXPECT_NEAR(result.valueAtRisk[0], 2.326348 * sigma, 0.02 * 2.326348 * sigma);
+    EXPECT_NEAR(result.valueAtRisk[1], 1.644854 * sigma, 0.02 * 1.644854 * sigma);
+    EXPECT_NEAR(result.expectedShortfall[0], 2.665214 * sigma, 0.025 * 2.665214 * sigma);
+    EXPECT_NEAR(result.expectedShortfall[1], 2.062713 * sigma, 0.02 * 2.062713 * sigma);
+    EXPECT_NEAR(result.pnlVolatility, sigma, 0.01 * sigma);
+    EXPECT_NEAR(result.meanPnl, 0.0, 0.01 * sigma);
+    EXPECT_EQ(result.numPaths, 200000u);
+}
+
+TEST_F(MonteCarloRiskTest, ThreadCountDoesNotChangeResults) {
+    MacroFactors factors = createFactorModel();
+    Eigen::VectorXd beta = createSensitivities();
+    MonteCarloOptions options;
+    options.numPaths = 20011;
+    options.confidenceLevels = {0.9, 0.975, 0.999};
+    options.innovations = InnovationDistribution::StudentT;
+    options.regimes = {{0.7, 1.0}, {0.3, 2.0}};
+
+    options.numThreads = 1;
+    MonteCarloRiskResult serial = MonteCarloRisk::simulate(beta, factors, 1.0, options);
+    options.numThreads = 5;
+    MonteCarloRiskResult parallel = MonteCarloRisk::simulate(beta, factors, 1.0, options);
+
+    EXPECT_EQ(serial.valueAtRisk, parallel.valueAtRisk);
+    for (size_t i = 0; i < serial.expectedShortfall.size(); i++) {
+        EXPECT_NEAR(serial.expectedShortfall[i], parallel.expectedShortfall[i], 1e-12 * serial.expectedShortfall[i]);
+    }
+    EXPECT_NEAR(serial.meanPnl, parallel.meanPnl, 1e-12);
+
+    // A different seed is a different sample
+    options.seed = 99;
+    EXPECT_NE(MonteCarloRisk::simulate(beta, factors, 1.0, options).valueAtRisk, serial.valueAtRisk);
+}
+
+// ===== Fat Tail Tests =====
+
+TEST_F(MonteCarloRiskTest, StudentTKeepsVarianceAndFattensTail) {
+    MacroFactors factors = createFactorModel();
+    Eigen::VectorXd beta = createSensitivities();
+    MonteCarloOptions options;
+    options.numPaths = 200000;
+    options.confidenceLevels = {0.99};
+
+    MonteCarloRiskResult gaussian = MonteCarloRisk::simulate(beta, factors, 1.0, options);
+    options.innovations = InnovationDistribution::StudentT;
+    options.degreesOfFreedom = 6.0;
+    MonteCarloRiskResult studentT = MonteCarloRisk::simulate(beta, factors, 1.0, options);
+
+    const double sigma = analyticVolatility(beta, factors);
+    EXPECT_NEAR(studentT.pnlVolatility, sigma, 0.03 * sigma);
+    double gaussianRatio = gaussian.expectedShortfall[0] / gaussian.valueAtRisk[0];
+    double studentRatio = studentT.expectedShortfall[0] / studentT.valueAtRisk[0];
+    EXPECT_GT(studentRatio, gaussianRatio + 0.02);
+}
+
+TEST_F(MonteCarloRiskTest, RegimeMixtureScalesVariance) {
+    MacroFactors factors = createFactorModel();
+    Eigen::VectorXd beta = createSensitivities();
+    MonteCarloOptions options;
+    options.numPaths = 200000;
+    options.confidenceLevels = {0.99};
+
+    MonteCarloRiskResult calm = MonteCarloRisk::simulate(beta, factors, 1.0, options);
+    options.regimes = {{9.0, 1.0}, {1.0, 3.0}};      // Unnormalized: 90% calm, 10% stressed
+    MonteCarloRiskResult mixed = MonteCarloRisk::simulate(beta, factors, 1.0, options);
+
+    // Var = σ² (0.9 · 1 + 0.1 · 9)
+    const double sigma = analyticVolatility(beta, factors);
+    EXPECT_NEAR(mixed.pnlVolatility, std::sqrt(1.8) * sigma, 0.02 * sigma);
+    EXPECT_GT(mixed.valueAtRisk[0], 1.3 * calm.valueAtRisk[0]);
+}
+
+// ===== Error Handling =====
+
+TEST_F(MonteCarloRiskTest, RejectsInvalidInput) {
+    MacroFactors factors = createFactorModel();
+    Eigen::VectorXd beta = createSensitivities();
+
+    EXPECT_THROW(MonteCarloRisk::simulate(Eigen::VectorXd::Ones(3), factors, 1.0), std::invalid_argument);
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, NAN), std::invalid_argument);
+
+    MonteCarloOptions options;
+    options.numPaths = 0;
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, 1.0, options), std::invalid_argument);
+    options = MonteCarloOptions();
+    options.confidenceLevels = {0.95, 1.0};
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, 1.0, options), std::invalid_argument);
+    options = MonteCarloOptions();
+    options.innovations = InnovationDistribution::StudentT;
+    options.degreesOfFreedom = 2.0;
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, 1.0, options), std::invalid_argument);
+    options = MonteCarloOptions();
+    options.regimes = {{0.0, 1.0}};
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, 1.0, options), std::invalid_argument);
+    options.regimes = {{0.5, -1.0}};
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, 1.0, options), std::invalid_argument);
+
+    factors.factorVariances.pop_back();
+    EXPECT_THROW(MonteCarloRisk::simulate(beta, factors, 1.0), std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
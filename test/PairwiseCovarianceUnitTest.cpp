@@ -0,0 +1,181 @@
+//
+//  PairwiseCovarianceUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the pairwise-complete (masked) covariance kernel
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/PairwiseCovariance.hpp"
+#include <Eigen/Eigenvalues>
+#include <cmath>
+#include <random>
+
+class PairwiseCovarianceTest : public ::testing::Test {
+protected:
+    static std::map<std::string, std::vector<double>> randomPanel(int T, int N, uint64_t seed = 5) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        std::map<std::string, std::vector<double>> panel;
+        std::vector<double> common(T);
+        for (double& c : common) {
+            c = normal(rng);
+        }
+        for (int j = 0; j < N; j++) {
+            std::string name = "series_" + std::to_string(j);
+            for (int t = 0; t < T; t++) {
+                panel[name].push_back(100.0 + 0.7 * common[t] + normal(rng));   // Level offset tests the shift
+            }
+        }
+        return panel;
+    }
+
+    // Unbiased covariance over the dates where both series are observed
+    static double overlapCovariance(const std::vector<double>& x, const std::vector<double>& y) {
+        std::vector<double> a, b;
+        for (size_t t = 0; t < x.size(); t++) {
+            if (!std::isnan(x[t]) && !std::isnan(y[t])) {
+                a.push_back(x[t]);
+                b.push_back(y[t]);
+            }
+        }
+        double meanA = 0.0, meanB = 0.0;
+        for (size_t t = 0; t < a.size(); t++) {
+            meanA += a[t] / a.size();
+            meanB += b[t] / b.size();
+        }
+        double sum = 0.0;
+        for (size_t t = 0; t < a.size(); t++) {
+            sum += (a[t] - meanA) * (b[t] - meanB);
+        }
+        return sum / (a.size() - 1);
+    }
+};
+
+// ===== Validity Mask Tests =====
+
+TEST_F(PairwiseCovarianceTest, MaskCountsAcrossWordBoundaries) {
+    ValidityMask mask(150, 2);
+    for (size_t t = 0; t < 150; t++) {
+        if (t % 2 == 0) mask.set(t, 0);
+        if (t % 3 == 0) mask.set(t, 1);
+    }
+    EXPECT_EQ(mask.count(0), 75u);
+    EXPECT_EQ(mask.count(1), 50u);
+    EXPECT_EQ(mask.overlap(0, 1), 25u);     // Multiples of 6
+    EXPECT_TRUE(mask.test(126, 0));
+    EXPECT_FALSE(mask.test(127, 0));
+}
+
+// ===== Estimator Tests =====
+
+TEST_F(PairwiseCovarianceTest, CompleteDataMatchesSampleCovariance) {
+    auto panel = randomPanel(60, 6);
+    CovarianceCalculator calculator;
+    PairwiseCovarianceDiagnostics diagnostics;
+
+    CovarianceMatrix pairwise = PairwiseCovariance::compute(panel, PairwiseCovarianceOptions(), &diagnostics);
+    CovarianceMatrix sample = calculator.calculateCovarianceMatrix(panel);
+
+    EXPECT_EQ(pairwise.getIndicatorNames(), sample.getIndicatorNames());
+    EXPECT_TRUE(pairwise.getMatrix().isApprox(sample.getMatrix(), 1e-10));
+    EXPECT_FALSE(diagnostics.repaired);
+    EXPECT_EQ(diagnostics.pairObservations.minCoeff(), 60);
+    EXPECT_GT(diagnostics.minEigenvalue, 0.0);
+}
+
+TEST_F(PairwiseCovarianceTest, RaggedStartsUseEachPairsOverlap) {
+    auto panel = randomPanel(90, 4, 17);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::fill(panel["series_1"].begin(), panel["series_1"].begin() + 30, nan);    // Late start
+    std::fill(panel["series_2"].begin(), panel["series_2"].begin() + 70, nan);    // Very late start
+    panel["series_3"][45] = nan;                                                  // FRED "." gap
+    panel["series_3"][46] = nan;
+
+    PairwiseCovarianceOptions options;
+    options.repairPsd = false;
+    PairwiseCovarianceDiagnostics diagnostics;
+    CovarianceMatrix result = PairwiseCovariance::compute(panel, options, &diagnostics);
+
+    auto names = result.getIndicatorNames();
+    for (size_t i = 0; i < names.size(); i++) {
+        for (size_t j = 0; j < names.size(); j++) {
+            EXPECT_NEAR(result.getMatrix()(i, j), overlapCovariance(panel[names[i]], panel[names[j]]), 1e-10)
+                << names[i] << " / " << names[j];
+        }
+    }
+    EXPECT_EQ(diagnostics.pairObservations(0, 0), 90);
+    EXPECT_EQ(diagnostics.pairObservations(1, 2), 20);
+    EXPECT_EQ(diagnostics.pairObservations(0, 3), 88);
+}
+
+// ===== PSD Repair Tests =====
+
+TEST_F(PairwiseCovarianceTest, RepairRestoresPsdAndVariances) {
+    Eigen::Matrix3d indefinite;
+    indefinite << 1.0,  0.9, -0.9,
+                  0.9,  2.0,  0.9,
+                 -0.9,  0.9,  1.5;
+    ASSERT_LT(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(indefinite).eigenvalues().minCoeff(), 0.0);
+
+    Eigen::MatrixXd repaired = PairwiseCovariance::repairPsd(indefinite);
+    EXPECT_GE(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(repaired).eigenvalues().minCoeff(), -1e-12);
+    EXPECT_TRUE(repaired.diagonal().isApprox(indefinite.diagonal(), 1e-12));
+    EXPECT_TRUE(repaired.isApprox(repaired.transpose()));
+
+    // Already PSD: unchanged
+    Eigen::Matrix2d psd;
+    psd << 2.0, 0.5, 0.5, 1.0;
+    EXPECT_TRUE(PairwiseCovariance::repairPsd(psd).isApprox(psd, 1e-12));
+}
+
+TEST_F(PairwiseCovarianceTest, SparsePanelsComeOutPsd) {
+    std::mt19937_64 rng(23);
+    std::bernoulli_distribution missing(0.4);
+    int repairs = 0;
+
+    for (uint64_t trial = 0; trial < 40; trial++) {
+        auto panel = randomPanel(30, 7, trial);
+        for (auto& [name, series] : panel) {
+            for (double& value : series) {
+                if (missing(rng)) value = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+        PairwiseCovarianceDiagnostics diagnostics;
+        CovarianceMatrix result = PairwiseCovariance::compute(panel, PairwiseCovarianceOptions(), &diagnostics);
+        double scale = result.getMatrix().diagonal().mean();
+        EXPECT_GE(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(result.getMatrix()).eigenvalues().minCoeff(),
+                  -1e-9 * scale);
+        repairs += diagnostics.repaired ? 1 : 0;
+    }
+    EXPECT_GT(repairs, 0);  // Sparse pairwise estimates are regularly indefinite
+}
+
+// ===== Error Handling =====
+
+TEST_F(PairwiseCovarianceTest, RejectsUnusableInput) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_THROW(PairwiseCovariance::compute({}), std::invalid_argument);
+    EXPECT_THROW(PairwiseCovariance::compute({{"a", {1, 2, 3}}, {"b", {1, 2}}}), std::invalid_argument);
+    EXPECT_THROW(PairwiseCovariance::compute({{"a", {1, INFINITY, 3}}, {"b", {1, 2, 3}}}), std::invalid_argument);
+
+    // Disjoint histories: no overlap to estimate from
+    EXPECT_THROW(PairwiseCovariance::compute({{"a", {1, 2, 3, nan, nan, nan}}, {"b", {nan, nan, nan, 4, 5, 7}}}),
+                 std::invalid_argument);
+
+    PairwiseCovarianceOptions options;
+    options.minPairObservations = 4;
+    EXPECT_THROW(PairwiseCovariance::compute({{"a", {1, 2, 3, 5}}, {"b", {nan, 2, 3, 1}}}, options),
+                 std::invalid_argument);
+    options.minPairObservations = 1;
+    EXPECT_THROW(PairwiseCovariance::compute({{"a", {1, 2}}}, options), std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,217 @@
+//
+//  ParameterSweepUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the parallel hyperparameter sweep
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Backtest/ParameterSweep.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <cmath>
+
+class ParameterSweepTest : public ::testing::Test {
+protected:
+    static std::string root;
+
+    // 10 years × 12 months × 21 trading days of synthetic history, written once
+    static void SetUpTestSuite() {
+        root = (std::filesystem::temp_directory_path() /
+                ("parameter_sweep_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+        std::filesystem::remove_all(root);
+
+        std::mt19937 rng(7);
+        std::normal_distribution<double> noise(0.0, 1.0);
+
+        std::vector<int32_t> days, months;
+        for (int year = 2010; year < 2020; year++) {
+            for (int month = 1; month <= 12; month++) {
+                months.push_back(year * 10000 + month * 100 + 1);
+                for (int day = 1; day <= 21; day++) {
+                    days.push_back(year * 10000 + month * 100 + day);
+                }
+            }
+        }
+
+        std::vector<double> returns, vix;
+        double vixLevel = 18.0;
+        for (size_t i = 0; i < days.size(); i++) {
+            vixLevel = std::clamp(vixLevel + 0.8 * noise(rng) + 0.02 * (18.0 - vixLevel), 9.0, 80.0);
+            vix.push_back(vixLevel);
+            returns.push_back(0.0003 + 0.01 * noise(rng));
+        }
+        HistoryStore::writeSeries(root, "es_returns", days, returns);
+        HistoryStore::writeSeries(root, "vix", days, vix);
+
+        for (const std::string name : {"fed_funds", "gdp", "inflation", "unemployment"}) {
+            std::vector<double> levels;
+            double level = 5.0;
+            for (size_t m = 0; m < months.size(); m++) {
+                level += 0.1 * noise(rng);
+                levels.push_back(level);
+            }
+            HistoryStore::writeSeries(root, name, months, levels);
+        }
+    }
+
+    static void TearDownTestSuite() {
+        std::filesystem::remove_all(root);
+    }
+
+    static BacktestConfig createConfig() {
+        BacktestConfig config;
+        config.indicators = {"unemployment", "gdp", "inflation", "fed_funds"};
+        config.indicatorBetas = {{"gdp", 0.6}, {"unemployment", -0.5}, {"inflation", -0.2}, {"fed_funds", 0.3}};
+        return config;
+    }
+};
+
+std::string ParameterSweepTest::root;
+
+// ===== Point Generation Tests =====
+
+TEST_F(ParameterSweepTest, GridIsCartesianProduct) {
+    SweepGrid grid;
+    grid.windowMonths = {6, 12, 24};
+    grid.numFactors = {2, 3};
+    grid.vixWeights = {0.2, 0.4};
+
+    auto points = ParameterSweep::expandGrid(grid);
+    ASSERT_EQ(points.size(), 3u * 2u * 2u);
+    EXPECT_EQ(points.front().windowMonths, 6);
+    EXPECT_EQ(points.back().windowMonths, 24);
+    EXPECT_DOUBLE_EQ(points.front().labelThreshold, MacroFactorModel::DEFAULT_LABEL_THRESHOLD);
+    EXPECT_DOUBLE_EQ(points.front().moveWeight, PositionSizer::defaultRegimeWeights().move);
+}
+
+TEST_F(ParameterSweepTest, RandomSamplesStayInRangeAndAreSeeded) {
+    SweepRanges ranges;
+    auto first = ParameterSweep::sampleRandom(ranges, 200, 11);
+    auto second = ParameterSweep::sampleRandom(ranges, 200, 11);
+    auto other = ParameterSweep::sampleRandom(ranges, 200, 12);
+
+    ASSERT_EQ(first.size(), 200u);
+    bool differs = false;
+    for (size_t i = 0; i < first.size(); i++) {
+        EXPECT_GE(first[i].windowMonths, ranges.minWindowMonths);
+        EXPECT_LE(first[i].windowMonths, ranges.maxWindowMonths);
+        EXPECT_GE(first[i].numFactors, ranges.minNumFactors);
+        EXPECT_LE(first[i].numFactors, ranges.maxNumFactors);
+        EXPECT_GE(first[i].labelThreshold, ranges.minLabelThreshold);
+        EXPECT_LE(first[i].labelThreshold, ranges.maxLabelThreshold);
+        EXPECT_GE(first[i].vixWeight, ranges.minVixWeight);
+        EXPECT_LE(first[i].vixWeight, ranges.maxVixWeight);
+
+        EXPECT_EQ(first[i].windowMonths, second[i].windowMonths);
+        EXPECT_DOUBLE_EQ(first[i].vixWeight, second[i].vixWeight);
+        differs |= first[i].vixWeight != other[i].vixWeight;
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST_F(ParameterSweepTest, ParsesJsonSpec) {
+    auto grid = ParameterSweep::fromSpec(json::parse(R"({"windowMonths": [6, 12], "labelThreshold": 0.7})"));
+    ASSERT_EQ(grid.size(), 2u);
+    EXPECT_DOUBLE_EQ(grid[1].labelThreshold, 0.7);
+
+    auto random = ParameterSweep::fromSpec(json::parse(
+        R"({"random": {"samples": 25, "seed": 3, "windowMonths": [10, 14]}})"));
+    ASSERT_EQ(random.size(), 25u);
+    for (const auto& point : random) {
+        EXPECT_GE(point.windowMonths, 10);
+        EXPECT_LE(point.windowMonths, 14);
+    }
+
+    EXPECT_THROW(ParameterSweep::fromSpec(json::parse(R"({"lookback": [3, 6]})")), std::invalid_argument);
+    EXPECT_THROW(ParameterSweep::fromSpec(json::parse(R"({"windowMonths": []})")), std::invalid_argument);
+    EXPECT_THROW(ParameterSweep::fromSpec(json::parse(R"({"random": {"vixWeight": [0.5, 0.1]}})")),
+                 std::invalid_argument);
+}
+
+// ===== Run Tests =====
+
+TEST_F(ParameterSweepTest, ParallelMatchesSerialAndIndividualRuns) {
+    HistoryStore store(root);
+    SweepGrid grid;
+    grid.windowMonths = {6, 12};
+    grid.numFactors = {2, 3};
+    grid.vixWeights = {0.2, 0.6};
+    auto points = ParameterSweep::expandGrid(grid);
+
+    auto serial = ParameterSweep::run(store, createConfig(), points, 1);
+    auto parallel = ParameterSweep::run(store, createConfig(), points, 4);
+
+    ASSERT_EQ(serial.size(), points.size());
+    ASSERT_EQ(parallel.size(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_TRUE(parallel[i].error.empty()) << parallel[i].error;
+        EXPECT_EQ(parallel[i].parameters.windowMonths, points[i].windowMonths);
+        EXPECT_DOUBLE_EQ(parallel[i].totalReturn, serial[i].totalReturn);
+        EXPECT_DOUBLE_EQ(parallel[i].sharpeRatio, serial[i].sharpeRatio);
+        EXPECT_EQ(parallel[i].factorRefits, serial[i].factorRefits);
+    }
+
+    // Row 0 is the same as a standalone backtest with the point applied
+    BacktestConfig config = ParameterSweep::applyParameters(createConfig(), points[0]);
+    BacktestResult direct = BacktestEngine(store, config).run();
+    EXPECT_DOUBLE_EQ(parallel[0].totalReturn, direct.totalReturn);
+    EXPECT_EQ(parallel[0].regimeChanges, direct.regimeChanges);
+
+    // A shorter window refits more often over the same history
+    EXPECT_GT(parallel[0].factorRefits, parallel[points.size() - 1].factorRefits);
+}
+
+TEST_F(ParameterSweepTest, VaryingWeightsChangesOutcome) {
+    HistoryStore store(root);
+    SweepGrid grid;
+    grid.vixWeights = {0.1, 0.7};
+    auto results = ParameterSweep::run(store, createConfig(), ParameterSweep::expandGrid(grid), 2);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_NE(results[0].totalReturn, results[1].totalReturn);
+}
+
+TEST_F(ParameterSweepTest, InvalidPointRecordsErrorWithoutStoppingSweep) {
+    HistoryStore store(root);
+    std::vector<SweepParameters> points = {
+        {12, 3, 0.65, 0.4, 0.25},
+        {12, 9, 0.65, 0.4, 0.25},   // More factors than indicators
+    };
+
+    auto results = ParameterSweep::run(store, createConfig(), points, 2);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].error.empty());
+    EXPECT_GT(results[0].factorRefits, 0);
+    EXPECT_FALSE(results[1].error.empty());
+}
+
+TEST_F(ParameterSweepTest, WritesResultsTable) {
+    HistoryStore store(root);
+    std::vector<SweepParameters> points = {{12, 3, 0.65, 0.4, 0.25}, {12, 9, 0.65, 0.4, 0.25}};
+    auto results = ParameterSweep::run(store, createConfig(), points, 1);
+
+    std::string path = root + "_sweep.csv";
+    ParameterSweep::writeResultsCsv(results, path);
+
+    std::ifstream csv(path);
+    std::string header, first, second, extra;
+    std::getline(csv, header);
+    std::getline(csv, first);
+    std::getline(csv, second);
+    EXPECT_EQ(header.rfind("window_months,num_factors,label_threshold", 0), 0u);
+    EXPECT_EQ(first.rfind("12,3,", 0), 0u);
+    EXPECT_NE(second.find('"'), std::string::npos);
+    EXPECT_FALSE(std::getline(csv, extra));
+
+    std::filesystem::remove(path);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
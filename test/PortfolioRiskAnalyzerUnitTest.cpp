@@ -12,6 +12,7 @@
 #include "../src/DataProcessors/CovarianceCalculator.hpp"
 #include <cmath>
 #include <numeric>
+#include <random>
 
 class PortfolioRiskAnalyzerTest : public ::testing::Test {
 protected:
@@ -64,6 +65,32 @@ protected:
         beta(7) = -0.7;  // MOVE: negative
         return beta;
     }
+
+    // T days of K factor shocks with r_t = γᵀ f_t + noise
+    static std::pair<Eigen::VectorXd, Eigen::MatrixXd> drawdownSample(int T, int K, uint64_t seed = 11) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        Eigen::MatrixXd shocks(T, K);
+        Eigen::VectorXd returns(T);
+        for (int t = 0; t < T; t++) {
+            for (int k = 0; k < K; k++) {
+                shocks(t, k) = 0.01 * normal(rng);
+            }
+            returns(t) = 0.002 * normal(rng) - 0.0005;
+            for (int k = 0; k < K; k++) {
+                returns(t) += (0.5 - 0.3 * k) * shocks(t, k);
+            }
+        }
+        return {returns, shocks};
+    }
+
+    static std::vector<std::string> drawdownLabels(int K) {
+        std::vector<std::string> labels;
+        for (int k = 0; k < K; k++) {
+            labels.push_back("Factor_" + std::to_string(k));
+        }
+        return labels;
+    }
 };
 
 // ===== Basic Risk Attribution Tests =====
@@ -325,6 +352,131 @@ TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetingDifferentTargets) {
                alloc2.componentContributions[0], 0.1);
 }
 
+TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetingFullCovarianceEqualContributions) {
+    // Strongly correlated factors: inverse volatility is no longer ERC
+    Eigen::Matrix4d covariance;
+    covariance << 0.040, 0.018, -0.006, 0.010,
+                  0.018, 0.025,  0.004, 0.008,
+                 -0.006, 0.004,  0.090, 0.030,
+                  0.010, 0.008,  0.030, 0.016;
+    std::vector<std::string> labels = {"Growth", "Inflation", "Volatility", "Policy"};
+
+    RiskDecomposition allocation = PortfolioRiskAnalyzer::riskBudgetingAllocation(
+        0.12, covariance, Eigen::Vector4d::Ones(), labels);
+
+    EXPECT_NEAR(allocation.totalRisk, 0.12, 1e-12);
+    for (int k = 0; k < 4; k++) {
+        EXPECT_GT(allocation.factorSensitivities[k], 0.0);
+        EXPECT_NEAR(allocation.componentContributions[k], 0.25, 1e-9);
+        EXPECT_NEAR(allocation.factorRiskContributions[k], 0.25 * allocation.totalVariance, 1e-12);
+    }
+
+    // Inverse-volatility weights miss the equal split on this Σ_f
+    Eigen::Vector4d inverseVol = covariance.diagonal().array().rsqrt();
+    Eigen::Vector4d shares = inverseVol.cwiseProduct(covariance * inverseVol) / inverseVol.dot(covariance * inverseVol);
+    EXPECT_GT((shares.array() - 0.25).abs().maxCoeff(), 0.05);
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetingArbitraryBudgetsAndDiagonalCase) {
+    Eigen::MatrixXd covariance = 0.02 * Eigen::MatrixXd::Identity(5, 5) + Eigen::MatrixXd::Constant(5, 5, 0.01);
+    Eigen::VectorXd budgets(5);
+    budgets << 4.0, 3.0, 1.5, 1.0, 0.5;      // Normalized to 0.40, 0.30, 0.15, 0.10, 0.05
+
+    RiskBudgetSolution solution = PortfolioRiskAnalyzer::solveRiskBudget(covariance, budgets);
+    ASSERT_TRUE(solution.converged);
+    EXPECT_NEAR(solution.weights.sum(), 1.0, 1e-14);
+    EXPECT_TRUE(solution.riskContributions.isApprox(budgets / budgets.sum(), 1e-9));
+    EXPECT_LE(solution.budgetError, 1e-10);
+
+    // Diagonal Σ_f with equal budgets reproduces the inverse-volatility allocation
+    auto factors = createMockFactorModel();
+    Eigen::Matrix3d diagonal = Eigen::Vector3d(0.40, 0.25, 0.15).asDiagonal();
+    RiskDecomposition legacy = PortfolioRiskAnalyzer::riskBudgetingAllocation(0.15, factors);
+    RiskDecomposition solved = PortfolioRiskAnalyzer::riskBudgetingAllocation(
+        0.15, diagonal, Eigen::Vector3d::Ones(), factors.factorLabels);
+    for (int k = 0; k < 3; k++) {
+        EXPECT_NEAR(solved.factorSensitivities[k], legacy.factorSensitivities[k], 1e-10);
+    }
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetingUnequalBudgetsStayPositive) {
+    // Lognormal budgets and volatilities on a full correlated Σ: tiny budgets
+    // used to push the damped Newton step through y_i = 0
+    std::mt19937_64 rng(17);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto check = [](const Eigen::MatrixXd& covariance, const Eigen::VectorXd& budgets, int trial) {
+        RiskBudgetSolution solution = PortfolioRiskAnalyzer::solveRiskBudget(covariance, budgets);
+        ASSERT_TRUE(solution.converged) << "trial " << trial;
+        EXPECT_GT(solution.weights.minCoeff(), 0.0) << "trial " << trial;
+        EXPECT_NEAR(solution.weights.sum(), 1.0, 1e-12) << "trial " << trial;
+        EXPECT_TRUE(solution.riskContributions.isApprox(budgets / budgets.sum(), 1e-8)) << "trial " << trial;
+    };
+
+    for (int trial = 0; trial < 200; trial++) {
+        const int n = 2 + trial % 15;
+        Eigen::MatrixXd loadings(n, n);
+        Eigen::VectorXd budgets(n);
+        Eigen::VectorXd vols(n);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                loadings(i, j) = normal(rng);
+            }
+            budgets(i) = std::exp(1.5 * normal(rng));
+            vols(i) = std::exp(normal(rng));
+        }
+        Eigen::MatrixXd correlation = loadings * loadings.transpose() + 0.05 * n * Eigen::MatrixXd::Identity(n, n);
+        const Eigen::VectorXd scale = correlation.diagonal().array().rsqrt();
+        correlation = scale.asDiagonal() * correlation * scale.asDiagonal();
+        check(vols.asDiagonal() * correlation * vols.asDiagonal(), budgets, trial);
+    }
+
+    // One dominant budget against many small ones
+    const int n = 12;
+    Eigen::MatrixXd covariance = 0.02 * Eigen::MatrixXd::Identity(n, n) + Eigen::MatrixXd::Constant(n, n, 0.015);
+    covariance(0, 1) = covariance(1, 0) = -0.01;
+    Eigen::VectorXd budgets = Eigen::VectorXd::Ones(n);
+    budgets(0) = 5.0;
+    check(covariance, budgets, -1);
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetingWarmStartConvergesFaster) {
+    std::mt19937_64 rng(5);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const int n = 30;
+    Eigen::MatrixXd loadings(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            loadings(i, j) = normal(rng);
+        }
+    }
+    Eigen::MatrixXd today = loadings * loadings.transpose() / n + 0.2 * Eigen::MatrixXd::Identity(n, n);
+    Eigen::VectorXd budgets = Eigen::VectorXd::LinSpaced(n, 1.0, 3.0);
+
+    // Tomorrow's Σ moves by about 1%
+    Eigen::MatrixXd drift(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            drift(i, j) = normal(rng);
+        }
+    }
+    Eigen::MatrixXd tomorrow = today + 0.01 * (drift * drift.transpose()) / n;
+
+    RiskBudgetSolution yesterday = PortfolioRiskAnalyzer::solveRiskBudget(today, budgets);
+    RiskBudgetSolution cold = PortfolioRiskAnalyzer::solveRiskBudget(tomorrow, budgets);
+    RiskBudgetSolution warm = PortfolioRiskAnalyzer::solveRiskBudget(tomorrow, budgets, yesterday.weights);
+
+    ASSERT_TRUE(cold.converged);
+    ASSERT_TRUE(warm.converged);
+    EXPECT_LT(warm.iterations, cold.iterations);
+    EXPECT_LE(warm.iterations, 3);
+    EXPECT_TRUE(warm.weights.isApprox(cold.weights, 1e-8));
+
+    // An iteration cap reports non-convergence instead of throwing
+    RiskBudgetOptions capped;
+    capped.maxIterations = 1;
+    EXPECT_FALSE(PortfolioRiskAnalyzer::solveRiskBudget(tomorrow, budgets, Eigen::VectorXd(), capped).converged);
+}
+
 // ===== Error Handling Tests =====
 
 TEST_F(PortfolioRiskAnalyzerTest, AnalyzeRiskMismatchedSizes) {
@@ -370,6 +522,20 @@ TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetingNegativeTarget) {
     );
 }
 
+TEST_F(PortfolioRiskAnalyzerTest, RiskBudgetSolverRejectsInvalidInput) {
+    Eigen::Matrix2d covariance;
+    covariance << 0.04, 0.01, 0.01, 0.02;
+    EXPECT_THROW(PortfolioRiskAnalyzer::solveRiskBudget(covariance, Eigen::Vector3d::Ones()), std::invalid_argument);
+    EXPECT_THROW(PortfolioRiskAnalyzer::solveRiskBudget(covariance, Eigen::Vector2d(1.0, 0.0)), std::invalid_argument);
+    EXPECT_THROW(PortfolioRiskAnalyzer::solveRiskBudget(covariance, Eigen::Vector2d::Ones(), Eigen::Vector3d::Ones()),
+                 std::invalid_argument);
+    Eigen::Matrix2d degenerate = covariance;
+    degenerate(1, 1) = 0.0;
+    EXPECT_THROW(PortfolioRiskAnalyzer::solveRiskBudget(degenerate, Eigen::Vector2d::Ones()), std::invalid_argument);
+    EXPECT_THROW(PortfolioRiskAnalyzer::riskBudgetingAllocation(0.1, covariance, Eigen::Vector2d::Ones(), {"Growth"}),
+                 std::invalid_argument);
+}
+
 TEST_F(PortfolioRiskAnalyzerTest, RollingEmptyFactors) {
     auto beta = createPortfolioSensitivities();
     std::vector<MacroFactors> empty;
@@ -380,6 +546,208 @@ TEST_F(PortfolioRiskAnalyzerTest, RollingEmptyFactors) {
     );
 }
 
+// ===== Batch Risk Tests =====
+
+TEST_F(PortfolioRiskAnalyzerTest, BatchMatchesPerPortfolioAnalysis) {
+    MacroFactors factors = createMockFactorModel();
+    Eigen::MatrixXd books(8, 5);
+    books.col(0) = createPortfolioSensitivities();
+    books.col(1) = -createPortfolioSensitivities();
+    books.col(2) = Eigen::VectorXd::Zero(8);
+    books.col(3) = Eigen::VectorXd::LinSpaced(8, -1.0, 1.0);
+    books.col(4) = Eigen::VectorXd::Ones(8);
+
+    BatchRiskDecomposition batch;
+    PortfolioRiskAnalyzer::analyzeRiskBatch(books, factors, batch);
+
+    ASSERT_EQ(batch.factorSensitivities.rows(), 3);
+    ASSERT_EQ(batch.factorSensitivities.cols(), 5);
+    for (int p = 0; p < 5; p++) {
+        RiskDecomposition single = PortfolioRiskAnalyzer::analyzeRisk(books.col(p), factors);
+        EXPECT_NEAR(batch.totalVariance(p), single.totalVariance, 1e-12);
+        EXPECT_NEAR(batch.totalRisk(p), single.totalRisk, 1e-12);
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(batch.factorSensitivities(k, p), single.factorSensitivities[k], 1e-12);
+            EXPECT_NEAR(batch.factorRiskContributions(k, p), single.factorRiskContributions[k], 1e-12);
+            EXPECT_NEAR(batch.marginalRiskContributions(k, p), single.marginalRiskContributions[k], 1e-12);
+            EXPECT_NEAR(batch.componentContributions(k, p), single.componentContributions[k], 1e-12);
+        }
+    }
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, BatchResidualVarianceIsQuadraticForm) {
+    MacroFactors factors = createMockFactorModel();
+    Eigen::MatrixXd noise = Eigen::MatrixXd::Random(8, 8);
+    factors.residualCovariance = noise * noise.transpose() * 0.01;
+    Eigen::MatrixXd books = Eigen::MatrixXd::Random(8, 4);
+
+    BatchRiskDecomposition batch;
+    PortfolioRiskAnalyzer::analyzeRiskBatch(books, factors, batch);
+    for (int p = 0; p < 4; p++) {
+        EXPECT_NEAR(batch.residualVariance(p), books.col(p).dot(factors.residualCovariance * books.col(p)), 1e-12);
+    }
+
+    // Wide-panel decompositions carry only Ψ = diag(Σ_u)
+    factors.residualCovariance.resize(0, 0);
+    factors.uniquenesses = Eigen::VectorXd::Constant(8, 0.02);
+    PortfolioRiskAnalyzer::analyzeRiskBatch(books, factors, batch);
+    for (int p = 0; p < 4; p++) {
+        EXPECT_NEAR(batch.residualVariance(p), 0.02 * books.col(p).squaredNorm(), 1e-12);
+    }
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, BatchReusesPreallocatedStorage) {
+    MacroFactors factors = createMockFactorModel();
+    Eigen::MatrixXd books = Eigen::MatrixXd::Random(8, 64);
+
+    BatchRiskDecomposition batch;
+    PortfolioRiskAnalyzer::analyzeRiskBatch(books, factors, batch);
+    const double* sensitivities = batch.factorSensitivities.data();
+    const double* variances = batch.totalVariance.data();
+
+    books = Eigen::MatrixXd::Random(8, 64);
+    PortfolioRiskAnalyzer::analyzeRiskBatch(books, factors, batch);
+    EXPECT_EQ(batch.factorSensitivities.data(), sensitivities);
+    EXPECT_EQ(batch.totalVariance.data(), variances);
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, BatchMismatchedSizesThrows) {
+    MacroFactors factors = createMockFactorModel();
+    BatchRiskDecomposition batch;
+    EXPECT_THROW(PortfolioRiskAnalyzer::analyzeRiskBatch(Eigen::MatrixXd::Ones(7, 3), factors, batch),
+                 std::invalid_argument);
+    factors.factorVariances.pop_back();
+    EXPECT_THROW(PortfolioRiskAnalyzer::analyzeRiskBatch(Eigen::MatrixXd::Ones(8, 3), factors, batch),
+                 std::invalid_argument);
+}
+
+// ===== Drawdown Regression Tests =====
+
+TEST_F(PortfolioRiskAnalyzerTest, DrawdownMatrixOverloadMatchesLeastSquares) {
+    auto [returns, shocks] = drawdownSample(250, 4);
+    RiskDecomposition decomp = PortfolioRiskAnalyzer::explainHistoricalDrawdown(returns, shocks, drawdownLabels(4));
+
+    Eigen::VectorXd gamma = shocks.colPivHouseholderQr().solve(returns);
+    Eigen::VectorXd residuals = returns - shocks * gamma;
+    double ssTot = (returns.array() - returns.mean()).square().sum();
+    for (int k = 0; k < 4; k++) {
+        EXPECT_NEAR(decomp.factorSensitivities[k], gamma(k), 1e-6);
+    }
+    EXPECT_NEAR(decomp.varianceExplained, 1.0 - residuals.squaredNorm() / ssTot, 1e-8);
+    EXPECT_NEAR(decomp.totalVariance, ssTot / 250.0, 1e-14);
+    EXPECT_NEAR(decomp.residualRisk, std::sqrt(residuals.squaredNorm() / 250.0), 1e-8);
+
+    // Row-vector overload is the same computation
+    std::vector<double> returnVector(returns.data(), returns.data() + returns.size());
+    std::vector<std::vector<double>> shockRows(250, std::vector<double>(4));
+    for (int t = 0; t < 250; t++) {
+        for (int k = 0; k < 4; k++) {
+            shockRows[t][k] = shocks(t, k);
+        }
+    }
+    RiskDecomposition fromRows = PortfolioRiskAnalyzer::explainHistoricalDrawdown(returnVector, shockRows, drawdownLabels(4));
+    EXPECT_EQ(fromRows.factorSensitivities, decomp.factorSensitivities);
+    EXPECT_EQ(fromRows.factorRiskContributions, decomp.factorRiskContributions);
+    EXPECT_DOUBLE_EQ(fromRows.varianceExplained, decomp.varianceExplained);
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, RollingDrawdownMatchesWindowRefits) {
+    auto [returns, shocks] = drawdownSample(400, 3);
+    const int window = 60;
+    std::vector<RiskDecomposition> rolling =
+        PortfolioRiskAnalyzer::rollingDrawdownAttribution(returns, shocks, drawdownLabels(3), window);
+
+    ASSERT_EQ(rolling.size(), 400u - window + 1);
+    for (size_t s = 0; s < rolling.size(); s += 17) {
+        RiskDecomposition refit = PortfolioRiskAnalyzer::explainHistoricalDrawdown(
+            returns.segment(s, window), shocks.middleRows(s, window), drawdownLabels(3));
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(rolling[s].factorSensitivities[k], refit.factorSensitivities[k], 1e-8) << "step " << s;
+            EXPECT_NEAR(rolling[s].factorRiskContributions[k], refit.factorRiskContributions[k], 1e-12);
+        }
+        EXPECT_NEAR(rolling[s].varianceExplained, refit.varianceExplained, 1e-8);
+        EXPECT_NEAR(rolling[s].totalVariance, refit.totalVariance, 1e-12);
+    }
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, RollingDrawdownDoesNotDriftAcrossScaleShifts) {
+    // A crisis at a million times the scale, then ordinary days: without
+    // periodic resumming the downdates leave residue larger than the quiet
+    // window's own statistics
+    auto [returns, shocks] = drawdownSample(20000, 3, 5);
+    returns.head(10000) *= 1e6;
+    shocks.topRows(10000) *= 1e6;
+
+    const int window = 50;
+    std::vector<RiskDecomposition> rolling =
+        PortfolioRiskAnalyzer::rollingDrawdownAttribution(returns, shocks, drawdownLabels(3), window);
+    ASSERT_EQ(rolling.size(), 20000u - window + 1);
+
+    for (size_t s = rolling.size() - 120; s < rolling.size(); s += 7) {
+        RiskDecomposition refit = PortfolioRiskAnalyzer::explainHistoricalDrawdown(
+            returns.segment(s, window), shocks.middleRows(s, window), drawdownLabels(3));
+        for (int k = 0; k < 3; k++) {
+            EXPECT_NEAR(rolling[s].factorSensitivities[k], refit.factorSensitivities[k], 1e-8) << "step " << s;
+        }
+        EXPECT_NEAR(rolling[s].varianceExplained, refit.varianceExplained, 1e-8);
+        EXPECT_NEAR(rolling[s].totalVariance / refit.totalVariance, 1.0, 1e-9);
+    }
+
+    // Returns far from zero: ssTot is taken from centered values, not Σy² − n·ȳ²
+    auto [small, smallShocks] = drawdownSample(50, 3, 8);
+    Eigen::VectorXd offset = small.array() + 1e4;
+    RiskDecomposition shifted = PortfolioRiskAnalyzer::explainHistoricalDrawdown(offset, smallShocks, drawdownLabels(3));
+    const double variance = (small.array() - small.mean()).square().sum() / 50.0;
+    EXPECT_NEAR(shifted.totalVariance / variance, 1.0, 1e-9);
+
+    DrawdownRegression regression(drawdownLabels(3));
+    for (int t = 0; t < 50; t++) {
+        regression.add(smallShocks.row(t).transpose(), offset(t));
+    }
+    EXPECT_NEAR(regression.decomposition().totalVariance / variance, 1.0, 1e-9);
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, ExpandingDrawdownEndsAtFullSample) {
+    auto [returns, shocks] = drawdownSample(120, 3, 29);
+    std::vector<RiskDecomposition> expanding =
+        PortfolioRiskAnalyzer::rollingDrawdownAttribution(returns, shocks, drawdownLabels(3));
+    ASSERT_EQ(expanding.size(), 120u - 4 + 1);     // First result after K + 1 rows
+
+    RiskDecomposition full = PortfolioRiskAnalyzer::explainHistoricalDrawdown(returns, shocks, drawdownLabels(3));
+    for (int k = 0; k < 3; k++) {
+        EXPECT_NEAR(expanding.back().factorSensitivities[k], full.factorSensitivities[k], 1e-9);
+    }
+    EXPECT_NEAR(expanding.back().varianceExplained, full.varianceExplained, 1e-9);
+
+    // Adding and then removing every row returns to an empty regression
+    DrawdownRegression regression(drawdownLabels(3));
+    regression.addBlock(shocks, returns);
+    for (int t = 0; t < 120; t++) {
+        regression.remove(shocks.row(t).transpose(), returns(t));
+    }
+    EXPECT_EQ(regression.observationCount(), 0u);
+    EXPECT_THROW(regression.decomposition(), std::runtime_error);
+}
+
+TEST_F(PortfolioRiskAnalyzerTest, DrawdownRegressionRejectsBadInput) {
+    std::vector<double> returns = {-0.01, -0.02};
+    std::vector<std::vector<double>> ragged = {{0.1, 0.2}, {0.1}};
+    EXPECT_THROW(PortfolioRiskAnalyzer::explainHistoricalDrawdown(returns, ragged, drawdownLabels(2)),
+                 std::invalid_argument);
+
+    auto [y, X] = drawdownSample(10, 3);
+    EXPECT_THROW(PortfolioRiskAnalyzer::explainHistoricalDrawdown(y.head(9), X, drawdownLabels(3)),
+                 std::invalid_argument);
+    EXPECT_THROW(PortfolioRiskAnalyzer::rollingDrawdownAttribution(y, X, drawdownLabels(3), 20),
+                 std::invalid_argument);
+    EXPECT_THROW(DrawdownRegression({}), std::invalid_argument);
+
+    DrawdownRegression regression(drawdownLabels(3));
+    EXPECT_THROW(regression.add(Eigen::Vector2d(0.1, 0.2), 0.0), std::invalid_argument);
+    EXPECT_THROW(regression.add(Eigen::Vector3d(0.1, NAN, 0.2), 0.0), std::invalid_argument);
+    EXPECT_THROW(regression.remove(Eigen::Vector3d::Zero(), 0.0), std::runtime_error);
+}
+
 // Run tests
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
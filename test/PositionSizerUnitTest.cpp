@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 #include "../src/DataProcessors/PositionSizer.hpp"
 #include <cmath>
+#include <random>
 
 class PositionSizerTest : public ::testing::Test {
 protected:
@@ -264,6 +265,133 @@ TEST_F(PositionSizerTest, StressTestPositionScales) {
     EXPECT_NEAR(loss2, loss1 * 5.0, std::abs(loss1) * 0.1);
 }
 
+TEST_F(PositionSizerTest, StressTestPositionAgainstScenarioLibrary) {
+    auto risk = createMockRiskDecomp();
+    const double position = 1000000.0;
+
+    // The built-in scenario as an episode, plus a growth × volatility grid
+    ScenarioLibrary library(risk.factorLabels);
+    library.addEpisode("built-in", Eigen::Vector3d(-2.0, 1.0, 2.0));
+    library.addGrid("growth x vol", {{"Growth", {-3.0, -1.5, 0.0}}, {"Volatility", {0.0, 1.5, 3.0}}});
+
+    double worst = PositionSizer::stressTestPosition(position, risk, library);
+    Eigen::MatrixXd pnl = ScenarioEvaluator::evaluate(
+        library, position * Eigen::Vector3d(0.6, -0.2, -0.8));
+    EXPECT_DOUBLE_EQ(worst, pnl.minCoeff());
+    EXPECT_LE(worst, PositionSizer::stressTestPosition(position, risk));
+    EXPECT_NEAR(worst, position * (0.6 * -3.0 - 0.8 * 3.0), 1e-6);
+
+    ScenarioLibrary mislabeled({"Growth", "Inflation", "Policy"});
+    mislabeled.addEpisode("x", Eigen::Vector3d::Ones());
+    EXPECT_THROW(PositionSizer::stressTestPosition(position, risk, mislabeled), std::invalid_argument);
+}
+
+// ===== Book Sizing Tests =====
+
+TEST_F(PositionSizerTest, BookSizingMatchesSingleInstrumentPath) {
+    Eigen::Matrix3d factorCovariance = Eigen::Vector3d(0.04, 0.01, 0.09).asDiagonal();
+    std::vector<std::string> labels = {"Growth", "Inflation", "Volatility"};
+    auto regime = createStressedRegime();
+    PositionConstraint constraints{10000000.0, 2.0, {{"Volatility", 0.5}}, 0.0, 500000.0};
+
+    InstrumentBook book;
+    book.symbols = {"ES"};
+    book.baseNotional = Eigen::VectorXd::Constant(1, 5000000.0);
+    book.maxNotional = Eigen::VectorXd::Constant(1, 10000000.0);
+    book.contractNotional = Eigen::VectorXd::Constant(1, 5000.0);
+    book.factorSensitivities = Eigen::Vector3d(0.6, -0.2, -0.8);
+    book.residualVariance = Eigen::VectorXd::Zero(1);
+
+    RiskDecomposition risk = createMockRiskDecomp();
+    risk.totalRisk = std::sqrt(book.factorSensitivities.col(0).dot(factorCovariance * book.factorSensitivities.col(0)));
+
+    BookSizing batch;
+    PositionSizer::computeBookSizing(book, factorCovariance, labels, regime, constraints, batch);
+    PositionSizing single = PositionSizer::computePositionSize(5000000.0, risk, regime, constraints);
+
+    EXPECT_DOUBLE_EQ(batch.recommendedNotional(0), single.recommendedNotional);
+    EXPECT_DOUBLE_EQ(batch.recommendedContracts(0), single.recommendedShares);
+    EXPECT_NEAR(batch.expectedDailyVol(0), single.expectedDailyVol, 1e-6);
+    EXPECT_NEAR(batch.stressLoss(0), PositionSizer::stressTestPosition(single.recommendedNotional, risk), 1e-6);
+    EXPECT_DOUBLE_EQ(batch.volatilityMultiplier, single.regimeAdjustmentFactor);
+    EXPECT_EQ(batch.isWithinConstraints, single.isWithinConstraints);
+    EXPECT_EQ(batch.rationale(0), single.rationale);
+    EXPECT_EQ(batch.constraintBreaches(0), single.constraintBreaches);
+    EXPECT_EQ(batch.constraintBreaches(0), std::vector<std::string>{"Factor Volatility exposure too high"});
+    EXPECT_THROW(batch.rationale(1), std::out_of_range);
+}
+
+TEST_F(PositionSizerTest, BookSizingUsesCrossInstrumentCorrelation) {
+    Eigen::Matrix2d factorCovariance = Eigen::Vector2d(0.0001, 0.0001).asDiagonal();
+    std::vector<std::string> labels = {"Growth", "Policy"};
+    auto regime = createCalmRegime();
+    PositionConstraint constraints{10000000.0, 2.0, {}, 100000.0, 500000.0};
+
+    // ES and NQ load on the same factor; ZN on an independent one
+    InstrumentBook book;
+    book.symbols = {"ES", "NQ", "ZN"};
+    book.baseNotional = Eigen::Vector3d::Constant(5000000.0);
+    book.maxNotional = Eigen::Vector3d::Constant(10000000.0);
+    book.contractNotional = Eigen::Vector3d(250000.0, 400000.0, 110000.0);
+    book.factorSensitivities.resize(2, 3);
+    book.factorSensitivities << 1.0, 1.2, 0.0,
+                                0.0, 0.0, 1.0;
+    book.residualVariance = Eigen::Vector3d::Zero();
+
+    BookSizing sizing;
+    PositionSizer::computeBookSizing(book, factorCovariance, labels, regime, constraints, sizing);
+
+    EXPECT_NEAR(sizing.correlation(0, 1), 1.0, 1e-12);
+    EXPECT_NEAR(sizing.correlation(0, 2), 0.0, 1e-12);
+    EXPECT_NEAR(sizing.correlation(2, 2), 1.0, 1e-12);
+    EXPECT_NEAR(sizing.riskContributions.sum(), sizing.bookVolatility, 1e-9);
+
+    // The 2σ book loss is held to the limit, and only diversification is rewarded
+    EXPECT_LT(sizing.bookScale, 1.0);
+    EXPECT_NEAR(2.0 * sizing.bookVolatility, constraints.maxDailyLoss, 1e-6);
+    EXPECT_FALSE(sizing.isWithinConstraints);
+    EXPECT_EQ(sizing.constraintBreaches(2), std::vector<std::string>{"Book scaled to daily loss limit"});
+    EXPECT_NE(sizing.rationale(0).find("BookScale="), std::string::npos);
+
+    // Reusing the output for a smaller book resizes every array
+    book.symbols = {"ZN"};
+    book.baseNotional = Eigen::VectorXd::Constant(1, 1000000.0);
+    book.maxNotional = Eigen::VectorXd::Constant(1, 10000000.0);
+    book.contractNotional = Eigen::VectorXd::Constant(1, 110000.0);
+    book.factorSensitivities = Eigen::Vector2d(0.0, 1.0);
+    book.residualVariance = Eigen::VectorXd::Zero(1);
+    PositionSizer::computeBookSizing(book, factorCovariance, labels, regime, constraints, sizing);
+    EXPECT_EQ(sizing.recommendedNotional.size(), 1);
+    EXPECT_EQ(sizing.breaches.size(), 1u);
+    EXPECT_DOUBLE_EQ(sizing.bookScale, 1.0);
+    EXPECT_TRUE(sizing.isWithinConstraints);
+    EXPECT_TRUE(sizing.constraintBreaches(0).empty());
+}
+
+TEST_F(PositionSizerTest, BookSizingRejectsMismatchedArrays) {
+    InstrumentBook book;
+    book.symbols = {"ES", "NQ"};
+    book.baseNotional = Eigen::Vector2d::Constant(1000000.0);
+    book.maxNotional = Eigen::Vector2d::Constant(5000000.0);
+    book.contractNotional = Eigen::Vector2d::Constant(250000.0);
+    book.factorSensitivities = Eigen::MatrixXd::Ones(3, 2);
+    book.residualVariance = Eigen::VectorXd::Zero(1);
+    Eigen::Matrix3d factorCovariance = Eigen::Matrix3d::Identity();
+    std::vector<std::string> labels = {"Growth", "Inflation", "Volatility"};
+    PositionConstraint constraints{10000000.0, 2.0, {}, 0.0, 500000.0};
+    BookSizing sizing;
+
+    EXPECT_THROW(PositionSizer::computeBookSizing(book, factorCovariance, labels, createCalmRegime(), constraints, sizing),
+                 std::invalid_argument);
+    book.residualVariance = Eigen::Vector2d::Zero();
+    EXPECT_THROW(PositionSizer::computeBookSizing(book, Eigen::Matrix2d::Identity(), labels, createCalmRegime(),
+                                                  constraints, sizing),
+                 std::invalid_argument);
+    book.contractNotional(1) = 0.0;
+    EXPECT_THROW(PositionSizer::computeBookSizing(book, factorCovariance, labels, createCalmRegime(), constraints, sizing),
+                 std::invalid_argument);
+}
+
 // ===== Hysteresis Tests =====
 
 TEST_F(PositionSizerTest, HysteresisReduceImmediately) {
@@ -325,6 +453,33 @@ TEST_F(PositionSizerTest, ComputeDailyVaR) {
     EXPECT_GT(var99, 0.0);
 }
 
+TEST_F(PositionSizerTest, HistoricalVaRFromFactorShockHistory) {
+    auto risk = createMockRiskDecomp();
+    double position = 5000000.0;
+
+    // Ten years of independent daily factor shocks, 1% vol each
+    std::mt19937_64 rng(31);
+    std::normal_distribution<double> normal(0.0, 0.01);
+    Eigen::MatrixXd shocks(2520, 3);
+    for (Eigen::Index t = 0; t < shocks.rows(); t++) {
+        for (Eigen::Index k = 0; k < 3; k++) {
+            shocks(t, k) = normal(rng);
+        }
+    }
+
+    double var95 = PositionSizer::computeHistoricalVaR(position, risk, shocks, 0.95);
+    double var99 = PositionSizer::computeHistoricalVaR(position, risk, shocks, 0.99);
+    double var95TenDay = PositionSizer::computeHistoricalVaR(position, risk, shocks, 0.95, 10);
+
+    // Gaussian shocks: close to the parametric 1.645σ with σ = ‖γ‖ · 1%
+    double sigma = position * 0.01 * std::sqrt(0.36 + 0.04 + 0.64);
+    EXPECT_NEAR(var95, 1.645 * sigma, 0.08 * 1.645 * sigma);
+    EXPECT_GT(var99, var95);
+    EXPECT_NEAR(var95TenDay, std::sqrt(10.0) * var95, 0.2 * std::sqrt(10.0) * var95);
+
+    EXPECT_THROW(PositionSizer::computeHistoricalVaR(position, risk, shocks.leftCols(2)), std::invalid_argument);
+}
+
 // ===== Error Handling Tests =====
 
 TEST_F(PositionSizerTest, ComputePositionSizeNegativeBase) {
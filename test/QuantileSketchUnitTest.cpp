@@ -0,0 +1,183 @@
+//
+//  QuantileSketchUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the t-digest and rolling quantile sketch
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/QuantileSketch.hpp"
+#include "../src/Storage/BinaryIO.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+class QuantileSketchTest : public ::testing::Test {
+protected:
+    // Heavy right tail, like VIX or credit spreads
+    static std::vector<double> lognormalStream(size_t n, uint64_t seed = 11) {
+        std::mt19937_64 rng(seed);
+        std::lognormal_distribution<double> draw(3.0, 0.4);
+        std::vector<double> values(n);
+        for (double& v : values) {
+            v = draw(rng);
+        }
+        return values;
+    }
+
+    // Fraction of the sorted sample at or below the estimate
+    static double empiricalRank(const std::vector<double>& sorted, double estimate) {
+        return static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin()) /
+               static_cast<double>(sorted.size());
+    }
+
+    static constexpr double PROBABILITIES[] = {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999};
+};
+
+// ===== TDigest Tests =====
+
+TEST_F(QuantileSketchTest, TracksExactQuantilesWithBoundedCentroids) {
+    std::vector<double> values = lognormalStream(200000);
+    TDigest digest;
+    for (double v : values) {
+        digest.add(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    EXPECT_DOUBLE_EQ(digest.count(), 200000.0);
+    EXPECT_DOUBLE_EQ(digest.quantile(0.0), values.front());
+    EXPECT_DOUBLE_EQ(digest.quantile(1.0), values.back());
+    for (double q : PROBABILITIES) {
+        // Rank error shrinks towards the tails: ~q(1−q)/δ
+        EXPECT_NEAR(empiricalRank(values, digest.quantile(q)), q, 0.002 + 0.02 * q * (1.0 - q)) << "q=" << q;
+    }
+    EXPECT_LE(digest.centroidCount(), static_cast<size_t>(digest.compression()));
+}
+
+TEST_F(QuantileSketchTest, MergedDigestsMatchOneDigest) {
+    std::vector<double> values = lognormalStream(100000, 5);
+    TDigest whole;
+    std::vector<TDigest> parts(10);
+    for (size_t i = 0; i < values.size(); i++) {
+        whole.add(values[i]);
+        parts[i % parts.size()].add(values[i]);
+    }
+    TDigest merged;
+    for (const TDigest& part : parts) {
+        merged.merge(part);
+    }
+    std::sort(values.begin(), values.end());
+
+    EXPECT_DOUBLE_EQ(merged.count(), whole.count());
+    EXPECT_DOUBLE_EQ(merged.min(), whole.min());
+    EXPECT_DOUBLE_EQ(merged.max(), whole.max());
+    for (double q : PROBABILITIES) {
+        EXPECT_NEAR(empiricalRank(values, merged.quantile(q)), q, 0.002 + 0.02 * q * (1.0 - q)) << "q=" << q;
+    }
+}
+
+// ===== Rolling Window Tests =====
+
+TEST_F(QuantileSketchTest, RollingWindowForgetsOldObservations) {
+    std::mt19937_64 rng(9);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    RollingQuantileSketch sketch(1000, 10);
+
+    for (int i = 0; i < 5000; i++) {
+        sketch.add(noise(rng));
+    }
+    EXPECT_NEAR(sketch.quantile(0.5), 0.0, 0.15);
+
+    // Shift the level: after one full window the old regime is gone
+    for (int i = 0; i < 1000; i++) {
+        sketch.add(10.0 + noise(rng));
+        EXPECT_GE(sketch.count(), 900u);
+        EXPECT_LE(sketch.count(), 1000u);
+    }
+    EXPECT_NEAR(sketch.quantile(0.5), 10.0, 0.15);
+    EXPECT_GT(sketch.window().min(), 5.0);
+
+    // Until the first block rolls, the window is everything seen so far
+    RollingQuantileSketch young(1000, 10);
+    for (int i = 1; i <= 50; i++) {
+        young.add(i);
+    }
+    EXPECT_EQ(young.count(), 50u);
+    EXPECT_NEAR(young.quantile(0.5), 25.5, 1e-9);
+}
+
+TEST_F(QuantileSketchTest, RollingWindowNeverExceedsItsLength) {
+    // W = 25 in 20 blocks of 2: only 12 full blocks fit beside a partial one
+    RollingQuantileSketch sketch(25, 20);
+    EXPECT_EQ(sketch.minimumCount(), 24u);
+    for (int i = 1; i <= 200; i++) {
+        sketch.add(i);
+        ASSERT_LE(sketch.count(), 25u) << "after " << i;
+        EXPECT_DOUBLE_EQ(sketch.window().count(), static_cast<double>(sketch.count()));
+        if (i >= 25) {
+            EXPECT_GE(sketch.count(), sketch.minimumCount());
+            EXPECT_DOUBLE_EQ(sketch.window().max(), i);
+            EXPECT_GT(sketch.window().min(), i - 25);
+        }
+    }
+
+    RollingQuantileSketch uneven(252, 20);
+    for (int i = 0; i < 2000; i++) {
+        uneven.add(i);
+        ASSERT_LE(uneven.count(), 252u);
+    }
+}
+
+TEST_F(QuantileSketchTest, SnapshotRestoresTheWindowExactly) {
+    std::vector<double> values = lognormalStream(5000, 31);
+    RollingQuantileSketch uninterrupted(1000, 10);
+    RollingQuantileSketch first(1000, 10);
+    for (size_t i = 0; i < 2345; i++) {
+        uninterrupted.add(values[i]);
+        first.add(values[i]);
+    }
+
+    ByteWriter writer;
+    first.serialize(writer);
+    ByteReader reader(writer.bytes().data(), writer.size());
+    RollingQuantileSketch resumed = RollingQuantileSketch::deserialize(reader);
+    EXPECT_EQ(reader.remaining(), 0u);
+    EXPECT_EQ(resumed.count(), first.count());
+
+    for (size_t i = 2345; i < values.size(); i++) {
+        uninterrupted.add(values[i]);
+        resumed.add(values[i]);
+        for (double q : PROBABILITIES) {
+            ASSERT_EQ(resumed.quantile(q), uninterrupted.quantile(q)) << "i=" << i << " q=" << q;
+        }
+    }
+
+    ByteReader truncated(writer.bytes().data(), writer.size() - 8);
+    EXPECT_THROW(RollingQuantileSketch::deserialize(truncated), std::runtime_error);
+}
+
+// ===== Error Handling =====
+
+TEST_F(QuantileSketchTest, RejectsBadArguments) {
+    EXPECT_THROW(TDigest(5.0), std::invalid_argument);
+    TDigest digest;
+    EXPECT_THROW(digest.quantile(0.5), std::logic_error);
+    digest.add(std::nan(""));
+    EXPECT_TRUE(digest.empty());
+    digest.add(1.0);
+    EXPECT_THROW(digest.add(2.0, 0.0), std::invalid_argument);
+    EXPECT_THROW(digest.quantile(1.5), std::invalid_argument);
+    EXPECT_DOUBLE_EQ(digest.quantile(0.3), 1.0);
+
+    EXPECT_THROW(RollingQuantileSketch(100, 1), std::invalid_argument);
+    EXPECT_THROW(RollingQuantileSketch(5, 10), std::invalid_argument);
+    EXPECT_THROW(RollingQuantileSketch(100, 10).quantile(0.5), std::logic_error);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
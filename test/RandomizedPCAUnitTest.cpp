@@ -0,0 +1,209 @@
+//
+//  RandomizedPCAUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for randomized truncated PCA and its error bounds
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/RandomizedPCA.hpp"
+#include "../src/DataProcessors/MacroFactorModel.hpp"
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <random>
+
+class RandomizedPCATest : public ::testing::Test {
+protected:
+    /**
+     * Column-centered T × N panel: `rank` latent factors with geometrically
+     * decaying strength plus isotropic noise
+     */
+    static Eigen::MatrixXd factorPanel(int T, int N, int rank, double noise, uint64_t seed = 11) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        auto gaussian = [&](int rows, int cols) {
+            Eigen::MatrixXd m(rows, cols);
+            for (int j = 0; j < cols; j++) {
+                for (int i = 0; i < rows; i++) {
+                    m(i, j) = normal(rng);
+                }
+            }
+            return m;
+        };
+
+        Eigen::MatrixXd factors = gaussian(T, rank);
+        for (int k = 0; k < rank; k++) {
+            factors.col(k) *= std::pow(0.6, k) * 3.0;
+        }
+        Eigen::MatrixXd panel = factors * gaussian(rank, N) + noise * gaussian(T, N);
+        panel.rowwise() -= panel.colwise().mean();
+        return panel;
+    }
+
+    struct Exact {
+        Eigen::VectorXd eigenvalues;    // Descending
+        Eigen::MatrixXd eigenvectors;
+    };
+
+    static Exact exactEigen(const Eigen::MatrixXd& panel) {
+        Eigen::MatrixXd cov = panel.transpose() * panel / static_cast<double>(panel.rows() - 1);
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(cov);
+        return {solver.eigenvalues().reverse(), solver.eigenvectors().rowwise().reverse()};
+    }
+};
+
+// ===== Accuracy Tests =====
+
+TEST_F(RandomizedPCATest, MatchesExactSolverOnFactorPanel) {
+    Eigen::MatrixXd panel = factorPanel(400, 300, 3, 0.3);
+    PrincipalComponents pca = RandomizedPCA::compute(panel, 3);
+    Exact exact = exactEigen(panel);
+
+    ASSERT_EQ(pca.components.rows(), 300);
+    ASSERT_EQ(pca.components.cols(), 3);
+    EXPECT_EQ(pca.sketchSize, 13);
+    EXPECT_NEAR(pca.totalVariance, exact.eigenvalues.sum(), 1e-8 * exact.eigenvalues.sum());
+
+    for (int k = 0; k < 3; k++) {
+        EXPECT_NEAR(pca.eigenvalues(k), exact.eigenvalues(k), 1e-6 * exact.eigenvalues(k));
+        EXPECT_GT(std::abs(pca.components.col(k).dot(exact.eigenvectors.col(k))), 0.9999);
+    }
+
+    // Components are orthonormal
+    Eigen::MatrixXd gram = pca.components.transpose() * pca.components;
+    EXPECT_TRUE(gram.isApprox(Eigen::MatrixXd::Identity(3, 3), 1e-10));
+}
+
+TEST_F(RandomizedPCATest, ErrorBoundsHoldAgainstExactSolver) {
+    // Flat noisy spectrum, no power iterations: the sketch is rough, the bounds must still hold
+    Eigen::MatrixXd panel = factorPanel(200, 150, 6, 1.5, 5);
+    RandomizedPCAOptions options;
+    options.powerIterations = 0;
+    options.oversampling = 4;
+
+    PrincipalComponents pca = RandomizedPCA::compute(panel, 5, options);
+    Exact exact = exactEigen(panel);
+
+    for (int k = 0; k < 5; k++) {
+        double nearest = (exact.eigenvalues.array() - pca.eigenvalues(k)).abs().minCoeff();
+        EXPECT_LE(nearest, pca.eigenvalueErrorBounds(k) + 1e-12);
+        EXPECT_LE(pca.eigenvalues(k), exact.eigenvalues(k) * (1 + 1e-12));   // Rayleigh-Ritz never overshoots
+    }
+
+    // Nothing the sketch missed can carry more variance than the bound
+    EXPECT_GE(pca.uncapturedVarianceBound, exact.eigenvalues(pca.sketchSize));
+}
+
+TEST_F(RandomizedPCATest, PowerIterationsTightenBounds) {
+    Eigen::MatrixXd panel = factorPanel(300, 250, 4, 0.8, 9);
+
+    double previous = std::numeric_limits<double>::infinity();
+    for (int q : {0, 1, 3}) {
+        RandomizedPCAOptions options;
+        options.powerIterations = q;
+        options.oversampling = 5;
+        PrincipalComponents pca = RandomizedPCA::compute(panel, 4, options);
+        double worst = pca.eigenvalueErrorBounds.maxCoeff();
+        EXPECT_LT(worst, previous);
+        previous = worst;
+    }
+}
+
+TEST_F(RandomizedPCATest, DeterministicPerSeed) {
+    Eigen::MatrixXd panel = factorPanel(120, 80, 3, 0.5);
+    RandomizedPCAOptions options;
+    options.powerIterations = 0;
+
+    PrincipalComponents a = RandomizedPCA::compute(panel, 3, options);
+    PrincipalComponents b = RandomizedPCA::compute(panel, 3, options);
+    EXPECT_EQ(a.eigenvalues, b.eigenvalues);
+    EXPECT_EQ(a.components, b.components);
+
+    options.seed = 99;
+    PrincipalComponents c = RandomizedPCA::compute(panel, 3, options);
+    EXPECT_NE(a.components, c.components);
+}
+
+TEST_F(RandomizedPCATest, SketchCappedByPanelShape) {
+    // Short panel: T < K + p
+    Eigen::MatrixXd panel = factorPanel(8, 50, 2, 0.1);
+    PrincipalComponents pca = RandomizedPCA::compute(panel, 3);
+    EXPECT_EQ(pca.sketchSize, 8);
+    EXPECT_EQ(pca.eigenvalues.size(), 3);
+    EXPECT_GE(pca.eigenvalues(0), pca.eigenvalues(1));
+}
+
+TEST_F(RandomizedPCATest, RejectsBadInput) {
+    Eigen::MatrixXd panel = factorPanel(20, 10, 2, 0.1);
+    EXPECT_THROW(RandomizedPCA::compute(panel, 0), std::invalid_argument);
+    EXPECT_THROW(RandomizedPCA::compute(panel, 11), std::invalid_argument);
+    EXPECT_THROW(RandomizedPCA::compute(Eigen::MatrixXd(1, 5), 1), std::invalid_argument);
+
+    RandomizedPCAOptions options;
+    options.powerIterations = -1;
+    EXPECT_THROW(RandomizedPCA::compute(panel, 2, options), std::invalid_argument);
+
+    std::vector<std::string> names;
+    EXPECT_THROW(RandomizedPCA::centeredPanel({}, names), std::invalid_argument);
+    EXPECT_THROW(RandomizedPCA::centeredPanel({{"a", {1, 2, 3}}, {"b", {1, 2}}}, names),
+                 std::invalid_argument);
+}
+
+// ===== MacroFactorModel Integration =====
+
+TEST_F(RandomizedPCATest, PanelDecompositionMatchesCovariancePath) {
+    Eigen::MatrixXd raw = factorPanel(120, 8, 3, 0.3, 21);
+    std::vector<std::string> names = {
+        "consumer_sentiment", "fed_funds", "gdp", "inflation",
+        "inverted_yield", "treasury_10y", "unemployment", "vix"
+    };
+    std::map<std::string, std::vector<double>> surprises;
+    for (int j = 0; j < 8; j++) {
+        surprises[names[j]] = std::vector<double>(raw.col(j).data(), raw.col(j).data() + raw.rows());
+    }
+
+    CovarianceCalculator calculator;
+    MacroFactors exact = MacroFactorModel::decomposeSurpriseCovariance(
+        calculator.calculateCovarianceMatrix(surprises), 3);
+    PrincipalComponents diagnostics;
+    MacroFactors sketched = MacroFactorModel::decomposeSurprisePanel(
+        surprises, 3, RandomizedPCAOptions(), MacroFactorModel::DEFAULT_LABEL_THRESHOLD, &diagnostics);
+
+    EXPECT_EQ(sketched.indicatorNames, exact.indicatorNames);
+    EXPECT_NEAR(sketched.cumulativeVarianceExplained, exact.cumulativeVarianceExplained, 1e-9);
+    for (int k = 0; k < 3; k++) {
+        EXPECT_NEAR(sketched.factorVariances[k], exact.factorVariances[k], 1e-9 * exact.factorVariances[0]);
+        double cosine = sketched.loadings.col(k).normalized().dot(exact.loadings.col(k).normalized());
+        EXPECT_NEAR(std::abs(cosine), 1.0, 1e-9);
+    }
+
+    // Residual covariance agrees up to the sign-invariant B Bᵀ
+    EXPECT_TRUE(sketched.residualCovariance.isApprox(exact.residualCovariance, 1e-6));
+    EXPECT_EQ(diagnostics.eigenvalues.size(), 3);
+}
+
+TEST_F(RandomizedPCATest, WidePanelSkipsResidualCovariance) {
+    const int N = MacroFactorModel::MAX_RESIDUAL_COVARIANCE_INDICATORS + 88;
+    Eigen::MatrixXd raw = factorPanel(60, N, 3, 0.5, 4);
+    std::map<std::string, std::vector<double>> surprises;
+    for (int j = 0; j < N; j++) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "series_%04d", j);
+        surprises[name] = std::vector<double>(raw.col(j).data(), raw.col(j).data() + raw.rows());
+    }
+
+    MacroFactors factors = MacroFactorModel::decomposeSurprisePanel(surprises, 3);
+    EXPECT_EQ(factors.loadings.rows(), N);
+    EXPECT_EQ(factors.residualCovariance.size(), 0);
+    EXPECT_GT(factors.cumulativeVarianceExplained, 0.5);
+    EXPECT_LE(factors.cumulativeVarianceExplained, 1.0);
+    EXPECT_EQ(factors.factorLabels.size(), 3u);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
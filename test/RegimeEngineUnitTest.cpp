@@ -0,0 +1,254 @@
+//
+//  RegimeEngineUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the streaming regime engine
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/RegimeEngine.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+class RegimeEngineTest : public ::testing::Test {
+protected:
+    // Random walk through calm, neutral and stressed markets
+    static std::vector<RegimeTick> tickHistory(int days, uint64_t seed = 3) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> step(0.0, 1.0);
+        std::vector<RegimeTick> ticks;
+        double vix = 18.0, spread = 150.0;
+        for (int d = 0; d < days; d++) {
+            vix = std::clamp(vix + 2.5 * step(rng), 9.0, 60.0);
+            spread = std::clamp(spread + 15.0 * step(rng), 60.0, 400.0);
+            ticks.push_back({20200101 + d, vix, 80.0 + 2.0 * vix, spread, 50.0 - vix, 0.8 + vix / 100.0});
+        }
+        return ticks;
+    }
+
+    // Recommended size falls with the volatility multiplier
+    static double recommendation(const MacroRegime& regime) {
+        return 5000000.0 / regime.volatilityMultiplier;
+    }
+};
+
+// ===== Streaming Tests =====
+
+TEST_F(RegimeEngineTest, MatchesStatelessFunctionsDayByDay) {
+    std::vector<RegimeTick> ticks = tickHistory(400);
+    RegimeEngine engine;
+
+    MacroRegime previous{};
+    bool hasPrevious = false;
+    int days = 0;
+    int64_t changes = 0;
+    double size = 0.0;
+
+    for (size_t d = 0; d < ticks.size(); d++) {
+        const RegimeTick& t = ticks[d];
+        MacroRegime regime = PositionSizer::classifyRegime(t.vixLevel, t.moveIndex, t.creditSpread,
+                                                           t.yieldCurveSlope, t.putCallRatio);
+        if (hasPrevious && regime.riskLabel == previous.riskLabel) {
+            days++;
+        } else {
+            changes += hasPrevious ? 1 : 0;
+            days = 1;
+        }
+        size = d == 0 ? recommendation(regime)
+                      : PositionSizer::applyHysteresis(size, recommendation(regime), previous, regime, days);
+
+        const MacroRegime& streamed = engine.observe(t);
+        EXPECT_EQ(streamed.riskLabel, regime.riskLabel);
+        EXPECT_DOUBLE_EQ(streamed.volatilityMultiplier, regime.volatilityMultiplier);
+        EXPECT_EQ(engine.daysInCurrentRegime(), days);
+        EXPECT_DOUBLE_EQ(engine.rebalance(recommendation(streamed)), size);
+
+        previous = regime;
+        hasPrevious = true;
+    }
+    EXPECT_EQ(engine.regimeChanges(), changes);
+    EXPECT_GT(changes, 0);
+    EXPECT_EQ(engine.lastDate(), ticks.back().date);
+}
+
+// ===== Snapshot Tests =====
+
+TEST_F(RegimeEngineTest, SnapshotResumesExactly) {
+    std::vector<RegimeTick> ticks = tickHistory(300, 17);
+    RegimeWeights weights{0.5, 0.2, 0.1, 0.1, 0.1};
+    RegimeEngine uninterrupted(weights);
+    RegimeEngine first(weights);
+
+    for (size_t d = 0; d < 150; d++) {
+        uninterrupted.rebalance(recommendation(uninterrupted.observe(ticks[d])));
+        first.rebalance(recommendation(first.observe(ticks[d])));
+    }
+
+    const std::string path = ::testing::TempDir() + "regime_engine_snapshot.bin";
+    first.save(path);
+    RegimeEngine resumed = RegimeEngine::load(path);
+    std::remove(path.c_str());
+    EXPECT_EQ(resumed.serialize(), first.serialize());
+    EXPECT_EQ(resumed.regime().riskLabel, first.regime().riskLabel);
+    EXPECT_DOUBLE_EQ(resumed.weights().vix, 0.5);
+
+    for (size_t d = 150; d < ticks.size(); d++) {
+        const MacroRegime& expected = uninterrupted.observe(ticks[d]);
+        const MacroRegime& actual = resumed.observe(ticks[d]);
+        EXPECT_EQ(actual.riskLabel, expected.riskLabel);
+        EXPECT_DOUBLE_EQ(resumed.rebalance(recommendation(actual)), uninterrupted.rebalance(recommendation(expected)));
+        EXPECT_EQ(resumed.daysInCurrentRegime(), uninterrupted.daysInCurrentRegime());
+    }
+    EXPECT_EQ(resumed.regimeChanges(), uninterrupted.regimeChanges());
+
+    // A fresh engine round-trips too
+    RegimeEngine empty = RegimeEngine::deserialize(RegimeEngine().serialize());
+    EXPECT_FALSE(empty.hasRegime());
+    EXPECT_FALSE(empty.isSized());
+}
+
+// ===== Adaptive Threshold Tests =====
+
+TEST_F(RegimeEngineTest, AdaptiveThresholdsTrackRollingPercentiles) {
+    std::vector<RegimeTick> ticks = tickHistory(1500, 23);
+    AdaptiveThresholdOptions options;
+    options.windowDays = 500;
+    options.numBlocks = 10;
+    options.minObservations = 200;
+    AdaptiveRegimeThresholds adaptive(options);
+
+    RegimeEngine engine;
+    RegimeEngine reference;
+    const RegimeThresholds defaults = PositionSizer::defaultRegimeThresholds();
+    for (size_t d = 0; d < ticks.size(); d++) {
+        const RegimeThresholds& thresholds = adaptive.observe(ticks[d]);
+        engine.setThresholds(thresholds);
+        EXPECT_EQ(engine.observe(ticks[d]).riskLabel,
+                  PositionSizer::classifyRegime(ticks[d].vixLevel, ticks[d].moveIndex, ticks[d].creditSpread,
+                                                ticks[d].yieldCurveSlope, ticks[d].putCallRatio,
+                                                PositionSizer::defaultRegimeWeights(), thresholds).riskLabel);
+        if (d + 1 < options.minObservations) {
+            EXPECT_FALSE(adaptive.isWarm());
+            EXPECT_DOUBLE_EQ(thresholds.vixRiskOff, defaults.vixRiskOff);
+            EXPECT_DOUBLE_EQ(thresholds.curveFlat, defaults.curveFlat);
+        }
+    }
+    ASSERT_TRUE(adaptive.isWarm());
+
+    // The window holds the last 450-500 days; compare with exact percentiles of the last 475
+    std::vector<double> vix, spread;
+    for (size_t d = ticks.size() - 475; d < ticks.size(); d++) {
+        vix.push_back(ticks[d].vixLevel);
+        spread.push_back(ticks[d].creditSpread);
+    }
+    std::sort(vix.begin(), vix.end());
+    std::sort(spread.begin(), spread.end());
+    auto exact = [](const std::vector<double>& sorted, double q) { return sorted[static_cast<size_t>(q * (sorted.size() - 1))]; };
+
+    const RegimeThresholds& current = adaptive.current();
+    const double vixRange = vix.back() - vix.front();
+    const double spreadRange = spread.back() - spread.front();
+    EXPECT_NEAR(current.vixRiskOn, exact(vix, options.vixRiskOn), 0.05 * vixRange);
+    EXPECT_NEAR(current.vixRiskOff, exact(vix, options.vixRiskOff), 0.05 * vixRange);
+    EXPECT_NEAR(current.spreadWide, exact(spread, options.spreadWide), 0.05 * spreadRange);
+    EXPECT_LT(current.vixRiskOn, current.fragileVix);
+    EXPECT_LT(current.fragileVix, current.vixRiskOff);
+
+    // The engine remembers which thresholds classified each tick
+    engine.setThresholds(defaults);
+    RegimeEngine resumed = RegimeEngine::deserialize(engine.serialize());
+    EXPECT_EQ(resumed.regime().riskLabel, engine.regime().riskLabel);
+    EXPECT_DOUBLE_EQ(resumed.thresholds().vixRiskOff, defaults.vixRiskOff);
+}
+
+TEST_F(RegimeEngineTest, AdaptiveSnapshotResumesExactly) {
+    std::vector<RegimeTick> ticks = tickHistory(1200, 29);
+    AdaptiveThresholdOptions options;
+    options.windowDays = 500;
+    options.numBlocks = 10;
+    options.minObservations = 200;
+
+    // One daemon runs straight through; the other restarts from its snapshots
+    AdaptiveRegimeThresholds uninterruptedThresholds(options);
+    RegimeEngine uninterrupted;
+    AdaptiveRegimeThresholds firstThresholds(options);
+    RegimeEngine first;
+    for (size_t d = 0; d < 777; d++) {
+        uninterrupted.setThresholds(uninterruptedThresholds.observe(ticks[d]));
+        uninterrupted.rebalance(recommendation(uninterrupted.observe(ticks[d])));
+        first.setThresholds(firstThresholds.observe(ticks[d]));
+        first.rebalance(recommendation(first.observe(ticks[d])));
+    }
+
+    const std::string enginePath = ::testing::TempDir() + "regime_engine_adaptive.bin";
+    const std::string thresholdsPath = enginePath + ".thresholds";
+    first.save(enginePath);
+    firstThresholds.save(thresholdsPath);
+    RegimeEngine resumed = RegimeEngine::load(enginePath);
+    AdaptiveRegimeThresholds resumedThresholds = AdaptiveRegimeThresholds::load(thresholdsPath);
+    std::remove(enginePath.c_str());
+    std::remove(thresholdsPath.c_str());
+    EXPECT_EQ(resumedThresholds.serialize(), firstThresholds.serialize());
+    EXPECT_TRUE(resumedThresholds.isWarm());
+
+    for (size_t d = 777; d < ticks.size(); d++) {
+        const RegimeThresholds& expected = uninterruptedThresholds.observe(ticks[d]);
+        const RegimeThresholds& actual = resumedThresholds.observe(ticks[d]);
+        ASSERT_EQ(actual.vixRiskOn, expected.vixRiskOn) << "day " << d;
+        ASSERT_EQ(actual.vixRiskOff, expected.vixRiskOff) << "day " << d;
+        ASSERT_EQ(actual.fragileMove, expected.fragileMove) << "day " << d;
+        ASSERT_EQ(actual.spreadWide, expected.spreadWide) << "day " << d;
+        ASSERT_EQ(actual.curveSteep, expected.curveSteep) << "day " << d;
+        uninterrupted.setThresholds(expected);
+        resumed.setThresholds(actual);
+        EXPECT_EQ(resumed.observe(ticks[d]).riskLabel, uninterrupted.observe(ticks[d]).riskLabel);
+        EXPECT_DOUBLE_EQ(resumed.rebalance(recommendation(resumed.regime())),
+                         uninterrupted.rebalance(recommendation(uninterrupted.regime())));
+    }
+    EXPECT_EQ(resumed.regimeChanges(), uninterrupted.regimeChanges());
+
+    std::string bytes = firstThresholds.serialize();
+    bytes[40] ^= 0x01;
+    EXPECT_THROW(AdaptiveRegimeThresholds::deserialize(bytes), std::runtime_error);
+    EXPECT_THROW(AdaptiveRegimeThresholds::deserialize(first.serialize()), std::runtime_error);
+}
+
+// ===== Error Handling =====
+
+TEST_F(RegimeEngineTest, RejectsBadInputAndCorruptSnapshots) {
+    RegimeEngine engine;
+    EXPECT_THROW(engine.regime(), std::logic_error);
+    EXPECT_THROW(engine.rebalance(1.0), std::logic_error);
+
+    engine.observe({20240102, 15.0, 90.0, 120.0, 80.0, 0.9});
+    EXPECT_THROW(engine.observe({20240102, 16.0, 90.0, 120.0, 80.0, 0.9}), std::invalid_argument);
+    EXPECT_THROW(engine.observe({20240101, 16.0, 90.0, 120.0, 80.0, 0.9}), std::invalid_argument);
+
+    std::string bytes = engine.serialize();
+    std::string flipped = bytes;
+    flipped[20] ^= 0x01;
+    EXPECT_THROW(RegimeEngine::deserialize(flipped), std::runtime_error);
+    EXPECT_THROW(RegimeEngine::deserialize(bytes.substr(0, bytes.size() - 9)), std::runtime_error);
+    EXPECT_THROW(RegimeEngine::deserialize("not a snapshot"), std::runtime_error);
+    EXPECT_THROW(RegimeEngine::load(::testing::TempDir() + "missing_regime_snapshot.bin"), std::runtime_error);
+
+    AdaptiveThresholdOptions options;
+    options.vixRiskOn = 1.5;
+    EXPECT_THROW(AdaptiveRegimeThresholds{options}, std::invalid_argument);
+    options = AdaptiveThresholdOptions();
+    options.spreadTight = 0.9;
+    options.spreadWide = 0.5;
+    EXPECT_THROW(AdaptiveRegimeThresholds{options}, std::invalid_argument);
+    options = AdaptiveThresholdOptions();
+    options.minObservations = options.windowDays;
+    EXPECT_THROW(AdaptiveRegimeThresholds{options}, std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
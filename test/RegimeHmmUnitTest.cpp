@@ -0,0 +1,204 @@
+//
+//  RegimeHmmUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the Gaussian HMM regime model and online filter
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/RegimeHmm.hpp"
+#include <chrono>
+#include <cmath>
+#include <random>
+
+class RegimeHmmTest : public ::testing::Test {
+protected:
+    // Calm and stressed markets (VIX, MOVE, spread, 2s10s, put/call)
+    static GaussianHmm trueModel() {
+        Eigen::VectorXd initial(2);
+        initial << 0.7, 0.3;
+        Eigen::MatrixXd transition(2, 2);
+        transition << 0.99, 0.01,
+                      0.03, 0.97;
+        Eigen::MatrixXd means(2, 5);
+        means << 14.0, 85.0, 110.0, 120.0, 0.8,
+                 32.0, 130.0, 260.0, -20.0, 1.1;
+        Eigen::MatrixXd sd(2, 5);
+        sd << 2.0, 8.0, 15.0, 30.0, 0.05,
+              5.0, 15.0, 40.0, 40.0, 0.10;
+        return GaussianHmm(initial, transition, means, sd.cwiseProduct(sd));
+    }
+
+    static std::vector<RegimeTick> simulate(const GaussianHmm& model, int days, std::vector<int>& states,
+                                            uint64_t seed = 21) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        auto draw = [&](const Eigen::VectorXd& probabilities) {
+            double u = uniform(rng);
+            int s = 0;
+            while (s + 1 < probabilities.size() && (u -= probabilities(s)) > 0.0) {
+                s++;
+            }
+            return s;
+        };
+
+        std::vector<RegimeTick> ticks;
+        states.clear();
+        int state = draw(model.initialProbabilities());
+        for (int d = 0; d < days; d++) {
+            if (d > 0) {
+                state = draw(model.transitionMatrix().row(state).transpose());
+            }
+            double x[5];
+            for (int k = 0; k < 5; k++) {
+                x[k] = model.means()(state, k) + std::sqrt(model.variances()(state, k)) * noise(rng);
+            }
+            ticks.push_back({19950101 + d, x[0], x[1], x[2], x[3], x[4]});
+            states.push_back(state);
+        }
+        return ticks;
+    }
+};
+
+// ===== Forward-Backward Tests =====
+
+TEST_F(RegimeHmmTest, ForwardBackwardMatchesPathEnumeration) {
+    GaussianHmm model = trueModel();
+    std::vector<int> states;
+    std::vector<RegimeTick> ticks = simulate(model, 7, states);
+
+    // Emission density by hand
+    auto density = [&](int s, const RegimeTick& tick) {
+        Eigen::VectorXd x = GaussianHmm::observation(tick);
+        double p = 1.0;
+        for (int k = 0; k < 5; k++) {
+            const double v = model.variances()(s, k);
+            const double z = x(k) - model.means()(s, k);
+            p *= std::exp(-0.5 * z * z / v) / std::sqrt(2.0 * M_PI * v);
+        }
+        return p;
+    };
+
+    // Sum over all 2^7 state paths
+    const int T = static_cast<int>(ticks.size());
+    double total = 0.0;
+    Eigen::MatrixXd marginals = Eigen::MatrixXd::Zero(T, 2);
+    for (int path = 0; path < (1 << T); path++) {
+        double p = 1.0;
+        for (int t = 0; t < T; t++) {
+            const int s = (path >> t) & 1;
+            p *= (t == 0 ? model.initialProbabilities()(s)
+                         : model.transitionMatrix()((path >> (t - 1)) & 1, s)) * density(s, ticks[t]);
+        }
+        total += p;
+        for (int t = 0; t < T; t++) {
+            marginals(t, (path >> t) & 1) += p;
+        }
+    }
+    marginals /= total;
+
+    EXPECT_NEAR(model.logLikelihood(ticks), std::log(total), 1e-9);
+    EXPECT_TRUE(model.smoothedProbabilities(ticks).isApprox(marginals, 1e-9));
+    EXPECT_TRUE(model.filteredProbabilities(ticks).row(T - 1).isApprox(marginals.row(T - 1), 1e-9));
+}
+
+// ===== Baum-Welch Tests =====
+
+TEST_F(RegimeHmmTest, RecoversParametersFromThirtyYears) {
+    GaussianHmm truth = trueModel();
+    std::vector<int> states;
+    std::vector<RegimeTick> ticks = simulate(truth, 7560, states);
+
+    HmmOptions options;
+    options.numStates = 2;
+    auto start = std::chrono::steady_clock::now();
+    GaussianHmm fitted = GaussianHmm::fit(ticks, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_TRUE(fitted.converged());
+    EXPECT_LT(seconds, 1.0);
+    EXPECT_GE(fitted.trainingLogLikelihood(), truth.logLikelihood(ticks) - 1.0);
+
+    // State 0 is the calm one
+    EXPECT_NEAR(fitted.means()(0, 0), 14.0, 0.3);
+    EXPECT_NEAR(fitted.means()(1, 0), 32.0, 0.6);
+    EXPECT_NEAR(fitted.means()(1, 2), 260.0, 5.0);
+    EXPECT_NEAR(std::sqrt(fitted.variances()(1, 0)), 5.0, 0.4);
+    EXPECT_NEAR(fitted.transitionMatrix()(0, 0), 0.99, 0.005);
+    EXPECT_NEAR(fitted.transitionMatrix()(1, 1), 0.97, 0.015);
+    EXPECT_EQ(fitted.stateRegimes()[1].riskLabel, "Risk-Off");
+    EXPECT_LT(fitted.stateRegimes()[0].volatilityMultiplier, fitted.stateRegimes()[1].volatilityMultiplier);
+
+    Eigen::MatrixXd smoothed = fitted.smoothedProbabilities(ticks);
+    int correct = 0;
+    for (size_t t = 0; t < ticks.size(); t++) {
+        correct += (smoothed(static_cast<Eigen::Index>(t), 1) > 0.5) == (states[t] == 1);
+    }
+    EXPECT_GT(correct, 0.98 * ticks.size());
+}
+
+// ===== Online Filter Tests =====
+
+TEST_F(RegimeHmmTest, OnlineFilterMatchesBatchFiltering) {
+    GaussianHmm model = trueModel();
+    std::vector<int> states;
+    std::vector<RegimeTick> ticks = simulate(model, 500, states, 4);
+    Eigen::MatrixXd batch = model.filteredProbabilities(ticks);
+
+    HmmRegimeFilter filter(model);
+    EXPECT_THROW(filter.regime(), std::logic_error);
+    for (size_t t = 0; t < ticks.size(); t++) {
+        const Eigen::VectorXd& p = filter.update(ticks[t]);
+        ASSERT_TRUE(p.isApprox(batch.row(static_cast<Eigen::Index>(t)).transpose(), 1e-9)) << "day " << t;
+    }
+
+    MacroRegime regime = filter.regime();
+    Eigen::Index top;
+    const double confidence = filter.probabilities().maxCoeff(&top);
+    EXPECT_EQ(regime.riskLabel, model.stateRegimes()[static_cast<size_t>(top)].riskLabel);
+    EXPECT_DOUBLE_EQ(regime.confidence, confidence);
+    EXPECT_DOUBLE_EQ(regime.vixLevel, ticks.back().vixLevel);
+    EXPECT_NEAR(regime.volatilityMultiplier,
+                filter.probabilities().dot(Eigen::Vector2d(model.stateRegimes()[0].volatilityMultiplier,
+                                                           model.stateRegimes()[1].volatilityMultiplier)), 1e-12);
+
+    // A day with only VIX still updates; a stale date does not
+    RegimeTick partial{ticks.back().date + 1, 40.0, NAN, NAN, NAN, NAN};
+    EXPECT_GT(filter.update(partial)(1), 0.5);
+    EXPECT_EQ(filter.days(), 501);
+    EXPECT_THROW(filter.update(partial), std::invalid_argument);
+}
+
+// ===== Error Handling =====
+
+TEST_F(RegimeHmmTest, RejectsInvalidModelsAndHistories) {
+    GaussianHmm model = trueModel();
+    Eigen::MatrixXd badTransition = model.transitionMatrix();
+    badTransition(0, 0) = 0.5;
+    EXPECT_THROW(GaussianHmm(model.initialProbabilities(), badTransition, model.means(), model.variances()),
+                 std::invalid_argument);
+    EXPECT_THROW(GaussianHmm(model.initialProbabilities(), model.transitionMatrix(), model.means(),
+                             -model.variances()), std::invalid_argument);
+    EXPECT_THROW(GaussianHmm(model.initialProbabilities(), model.transitionMatrix(),
+                             model.means().leftCols(4), model.variances()), std::invalid_argument);
+    EXPECT_THROW(model.volatilityMultiplier(Eigen::Vector3d(0.2, 0.3, 0.5)), std::invalid_argument);
+
+    std::vector<int> states;
+    std::vector<RegimeTick> ticks = simulate(model, 50, states);
+    HmmOptions options;
+    EXPECT_THROW(GaussianHmm::fit(std::vector<RegimeTick>(ticks.begin(), ticks.begin() + 5), options),
+                 std::invalid_argument);
+    options.numStates = 0;
+    EXPECT_THROW(GaussianHmm::fit(ticks, options), std::invalid_argument);
+    ticks[10].creditSpread = NAN;
+    EXPECT_THROW(GaussianHmm::fit(ticks, HmmOptions()), std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,249 @@
+//
+//  ResultsLogUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the append-only binary results log
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Storage/ResultsLog.hpp"
+#include "../src/Utils/Date.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+
+class ResultsLogTest : public ::testing::Test {
+protected:
+    std::string logPath;
+
+    void SetUp() override {
+        auto dir = std::filesystem::temp_directory_path() /
+                   ("results_log_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                    "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::create_directories(dir);
+        logPath = (dir / "results.log").string();
+        std::filesystem::remove(logPath);
+        std::filesystem::remove(logPath + ".idx");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(std::filesystem::path(logPath).parent_path());
+    }
+
+    // Create a deterministic 3-indicator result for a given date
+    static DailyResult createResult(int date) {
+        DailyResult result;
+        result.date = date;
+        result.timestamp = 1700000000 + date;
+        result.indicatorNames = {"gdp", "inflation", "vix"};
+        result.covariance = Eigen::MatrixXd::Identity(3, 3) * (date % 100);
+        result.eigenvalues = Eigen::Vector3d(3.0, 2.0, 1.0);
+        result.eigenvectors = Eigen::MatrixXd::Identity(3, 3);
+        result.frobeniusNorm = 1.5 + date % 7;
+        result.conditionNumber = 3.0;
+        result.varianceExplained = 0.87;
+        result.factorLabels = {"Growth", "Volatility"};
+        result.labelConfidences = {0.9, 0.75};
+        result.recommendedNotional = 4500000.0;
+        result.recommendedShares = 900.0;
+        result.recommendedLeverage = 1.8;
+        result.riskLabel = "Neutral";
+        result.volatilityMultiplier = 1.2;
+        return result;
+    }
+};
+
+// ===== Date Key Tests =====
+
+TEST_F(ResultsLogTest, DateKeysRoundTrip) {
+    EXPECT_EQ(dateToInt("2025-12-26"), 20251226);
+    EXPECT_EQ(intToDate(20250105), "2025-01-05");
+    EXPECT_THROW(dateToInt("12/26/2025"), std::invalid_argument);
+}
+
+// ===== Round-Trip Tests =====
+
+TEST_F(ResultsLogTest, AppendAndReadBack) {
+    {
+        ResultsLogWriter writer(logPath);
+        writer.append(createResult(20250101));
+        writer.append(createResult(20250102));
+        writer.flush();
+        EXPECT_EQ(writer.recordCount(), 2);
+    }
+
+    ResultsLogReader reader(logPath);
+    ASSERT_EQ(reader.size(), 2);
+
+    auto results = reader.readRange(20250101, 20250102);
+    ASSERT_EQ(results.size(), 2);
+
+    DailyResult expected = createResult(20250102);
+    const DailyResult& actual = results[1];
+    EXPECT_EQ(actual.date, expected.date);
+    EXPECT_EQ(actual.timestamp, expected.timestamp);
+    EXPECT_EQ(actual.indicatorNames, expected.indicatorNames);
+    EXPECT_TRUE(actual.covariance.isApprox(expected.covariance));
+    EXPECT_TRUE(actual.eigenvalues.isApprox(expected.eigenvalues));
+    EXPECT_TRUE(actual.eigenvectors.isApprox(expected.eigenvectors));
+    EXPECT_DOUBLE_EQ(actual.frobeniusNorm, expected.frobeniusNorm);
+    EXPECT_EQ(actual.factorLabels, expected.factorLabels);
+    EXPECT_EQ(actual.labelConfidences, expected.labelConfidences);
+    EXPECT_DOUBLE_EQ(actual.recommendedNotional, expected.recommendedNotional);
+    EXPECT_EQ(actual.riskLabel, expected.riskLabel);
+    EXPECT_DOUBLE_EQ(actual.volatilityMultiplier, expected.volatilityMultiplier);
+}
+
+TEST_F(ResultsLogTest, ReadLatest) {
+    {
+        ResultsLogWriter writer(logPath);
+        for (int day = 1; day <= 10; day++) {
+            writer.append(createResult(20250100 + day));
+        }
+    }
+
+    ResultsLogReader reader(logPath);
+    DailyResult latest;
+    ASSERT_TRUE(reader.readLatest(latest));
+    EXPECT_EQ(latest.date, 20250110);
+}
+
+TEST_F(ResultsLogTest, EmptyLog) {
+    { ResultsLogWriter writer(logPath); }
+
+    ResultsLogReader reader(logPath);
+    DailyResult latest;
+    EXPECT_EQ(reader.size(), 0);
+    EXPECT_FALSE(reader.readLatest(latest));
+    EXPECT_TRUE(reader.readRange(0, 99999999).empty());
+}
+
+// ===== Range Query Tests (sparse index) =====
+
+TEST_F(ResultsLogTest, RangeQueryAcrossIndexStride) {
+    {
+        ResultsLogWriter writer(logPath, 4);  // Small stride to exercise the index
+        for (int month = 1; month <= 12; month++) {
+            for (int day = 1; day <= 28; day++) {
+                writer.append(createResult(20240000 + month * 100 + day));
+            }
+        }
+    }
+
+    ResultsLogReader reader(logPath);
+    EXPECT_EQ(reader.size(), 12 * 28);
+
+    auto march = reader.readRange(20240301, 20240331);
+    ASSERT_EQ(march.size(), 28);
+    EXPECT_EQ(march.front().date, 20240301);
+    EXPECT_EQ(march.back().date, 20240328);
+
+    auto none = reader.readRange(20240229, 20240229);
+    EXPECT_TRUE(none.empty());
+}
+
+TEST_F(ResultsLogTest, DuplicateDatesStraddlingIndexBoundary) {
+    {
+        ResultsLogWriter writer(logPath, 2);
+        writer.append(createResult(20250101));
+        writer.append(createResult(20250102));
+        writer.append(createResult(20250102));
+        writer.append(createResult(20250102));
+        writer.append(createResult(20250103));
+    }
+
+    ResultsLogReader reader(logPath);
+    EXPECT_EQ(reader.readRange(20250102, 20250102).size(), 3);
+}
+
+TEST_F(ResultsLogTest, RejectsOutOfOrderDates) {
+    ResultsLogWriter writer(logPath);
+    writer.append(createResult(20250105));
+    EXPECT_THROW(writer.append(createResult(20250104)), std::invalid_argument);
+}
+
+// ===== Durability Tests =====
+
+TEST_F(ResultsLogTest, ReopenContinuesAppending) {
+    {
+        ResultsLogWriter writer(logPath, 3);
+        for (int day = 1; day <= 5; day++) writer.append(createResult(20250100 + day));
+    }
+    {
+        ResultsLogWriter writer(logPath, 3);
+        EXPECT_EQ(writer.recordCount(), 5);
+        EXPECT_EQ(writer.lastDate(), 20250105);
+        for (int day = 6; day <= 9; day++) writer.append(createResult(20250100 + day));
+    }
+
+    ResultsLogReader reader(logPath);
+    EXPECT_EQ(reader.size(), 9);
+    EXPECT_EQ(reader.readRange(20250104, 20250107).size(), 4);
+}
+
+TEST_F(ResultsLogTest, TornTailIsTruncatedOnReopen) {
+    {
+        ResultsLogWriter writer(logPath);
+        writer.append(createResult(20250101));
+        writer.append(createResult(20250102));
+    }
+
+    // Simulate a crash mid-write: chop the last record in half
+    auto fullSize = std::filesystem::file_size(logPath);
+    std::filesystem::resize_file(logPath, fullSize - 20);
+
+    {
+        ResultsLogReader reader(logPath);
+        EXPECT_EQ(reader.size(), 1);
+    }
+
+    {
+        ResultsLogWriter writer(logPath);
+        EXPECT_EQ(writer.recordCount(), 1);
+        writer.append(createResult(20250103));
+    }
+
+    ResultsLogReader reader(logPath);
+    auto results = reader.readRange(0, 99999999);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[1].date, 20250103);
+}
+
+TEST_F(ResultsLogTest, MissingIndexFallsBackToScan) {
+    {
+        ResultsLogWriter writer(logPath, 2);
+        for (int day = 1; day <= 7; day++) writer.append(createResult(20250100 + day));
+    }
+    std::filesystem::remove(logPath + ".idx");
+
+    ResultsLogReader reader(logPath);
+    EXPECT_EQ(reader.size(), 7);
+    EXPECT_EQ(reader.readRange(20250103, 20250105).size(), 3);
+}
+
+TEST_F(ResultsLogTest, RejectsForeignFile) {
+    std::ofstream(logPath) << "{\"date\": \"2025-01-01\"}";
+    EXPECT_THROW(ResultsLogReader reader(logPath), std::runtime_error);
+    EXPECT_THROW(ResultsLogWriter writer(logPath), std::runtime_error);
+}
+
+// ===== JSON Export Tests =====
+
+TEST_F(ResultsLogTest, JsonExport) {
+    json exported = ResultsLogReader::toJson(createResult(20251226));
+
+    EXPECT_EQ(exported["date"], "2025-12-26");
+    EXPECT_EQ(exported["covariance_matrix"].size(), 3);
+    EXPECT_EQ(exported["eigenvalues"].size(), 3);
+    EXPECT_EQ(exported["factors"][0]["label"], "Growth");
+    EXPECT_DOUBLE_EQ(exported["position"]["notional"].get<double>(), 4500000.0);
+    EXPECT_EQ(exported["regime"]["risk_label"], "Neutral");
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
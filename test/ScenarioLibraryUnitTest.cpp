@@ -0,0 +1,186 @@
+//
+//  ScenarioLibraryUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the scenario library and stress grid evaluator
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/DataProcessors/ScenarioLibrary.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+class ScenarioLibraryTest : public ::testing::Test {
+protected:
+    static MacroFactors createFactors() {
+        MacroFactors factors;
+        factors.numFactors = 3;
+        factors.factorLabels = {"Growth", "Inflation", "Volatility"};
+        factors.factorVariances = {0.04, 0.01, 0.25};     // σ = 0.2, 0.1, 0.5
+        return factors;
+    }
+
+    static json createSpec() {
+        return json::parse(R"({
+            "description": "test library",
+            "episodes": [
+                {"name": "2008 Q4", "shocks": {"Growth": -3.0, "Volatility": 4.0}},
+                {"name": "2022 inflation", "description": "CPI surprise", "shocks": {"Inflation": 3.0}}
+            ],
+            "grids": [
+                {"name": "growth x vol", "axes": {"Growth": [-2, -1, 0], "Volatility": {"from": 0, "to": 4, "steps": 5}}}
+            ]
+        })");
+    }
+
+    // Three books with distinct factor exposures (K × P)
+    static Eigen::MatrixXd createExposures() {
+        Eigen::MatrixXd exposures(3, 3);
+        exposures << 1.0, -0.5, 0.2,
+                     -0.3, 0.8, 0.0,
+                     -0.6, 0.1, 1.0;
+        return exposures;
+    }
+};
+
+// ===== Library Tests =====
+
+TEST_F(ScenarioLibraryTest, SpecBuildsEpisodesAndGridsInSigmaUnits) {
+    ScenarioLibrary library = ScenarioLibrary::fromSpec(createSpec(), createFactors());
+
+    ASSERT_EQ(library.size(), 2u + 15u);
+    auto shocks = library.shocks();
+    EXPECT_TRUE(shocks.row(0).isApprox(Eigen::RowVector3d(-0.6, 0.0, 2.0)));
+    EXPECT_TRUE(shocks.row(1).isApprox(Eigen::RowVector3d(0.0, 0.3, 0.0)));
+    EXPECT_EQ(library.scenarioName(0), "2008 Q4");
+    EXPECT_EQ(library.scenarioName(1), "2022 inflation");
+
+    // Grid rows: Growth outer, Volatility inner; Inflation untouched
+    EXPECT_TRUE(shocks.row(2).isApprox(Eigen::RowVector3d(-0.4, 0.0, 0.0)));
+    EXPECT_TRUE(shocks.row(3).isApprox(Eigen::RowVector3d(-0.4, 0.0, 0.5)));
+    EXPECT_TRUE(shocks.row(16).isApprox(Eigen::RowVector3d(0.0, 0.0, 2.0)));
+    EXPECT_EQ(library.scenarioName(3), "growth x vol [Growth=-0.4, Volatility=0.5]");
+    EXPECT_THROW(library.scenarioName(17), std::out_of_range);
+
+    // Factor units skip the σ scaling
+    json spec = createSpec();
+    spec["units"] = "factor";
+    EXPECT_TRUE(ScenarioLibrary::fromSpec(spec, createFactors()).shocks().row(0).isApprox(Eigen::RowVector3d(-3, 0, 4)));
+}
+
+TEST_F(ScenarioLibraryTest, ShippedSpecLoadsAgainstDefaultThreeFactorModel) {
+    // The shipped spec also shocks "Policy", which a 3-factor model may lack
+    std::ifstream file("config/stress_scenarios.json");
+    ASSERT_TRUE(file.is_open());
+    ScenarioLibrary library = ScenarioLibrary::fromSpec(json::parse(file), createFactors());
+
+    // Five episodes, 25×25 growth x volatility, and inflation x policy cut to its inflation axis
+    ASSERT_EQ(library.size(), 5u + 625u + 25u);
+    auto shocks = library.shocks();
+    EXPECT_TRUE(shocks.row(0).isApprox(Eigen::RowVector3d(-0.6, -0.15, 2.0)));
+    EXPECT_EQ(library.scenarioName(1), "2013 taper tantrum");
+    EXPECT_TRUE(shocks.row(1).isApprox(Eigen::RowVector3d(0.0, 0.0, 0.5)));
+    EXPECT_TRUE(shocks.row(630).isApprox(Eigen::RowVector3d(0.0, -0.2, 0.0)));
+    EXPECT_EQ(library.scenarioName(654), "inflation x policy [Inflation=0.4]");
+}
+
+TEST_F(ScenarioLibraryTest, UnknownAndAmbiguousLabelsAreDropped) {
+    json spec = json::parse(R"({
+        "episodes": [
+            {"name": "liquidity", "shocks": {"Liquidity": 2.0}},
+            {"name": "mixed", "shocks": {"Growth": -1.0, "Liquidity": 2.0, "Unclassified": 1.0}}
+        ],
+        "grids": [
+            {"name": "orphan", "axes": {"Liquidity": [1, 2]}},
+            {"name": "half", "axes": {"Unclassified": [1, 2], "Growth": [-1, 1]}}
+        ]
+    })");
+
+    // Two unlabeled factors share "Unclassified": neither may absorb the shock
+    MacroFactors factors = createFactors();
+    factors.factorLabels = {"Growth", "Unclassified", "Unclassified"};
+    ScenarioLibrary library = ScenarioLibrary::fromSpec(spec, factors);
+
+    ASSERT_EQ(library.size(), 1u + 2u);
+    EXPECT_EQ(library.scenarioName(0), "mixed");
+    EXPECT_TRUE(library.shocks().row(0).isApprox(Eigen::RowVector3d(-0.2, 0.0, 0.0)));
+    EXPECT_EQ(library.scenarioName(2), "half [Growth=0.2]");
+
+    EXPECT_THROW(library.addGrid("direct", {{"Unclassified", {1.0}}}), std::invalid_argument);
+    EXPECT_THROW(library.addGrid("direct", {{"Liquidity", {1.0}}}), std::invalid_argument);
+}
+
+// ===== Evaluator Tests =====
+
+TEST_F(ScenarioLibraryTest, EvaluateIsOneMatrixProduct) {
+    ScenarioLibrary library = ScenarioLibrary::fromSpec(createSpec(), createFactors());
+    Eigen::MatrixXd exposures = createExposures();
+    Eigen::MatrixXd pnl = ScenarioEvaluator::evaluate(library, exposures);
+
+    ASSERT_EQ(pnl.rows(), 17);
+    ASSERT_EQ(pnl.cols(), 3);
+    for (Eigen::Index s = 0; s < 17; s++) {
+        for (Eigen::Index p = 0; p < 3; p++) {
+            EXPECT_NEAR(pnl(s, p), library.shocks().row(s).dot(exposures.col(p)), 1e-14);
+        }
+    }
+}
+
+TEST_F(ScenarioLibraryTest, WorstCasesMatchFullSortAcrossBlocks) {
+    // 41 × 41 × 9 = 15129 rows: several evaluator blocks
+    ScenarioLibrary library({"Growth", "Inflation", "Volatility"});
+    std::vector<double> wide(41), narrow(9);
+    for (int i = 0; i < 41; i++) wide[i] = -2.0 + 0.1 * i;
+    for (int i = 0; i < 9; i++) narrow[i] = 0.25 * i;
+    library.addEpisode("tail event", Eigen::Vector3d(-5.0, 2.0, 6.0));
+    library.addGrid("cube", {{"Growth", wide}, {"Inflation", wide}, {"Volatility", narrow}});
+    ASSERT_GT(library.size(), static_cast<size_t>(2 * ScenarioEvaluator::BLOCK_ROWS));
+
+    Eigen::MatrixXd exposures = createExposures();
+    Eigen::MatrixXd pnl = ScenarioEvaluator::evaluate(library, exposures);
+    auto tables = ScenarioEvaluator::worstCases(library, exposures, 25);
+
+    ASSERT_EQ(tables.size(), 3u);
+    for (Eigen::Index p = 0; p < 3; p++) {
+        std::vector<double> column(pnl.col(p).data(), pnl.col(p).data() + pnl.rows());
+        std::sort(column.begin(), column.end());
+        ASSERT_EQ(tables[p].size(), 25u);
+        for (size_t i = 0; i < 25; i++) {
+            EXPECT_NEAR(tables[p][i].pnl, column[i], 1e-12);
+            EXPECT_DOUBLE_EQ(tables[p][i].pnl, pnl(tables[p][i].scenario, p));
+            EXPECT_EQ(tables[p][i].name, library.scenarioName(tables[p][i].scenario));
+        }
+    }
+    EXPECT_EQ(tables[0][0].name, "tail event");
+}
+
+// ===== Error Handling =====
+
+TEST_F(ScenarioLibraryTest, RejectsMalformedSpecs) {
+    MacroFactors factors = createFactors();
+    EXPECT_THROW(ScenarioLibrary::fromSpec(json::array(), factors), std::invalid_argument);
+    EXPECT_THROW(ScenarioLibrary::fromSpec(json::parse(R"({"scenarios": []})"), factors), std::invalid_argument);
+    EXPECT_THROW(ScenarioLibrary::fromSpec(json::parse(R"({"units": "bps"})"), factors), std::invalid_argument);
+    EXPECT_THROW(ScenarioLibrary::fromSpec(
+        json::parse(R"({"episodes": [{"name": "x", "shocks": {"Growth": "down"}}]})"), factors), std::invalid_argument);
+    EXPECT_THROW(ScenarioLibrary::fromSpec(
+        json::parse(R"({"grids": [{"name": "g", "axes": {"Growth": []}}]})"), factors), std::invalid_argument);
+    EXPECT_THROW(ScenarioLibrary::fromSpec(
+        json::parse(R"({"grids": [{"name": "g", "axes": {"Growth": {"from": 0, "to": 1, "steps": 0}}}]})"), factors),
+        std::invalid_argument);
+
+    ScenarioLibrary library(factors.factorLabels);
+    EXPECT_THROW(library.addEpisode("short", Eigen::Vector2d::Zero()), std::invalid_argument);
+    EXPECT_THROW(library.addGrid("dup", {{"Growth", {1.0}}, {"Growth", {2.0}}}), std::invalid_argument);
+    EXPECT_THROW(ScenarioEvaluator::evaluate(library, Eigen::MatrixXd::Ones(2, 1)), std::invalid_argument);
+    EXPECT_THROW(ScenarioLibrary(std::vector<std::string>{}), std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,211 @@
+//
+//  TracerUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the Chrome trace-event recorder
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Utils/Tracer.hpp"
+#include "../src/Utils/Metrics.hpp"
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <thread>
+#include <vector>
+
+class TracerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        Tracer::stop();
+    }
+};
+
+// ===== Recording Tests =====
+
+TEST_F(TracerTest, DisabledRecordsNothing) {
+    Tracer::start(16);
+    Tracer::stop();
+
+    {
+        TRACE_SCOPE("test", "ignored");
+    }
+    Tracer::record("test", "ignored", 0, 10);
+
+    EXPECT_FALSE(Tracer::enabled());
+    EXPECT_TRUE(Tracer::events().empty());
+}
+
+TEST_F(TracerTest, SpanCoversScope) {
+    Tracer::start(16);
+    {
+        TRACE_SCOPE("test", "sleep");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    std::vector<TraceEvent> events = Tracer::events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].name, "sleep");
+    EXPECT_EQ(events[0].category, "test");
+    EXPECT_EQ(events[0].threadId, Tracer::currentThreadId());
+    EXPECT_GE(events[0].durationNanos, 2000000u);
+    EXPECT_TRUE(events[0].args.is_null());
+}
+
+TEST_F(TracerTest, ThreadsGetDistinctIds) {
+    Tracer::start(1024);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            Tracer::setThreadName("worker-" + std::to_string(t));
+            for (int i = 0; i < 50; i++) {
+                TRACE_SCOPE("test", "work");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<TraceEvent> events = Tracer::events();
+    ASSERT_EQ(events.size(), 200u);
+
+    std::set<uint32_t> threadIds;
+    for (size_t i = 0; i < events.size(); i++) {
+        threadIds.insert(events[i].threadId);
+        if (i > 0) {
+            EXPECT_GE(events[i].startNanos, events[i - 1].startNanos);
+        }
+    }
+    EXPECT_EQ(threadIds.size(), 4u);
+    EXPECT_EQ(threadIds.count(Tracer::currentThreadId()), 0u);
+}
+
+TEST_F(TracerTest, FullBufferDropsAndCounts) {
+    Tracer::start(10);
+    for (int i = 0; i < 25; i++) {
+        Tracer::record("test", "span", i, i + 1);
+    }
+
+    EXPECT_EQ(Tracer::events().size(), 10u);
+    EXPECT_EQ(Tracer::droppedCount(), 15u);
+    EXPECT_EQ(Tracer::toJson()["otherData"]["dropped_events"], 15);
+
+    // Restarting clears both
+    Tracer::start(10);
+    EXPECT_TRUE(Tracer::events().empty());
+    EXPECT_EQ(Tracer::droppedCount(), 0u);
+}
+
+TEST_F(TracerTest, ArgsOnlyBuiltWhenEnabled) {
+    int evaluations = 0;
+    auto expensive = [&]() { evaluations++; return 42; };
+
+    {
+        TRACE_SCOPE_ARGS("test", "off", {{"value", expensive()}});
+    }
+    EXPECT_EQ(evaluations, 0);
+
+    Tracer::start(16);
+    {
+        TRACE_SCOPE_ARGS("test", "on", {{"value", expensive()}, {"label", "x"}});
+    }
+    EXPECT_EQ(evaluations, 1);
+
+    std::vector<TraceEvent> events = Tracer::events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].args["value"], 42);
+    EXPECT_EQ(events[0].args["label"], "x");
+}
+
+TEST_F(TracerTest, ScopedTimerEmitsSpanWhenTracing) {
+    Metrics::reset();
+    Tracer::start(16);
+    {
+        METRICS_SCOPED_TIMER("stage.decompose");
+    }
+    {
+        METRICS_TIMER_START(alignTimer, "stage.align");
+        METRICS_TIMER_STOP(alignTimer);
+    }
+
+    std::vector<TraceEvent> events = Tracer::events();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].name, "stage.decompose");
+    EXPECT_EQ(events[0].category, "stage");
+    EXPECT_EQ(events[1].name, "stage.align");
+    EXPECT_EQ(Metrics::histogram("stage.decompose").count(), 1u);
+}
+
+// ===== Export Tests =====
+
+TEST_F(TracerTest, JsonUsesTraceEventFormat) {
+    Tracer::start(16);
+    Tracer::setThreadName("main");
+    Tracer::record("stage", "later", 5000, 9000);
+    Tracer::record("stage", "earlier", 1000, 3500, {{"t", 7}});
+
+    json trace = Tracer::toJson();
+    EXPECT_EQ(trace["displayTimeUnit"], "ms");
+
+    std::vector<json> spans;
+    bool namedThread = false;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            spans.push_back(event);
+        } else if (event["ph"] == "M" && event["name"] == "thread_name") {
+            namedThread = namedThread || (event["args"]["name"] == "main" &&
+                                          event["tid"] == Tracer::currentThreadId());
+        }
+    }
+    EXPECT_TRUE(namedThread);
+
+    ASSERT_EQ(spans.size(), 2u);
+    EXPECT_EQ(spans[0]["name"], "earlier");
+    EXPECT_EQ(spans[0]["cat"], "stage");
+    EXPECT_EQ(spans[0]["pid"], 1);
+    EXPECT_DOUBLE_EQ(spans[0]["ts"].get<double>(), 1.0);    // Microseconds
+    EXPECT_DOUBLE_EQ(spans[0]["dur"].get<double>(), 2.5);
+    EXPECT_EQ(spans[0]["args"]["t"], 7);
+    EXPECT_FALSE(spans[1].contains("args"));
+}
+
+TEST_F(TracerTest, SessionWritesParseableFile) {
+    std::string path = "/tmp/iyc_tracer_unit_test.json";
+    std::remove(path.c_str());
+
+    {
+        TraceSession session(path.c_str());
+        EXPECT_TRUE(Tracer::enabled());
+        TRACE_SCOPE("test", "session");
+    }
+    EXPECT_FALSE(Tracer::enabled());
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.is_open());
+    json trace = json::parse(file);
+    EXPECT_TRUE(trace.contains("traceEvents"));
+    EXPECT_EQ(Tracer::events().size(), 1u);
+    std::remove(path.c_str());
+
+    // No path: tracing stays off
+    {
+        TraceSession session(nullptr);
+        EXPECT_FALSE(Tracer::enabled());
+    }
+}
+
+TEST_F(TracerTest, WriteToBadPathThrows) {
+    Tracer::start(4);
+    EXPECT_THROW(Tracer::write("/nonexistent-dir/trace.json"), std::runtime_error);
+    EXPECT_THROW(Tracer::start(0), std::invalid_argument);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
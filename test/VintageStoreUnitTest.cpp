@@ -0,0 +1,168 @@
+//
+//  VintageStoreUnitTest.cpp
+//  InvertedYieldCurveTrader
+//
+//  Unit tests for the point-in-time vintage store
+//
+//  Created by Ryan Hamby on 10/18/26.
+//
+
+#include <gtest/gtest.h>
+#include "../src/Storage/VintageStore.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+
+class VintageStoreTest : public ::testing::Test {
+protected:
+    std::string root;
+
+    void SetUp() override {
+        auto dir = std::filesystem::temp_directory_path() /
+                   ("vintage_store_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                    "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir);
+        root = dir.string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+
+    // Q4 2023 GDP: advance 3.3, second 3.2, third 3.4; Q1 2024: advance 1.6
+    static std::string alfredResponse() {
+        return R"({
+            "realtime_start": "1776-07-04",
+            "realtime_end": "9999-12-31",
+            "observations": [
+                {"realtime_start": "2024-01-25", "realtime_end": "2024-02-27", "date": "2023-10-01", "value": "3.3"},
+                {"realtime_start": "2024-02-28", "realtime_end": "2024-03-27", "date": "2023-10-01", "value": "3.2"},
+                {"realtime_start": "2024-03-28", "realtime_end": "9999-12-31", "date": "2023-10-01", "value": "3.4"},
+                {"realtime_start": "2023-10-26", "realtime_end": "2024-01-24", "date": "2023-07-01", "value": "4.9"},
+                {"realtime_start": "2024-01-25", "realtime_end": "9999-12-31", "date": "2023-07-01", "value": "."},
+                {"realtime_start": "2024-04-25", "realtime_end": "9999-12-31", "date": "2024-01-01", "value": "1.6"}
+            ]
+        })";
+    }
+};
+
+// ===== ALFRED Import Tests =====
+
+TEST_F(VintageStoreTest, ParseALFREDDropsMissingValues) {
+    auto records = VintageStore::parseALFRED(alfredResponse());
+    ASSERT_EQ(records.size(), 5);
+    EXPECT_EQ(records[0].date, 20231001);
+    EXPECT_EQ(records[0].realtimeStart, 20240125);
+    EXPECT_EQ(records[2].realtimeEnd, REALTIME_OPEN_END);
+    EXPECT_DOUBLE_EQ(records[2].value, 3.4);
+}
+
+TEST_F(VintageStoreTest, ParseALFREDRejectsMalformedResponse) {
+    EXPECT_THROW(VintageStore::parseALFRED("{\"error_code\": 400}"), std::runtime_error);
+    EXPECT_THROW(VintageStore::parseALFRED("not json"), std::runtime_error);
+}
+
+// ===== As-Of Query Tests =====
+
+TEST_F(VintageStoreTest, ValueAsOfFollowsRevisions) {
+    VintageStore::writeSeries(root, "gdp", VintageStore::parseALFRED(alfredResponse()));
+
+    VintageStore store(root);
+    const VintageSeries& gdp = store.series("gdp");
+    EXPECT_EQ(gdp.recordCount(), 5);
+    EXPECT_EQ(gdp.observationCount(), 3);
+
+    EXPECT_TRUE(std::isnan(gdp.valueAsOf(20231001, 20240124)));   // Not yet released
+    EXPECT_DOUBLE_EQ(gdp.valueAsOf(20231001, 20240125), 3.3);      // Advance estimate
+    EXPECT_DOUBLE_EQ(gdp.valueAsOf(20231001, 20240227), 3.3);      // Inclusive end
+    EXPECT_DOUBLE_EQ(gdp.valueAsOf(20231001, 20240228), 3.2);      // Second estimate
+    EXPECT_DOUBLE_EQ(gdp.valueAsOf(20231001, 20251231), 3.4);      // Latest vintage
+    EXPECT_TRUE(std::isnan(gdp.valueAsOf(20230401, 20251231)));    // Unknown observation
+}
+
+TEST_F(VintageStoreTest, SnapshotRebuildsWhatWasKnown) {
+    VintageStore::writeSeries(root, "gdp", VintageStore::parseALFRED(alfredResponse()));
+    VintageStore store(root);
+
+    auto early = store.series("gdp").snapshotAsOf(20240201);
+    ASSERT_EQ(early.dates.size(), 1);
+    EXPECT_EQ(early.dates[0], 20231001);                            // Q3 withdrawn ('.'), Q1 not released
+    EXPECT_DOUBLE_EQ(early.values[0], 3.3);
+
+    auto late = store.asOf(20240501);
+    ASSERT_EQ(late["gdp"].dates.size(), 2);
+    EXPECT_EQ(late["gdp"].dates, (std::vector<int32_t>{20231001, 20240101}));
+    EXPECT_EQ(late["gdp"].values, (std::vector<double>{3.4, 1.6}));
+
+    auto before = store.asOf(20231101);
+    EXPECT_EQ(before["gdp"].values, (std::vector<double>{4.9}));
+}
+
+TEST_F(VintageStoreTest, RecentAsOfIsMostRecentFirst) {
+    VintageStore::writeSeries(root, "gdp", VintageStore::parseALFRED(alfredResponse()));
+    VintageStore store(root);
+    const VintageSeries& gdp = store.series("gdp");
+
+    EXPECT_EQ(gdp.recentAsOf(20240501, 10), (std::vector<double>{1.6, 3.4}));
+    EXPECT_EQ(gdp.recentAsOf(20240501, 1), (std::vector<double>{1.6}));
+    EXPECT_TRUE(gdp.recentAsOf(20230101, 5).empty());
+}
+
+TEST_F(VintageStoreTest, ManyVintagesBinarySearch) {
+    // Monthly series, 600 observations, each revised 12 times a month apart
+    std::vector<VintageRecord> records;
+    for (int obs = 0; obs < 600; obs++) {
+        int32_t date = (1975 + obs / 12) * 10000 + (obs % 12 + 1) * 100 + 1;
+        for (int rev = 0; rev < 12; rev++) {
+            int year = 1975 + (obs + rev + 1) / 12;
+            int month = (obs + rev + 1) % 12 + 1;
+            int32_t start = year * 10000 + month * 100 + 15;
+            int32_t end = rev == 11 ? REALTIME_OPEN_END : start + ((month == 12) ? 8900 : 100) - 1;
+            records.push_back({date, start, end, obs + rev / 100.0});
+        }
+    }
+    VintageStore::writeSeries(root, "cpi", records);
+
+    VintageStore store(root);
+    const VintageSeries& cpi = store.series("cpi");
+    EXPECT_EQ(cpi.recordCount(), 7200);
+    EXPECT_EQ(cpi.observationCount(), 600);
+
+    // Observation 0 (Jan 1975) first published 1975-02-15, revised monthly through 1976-01
+    EXPECT_TRUE(std::isnan(cpi.valueAsOf(19750101, 19750214)));
+    EXPECT_DOUBLE_EQ(cpi.valueAsOf(19750101, 19750215), 0.0);
+    EXPECT_DOUBLE_EQ(cpi.valueAsOf(19750101, 19750415), 0.02);
+    EXPECT_DOUBLE_EQ(cpi.valueAsOf(19750101, 20200101), 0.11);
+}
+
+// ===== Validation Tests =====
+
+TEST_F(VintageStoreTest, RejectsOverlappingVintages) {
+    std::vector<VintageRecord> overlapping = {
+        {20240101, 20240201, 20240310, 1.0},
+        {20240101, 20240301, REALTIME_OPEN_END, 1.1},
+    };
+    EXPECT_THROW(VintageStore::writeSeries(root, "bad", overlapping), std::invalid_argument);
+
+    std::vector<VintageRecord> inverted = {{20240101, 20240301, 20240201, 1.0}};
+    EXPECT_THROW(VintageStore::writeSeries(root, "bad", inverted), std::invalid_argument);
+    EXPECT_THROW(VintageStore::writeSeries(root, "../bad", {}), std::invalid_argument);
+}
+
+TEST_F(VintageStoreTest, RejectsCorruptFileAndMissingSeries) {
+    VintageStore::writeSeries(root, "gdp", VintageStore::parseALFRED(alfredResponse()));
+    {
+        VintageStore store(root);
+        EXPECT_EQ(store.seriesNames(), std::vector<std::string>{"gdp"});
+        EXPECT_THROW(store.series("cpi"), std::out_of_range);
+    }
+
+    std::ofstream(root + "/junk.vin") << "garbage";
+    EXPECT_THROW(VintageStore store(root), std::runtime_error);
+}
+
+// Run tests
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
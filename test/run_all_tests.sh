@@ -27,10 +27,13 @@ FED_FUNDS_PROC="src/DataProcessors/FedFundsProcessor.cpp"
 UNEMPLOYMENT_PROC="src/DataProcessors/UnemploymentProcessor.cpp"
 SENTIMENT_PROC="src/DataProcessors/ConsumerSentimentProcessor.cpp"
 VIX_PROC="src/DataProcessors/VIXDataProcessor.cpp"
+HISTORY_STORE="src/Storage/HistoryStore.cpp src/Storage/MappedFile.cpp"
+METRICS="src/Utils/Metrics.cpp src/Utils/Tracer.cpp src/Utils/Logger.cpp"
 
 echo "1. Compiling FREDDataClient integration tests..."
 g++ $CXX_FLAGS $INCLUDES \
     $FRED_CLIENT \
+    $METRICS \
     test/FREDDataClientIntegrationTest.cpp \
     $LIBS $GTEST_LIBS \
     -o test_fred_client_integration || { echo "❌ Failed to compile FREDDataClient integration tests"; exit 1; }
@@ -41,6 +44,8 @@ g++ $CXX_FLAGS $INCLUDES \
     $FED_FUNDS_PROC \
     $UNEMPLOYMENT_PROC \
     $SENTIMENT_PROC \
+    $HISTORY_STORE \
+    $METRICS \
     test/FREDDataProcessorsIntegrationTest.cpp \
     $LIBS $GTEST_LIBS \
     -o test_fred_processors_integration || { echo "❌ Failed to compile FRED Processors integration tests"; exit 1; }
@@ -48,6 +53,8 @@ g++ $CXX_FLAGS $INCLUDES \
 echo "3. Compiling VIX Processor integration tests..."
 g++ $CXX_FLAGS $INCLUDES \
     $VIX_PROC \
+    $HISTORY_STORE \
+    $METRICS \
     test/VIXDataProcessorIntegrationTest.cpp \
     $LIBS $GTEST_LIBS \
     -o test_vix_processor_integration || { echo "❌ Failed to compile VIX Processor integration tests"; exit 1; }
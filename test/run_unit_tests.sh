@@ -16,7 +16,8 @@ GTEST_LIBS="-L/opt/homebrew/opt/googletest/lib -lgtest -lgtest_main -pthread"
 CXX_FLAGS="-std=c++20"
 
 FRED_CLIENT="src/DataProviders/FREDDataClient.cpp"
-VIX_PROC="src/DataProcessors/VIXDataProcessor.cpp"
+VIX_PROC="src/DataProcessors/VIXDataProcessor.cpp src/Storage/HistoryStore.cpp src/Storage/MappedFile.cpp"
+METRICS="src/Utils/Metrics.cpp src/Utils/Tracer.cpp src/Utils/Logger.cpp"
 DATA_ALIGNER="src/DataProcessors/DataAligner.cpp"
 COVARIANCE_CALC="src/DataProcessors/CovarianceCalculator.cpp"
 
@@ -27,6 +28,7 @@ INCLUDES="$INCLUDES $EIGEN_INCLUDE"
 echo "1. Compiling FRED Data Client unit tests..."
 g++ $CXX_FLAGS $INCLUDES \
     $FRED_CLIENT \
+    $METRICS \
     test/FREDDataClientUnitTest.cpp \
     $LIBS $GTEST_LIBS \
     -o test_fred_client_unit || { echo "❌ Failed to compile FRED unit tests"; exit 1; }
@@ -34,6 +36,7 @@ g++ $CXX_FLAGS $INCLUDES \
 echo "2. Compiling VIX Data Processor unit tests..."
 g++ $CXX_FLAGS $INCLUDES \
     $VIX_PROC \
+    $METRICS \
     test/VIXDataProcessorUnitTest.cpp \
     $LIBS $GTEST_LIBS \
     -o test_vix_processor_unit || { echo "❌ Failed to compile VIX unit tests"; exit 1; }
@@ -61,7 +64,7 @@ g++ $CXX_FLAGS $INCLUDES \
     -o test_surprise_transformer_unit || { echo "❌ Failed to compile SurpriseTransformer unit tests"; exit 1; }
 
 echo "6. Compiling MacroFactorModel unit tests..."
-MACRO_FACTOR_MODEL="src/DataProcessors/MacroFactorModel.cpp"
+MACRO_FACTOR_MODEL="src/DataProcessors/MacroFactorModel.cpp src/DataProcessors/RandomizedPCA.cpp src/Utils/Tracer.cpp src/Utils/Logger.cpp"
 g++ $CXX_FLAGS $INCLUDES \
     $MACRO_FACTOR_MODEL \
     $COVARIANCE_CALC \
@@ -90,7 +93,7 @@ g++ $CXX_FLAGS $INCLUDES \
     -o test_portfolio_risk_analyzer_unit || { echo "❌ Failed to compile PortfolioRiskAnalyzer unit tests"; exit 1; }
 
 echo "9. Compiling PositionSizer unit tests..."
-POSITION_SIZER="src/DataProcessors/PositionSizer.cpp"
+POSITION_SIZER="src/DataProcessors/PositionSizer.cpp src/DataProcessors/HistoricalSimulation.cpp src/DataProcessors/ScenarioLibrary.cpp"
 g++ $CXX_FLAGS $INCLUDES \
     $POSITION_SIZER \
     $PORTFOLIO_RISK_ANALYZER \
@@ -100,6 +103,140 @@ g++ $CXX_FLAGS $INCLUDES \
     $LIBS $GTEST_LIBS \
     -o test_position_sizer_unit || { echo "❌ Failed to compile PositionSizer unit tests"; exit 1; }
 
+echo "10. Compiling ResultsLog unit tests..."
+RESULTS_LOG="src/Storage/ResultsLog.cpp src/Storage/MappedFile.cpp src/Utils/Date.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $RESULTS_LOG \
+    test/ResultsLogUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_results_log_unit || { echo "❌ Failed to compile ResultsLog unit tests"; exit 1; }
+
+echo "11. Compiling HistoryStore unit tests..."
+HISTORY_STORE="src/Storage/HistoryStore.cpp src/Storage/MappedFile.cpp src/Utils/Logger.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $HISTORY_STORE \
+    test/HistoryStoreUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_history_store_unit || { echo "❌ Failed to compile HistoryStore unit tests"; exit 1; }
+
+echo "12. Compiling VintageStore unit tests..."
+VINTAGE_STORE="src/Storage/VintageStore.cpp src/Storage/MappedFile.cpp src/Utils/Date.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $VINTAGE_STORE \
+    test/VintageStoreUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_vintage_store_unit || { echo "❌ Failed to compile VintageStore unit tests"; exit 1; }
+
+echo "13. Compiling BacktestEngine unit tests..."
+BACKTEST_ENGINE="src/Backtest/BacktestEngine.cpp src/Storage/HistoryStore.cpp src/Storage/VintageStore.cpp src/Storage/MappedFile.cpp src/Utils/Date.cpp src/DataProcessors/PositionSizer.cpp src/DataProcessors/RegimeEngine.cpp src/DataProcessors/QuantileSketch.cpp src/DataProcessors/HistoricalSimulation.cpp src/DataProcessors/ScenarioLibrary.cpp src/DataProcessors/PortfolioRiskAnalyzer.cpp src/DataProcessors/MacroFactorModel.cpp src/DataProcessors/RandomizedPCA.cpp src/Utils/Tracer.cpp src/Utils/Logger.cpp src/DataProcessors/CovarianceCalculator.cpp src/DataProcessors/SurpriseTransformer.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $BACKTEST_ENGINE \
+    test/BacktestEngineUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_backtest_engine_unit || { echo "❌ Failed to compile BacktestEngine unit tests"; exit 1; }
+
+echo "14. Compiling ParameterSweep unit tests..."
+PARAMETER_SWEEP="src/Backtest/BacktestEngine.cpp src/Storage/HistoryStore.cpp src/Storage/VintageStore.cpp src/Storage/MappedFile.cpp src/Utils/Date.cpp src/DataProcessors/PositionSizer.cpp src/DataProcessors/RegimeEngine.cpp src/DataProcessors/QuantileSketch.cpp src/DataProcessors/HistoricalSimulation.cpp src/DataProcessors/ScenarioLibrary.cpp src/DataProcessors/PortfolioRiskAnalyzer.cpp src/DataProcessors/MacroFactorModel.cpp src/DataProcessors/RandomizedPCA.cpp src/Utils/Tracer.cpp src/Utils/Logger.cpp src/DataProcessors/CovarianceCalculator.cpp src/DataProcessors/SurpriseTransformer.cpp src/Backtest/ParameterSweep.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $PARAMETER_SWEEP \
+    test/ParameterSweepUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_parameter_sweep_unit || { echo "❌ Failed to compile ParameterSweep unit tests"; exit 1; }
+
+echo "15. Compiling Metrics unit tests..."
+g++ $CXX_FLAGS $INCLUDES \
+    $METRICS \
+    test/MetricsUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_metrics_unit || { echo "❌ Failed to compile Metrics unit tests"; exit 1; }
+
+echo "16. Compiling Tracer unit tests..."
+g++ $CXX_FLAGS $INCLUDES \
+    $METRICS \
+    test/TracerUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_tracer_unit || { echo "❌ Failed to compile Tracer unit tests"; exit 1; }
+
+echo "17. Compiling Logger unit tests..."
+LOGGER="src/Utils/Logger.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $LOGGER \
+    test/LoggerUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_logger_unit || { echo "❌ Failed to compile Logger unit tests"; exit 1; }
+
+echo "18. Compiling RandomizedPCA unit tests..."
+g++ $CXX_FLAGS $INCLUDES \
+    $MACRO_FACTOR_MODEL \
+    $COVARIANCE_CALC \
+    test/RandomizedPCAUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_randomized_pca_unit || { echo "❌ Failed to compile RandomizedPCA unit tests"; exit 1; }
+
+echo "19. Compiling EwmaCovariance unit tests..."
+EWMA_COVARIANCE="src/DataProcessors/EwmaCovariance.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $EWMA_COVARIANCE $COVARIANCE_CALC $MACRO_FACTOR_MODEL \
+    test/EwmaCovarianceUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_ewma_covariance_unit || { echo "❌ Failed to compile EwmaCovariance unit tests"; exit 1; }
+
+echo "20. Compiling PairwiseCovariance unit tests..."
+PAIRWISE_COVARIANCE="src/DataProcessors/PairwiseCovariance.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $PAIRWISE_COVARIANCE $COVARIANCE_CALC \
+    test/PairwiseCovarianceUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_pairwise_covariance_unit || { echo "❌ Failed to compile PairwiseCovariance unit tests"; exit 1; }
+
+echo "21. Compiling MonteCarloRisk unit tests..."
+MONTE_CARLO_RISK="src/DataProcessors/MonteCarloRisk.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $MONTE_CARLO_RISK \
+    test/MonteCarloRiskUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_monte_carlo_risk_unit || { echo "❌ Failed to compile MonteCarloRisk unit tests"; exit 1; }
+
+echo "22. Compiling HistoricalSimulation unit tests..."
+HISTORICAL_SIMULATION="src/DataProcessors/HistoricalSimulation.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $HISTORICAL_SIMULATION \
+    test/HistoricalSimulationUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_historical_simulation_unit || { echo "❌ Failed to compile HistoricalSimulation unit tests"; exit 1; }
+
+echo "23. Compiling ScenarioLibrary unit tests..."
+SCENARIO_LIBRARY="src/DataProcessors/ScenarioLibrary.cpp src/Utils/Logger.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $SCENARIO_LIBRARY \
+    test/ScenarioLibraryUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_scenario_library_unit || { echo "❌ Failed to compile ScenarioLibrary unit tests"; exit 1; }
+
+echo "24. Compiling RegimeEngine unit tests..."
+REGIME_ENGINE="src/DataProcessors/RegimeEngine.cpp src/DataProcessors/QuantileSketch.cpp src/DataProcessors/PositionSizer.cpp src/DataProcessors/HistoricalSimulation.cpp src/DataProcessors/ScenarioLibrary.cpp src/Utils/Logger.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $REGIME_ENGINE \
+    test/RegimeEngineUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_regime_engine_unit || { echo "❌ Failed to compile RegimeEngine unit tests"; exit 1; }
+
+echo "25. Compiling QuantileSketch unit tests..."
+QUANTILE_SKETCH="src/DataProcessors/QuantileSketch.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $QUANTILE_SKETCH \
+    test/QuantileSketchUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_quantile_sketch_unit || { echo "❌ Failed to compile QuantileSketch unit tests"; exit 1; }
+
+echo "26. Compiling RegimeHmm unit tests..."
+REGIME_HMM="src/DataProcessors/RegimeHmm.cpp src/DataProcessors/RegimeEngine.cpp src/DataProcessors/QuantileSketch.cpp src/DataProcessors/PositionSizer.cpp src/DataProcessors/HistoricalSimulation.cpp src/DataProcessors/ScenarioLibrary.cpp src/Utils/Logger.cpp"
+g++ $CXX_FLAGS $INCLUDES \
+    $REGIME_HMM \
+    test/RegimeHmmUnitTest.cpp \
+    $LIBS $GTEST_LIBS \
+    -o test_regime_hmm_unit || { echo "❌ Failed to compile RegimeHmm unit tests"; exit 1; }
+
 echo ""
 echo "✅ All unit tests compiled successfully!"
 echo ""
@@ -143,6 +280,74 @@ echo ""
 echo "--- PositionSizer Unit Tests ---"
 ./test_position_sizer_unit || { echo "❌ PositionSizer unit tests failed"; exit 1; }
 
+echo ""
+echo "--- ResultsLog Unit Tests ---"
+./test_results_log_unit || { echo "❌ ResultsLog unit tests failed"; exit 1; }
+
+echo ""
+echo "--- HistoryStore Unit Tests ---"
+./test_history_store_unit || { echo "❌ HistoryStore unit tests failed"; exit 1; }
+
+echo ""
+echo "--- VintageStore Unit Tests ---"
+./test_vintage_store_unit || { echo "❌ VintageStore unit tests failed"; exit 1; }
+
+echo ""
+echo "--- BacktestEngine Unit Tests ---"
+./test_backtest_engine_unit || { echo "❌ BacktestEngine unit tests failed"; exit 1; }
+
+echo ""
+echo "--- ParameterSweep Unit Tests ---"
+./test_parameter_sweep_unit || { echo "❌ ParameterSweep unit tests failed"; exit 1; }
+
+echo ""
+echo "--- Metrics Unit Tests ---"
+./test_metrics_unit || { echo "❌ Metrics unit tests failed"; exit 1; }
+
+echo ""
+echo "--- Tracer Unit Tests ---"
+./test_tracer_unit || { echo "❌ Tracer unit tests failed"; exit 1; }
+
+echo ""
+echo "--- Logger Unit Tests ---"
+./test_logger_unit || { echo "❌ Logger unit tests failed"; exit 1; }
+
+echo ""
+echo "--- RandomizedPCA Unit Tests ---"
+./test_randomized_pca_unit || { echo "❌ RandomizedPCA unit tests failed"; exit 1; }
+
+echo ""
+echo "--- EwmaCovariance Unit Tests ---"
+./test_ewma_covariance_unit || { echo "❌ EwmaCovariance unit tests failed"; exit 1; }
+
+echo ""
+echo "--- PairwiseCovariance Unit Tests ---"
+./test_pairwise_covariance_unit || { echo "❌ PairwiseCovariance unit tests failed"; exit 1; }
+
+echo ""
+echo "--- MonteCarloRisk Unit Tests ---"
+./test_monte_carlo_risk_unit || { echo "❌ MonteCarloRisk unit tests failed"; exit 1; }
+
+echo ""
+echo "--- HistoricalSimulation Unit Tests ---"
+./test_historical_simulation_unit || { echo "❌ HistoricalSimulation unit tests failed"; exit 1; }
+
+echo ""
+echo "--- ScenarioLibrary Unit Tests ---"
+./test_scenario_library_unit || { echo "❌ ScenarioLibrary unit tests failed"; exit 1; }
+
+echo ""
+echo "--- RegimeEngine Unit Tests ---"
+./test_regime_engine_unit || { echo "❌ RegimeEngine unit tests failed"; exit 1; }
+
+echo ""
+echo "--- QuantileSketch Unit Tests ---"
+./test_quantile_sketch_unit || { echo "❌ QuantileSketch unit tests failed"; exit 1; }
+
+echo ""
+echo "--- RegimeHmm Unit Tests ---"
+./test_regime_hmm_unit || { echo "❌ RegimeHmm unit tests failed"; exit 1; }
+
 echo ""
 echo "========================================="
 echo "✅ ALL UNIT TESTS PASSED!"
@@ -162,6 +367,23 @@ echo "  ✅ MacroFactorModel (PCA decomposition, archetype matching, stability t
 echo "  ✅ Phase 1 Integration (Full pipeline: Levels → Surprises → Factors)"
 echo "  ✅ PortfolioRiskAnalyzer (Exact risk attribution RC_k, scenario analysis, drawdown decomposition)"
 echo "  ✅ PositionSizer (Risk-aware ES sizing, regime classification, hedging recommendations)"
+echo "  ✅ ResultsLog (binary round-trip, sparse date index, torn-tail recovery)"
+echo "  ✅ HistoryStore (columnar round-trip, DeltaXor codec, in-place append)"
+echo "  ✅ VintageStore (ALFRED import, as-of snapshots, revision lookups)"
+echo "  ✅ BacktestEngine (30-year daily replay, P&L/drawdown accounting, regime tracking)"
+echo "  ✅ ParameterSweep (grid/random search, parallel determinism, results table)"
+echo "  ✅ Metrics (HDR histogram precision, concurrent recording, run summary record)"
+echo "  ✅ Tracer (Chrome trace-event export, bounded buffer, per-thread spans)"
+echo "  ✅ Logger (LOG_* field serialization, disabled-level short-circuit, async ring-buffer backend, drop reporting)"
+echo "  ✅ RandomizedPCA (sketch vs exact eigenpairs, a posteriori error bounds, wide-panel decomposition)"
+echo "  ✅ EwmaCovariance (half-life decay, direct weighted estimate, RiskMetrics steady state, term structure)"
+echo "  ✅ PairwiseCovariance (bitmask overlap counts, ragged-start pairwise estimates, PSD repair)"
+echo "  ✅ MonteCarloRisk (Philox streams, Gaussian/Student-t/regime VaR and ES)"
+echo "  ✅ HistoricalSimulation (Fenwick-tree rolling VaR/ES, multi-day scenarios)"
+echo "  ✅ ScenarioLibrary (episodes, sigma-scaled grids, blocked worst-case tables)"
+echo "  ✅ RegimeEngine (streaming dwell time and hysteresis, checksummed snapshots, adaptive thresholds)"
+echo "  ✅ QuantileSketch (t-digest accuracy and merging, rolling windows)"
+echo "  ✅ RegimeHmm (Baum-Welch vs path enumeration, parameter recovery, online filtering)"
 echo "  ✅ Error handling and edge cases"
 echo ""
 echo "Total: 180+ unit test cases"